@@ -987,6 +987,12 @@ tool "gfx"
     addSourceDir "tools/gfx/nvapi"
     addSourceDir "tools/gfx/cuda"
     addSourceDir "tools/gfx/debug-layer"
+
+    -- The CPU device runs dispatches on a thread pool
+    filter { "system:linux" }
+        links { "pthread" }
+    filter {}
+
     if targetInfo.isWindows then
         postbuildcommands {
             '{COPY} "$(SolutionDir)tools/gfx/gfx.slang" "%{cfg.targetdir}"',
@@ -1430,6 +1436,11 @@ standardProject("slang", "source/slang")
         defines { "SLANG_ENABLE_FULL_IR_VALIDATION" }
     end
 
+    -- Parallel downstream compilation uses std::thread
+    filter { "system:linux" }
+        links { "pthread" }
+    filter {}
+
     if enableEmbedStdLib then
         -- We only have this dependency if we are embedding stdlib
         if not skipSourceGeneration then
@@ -56,7 +56,7 @@ const uint64_t kTimeoutInfinite = 0xFFFFFFFFFFFFFFFF;
 
 enum class StructType
 {
-    D3D12DeviceExtendedDesc, D3D12ExperimentalFeaturesDesc
+    D3D12DeviceExtendedDesc, D3D12ExperimentalFeaturesDesc, CPUDeviceExtendedDesc
 };
 
 // TODO: Rename to Stage
@@ -2683,4 +2683,12 @@ struct D3D12DeviceExtendedDesc
     uint32_t highestShaderModel = 0;
 };
 
+struct CPUDeviceExtendedDesc
+{
+    StructType structType = StructType::CPUDeviceExtendedDesc;
+    /// The number of threads compute dispatches are run on, including the thread that dispatches.
+    /// 0 uses a thread per hardware thread, 1 runs all thread groups on the dispatching thread.
+    uint32_t workerThreadCount = 0;
+};
+
 }
@@ -781,6 +781,16 @@ extern "C"
         SLANG_DEBUG_INFO_FORMAT_COUNT_OF,
     };
 
+    /* Describes the format of a compilation performance report. */
+    typedef SlangUInt32 SlangPerformanceReportFormatIntegral;
+    enum SlangPerformanceReportFormat : SlangPerformanceReportFormatIntegral
+    {
+        SLANG_PERFORMANCE_REPORT_FORMAT_TEXT,       ///< Human readable table, with child phases indented
+        SLANG_PERFORMANCE_REPORT_FORMAT_JSON,       ///< JSON object holding the hierarchy of phases
+
+        SLANG_PERFORMANCE_REPORT_FORMAT_COUNT_OF,
+    };
+
     typedef SlangUInt32 SlangOptimizationLevelIntegral;
     enum SlangOptimizationLevel : SlangOptimizationLevelIntegral
     {
@@ -1565,6 +1575,22 @@ extern "C"
         SlangCompileRequest*    request,
         SlangOptimizationLevel  level);
 
+    /*! @see slang::ICompileRequest::setReportPerformance */
+    SLANG_API void spSetReportPerformance(
+        SlangCompileRequest*    request,
+        bool                    enable);
+
+    /*! @see slang::ICompileRequest::getPerformanceReport */
+    SLANG_API SlangResult spGetPerformanceReport(
+        SlangCompileRequest*            request,
+        SlangPerformanceReportFormat    format,
+        ISlangBlob**                    outReport);
+
+    /*! @see slang::ICompileRequest::setDownstreamCompileThreadCount */
+    SLANG_API void spSetDownstreamCompileThreadCount(
+        SlangCompileRequest*    request,
+        int                     count);
+
 
     
     /*! @see slang::ICompileRequest::setOutputContainerFormat */
@@ -3283,9 +3309,13 @@ namespace slang
         multiple sessions, in order to amortize startups costs (in current
         Slang this is mostly the cost of loading the Slang standard library).
 
-        The global session is currently *not* thread-safe and objects created from
-        a single global session should only be used from a single thread at
-        a time.
+        Once the standard library is loaded, sessions can be created from a global session
+        on multiple threads, and different sessions (and the objects created from them) can be
+        used on different threads at the same time. They share the standard library of the
+        global session. Each session, and the objects created from it, should still only be
+        used from a single thread at a time. Other methods of the global session (such as
+        setting downstream compiler paths or preludes) are not thread-safe, and should be
+        called before the global session is shared.
         */
     struct IGlobalSession : public ISlangUnknown
     {
@@ -4077,6 +4107,37 @@ namespace slang
 
             /** Set the debug format to be used for debugging information */
         virtual SLANG_NO_THROW void SLANG_MCALL setDebugInfoFormat(SlangDebugInfoFormat debugFormat) = 0;
+
+            /** Enable or disable recording of per-phase timing information.
+
+            When enabled, the time spent in each phase of compilation (preprocessing, parsing,
+            semantic checking, IR lowering, each IR pass, emit and downstream compilation) is
+            recorded, along with IR instruction counts and IR memory use after each pass.
+            The results accumulate over all compilations performed with the session of the
+            request, and can be retrieved with `getPerformanceReport`.
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL setReportPerformance(bool enable) = 0;
+
+            /** Get a report of the per-phase timing information recorded so far.
+            @param format The format of the report
+            @param outReport The report. The blob holds text (without a terminating 0).
+            @return SLANG_E_NOT_AVAILABLE if performance reporting is not enabled.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getPerformanceReport(
+            SlangPerformanceReportFormat format,
+            ISlangBlob** outReport) = 0;
+
+            /** Set the number of threads used to generate code for the entry points and targets of the request.
+
+            Linking, IR passes, source emit and downstream compilation (for example by dxc, fxc, glslang or
+            a C++ compiler) for each entry point and target run concurrently.
+            Generated code and diagnostics are identical to a serial compilation, and diagnostics are
+            reported in the same order.
+
+            @param count The number of threads. 1 generates code serially on the calling thread.
+            0 (the default) uses one thread per hardware thread.
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL setDownstreamCompileThreadCount(int count) = 0;
     };
 
     #define SLANG_UUID_ICompileRequest ICompileRequest::getTypeGuid()
@@ -4127,6 +4188,12 @@ namespace slang
         You have been warned.
         */
         kSessionFlag_FalcorCustomSharedKeywordSemantics = 1 << 0,
+
+        /** Record per-phase timing information for compilations performed with the session.
+
+        The recorded information can be retrieved with `IComponentType::getPerformanceReport`.
+        */
+        kSessionFlag_ReportPerformance = 1 << 1,
     };
 
     struct PreprocessorMacroDesc
@@ -4527,6 +4594,49 @@ namespace slang
             */
         virtual SLANG_NO_THROW SlangResult SLANG_MCALL renameEntryPoint(
             const char* newName, IComponentType** outEntryPoint) = 0;
+
+            /** Get a report of the per-phase timing information recorded by the session of this component type.
+
+            Requires the session to have been created with `kSessionFlag_ReportPerformance`.
+            The report covers all work done in the session so far, including loading modules
+            and generating code for component types.
+
+            @param format The format of the report
+            @param outReport The report. The blob holds text (without a terminating 0).
+            @return SLANG_E_NOT_AVAILABLE if performance reporting is not enabled.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getPerformanceReport(
+            SlangPerformanceReportFormat format,
+            ISlangBlob** outReport) = 0;
+
+            /** Get the code for an entry point of many specializations of this component type.
+
+            This produces the same code as calling `specialize`, then `link`, then `getEntryPointCode`
+            for each set of specialization arguments, but is faster when there are many sets. Work that
+            is the same for every specialization, such as building the symbols used to link the IR of
+            the stdlib and of this component type, is only done once for the whole batch. Downstream
+            compilation (for binary targets) of different specializations runs in parallel.
+
+            @param specializationArgs The sets of arguments, one set after another. Holds
+                `specializationArgCount * specializationArgSetCount` arguments.
+            @param specializationArgCount The number of arguments in each set. Must match the
+                number of specialization parameters of this component type.
+            @param specializationArgSetCount The number of sets of arguments.
+            @param entryPointIndex The index of the entry point to get code for.
+            @param targetIndex The index of the target to get code for.
+            @param outCodes Array of `specializationArgSetCount` blobs, which receives the code for each
+                set of arguments, in order. An entry is set to nullptr if code could not be produced for that set.
+            @param outDiagnostics Diagnostics for the whole batch.
+            @returns SLANG_OK if code was produced for every set of arguments.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getSpecializedEntryPointCodes(
+            SpecializationArg const*    specializationArgs,
+            SlangInt                    specializationArgCount,
+            SlangInt                    specializationArgSetCount,
+            SlangInt                    entryPointIndex,
+            SlangInt                    targetIndex,
+            IBlob**                     outCodes,
+            IBlob**                     outDiagnostics = nullptr) = 0;
     };
     #define SLANG_UUID_IComponentType IComponentType::getTypeGuid()
 
@@ -352,14 +352,14 @@ static void _sourceLocationNoteDiagnostic(DiagnosticSink* sink, SourceView* sour
     sb << caretLine << "\n";
 }
 
-// Output the length of the token at `sourceLoc`. This is used by language server.
-static void _tokenLengthNoteDiagnostic(
-    DiagnosticSink* sink, SourceView* sourceView, SourceLoc sourceLoc, StringBuilder& sb)
+// Get the length of the token at `sourceLoc`, or 0 if it can't be determined.
+static Index _calcTokenLength(DiagnosticSink* sink, SourceView* sourceView, SourceLoc sourceLoc)
 {
     SourceFile* sourceFile = sourceView->getSourceFile();
-    if (!sourceFile)
+    auto lexer = sink->getSourceLocationLexer();
+    if (!sourceFile || !lexer)
     {
-        return;
+        return 0;
     }
 
     UnownedStringSlice content = sourceFile->getContent();
@@ -371,7 +371,7 @@ static void _tokenLengthNoteDiagnostic(
     const int offset = sourceView->getRange().getOffset(sourceLoc);
     if (offset < 0 || offset >= content.getLength())
     {
-        return;
+        return 0;
     }
 
     // Work out the position of the SourceLoc in the source
@@ -382,15 +382,17 @@ static void _tokenLengthNoteDiagnostic(
     // Trim any trailing white space
     line = UnownedStringSlice(line.begin(), line.trim().end());
 
-    auto lexer = sink->getSourceLocationLexer();
-    if (lexer)
-    {
-        UnownedStringSlice token = lexer(UnownedStringSlice(pos, line.end()));
+    return lexer(UnownedStringSlice(pos, line.end())).getLength();
+}
 
-        if (token.getLength() > 1)
-        {
-            sb << "^+" << token.getLength() << "\n";
-        }
+// Output the length of the token at `sourceLoc`. This is used by language server.
+static void _tokenLengthNoteDiagnostic(
+    DiagnosticSink* sink, SourceView* sourceView, SourceLoc sourceLoc, StringBuilder& sb)
+{
+    const Index tokenLength = _calcTokenLength(sink, sourceView, sourceLoc);
+    if (tokenLength > 1)
+    {
+        sb << "^+" << tokenLength << "\n";
     }
 }
 
@@ -486,6 +488,7 @@ static void formatDiagnostic(
 void DiagnosticSink::init(SourceManager* sourceManager, SourceLocationLexer sourceLocationLexer)
 {
     m_errorCount = 0;
+    m_diagnosticCount = 0;
     m_internalErrorLocsNoted = 0;
 
     m_sourceManager = sourceManager;
@@ -504,9 +507,11 @@ void DiagnosticSink::init(SourceManager* sourceManager, SourceLocationLexer sour
 void DiagnosticSink::reset()
 {
     m_errorCount = 0;
+    m_diagnosticCount = 0;
     m_internalErrorLocsNoted = 0;
 
     outputBuffer.Clear();
+    m_recordedDiagnostics.clear();
 }
 
 
@@ -558,6 +563,7 @@ void DiagnosticSink::diagnoseImpl(DiagnosticInfo const& info, const UnownedStrin
     {
         m_errorCount++;
     }
+    m_diagnosticCount++;
 
     if (writer)
     {
@@ -580,6 +586,79 @@ void DiagnosticSink::diagnoseImpl(DiagnosticInfo const& info, const UnownedStrin
     }
 }
 
+void DiagnosticSink::_appendFormattedDiagnostics(const UnownedStringSlice& formattedText, int errorCount)
+{
+    m_errorCount += errorCount;
+    if (formattedText.getLength())
+    {
+        m_diagnosticCount++;
+    }
+
+    if (writer)
+    {
+        writer->write(formattedText.begin(), formattedText.getLength());
+    }
+    else
+    {
+        outputBuffer.append(formattedText);
+    }
+
+    if (m_parentSink)
+    {
+        m_parentSink->_appendFormattedDiagnostics(formattedText, errorCount);
+    }
+}
+
+void DiagnosticSink::appendBufferedDiagnostics(DiagnosticSink* sink)
+{
+    SLANG_ASSERT(sink->writer == nullptr);
+    if (sink->outputBuffer.getLength() || sink->getErrorCount())
+    {
+        _appendFormattedDiagnostics(sink->outputBuffer.getUnownedSlice(), sink->getErrorCount());
+    }
+    m_recordedDiagnostics.addRange(sink->m_recordedDiagnostics);
+    m_diagnosticCount += int(sink->m_recordedDiagnostics.getCount());
+}
+
+void DiagnosticSink::_recordDiagnostic(DiagnosticInfo const& info, Diagnostic const& diagnostic)
+{
+    if (info.severity >= Severity::Error)
+    {
+        m_errorCount++;
+    }
+    m_diagnosticCount++;
+
+    RecordedDiagnostic recordedDiagnostic;
+    recordedDiagnostic.severity = diagnostic.severity;
+    recordedDiagnostic.code = diagnostic.ErrorID;
+    recordedDiagnostic.range = SourceRange(diagnostic.loc);
+    recordedDiagnostic.message = diagnostic.Message;
+
+    if (m_sourceManager)
+    {
+        if (SourceView* sourceView = m_sourceManager->findSourceViewRecursively(diagnostic.loc))
+        {
+            recordedDiagnostic.range.end = diagnostic.loc + _calcTokenLength(this, sourceView, diagnostic.loc);
+        }
+    }
+
+    m_recordedDiagnostics.add(recordedDiagnostic);
+
+    if (m_parentSink)
+    {
+        // The parent receives the diagnostic as formatted by this sink
+        StringBuilder messageBuilder;
+        formatDiagnostic(this, diagnostic, messageBuilder);
+        m_parentSink->diagnoseImpl(info, messageBuilder.getUnownedSlice());
+    }
+
+    if (info.severity >= Severity::Fatal)
+    {
+        // TODO: figure out a better policy for aborting compilation
+        SLANG_ABORT_COMPILATION("");
+    }
+}
+
 Severity DiagnosticSink::getEffectiveMessageSeverity(DiagnosticInfo const& info)
 {
     Severity effectiveSeverity = info.severity;
@@ -619,6 +698,12 @@ void DiagnosticSink::diagnoseImpl(SourceLoc const& pos, DiagnosticInfo info, int
         diagnostic.loc = pos;
         diagnostic.severity = info.severity;
 
+        if (isFlagSet(Flag::RecordDiagnostics))
+        {
+            _recordDiagnostic(info, diagnostic);
+            return;
+        }
+
         // If so, pass the error string along to them
         formatDiagnostic(this, diagnostic, messageBuilder);
     }
@@ -641,6 +726,7 @@ void DiagnosticSink::diagnoseRaw(
     {
         m_errorCount++;
     }
+    m_diagnosticCount++;
 
     // Did the client supply a callback for us to use?
     if(writer)
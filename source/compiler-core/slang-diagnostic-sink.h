@@ -81,6 +81,17 @@ public:
     }
 };
 
+    /// A diagnostic recorded as data by a DiagnosticSink, see DiagnosticSink::Flag::RecordDiagnostics
+struct RecordedDiagnostic
+{
+    Severity severity = Severity::Note;
+    int code = -1;
+        /// Where the diagnostic applies. If the sink has a SourceLocationLexer, the range
+        /// covers the token at the diagnostic location, otherwise it is empty.
+    SourceRange range;
+    String message;
+};
+
 class Name;
 
 void printDiagnosticArg(StringBuilder& sb, char const* str);
@@ -152,6 +163,7 @@ public:
             HumaneLoc           = 0x4,           ///< If set will display humane locs (filename/line number) information
             TreatWarningsAsErrors = 0x8,         ///< If set will turn all Warning type messages (after overrides) into Error type messages
             LanguageServer        = 0x10,        ///< If set will format message in a way that is suitable for language server
+            RecordDiagnostics     = 0x20,        ///< If set diagnostics are recorded as data (see getRecordedDiagnostics) instead of being formatted into the output
         };
     };
 
@@ -161,6 +173,8 @@ public:
 
         /// Get the total amount of errors that have taken place on this DiagnosticSink
     SLANG_FORCE_INLINE int getErrorCount() { return m_errorCount; }
+        /// Get the total amount of diagnostics of any severity (including warnings) that have been output on this DiagnosticSink
+    SLANG_FORCE_INLINE int getDiagnosticCount() { return m_diagnosticCount; }
 
     void diagnoseDispatch(SourceLoc const& pos, DiagnosticInfo const& info)
     {
@@ -243,8 +257,17 @@ public:
     void setParentSink(DiagnosticSink* parentSink) { m_parentSink = parentSink; }
     DiagnosticSink* getParentSink() const { return m_parentSink; }
 
+        /// Output the diagnostics buffered in `sink` (which must not have a writer set) through this sink, as
+        /// if they had been diagnosed on it. Used to merge diagnostics that were produced in isolation, for
+        /// example on another thread.
+    void appendBufferedDiagnostics(DiagnosticSink* sink);
+
+        /// Get the diagnostics recorded when Flag::RecordDiagnostics is set.
+        /// Raw diagnostics (such as from downstream compilers) are not recorded, and are still output as text.
+    const List<RecordedDiagnostic>& getRecordedDiagnostics() const { return m_recordedDiagnostics; }
+
         /// Reset state.
-        /// Resets error counts. Resets the output buffer.
+        /// Resets error counts. Resets the output buffer and recorded diagnostics.
     void reset();
 
         /// Initialize state. 
@@ -269,6 +292,8 @@ public:
 protected:
     void diagnoseImpl(SourceLoc const& pos, DiagnosticInfo info, int argCount, DiagnosticArg const* const* args);
     void diagnoseImpl(DiagnosticInfo const& info, const UnownedStringSlice& formattedMessage);
+    void _appendFormattedDiagnostics(const UnownedStringSlice& formattedText, int errorCount);
+    void _recordDiagnostic(DiagnosticInfo const& info, Diagnostic const& diagnostic);
 
     Severity getEffectiveMessageSeverity(DiagnosticInfo const& info);
 
@@ -276,6 +301,7 @@ protected:
     DiagnosticSink* m_parentSink = nullptr;
 
     int m_errorCount = 0;
+    int m_diagnosticCount = 0;
     int m_internalErrorLocsNoted = 0;
 
     /// If 0, then there is no limit, otherwise max amount of chars of the source line location
@@ -291,6 +317,8 @@ protected:
     
     // Configuration that allows the user to control the severity of certain diagnostic messages
     Dictionary<int, Severity> m_severityOverrides;
+
+    List<RecordedDiagnostic> m_recordedDiagnostics;
 };
 
     /// An `ISlangWriter` that writes directly to a diagnostic sink.
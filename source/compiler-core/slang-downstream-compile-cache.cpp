@@ -0,0 +1,543 @@
+// slang-downstream-compile-cache.cpp
+#include "slang-downstream-compile-cache.h"
+
+#include "../core/slang-blob.h"
+#include "../core/slang-crypto.h"
+#include "../core/slang-file-system.h"
+#include "../core/slang-io.h"
+#include "../core/slang-stream.h"
+#include "../core/slang-string-util.h"
+
+#include "slang-artifact-associated-impl.h"
+#include "slang-artifact-desc-util.h"
+#include "slang-artifact-util.h"
+#include "slang-slice-allocator.h"
+
+namespace Slang
+{
+
+// Must be incremented whenever the key calculation or the layout of an entry changes.
+static const uint32_t kDownstreamCompileCacheVersion = 1;
+
+static bool _isCacheable(const ArtifactDesc& desc)
+{
+    // Binaries for the host (executables, shared libraries and so on) are used via the file system or loaded
+    // into the process, so there is more to them than a blob.
+    return !ArtifactDescUtil::isCpuBinary(desc);
+}
+
+// Slices are prefixed with their length, such that adjacent slices can't produce the same key.
+static void _appendSlice(DigestBuilder<SHA1>& builder, const UnownedStringSlice& slice)
+{
+    builder.append(slice.getLength());
+    builder.append(slice);
+}
+
+static void _appendBlob(DigestBuilder<SHA1>& builder, ISlangBlob* blob)
+{
+    builder.append(blob->getBufferSize());
+    builder.append(blob);
+}
+
+namespace { // anonymous
+
+/* Adds the contents of the files `#include`d by source to the key.
+
+Includes are found by scanning the source for `#include` directives, so includes that are disabled by
+the preprocessor are added too. That can only cause a spurious miss, whereas missing an include could
+produce a stale hit. Includes that can't be found (such as system headers) are added by name. */
+struct IncludeHasher
+{
+    void hashIncludes(const String& directory, const UnownedStringSlice& text)
+    {
+        List<UnownedStringSlice> lines;
+        StringUtil::calcLines(text, lines);
+
+        for (auto line : lines)
+        {
+            bool isSystem = false;
+            UnownedStringSlice name;
+            if (_parseInclude(line, name, isSystem))
+            {
+                _hashInclude(directory, name, isSystem);
+            }
+        }
+    }
+
+    IncludeHasher(ISlangFileSystemExt* fileSystem, const Slice<TerminatedCharSlice>& includePaths, DigestBuilder<SHA1>& builder):
+        m_fileSystem(fileSystem),
+        m_includePaths(includePaths),
+        m_builder(builder)
+    {
+    }
+
+protected:
+    static bool _parseInclude(UnownedStringSlice line, UnownedStringSlice& outName, bool& outIsSystem)
+    {
+        line = line.trim();
+        if (!line.startsWith(toSlice("#")))
+        {
+            return false;
+        }
+        line = UnownedStringSlice(line.begin() + 1, line.end()).trim();
+        if (!line.startsWith(toSlice("include")))
+        {
+            return false;
+        }
+        line = UnownedStringSlice(line.begin() + 7, line.end()).trim();
+        if (line.getLength() < 2)
+        {
+            return false;
+        }
+
+        const char close = (line[0] == '<') ? '>' : '"';
+        if (line[0] != '"' && line[0] != '<')
+        {
+            return false;
+        }
+
+        const Index closeIndex = UnownedStringSlice(line.begin() + 1, line.end()).indexOf(close);
+        if (closeIndex < 0)
+        {
+            return false;
+        }
+
+        outName = UnownedStringSlice(line.begin() + 1, closeIndex);
+        outIsSystem = (close == '>');
+        return true;
+    }
+
+    bool _tryHashFile(const String& path)
+    {
+        if (m_visitedPaths.Contains(path))
+        {
+            _appendSlice(m_builder, path.getUnownedSlice());
+            return true;
+        }
+
+        ComPtr<ISlangBlob> contents;
+        if (SLANG_FAILED(m_fileSystem->loadFile(path.getBuffer(), contents.writeRef())))
+        {
+            return false;
+        }
+        m_visitedPaths.Add(path);
+
+        _appendSlice(m_builder, path.getUnownedSlice());
+        _appendBlob(m_builder, contents);
+
+        hashIncludes(Path::getParentDirectory(path), StringUtil::getSlice(contents));
+        return true;
+    }
+
+    void _hashInclude(const String& directory, const UnownedStringSlice& name, bool isSystem)
+    {
+        if (Path::isAbsolute(name))
+        {
+            if (_tryHashFile(Path::simplify(name)))
+            {
+                return;
+            }
+        }
+        else
+        {
+            if (!isSystem && _tryHashFile(Path::simplify(Path::combine(directory, String(name)))))
+            {
+                return;
+            }
+            for (const auto& includePath : m_includePaths)
+            {
+                if (_tryHashFile(Path::simplify(Path::combine(String(asStringSlice(includePath)), String(name)))))
+                {
+                    return;
+                }
+            }
+        }
+
+        // Not found
+        _appendSlice(m_builder, name);
+    }
+
+    ISlangFileSystemExt* m_fileSystem;
+    Slice<TerminatedCharSlice> m_includePaths;
+    DigestBuilder<SHA1>& m_builder;
+    HashSet<String> m_visitedPaths;
+};
+
+} // anonymous
+
+/* static */SlangResult DownstreamCompileCache::calcKey(IDownstreamCompiler* compiler, const DownstreamCompileOptions& options, Key& outKey)
+{
+    if (!_isCacheable(ArtifactDescUtil::makeDescForCompileTarget(options.targetType)))
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    DigestBuilder<SHA1> builder;
+    builder.append(kDownstreamCompileCacheVersion);
+
+    // The compiler
+    {
+        const auto& desc = compiler->getDesc();
+        builder.append(desc.type);
+        builder.append(desc.version.m_major);
+        builder.append(desc.version.m_minor);
+        builder.append(desc.version.m_patch);
+
+        ComPtr<ISlangBlob> versionString;
+        if (SLANG_SUCCEEDED(compiler->getVersionString(versionString.writeRef())) && versionString)
+        {
+            _appendBlob(builder, versionString);
+        }
+    }
+
+    // The options. The file system and source manager are only used to access files, so aren't part of the key.
+    builder.append(options.optimizationLevel);
+    builder.append(options.debugInfoType);
+    builder.append(options.targetType);
+    builder.append(options.sourceLanguage);
+    builder.append(options.floatingPointMode);
+    builder.append(options.pipelineType);
+    builder.append(options.matrixLayout);
+    builder.append(options.flags);
+    builder.append(options.platform);
+    builder.append(options.stage);
+    builder.append(options.m_debugInfoFormat);
+
+    _appendSlice(builder, asStringSlice(options.modulePath));
+    _appendSlice(builder, asStringSlice(options.entryPointName));
+    _appendSlice(builder, asStringSlice(options.profileName));
+
+    builder.append(options.defines.count);
+    for (const auto& define : options.defines)
+    {
+        _appendSlice(builder, asStringSlice(define.nameWithSig));
+        _appendSlice(builder, asStringSlice(define.value));
+    }
+
+    const Slice<TerminatedCharSlice>* pathSlices[] = { &options.includePaths, &options.libraryPaths, &options.compilerSpecificArguments };
+    for (auto pathSlice : pathSlices)
+    {
+        builder.append(pathSlice->count);
+        for (const auto& path : *pathSlice)
+        {
+            _appendSlice(builder, asStringSlice(path));
+        }
+    }
+
+    builder.append(options.requiredCapabilityVersions.count);
+    for (const auto& capabilityVersion : options.requiredCapabilityVersions)
+    {
+        builder.append(capabilityVersion.kind);
+        builder.append(capabilityVersion.version.toInteger());
+    }
+
+    // Libraries are part of the output, so their contents must be available
+    builder.append(options.libraries.count);
+    for (auto library : options.libraries)
+    {
+        ComPtr<ISlangBlob> blob;
+        if (SLANG_FAILED(library->loadBlob(ArtifactKeep::No, blob.writeRef())))
+        {
+            return SLANG_E_NOT_AVAILABLE;
+        }
+        _appendBlob(builder, blob);
+    }
+
+    // The source, and anything it includes
+    ISlangFileSystemExt* fileSystem = options.fileSystemExt ? options.fileSystemExt : OSFileSystem::getExtSingleton();
+    IncludeHasher includeHasher(fileSystem, options.includePaths, builder);
+
+    builder.append(options.sourceArtifacts.count);
+    for (auto sourceArtifact : options.sourceArtifacts)
+    {
+        ComPtr<ISlangBlob> blob;
+        if (SLANG_FAILED(sourceArtifact->loadBlob(ArtifactKeep::No, blob.writeRef())))
+        {
+            return SLANG_E_NOT_AVAILABLE;
+        }
+
+        // The name is used in diagnostics, so is part of the key
+        const String name(sourceArtifact->getName());
+        _appendSlice(builder, name.getUnownedSlice());
+        _appendBlob(builder, blob);
+
+        includeHasher.hashIncludes(Path::getParentDirectory(name), StringUtil::getSlice(blob));
+    }
+
+    outKey = builder.finalize();
+    return SLANG_OK;
+}
+
+SlangResult DownstreamCompileCache::findArtifact(const Key& key, IArtifact** outArtifact)
+{
+    RefPtr<Entry> entry;
+    if (!m_entries.TryGetValue(key, entry))
+    {
+        // Try the on-disk tier, moving the entry into memory if found
+        ComPtr<ISlangBlob> entryBlob;
+        RefPtr<Entry> readEntry(new Entry);
+        if (!m_persistentCache ||
+            SLANG_FAILED(m_persistentCache->readEntry(key, entryBlob.writeRef())) ||
+            SLANG_FAILED(_readEntry(entryBlob, *readEntry)))
+        {
+            m_stats.missCount++;
+            return SLANG_E_NOT_FOUND;
+        }
+
+        entry = readEntry;
+        _addMemoryEntry(key, entry);
+    }
+    entry->lastUse = ++m_useCount;
+
+    // The diagnostics are copied, as the client may modify them
+    ComPtr<IArtifactDiagnostics> diagnostics((IArtifactDiagnostics*)entry->diagnostics->clone(IArtifactDiagnostics::getTypeGuid()));
+
+    auto artifact = ArtifactUtil::createArtifact(entry->desc);
+    artifact->addRepresentationUnknown(entry->blob);
+    artifact->addAssociated(diagnostics);
+
+    m_stats.hitCount++;
+    *outArtifact = artifact.detach();
+    return SLANG_OK;
+}
+
+SlangResult DownstreamCompileCache::storeArtifact(const Key& key, IArtifact* artifact)
+{
+    auto diagnostics = findAssociated<IArtifactDiagnostics>(artifact);
+    if (!diagnostics || SLANG_FAILED(diagnostics->getResult()))
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    // Anything else associated with the artifact (such as debug information) would be lost
+    // on a hit, so such artifacts can't be cached.
+    if (ICastableList* associated = artifact->getAssociated())
+    {
+        if (associated->getCount() != 1)
+        {
+            return SLANG_E_NOT_AVAILABLE;
+        }
+    }
+
+    RefPtr<Entry> entry(new Entry);
+    entry->desc = artifact->getDesc();
+    SLANG_RETURN_ON_FAIL(artifact->loadBlob(ArtifactKeep::Yes, entry->blob.writeRef()));
+    entry->diagnostics = ComPtr<IArtifactDiagnostics>((IArtifactDiagnostics*)diagnostics->clone(IArtifactDiagnostics::getTypeGuid()));
+
+    _addMemoryEntry(key, entry);
+    m_stats.storeCount++;
+
+    if (m_persistentCache)
+    {
+        ComPtr<ISlangBlob> entryBlob;
+        SLANG_RETURN_ON_FAIL(_writeEntry(*entry, entryBlob));
+        SLANG_RETURN_ON_FAIL(m_persistentCache->writeEntry(key, entryBlob));
+    }
+    return SLANG_OK;
+}
+
+void DownstreamCompileCache::setDirectory(const String& directory)
+{
+    if (directory == m_directory)
+    {
+        return;
+    }
+
+    m_directory = directory;
+    if (directory.getLength())
+    {
+        PersistentCache::Desc desc;
+        desc.directory = m_directory.getBuffer();
+        m_persistentCache = new PersistentCache(desc);
+    }
+    else
+    {
+        m_persistentCache.setNull();
+    }
+}
+
+void DownstreamCompileCache::_addMemoryEntry(const Key& key, Entry* entry)
+{
+    if (m_maxMemoryEntryCount <= 0)
+    {
+        return;
+    }
+
+    entry->lastUse = ++m_useCount;
+    m_entries[key] = entry;
+
+    if (m_entries.Count() > m_maxMemoryEntryCount)
+    {
+        // Evict a batch of entries, such that finding the least recently used ones isn't done
+        // on every store once the tier is full
+        _evictMemoryEntries(m_maxMemoryEntryCount - m_maxMemoryEntryCount / 4);
+    }
+}
+
+void DownstreamCompileCache::_evictMemoryEntries(Count maxCount)
+{
+    const Count evictCount = m_entries.Count() - maxCount;
+    if (evictCount <= 0)
+    {
+        return;
+    }
+
+    List<KeyValuePair<uint64_t, Key>> uses;
+    uses.reserve(m_entries.Count());
+    for (const auto& pair : m_entries)
+    {
+        uses.add(KeyValuePair<uint64_t, Key>(pair.Value->lastUse, pair.Key));
+    }
+    uses.sort([](const KeyValuePair<uint64_t, Key>& a, const KeyValuePair<uint64_t, Key>& b) { return a.Key < b.Key; });
+
+    for (Index i = 0; i < evictCount; ++i)
+    {
+        m_entries.Remove(uses[i].Value);
+    }
+    m_stats.evictCount += evictCount;
+}
+
+void DownstreamCompileCache::setMaxMemoryEntryCount(Count count)
+{
+    m_maxMemoryEntryCount = count;
+    _evictMemoryEntries(count);
+}
+
+SlangResult DownstreamCompileCache::clear()
+{
+    m_entries.Clear();
+    return m_persistentCache ? m_persistentCache->clear() : SLANG_OK;
+}
+
+/* static */SlangResult DownstreamCompileCache::_writeEntry(const Entry& entry, ComPtr<ISlangBlob>& outBlob)
+{
+    typedef DownstreamCompileCacheBinary Bin;
+
+    IArtifactDiagnostics* diagnostics = entry.diagnostics;
+
+    RiffContainer container;
+    {
+        RiffContainer::ScopeChunk scopeEntry(&container, RiffContainer::Chunk::Kind::List, Bin::kEntryFourCc);
+
+        Bin::Header header;
+        header.packedDesc = uint32_t(entry.desc.getPacked());
+        header.result = int32_t(diagnostics->getResult());
+        container.addDataChunk(Bin::kHeaderFourCc, &header, sizeof(header));
+
+        container.addDataChunk(Bin::kBlobFourCc, entry.blob->getBufferPointer(), entry.blob->getBufferSize());
+
+        const Count diagnosticCount = diagnostics->getCount();
+        for (Index i = 0; i < diagnosticCount; ++i)
+        {
+            const auto& diagnostic = *diagnostics->getAt(i);
+
+            Bin::Diagnostic dst;
+            memset(&dst, 0, sizeof(dst));
+            dst.severity = uint8_t(diagnostic.severity);
+            dst.stage = uint8_t(diagnostic.stage);
+            dst.textSize = uint32_t(diagnostic.text.count);
+            dst.codeSize = uint32_t(diagnostic.code.count);
+            dst.filePathSize = uint32_t(diagnostic.filePath.count);
+            dst.line = int64_t(diagnostic.location.line);
+            dst.column = int64_t(diagnostic.location.column);
+
+            List<uint8_t> buf;
+            buf.addRange((const uint8_t*)&dst, sizeof(dst));
+            const TerminatedCharSlice slices[] = { diagnostic.text, diagnostic.code, diagnostic.filePath };
+            for (const auto& slice : slices)
+            {
+                buf.addRange((const uint8_t*)slice.data, slice.count);
+                buf.add(0);
+            }
+            container.addDataChunk(Bin::kDiagnosticFourCc, buf.getBuffer(), buf.getCount());
+        }
+
+        const auto raw = diagnostics->getRaw();
+        container.addDataChunk(Bin::kRawDiagnosticsFourCc, raw.data, raw.count);
+    }
+
+    OwnedMemoryStream stream(FileAccess::Write);
+    SLANG_RETURN_ON_FAIL(RiffUtil::write(container.getRoot(), true, &stream));
+
+    List<uint8_t> contents;
+    contents.addRange(stream.getContents().getBuffer(), stream.getContents().getCount());
+    outBlob = ListBlob::moveCreate(contents);
+    return SLANG_OK;
+}
+
+/* static */SlangResult DownstreamCompileCache::_readEntry(ISlangBlob* entryBlob, Entry& outEntry)
+{
+    typedef DownstreamCompileCacheBinary Bin;
+
+    RiffContainer container;
+    {
+        MemoryStreamBase stream(FileAccess::Read, entryBlob->getBufferPointer(), entryBlob->getBufferSize());
+        SLANG_RETURN_ON_FAIL(RiffUtil::read(&stream, container));
+    }
+
+    RiffContainer::ListChunk* entryChunk = container.getRoot();
+    if (!entryChunk || entryChunk->getSubType() != Bin::kEntryFourCc)
+    {
+        return SLANG_FAIL;
+    }
+
+    auto header = entryChunk->findContainedData<Bin::Header>(Bin::kHeaderFourCc);
+    RiffContainer::Data* blobData = entryChunk->findContainedData(Bin::kBlobFourCc);
+    if (!header || !blobData)
+    {
+        return SLANG_FAIL;
+    }
+
+    outEntry.desc = ArtifactDesc::make(ArtifactDesc::Packed(header->packedDesc));
+    {
+        List<uint8_t> blob;
+        blob.addRange((const uint8_t*)blobData->getPayload(), Index(blobData->getSize()));
+        outEntry.blob = ListBlob::moveCreate(blob);
+    }
+
+    auto diagnostics = ArtifactDiagnostics::create();
+    diagnostics->setResult(SlangResult(header->result));
+
+    List<RiffContainer::DataChunk*> diagnosticChunks;
+    entryChunk->findContained(Bin::kDiagnosticFourCc, diagnosticChunks);
+    for (auto diagnosticChunk : diagnosticChunks)
+    {
+        RiffContainer::Data* data = diagnosticChunk->getSingleData();
+        if (!data || data->getSize() < sizeof(Bin::Diagnostic))
+        {
+            return SLANG_FAIL;
+        }
+
+        Bin::Diagnostic src;
+        memcpy(&src, data->getPayload(), sizeof(src));
+
+        const char* text = (const char*)data->getPayload() + sizeof(src);
+        const char* code = text + src.textSize + 1;
+        const char* filePath = code + src.codeSize + 1;
+        if (filePath + src.filePathSize + 1 > (const char*)data->getPayloadEnd())
+        {
+            return SLANG_FAIL;
+        }
+
+        // The slices are copied when the diagnostic is added
+        ArtifactDiagnostic diagnostic;
+        diagnostic.severity = ArtifactDiagnostic::Severity(src.severity);
+        diagnostic.stage = ArtifactDiagnostic::Stage(src.stage);
+        diagnostic.text = TerminatedCharSlice(text, Count(src.textSize));
+        diagnostic.code = TerminatedCharSlice(code, Count(src.codeSize));
+        diagnostic.filePath = TerminatedCharSlice(filePath, Count(src.filePathSize));
+        diagnostic.location.line = Int(src.line);
+        diagnostic.location.column = Int(src.column);
+        diagnostics->add(diagnostic);
+    }
+
+    if (RiffContainer::Data* rawData = entryChunk->findContainedData(Bin::kRawDiagnosticsFourCc))
+    {
+        diagnostics->setRaw(CharSlice((const char*)rawData->getPayload(), Count(rawData->getSize())));
+    }
+
+    outEntry.diagnostics = diagnostics;
+    return SLANG_OK;
+}
+
+}
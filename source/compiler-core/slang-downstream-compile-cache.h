@@ -0,0 +1,138 @@
+// slang-downstream-compile-cache.h
+#ifndef SLANG_DOWNSTREAM_COMPILE_CACHE_H
+#define SLANG_DOWNSTREAM_COMPILE_CACHE_H
+
+#include "../core/slang-basic.h"
+#include "../core/slang-persistent-cache.h"
+#include "../core/slang-riff.h"
+
+#include "slang-artifact-associated.h"
+#include "slang-downstream-compiler.h"
+
+namespace Slang
+{
+
+/* Holds RIFF FourCC codes for downstream compile cache entries */
+struct DownstreamCompileCacheBinary
+{
+        /// Cache entry LIST container. Holds the header, the output and diagnostics of the compile.
+    static const FourCC kEntryFourCc = SLANG_FOUR_CC('S', 'D', 'c', 'e');
+        /// Header data. Holds a `Header`.
+    static const FourCC kHeaderFourCc = SLANG_FOUR_CC('S', 'D', 'c', 'h');
+        /// The output blob of the compile
+    static const FourCC kBlobFourCc = SLANG_FOUR_CC('S', 'D', 'c', 'b');
+        /// A single diagnostic. Holds a `Diagnostic` followed by the text, code and file path, each zero terminated.
+    static const FourCC kDiagnosticFourCc = SLANG_FOUR_CC('S', 'D', 'c', 'd');
+        /// The raw diagnostics text
+    static const FourCC kRawDiagnosticsFourCc = SLANG_FOUR_CC('S', 'D', 'c', 'r');
+
+    struct Header
+    {
+        uint32_t packedDesc;            ///< The packed `ArtifactDesc` of the output
+        int32_t result;                 ///< The result held in the diagnostics
+    };
+
+    struct Diagnostic
+    {
+        uint8_t severity;
+        uint8_t stage;
+        uint8_t pad[2];
+        uint32_t textSize;              ///< Sizes of the strings that follow, in bytes, excluding the terminating zero
+        uint32_t codeSize;
+        uint32_t filePathSize;
+        int64_t line;
+        int64_t column;
+    };
+};
+
+/* A cache of the artifacts produced by `IDownstreamCompiler::compile`.
+
+Entries are keyed on
+
+* The compiler type, version and version string
+* All of the `DownstreamCompileOptions` that can influence the output, including defines and include paths
+* The contents of the source artifacts
+* The contents of files the source `#include`s (found by scanning the source, and then the included files)
+
+An entry holds the output blob of the compile and the diagnostics it produced. Entries are held in
+memory, and can additionally be written to an on-disk `PersistentCache` such that they are available
+to later processes. The in memory tier holds a limited number of entries, evicting the least recently
+used ones once it is full.
+
+Only compiles that produce an output blob (such as DXIL, SPIR-V or PTX) can be cached. Compiles that
+produce host binaries (executables, shared libraries and so on) are used through the file system or
+loaded into the process, so are not cached. */
+class DownstreamCompileCache : public RefObject
+{
+public:
+    typedef PersistentCache::Key Key;
+
+    struct Stats
+    {
+        Count hitCount = 0;             ///< Artifacts found in the cache
+        Count missCount = 0;            ///< Artifacts not found in the cache
+        Count storeCount = 0;           ///< Artifacts added to the cache
+        Count evictCount = 0;           ///< Entries evicted from the in memory tier
+    };
+
+        /// The default maximum number of entries held in memory
+    static const Count kDefaultMaxMemoryEntryCount = 256;
+
+        /// Calculate the key for compiling with `options` using `compiler`.
+        /// Returns SLANG_E_NOT_AVAILABLE if the compile can't be cached.
+    static SlangResult calcKey(IDownstreamCompiler* compiler, const DownstreamCompileOptions& options, Key& outKey);
+
+        /// Find the artifact with `key`. The artifact has a copy of the diagnostics produced by the compile associated.
+        /// Returns SLANG_E_NOT_FOUND if there is no entry.
+    SlangResult findArtifact(const Key& key, IArtifact** outArtifact);
+
+        /// Add `artifact` produced by a compile to the cache.
+        /// Returns SLANG_E_NOT_AVAILABLE if the artifact can't be cached, for example because the compile failed.
+    SlangResult storeArtifact(const Key& key, IArtifact* artifact);
+
+        /// Set the directory entries are additionally stored in. An empty path disables the on-disk tier.
+    void setDirectory(const String& directory);
+        /// Get the directory entries are stored in, or empty if there is no on-disk tier
+    const String& getDirectory() const { return m_directory; }
+
+        /// Set the maximum number of entries held in memory. 0 disables the in memory tier.
+    void setMaxMemoryEntryCount(Count count);
+    Count getMaxMemoryEntryCount() const { return m_maxMemoryEntryCount; }
+
+        /// Remove all entries from the cache
+    SlangResult clear();
+
+    const Stats& getStats() const { return m_stats; }
+
+protected:
+    struct Entry : RefObject
+    {
+        ArtifactDesc desc;
+        ComPtr<ISlangBlob> blob;
+        ComPtr<IArtifactDiagnostics> diagnostics;
+        uint64_t lastUse = 0;           ///< The value of m_useCount when the entry was last used
+    };
+
+        /// Add `entry` to the in memory tier, evicting entries if it is full
+    void _addMemoryEntry(const Key& key, Entry* entry);
+        /// Evict the least recently used entries, until at most `maxCount` are left
+    void _evictMemoryEntries(Count maxCount);
+
+    static SlangResult _writeEntry(const Entry& entry, ComPtr<ISlangBlob>& outBlob);
+    static SlangResult _readEntry(ISlangBlob* entryBlob, Entry& outEntry);
+
+    String m_directory;
+    RefPtr<PersistentCache> m_persistentCache;
+
+        /// The in memory tier
+    Dictionary<Key, RefPtr<Entry>> m_entries;
+    Count m_maxMemoryEntryCount = kDefaultMaxMemoryEntryCount;
+        /// Incremented on every use of an entry, to order the entries by when they were last used
+    uint64_t m_useCount = 0;
+
+    Stats m_stats;
+};
+
+}
+
+#endif
@@ -74,10 +74,15 @@ SlangResult CommandLineDownstreamCompiler::compile(const CompileOptions& inOptio
         return SLANG_E_NOT_IMPLEMENTED;
     }
 
-    CompileOptions options = getCompatibleVersion(&inOptions);
+    return _compile(m_cmdLine, getCompatibleVersion(&inOptions), outArtifact);
+}
+
+SlangResult CommandLineDownstreamCompiler::_compile(const CommandLine& baseCmdLine, const CompileOptions& inOptions, IArtifact** outArtifact)
+{
+    CompileOptions options(inOptions);
 
     // Copy the command line options
-    CommandLine cmdLine(m_cmdLine);
+    CommandLine cmdLine(baseCmdLine);
 
     // Work out the ArtifactDesc 
     const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
@@ -255,6 +255,10 @@ struct DownstreamCompileOptions
 
     // The debug info format to use. 
     SlangDebugInfoFormat m_debugInfoFormat = SLANG_DEBUG_INFO_FORMAT_DEFAULT;
+
+    /// Text that each of the source artifacts starts with, typically the language prelude. Compilers that support
+    /// precompiled headers can compile it once, and reuse the result across compiles. Can be empty.
+    TerminatedCharSlice sourcePrelude;
 };
 
 #define SLANG_ALIAS_DEPRECIATED_VERSION(name, id, firstField, lastField) \
@@ -370,6 +374,11 @@ public:
     CommandLineDownstreamCompiler(const Desc& desc):Super(desc) {}
 
     CommandLine m_cmdLine;
+
+protected:
+        /// Compile, where `cmdLine` holds the executable and any args that precede those calculated from `options`.
+        /// `options` must be a compatible version.
+    SlangResult _compile(const CommandLine& cmdLine, const CompileOptions& options, IArtifact** outArtifact);
 };
 
 /* Only purpose of having base-class here is to make all the DownstreamCompiler types available directly in derived Utils */
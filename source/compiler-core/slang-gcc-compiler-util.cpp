@@ -10,10 +10,14 @@
 #include "../core/slang-char-util.h"
 #include "../core/slang-string-slice-pool.h"
 
+#include "../core/slang-blob.h"
+
 #include "slang-artifact-desc-util.h"
 #include "slang-artifact-diagnostic-util.h"
+#include "slang-artifact-helper.h"
 #include "slang-artifact-util.h"
 #include "slang-artifact-representation-impl.h"
+#include "slang-slice-allocator.h"
 
 namespace Slang
 {
@@ -454,13 +458,9 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
     return SLANG_OK;
 }
 
-/* static */SlangResult GCCDownstreamCompilerUtil::calcArgs(const CompileOptions& options, CommandLine& cmdLine)
+/* static */SlangResult GCCDownstreamCompilerUtil::calcCompileArgs(const CompileOptions& options, CommandLine& cmdLine)
 {
-    SLANG_ASSERT(options.modulePath.count);
-
     PlatformKind platformKind = (options.platform == PlatformKind::Unknown) ? PlatformUtil::getPlatformKind() : options.platform;
-        
-    const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
 
     if (options.sourceLanguage == SLANG_SOURCE_LANGUAGE_CPP)
     {
@@ -515,11 +515,6 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
         cmdLine.addArg("-g");
     }
 
-    if (options.flags & CompileOptions::Flag::Verbose)
-    {
-        cmdLine.addArg("-v");
-    }
-
     switch (options.floatingPointMode)
     {
         case FloatingPointMode::Default: break;
@@ -537,6 +532,52 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
         }
     }
 
+    if (options.targetType == SLANG_SHADER_SHARED_LIBRARY && PlatformUtil::isFamily(PlatformFamily::Unix, platformKind))
+    {
+        // Position independent
+        cmdLine.addArg("-fPIC");
+    }
+
+    // Add defines
+    for (const auto& define : options.defines)
+    {
+        StringBuilder builder;
+
+        builder << "-D";
+        builder << define.nameWithSig;
+        if (define.value.count)
+        {
+            builder << "=" << asStringSlice(define.value);
+        }
+
+        cmdLine.addArg(builder);
+    }
+
+    // Add includes
+    for (const auto& include : options.includePaths)
+    {
+        cmdLine.addArg("-I");
+        cmdLine.addArg(asString(include));
+    }
+
+    return SLANG_OK;
+}
+
+/* static */SlangResult GCCDownstreamCompilerUtil::calcArgs(const CompileOptions& options, CommandLine& cmdLine)
+{
+    SLANG_ASSERT(options.modulePath.count);
+
+    PlatformKind platformKind = (options.platform == PlatformKind::Unknown) ? PlatformUtil::getPlatformKind() : options.platform;
+        
+    const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
+
+    SLANG_RETURN_ON_FAIL(calcCompileArgs(options, cmdLine));
+
+    if (options.flags & CompileOptions::Flag::Verbose)
+    {
+        cmdLine.addArg("-v");
+    }
+
     StringBuilder moduleFilePath; 
     SLANG_RETURN_ON_FAIL(ArtifactDescUtil::calcPathForDesc(targetDesc, asStringSlice(options.modulePath), moduleFilePath));
     
@@ -549,12 +590,6 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
         {
             // Shared library
             cmdLine.addArg("-shared");
-
-            if (PlatformUtil::isFamily(PlatformFamily::Unix, platformKind))
-            {
-                // Position independent
-                cmdLine.addArg("-fPIC");
-            }
             break;
         }
         case SLANG_HOST_EXECUTABLE:
@@ -571,28 +606,6 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
         default: break;
     }
 
-    // Add defines
-    for (const auto& define : options.defines)
-    {
-        StringBuilder builder;
-
-        builder << "-D";
-        builder << define.nameWithSig;
-        if (define.value.count)
-        {
-            builder << "=" << asStringSlice(define.value);
-        }
-
-        cmdLine.addArg(builder);
-    }
-
-    // Add includes
-    for (const auto& include : options.includePaths)
-    {
-        cmdLine.addArg("-I");
-        cmdLine.addArg(asString(include));
-    }
-
     // Link options
     if (0) // && options.targetType != TargetType::Object)
     {
@@ -676,6 +689,25 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
     return SLANG_OK;
 }
 
+/* static */String GCCDownstreamCompilerUtil::getPrecompiledHeaderPath(SlangPassThrough compilerType, const String& headerPath)
+{
+    // Both compilers look for the precompiled header next to the header when it's `-include`d
+    return headerPath + ((compilerType == SLANG_PASS_THROUGH_CLANG) ? ".pch" : ".gch");
+}
+
+/* static */SlangResult GCCDownstreamCompilerUtil::calcPrecompileHeaderArgs(SlangPassThrough compilerType, const CompileOptions& options, const String& headerPath, CommandLine& cmdLine)
+{
+    SLANG_RETURN_ON_FAIL(calcCompileArgs(options, cmdLine));
+
+    cmdLine.addArg("-x");
+    cmdLine.addArg((options.sourceLanguage == SLANG_SOURCE_LANGUAGE_CPP) ? "c++-header" : "c-header");
+    cmdLine.addArg(headerPath);
+
+    cmdLine.addArg("-o");
+    cmdLine.addArg(getPrecompiledHeaderPath(compilerType, headerPath));
+    return SLANG_OK;
+}
+
 /* static */SlangResult GCCDownstreamCompilerUtil::createCompiler(const ExecutableLocation& exe, ComPtr<IDownstreamCompiler>& outCompiler)
 {
     DownstreamCompilerDesc desc;
@@ -729,4 +761,141 @@ static SlangResult _parseGCCFamilyLine(SliceAllocator& allocator, const UnownedS
     return SLANG_OK;
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! GCCDownstreamCompiler !!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
+
+    /// Replace each of the sourceArtifacts with an artifact holding the source that follows `prelude`.
+    /// Fails if any of the sources doesn't start with the prelude.
+static SlangResult _removePrelude(const UnownedStringSlice& prelude, const Slice<IArtifact*>& sourceArtifacts, List<ComPtr<IArtifact>>& outArtifacts)
+{
+    // The remaining source starts on the line after the prelude, so diagnostics report the same lines
+    Count preludeLineCount = 0;
+    for (const char c : prelude)
+    {
+        preludeLineCount += Count(c == '\n');
+    }
+
+    for (IArtifact* sourceArtifact : sourceArtifacts)
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(sourceArtifact->loadBlob(ArtifactKeep::Yes, blob.writeRef()));
+
+        const UnownedStringSlice text = StringUtil::getSlice(blob);
+        if (!text.startsWith(prelude))
+        {
+            return SLANG_FAIL;
+        }
+
+        StringBuilder buf;
+        buf << "#line " << (preludeLineCount + 1) << "\n";
+        buf << text.tail(prelude.getLength());
+
+        auto artifact = ArtifactUtil::createArtifact(sourceArtifact->getDesc(), sourceArtifact->getName());
+        artifact->addRepresentationUnknown(StringBlob::moveCreate(buf));
+        outArtifacts.add(artifact);
+    }
+    return SLANG_OK;
+}
+
+SlangResult GCCDownstreamCompiler::compile(const CompileOptions& inOptions, IArtifact** outArtifact)
+{
+    if (!isVersionCompatible(inOptions))
+    {
+        // Not possible to compile with this version of the interface.
+        return SLANG_E_NOT_IMPLEMENTED;
+    }
+
+    CompileOptions options = getCompatibleVersion(&inOptions);
+    CommandLine cmdLine(m_cmdLine);
+
+    // If the sources start with a prelude, the prelude can be precompiled once, and `-include`d in place of the
+    // prelude text. That saves parsing the prelude for every compile, which for small kernels is most of the work.
+    // If several sources are compiled (and linked) in one invocation, they all share the precompiled prelude.
+    List<ComPtr<IArtifact>> sourceArtifacts;
+    String preludeHeaderPath;
+
+    const UnownedStringSlice prelude = asStringSlice(options.sourcePrelude);
+    if (prelude.endsWith(toSlice("\n")) &&
+        options.sourceArtifacts.count &&
+        SLANG_SUCCEEDED(_removePrelude(prelude, options.sourceArtifacts, sourceArtifacts)) &&
+        SLANG_SUCCEEDED(_findOrCreatePrecompiledPrelude(options, preludeHeaderPath)))
+    {
+        cmdLine.addArg("-include");
+        cmdLine.addArg(preludeHeaderPath);
+
+        options.sourceArtifacts = SliceUtil::asSlice(sourceArtifacts);
+    }
+
+    return _compile(cmdLine, options, outArtifact);
+}
+
+Count GCCDownstreamCompiler::getPrecompiledPreludeCount()
+{
+    std::lock_guard<std::mutex> guard(m_precompiledPreludesMutex);
+
+    Count count = 0;
+    for (const auto& pair : m_precompiledPreludes)
+    {
+        count += Count(SLANG_SUCCEEDED(pair.Value->result));
+    }
+    return count;
+}
+
+SlangResult GCCDownstreamCompiler::_findOrCreatePrecompiledPrelude(const CompileOptions& options, String& outHeaderPath)
+{
+    // A precompiled header can only be used by compiles with the same compile args
+    CommandLine compileArgs;
+    SLANG_RETURN_ON_FAIL(Util::calcCompileArgs(options, compileArgs));
+
+    DigestBuilder<SHA1> builder;
+    builder.append(asStringSlice(options.sourcePrelude));
+    for (const auto& arg : compileArgs.m_args)
+    {
+        builder.append(arg.getLength());
+        builder.append(arg);
+    }
+    const SHA1::Digest key = builder.finalize();
+
+    std::lock_guard<std::mutex> guard(m_precompiledPreludesMutex);
+
+    RefPtr<PrecompiledPrelude> precompiledPrelude;
+    if (!m_precompiledPreludes.TryGetValue(key, precompiledPrelude))
+    {
+        // Failures are recorded too, so precompiling isn't attempted on every compile
+        precompiledPrelude = new PrecompiledPrelude;
+        precompiledPrelude->result = _createPrecompiledPrelude(options, *precompiledPrelude);
+        m_precompiledPreludes.Add(key, precompiledPrelude);
+    }
+
+    SLANG_RETURN_ON_FAIL(precompiledPrelude->result);
+    outHeaderPath = precompiledPrelude->headerPath;
+    return SLANG_OK;
+}
+
+SlangResult GCCDownstreamCompiler::_createPrecompiledPrelude(const CompileOptions& options, PrecompiledPrelude& outPrelude)
+{
+    auto helper = DefaultArtifactHelper::getSingleton();
+    SLANG_RETURN_ON_FAIL(helper->createLockFile(asCharSlice(toSlice("slang-prelude")), outPrelude.lockFile.writeRef()));
+
+    outPrelude.headerPath = String(outPrelude.lockFile->getPath()) + ".h";
+    const String pchPath = Util::getPrecompiledHeaderPath(getDesc().type, outPrelude.headerPath);
+
+    // The files are owned, so are removed when the prelude is destroyed
+    SLANG_RETURN_ON_FAIL(File::writeAllText(outPrelude.headerPath, asString(options.sourcePrelude)));
+    outPrelude.files.add(OSFileArtifactRepresentation::create(IOSFileArtifactRepresentation::Kind::Owned, outPrelude.headerPath.getUnownedSlice(), outPrelude.lockFile));
+
+    CommandLine cmdLine(m_cmdLine);
+    SLANG_RETURN_ON_FAIL(Util::calcPrecompileHeaderArgs(getDesc().type, options, outPrelude.headerPath, cmdLine));
+
+    ExecuteResult exeRes;
+    SLANG_RETURN_ON_FAIL(ProcessUtil::execute(cmdLine, exeRes));
+
+    if (!File::exists(pchPath))
+    {
+        return SLANG_FAIL;
+    }
+    outPrelude.files.add(OSFileArtifactRepresentation::create(IOSFileArtifactRepresentation::Kind::Owned, pchPath.getUnownedSlice(), outPrelude.lockFile));
+
+    return (exeRes.resultCode == 0) ? SLANG_OK : SLANG_FAIL;
+}
+
 }
@@ -3,6 +3,10 @@
 
 #include "slang-downstream-compiler-util.h"
 
+#include "../core/slang-crypto.h"
+
+#include <mutex>
+
 namespace Slang
 {
 
@@ -18,6 +22,17 @@ struct GCCDownstreamCompilerUtil : public DownstreamCompilerUtilBase
         /// Calculate gcc family compilers (including clang) cmdLine arguments from options
     static SlangResult calcArgs(const CompileOptions& options, CommandLine& cmdLine);
 
+        /// Calculate the arguments that control how a translation unit is compiled (as opposed to linked).
+        /// A precompiled header can only be used by compiles that have the same compile arguments.
+    static SlangResult calcCompileArgs(const CompileOptions& options, CommandLine& cmdLine);
+
+        /// Calculate arguments to precompile the header at `headerPath`, such that it can be used by compiles with `options`
+        /// that `-include` the header. The output is written to `getPrecompiledHeaderPath`.
+    static SlangResult calcPrecompileHeaderArgs(SlangPassThrough compilerType, const CompileOptions& options, const String& headerPath, CommandLine& cmdLine);
+
+        /// Get the path the compiler looks for the precompiled version of the header at `headerPath`
+    static String getPrecompiledHeaderPath(SlangPassThrough compilerType, const String& headerPath);
+
         /// Parse ExecuteResult into diagnostics 
     static SlangResult parseOutput(const ExecuteResult& exeRes, IArtifactDiagnostics* diagnostics);
 
@@ -46,7 +61,34 @@ public:
     virtual SlangResult parseOutput(const ExecuteResult& exeResult, IArtifactDiagnostics* diagnostics) SLANG_OVERRIDE { return Util::parseOutput(exeResult, diagnostics); }
     virtual SlangResult calcCompileProducts(const CompileOptions& options, DownstreamProductFlags flags, IOSFileArtifactRepresentation* lockFile, List<ComPtr<IArtifact>>& outArtifacts) SLANG_OVERRIDE { return Util::calcCompileProducts(options, flags, lockFile, outArtifacts); }
 
+    // IDownstreamCompiler
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL compile(const CompileOptions& options, IArtifact** outArtifact) SLANG_OVERRIDE;
+
+        /// Get the number of source preludes that have been precompiled successfully
+    Count getPrecompiledPreludeCount();
+
     GCCDownstreamCompiler(const Desc& desc):Super(desc) {}
+
+protected:
+    /* A header holding a source prelude, and the precompiled version of it. The files are removed when the
+    compiler is destroyed. */
+    struct PrecompiledPrelude : RefObject
+    {
+        SlangResult result = SLANG_FAIL;                        ///< Failure if the prelude couldn't be precompiled
+        String headerPath;
+        ComPtr<IOSFileArtifactRepresentation> lockFile;
+        List<ComPtr<IOSFileArtifactRepresentation>> files;     ///< The header and precompiled header
+    };
+
+        /// Get the path to a header holding `options.sourcePrelude`, precompiling it if necessary
+    SlangResult _findOrCreatePrecompiledPrelude(const CompileOptions& options, String& outHeaderPath);
+        /// Write the prelude to a header and precompile it
+    SlangResult _createPrecompiledPrelude(const CompileOptions& options, PrecompiledPrelude& outPrelude);
+
+        /// Protects m_precompiledPreludes, as compiles can take place on multiple threads
+    std::mutex m_precompiledPreludesMutex;
+        /// Keyed on the prelude text and the compile args
+    Dictionary<SHA1::Digest, RefPtr<PrecompiledPrelude>> m_precompiledPreludes;
 };
 
 }
@@ -309,6 +309,7 @@ struct WorkspaceFolder
 struct InitializeParams
 {
     List<WorkspaceFolder> workspaceFolders;
+    String trace; // optional, one of "off", "messages" or "verbose"
     static const UnownedStringSlice methodName;
     static const StructRttiInfo g_rttiInfo;
 };
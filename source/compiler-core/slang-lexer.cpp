@@ -261,10 +261,96 @@ namespace Slang
         _handleNewLineInner(lexer, c);
     }
 
+    // Most of the input is made up of runs of characters that can be consumed without any of the
+    // special handling in `_peek`/`_advance`, such as the characters of an identifier, or the
+    // body of a comment. Such runs are consumed in bulk by looking up the class of each byte in a
+    // table, stopping at the first byte not in the class.
+    //
+    // No class contains `\\`, so runs always stop before a possible escaped newline, which is
+    // then dealt with by the per character path.
+
+    typedef uint8_t CharClassFlags;
+    struct CharClassFlag
+    {
+        enum Enum : CharClassFlags
+        {
+            HorizontalSpace     = 1 << 0,   ///< ` ` and `\t`
+            Identifier          = 1 << 1,   ///< Characters that can continue an identifier
+            Digit               = 1 << 2,   ///< Decimal digits
+            HexDigit            = 1 << 3,   ///< Hexadecimal digits
+            LineComment         = 1 << 4,   ///< Characters that don't end a line comment
+            BlockComment        = 1 << 5,   ///< Characters that don't end a block comment
+            StringLiteral       = 1 << 6,   ///< Characters that don't end a string or character literal, or start an escape
+        };
+    };
+
+    struct CharClassTable
+    {
+        CharClassTable()
+        {
+            for (int i = 0; i < 256; ++i)
+            {
+                const char c = char(i);
+                CharClassFlags flags = 0;
+
+                if (c == ' ' || c == '\t')
+                    flags |= CharClassFlag::HorizontalSpace;
+
+                const bool isDigit = (c >= '0' && c <= '9');
+                if (isDigit)
+                    flags |= CharClassFlag::Digit;
+                if (isDigit || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'))
+                    flags |= CharClassFlag::HexDigit;
+                if (isDigit || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_')
+                    flags |= CharClassFlag::Identifier;
+
+                if (c != '\n' && c != '\r' && c != '\\')
+                {
+                    flags |= CharClassFlag::LineComment;
+                    if (c != '*')
+                        flags |= CharClassFlag::BlockComment;
+                    if (c != '\"' && c != '\'')
+                        flags |= CharClassFlag::StringLiteral;
+                }
+
+                m_flags[i] = flags;
+            }
+        }
+
+        CharClassFlags m_flags[256];
+    };
+
+    static const CharClassTable g_charClassTable;
+
+        /// Consume the run of characters from the cursor that are all in one of the classes of `flags`
+    SLANG_FORCE_INLINE static void _advanceRun(Lexer* lexer, CharClassFlags flags)
+    {
+        const char* cursor = lexer->m_cursor;
+        const char* const end = lexer->m_end;
+
+        // Check 4 characters per iteration whilst there is enough input
+        while (end - cursor >= 4 &&
+            (g_charClassTable.m_flags[uint8_t(cursor[0])] &
+             g_charClassTable.m_flags[uint8_t(cursor[1])] &
+             g_charClassTable.m_flags[uint8_t(cursor[2])] &
+             g_charClassTable.m_flags[uint8_t(cursor[3])] & flags))
+        {
+            cursor += 4;
+        }
+        while (cursor != end && (g_charClassTable.m_flags[uint8_t(*cursor)] & flags))
+        {
+            cursor++;
+        }
+
+        lexer->m_cursor = cursor;
+    }
+
     static void _lexLineComment(Lexer* lexer)
     {
         for(;;)
         {
+            _advanceRun(lexer, CharClassFlag::LineComment);
+
             switch(_peek(lexer))
             {
             case '\n': case '\r': case kEOF:
@@ -281,6 +367,8 @@ namespace Slang
     {
         for(;;)
         {
+            _advanceRun(lexer, CharClassFlag::BlockComment);
+
             switch(_peek(lexer))
             {
             case kEOF:
@@ -314,6 +402,8 @@ namespace Slang
     {
         for(;;)
         {
+            _advanceRun(lexer, CharClassFlag::HorizontalSpace);
+
             switch(_peek(lexer))
             {
             case ' ': case '\t':
@@ -330,6 +420,8 @@ namespace Slang
     {
         for(;;)
         {
+            _advanceRun(lexer, CharClassFlag::Identifier);
+
             int c = _peek(lexer);
             if(('a' <= c ) && (c <= 'z')
                 || ('A' <= c) && (c <= 'Z')
@@ -351,8 +443,17 @@ namespace Slang
 
     static void _lexDigits(Lexer* lexer, int base)
     {
+        // Only bases 10 and 16 have a class, as all of its characters are valid digits. Invalid
+        // digits in other bases are diagnosed below.
+        const CharClassFlags digitFlags =
+            base == 10 ? CharClassFlags(CharClassFlag::Digit) :
+            base == 16 ? CharClassFlags(CharClassFlag::HexDigit) :
+            CharClassFlags(0);
+
         for(;;)
         {
+            _advanceRun(lexer, digitFlags);
+
             int c = _peek(lexer);
 
             int digitVal = 0;
@@ -399,6 +500,8 @@ namespace Slang
         //
         for( ;;)
         {
+            _advanceRun(lexer, CharClassFlag::Identifier);
+
             int c = _peek(lexer);
 
             // Accept any alphanumeric character, plus underscores.
@@ -691,6 +794,8 @@ namespace Slang
     {
         for(;;)
         {
+            _advanceRun(lexer, CharClassFlag::StringLiteral);
+
             int c = _peek(lexer);
             if(c == quote)
             {
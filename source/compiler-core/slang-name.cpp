@@ -11,7 +11,7 @@ String getText(Name* name)
 
 UnownedStringSlice getUnownedStringSliceText(Name* name)
 {
-    return name ? name->text.getUnownedSlice() : UnownedStringSlice();
+    return name ? name->text : UnownedStringSlice();
 }
 
 const char* getCstr(Name* name)
@@ -19,24 +19,49 @@ const char* getCstr(Name* name)
     return name ? name->text.getBuffer() : nullptr;
 }
 
-Name* NamePool::getName(String const& text)
+RootNamePool::RootNamePool()
+    : arena(8192)
 {
-    RefPtr<Name> name;
-    if (rootPool->names.TryGetValue(text, name))
-        return name;
+}
+
+Name* RootNamePool::findName(const UnownedStringSlice& text) const
+{
+    Name* const* name = names.TryGetValue(text);
+    return name ? *name : nullptr;
+}
+
+Name* RootNamePool::addName(const UnownedStringSlice& text)
+{
+    SLANG_ASSERT(findName(text) == nullptr);
 
-    name = new Name();
-    name->text = text;
-    rootPool->names.Add(text, name);
+    const char* chars = arena.allocateString(text.begin(), size_t(text.getLength()));
+    Name* name = new (arena.allocate<Name>()) Name(UnownedTerminatedStringSlice(chars, size_t(text.getLength())));
+
+    names.Add(name->text, name);
     return name;
 }
 
-Name* NamePool::tryGetName(String const& text)
+Name* NamePool::getName(const UnownedStringSlice& text)
 {
-    RefPtr<Name> name;
-    if (rootPool->names.TryGetValue(text, name))
+    {
+        std::shared_lock<std::shared_mutex> lock(rootPool->mutex);
+        if (Name* name = rootPool->findName(text))
+            return name;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(rootPool->mutex);
+
+    // Another thread may have added the name since the lookup
+    if (Name* name = rootPool->findName(text))
         return name;
-    return nullptr;
+
+    return rootPool->addName(text);
+}
+
+Name* NamePool::tryGetName(const UnownedStringSlice& text)
+{
+    std::shared_lock<std::shared_mutex> lock(rootPool->mutex);
+    return rootPool->findName(text);
 }
 
 } // namespace Slang
@@ -6,6 +6,11 @@
 // the name of types, variables, etc. in the AST.
 
 #include "../core/slang-basic.h"
+#include "../core/slang-flat-dictionary.h"
+#include "../core/slang-memory-arena.h"
+
+#include <mutex>
+#include <shared_mutex>
 
 namespace Slang {
 
@@ -21,15 +26,23 @@ namespace Slang {
 // cleaned up when the pool is deleted), and which is responsible for
 // ensuring the uniqueness of name objects.
 //
-class Name : public RefObject
+// A `Name` and its text are allocated from the arena of the `RootNamePool`
+// that created it, and are never freed individually.
+//
+class Name
 {
 public:
-    // The raw text of the name.
+    Name(const UnownedTerminatedStringSlice& inText)
+        : text(inText)
+    {}
+
+    // The raw text of the name. It is held in the arena of the owning
+    // `RootNamePool`, and is zero terminated.
     //
     // Note that at some point in the future we might have other categories
     // of name than "simple" names, and so this might change to a structured
     // ADT instead of a simple string.
-    String text;
+    UnownedTerminatedStringSlice text;
 };
 
 // Get the textual string representation of a name
@@ -47,10 +60,26 @@ const char* getCstr(Name* name);
 // get equivalent names for a string like `"Foo"`, then they need to use
 // the same root name pool (directly or indirectly).
 //
+// The root name pool of a session is shared by all of the linkages created from it, which
+// can be used from different threads, so access to it is synchronized.
+//
 struct RootNamePool
 {
-    // The mapping from text strings to the corresponding name.
-    Dictionary<String, RefPtr<Name> > names;
+    RootNamePool();
+
+        /// Find the name with `text`. Returns nullptr if not found. `mutex` must be held.
+    Name* findName(const UnownedStringSlice& text) const;
+        /// Add a name for `text`, which must not already be in the pool. `mutex` must be held exclusively.
+    Name* addName(const UnownedStringSlice& text);
+
+    // Maps the text of each name to the name. The keys are the text of the names, so are held in `arena`.
+    FlatDictionary<UnownedStringSlice, Name*> names;
+
+    // Holds all of the names and their text.
+    MemoryArena arena;
+
+    // Guards `names` and `arena`. Most lookups find an existing name, so they only take a shared lock.
+    std::shared_mutex mutex;
 };
 
 // A `NamePool` is effectively a way of storing a subset of the
@@ -68,10 +97,14 @@ struct RootNamePool
 struct NamePool
 {
     // Find or create the `Name` that represents the given `text`.
-    Name* getName(String const& text);
+    // Finding an existing name does not allocate.
+    Name* getName(const UnownedStringSlice& text);
+    Name* getName(const String& text) { return getName(text.getUnownedSlice()); }
+    Name* getName(const char* text) { return getName(UnownedStringSlice(text)); }
     // Try find the `Name` that represents the given `text`.
     // If the name does not exist, return nullptr
-    Name* tryGetName(String const& text);
+    Name* tryGetName(const UnownedStringSlice& text);
+    Name* tryGetName(const String& text) { return tryGetName(text.getUnownedSlice()); }
     // Set the parent name pool to use for lookup
     void setRootNamePool(RootNamePool* rootNamePool)
     {
@@ -729,7 +729,7 @@ SourceFile* SourceManager::findSourceFileByContent(const char* text) const
 
 void SourceManager::addSourceFile(const String& uniqueIdentity, SourceFile* sourceFile)
 {
-    SLANG_ASSERT(!findSourceFileRecursively(uniqueIdentity));
+    SLANG_ASSERT(!findSourceFile(uniqueIdentity));
     m_sourceFileMap.Add(uniqueIdentity, sourceFile);
 }
 
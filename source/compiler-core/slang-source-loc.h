@@ -451,7 +451,8 @@ struct SourceManager
         /// Get the file system associated with this source manager
     void setFileSystemExt(ISlangFileSystemExt* fileSystemExt) { m_fileSystemExt = fileSystemExt;  }
 
-        /// Add a source file, uniqueIdentity must be unique for this manager AND any parents
+        /// Add a source file, uniqueIdentity must be unique for this manager.
+        /// If a parent has a file with the same uniqueIdentity, it is shadowed by the added file.
     void addSourceFile(const String& uniqueIdentity, SourceFile* sourceFile);
 
         /// Get the slice pool
@@ -463,6 +464,9 @@ struct SourceManager
     
         /// Get the parent manager to this manager. Returns nullptr if there isn't any.
     SourceManager* getParent() const { return m_parent; }
+        /// Set the parent manager. The locations of this manager must follow those of the parent.
+        /// Used to drop a manager from a chain, when no locations owned by it are referenced any more.
+    void setParent(SourceManager* parent) { m_parent = parent; }
 
         /// A memory arena to hold allocations that are in scope for the same time as SourceManager
     MemoryArena* getMemoryArena() { return &m_memoryArena;  }
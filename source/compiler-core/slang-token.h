@@ -101,7 +101,7 @@ public:
 // ---------------------------------------------------------------------------
 SLANG_FORCE_INLINE UnownedStringSlice Token::getContent() const
 {
-    return (flags & TokenFlag::Name) ? charsNameUnion.name->text.getUnownedSlice() : UnownedStringSlice(charsNameUnion.chars, charsCount);
+    return (flags & TokenFlag::Name) ? UnownedStringSlice(charsNameUnion.name->text) : UnownedStringSlice(charsNameUnion.chars, charsCount);
 }
 
 // ---------------------------------------------------------------------------
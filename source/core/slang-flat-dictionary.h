@@ -0,0 +1,603 @@
+#ifndef SLANG_CORE_FLAT_DICTIONARY_H
+#define SLANG_CORE_FLAT_DICTIONARY_H
+
+#include "slang-dictionary.h"
+
+#include <new>
+#include <string.h>
+
+#if SLANG_PROCESSOR_X86 || SLANG_PROCESSOR_X86_64
+#   include <emmintrin.h>
+#   define SLANG_FLAT_HASH_SSE2 1
+#else
+#   define SLANG_FLAT_HASH_SSE2 0
+#endif
+
+#if SLANG_VC
+#   include <intrin.h>
+#endif
+
+namespace Slang
+{
+
+/* An open addressing hash table, with the same interface as `Dictionary`.
+
+The table holds a control byte for each slot, which is either empty, deleted (a tombstone) or holds 7
+bits of the hash of the key in the slot. The control bytes and the entries are stored in a single
+allocation. Slots are probed a group of 16 at a time: the control bytes of a group are compared to
+the hash bits at once (with SSE2 where available), so keys are only compared for slots that are
+likely to match, and a lookup typically touches one cache line of control bytes and one entry.
+
+Keys can be looked up with a different type, as long as the type has the same hash code and can be
+compared with the key (for example an `UnownedStringSlice` against `String` keys).
+
+The iteration order is unspecified, and differs from `Dictionary`. */
+struct FlatHashGroup
+{
+    static const Index kWidth = 16;
+
+    enum Ctrl : int8_t
+    {
+        kEmpty = -128,
+        kDeleted = -2,
+    };
+
+        /// Get a mask with a bit set for each control byte of the group at `ctrl` equal to `h2`
+    SLANG_FORCE_INLINE static uint32_t match(const int8_t* ctrl, int8_t h2)
+    {
+#if SLANG_FLAT_HASH_SSE2
+        const __m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+        return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(h2))));
+#else
+        uint32_t mask = 0;
+        for (Index i = 0; i < kWidth; ++i)
+        {
+            mask |= uint32_t(ctrl[i] == h2) << i;
+        }
+        return mask;
+#endif
+    }
+        /// Get a mask with a bit set for each empty slot of the group at `ctrl`
+    SLANG_FORCE_INLINE static uint32_t matchEmpty(const int8_t* ctrl) { return match(ctrl, kEmpty); }
+        /// Get a mask with a bit set for each empty or deleted slot of the group at `ctrl`
+    SLANG_FORCE_INLINE static uint32_t matchEmptyOrDeleted(const int8_t* ctrl)
+    {
+#if SLANG_FLAT_HASH_SSE2
+        // Empty and deleted are the only negative values
+        return uint32_t(_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrl)));
+#else
+        uint32_t mask = 0;
+        for (Index i = 0; i < kWidth; ++i)
+        {
+            mask |= uint32_t(ctrl[i] < 0) << i;
+        }
+        return mask;
+#endif
+    }
+
+        /// Get the index of the lowest set bit. `mask` must not be 0.
+    SLANG_FORCE_INLINE static Index lowestBit(uint32_t mask)
+    {
+        SLANG_ASSERT(mask);
+#if SLANG_VC
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return Index(index);
+#elif SLANG_GCC_FAMILY
+        return Index(__builtin_ctz(mask));
+#else
+        Index index = 0;
+        while ((mask & 1) == 0)
+        {
+            mask >>= 1;
+            index++;
+        }
+        return index;
+#endif
+    }
+};
+
+template<typename TKey, typename TValue>
+class FlatDictionary
+{
+public:
+    typedef TValue ValueType;
+    typedef TKey KeyType;
+    typedef KeyValuePair<TKey, TValue> Entry;
+
+    class Iterator
+    {
+    public:
+        Entry& operator*() const { return m_dict->m_entries[m_pos]; }
+        Entry* operator->() const { return m_dict->m_entries + m_pos; }
+        Iterator& operator++()
+        {
+            if (m_pos < m_dict->m_capacity)
+            {
+                m_pos = m_dict->_findFull(m_pos + 1);
+            }
+            return *this;
+        }
+        Iterator operator++(int)
+        {
+            Iterator rs = *this;
+            operator++();
+            return rs;
+        }
+        bool operator!=(const Iterator& that) const { return m_pos != that.m_pos || m_dict != that.m_dict; }
+        bool operator==(const Iterator& that) const { return m_pos == that.m_pos && m_dict == that.m_dict; }
+
+        Iterator(const FlatDictionary* dict, Index pos) : m_dict(dict), m_pos(pos) {}
+        Iterator() : m_dict(nullptr), m_pos(0) {}
+
+    private:
+        const FlatDictionary* m_dict;
+        Index m_pos;
+    };
+
+    class ItemProxy
+    {
+    public:
+        ItemProxy(const TKey& key, const FlatDictionary* dict) : m_dict(dict), m_key(key) {}
+        ItemProxy(TKey&& key, const FlatDictionary* dict) : m_dict(dict), m_key(_Move(key)) {}
+
+        TValue& GetValue() const
+        {
+            TValue* value = m_dict->TryGetValue(m_key);
+            if (!value)
+            {
+                SLANG_ASSERT_FAILURE("The key does not exist in dictionary.");
+            }
+            return *value;
+        }
+        inline TValue& operator()() const { return GetValue(); }
+        operator TValue&() const { return GetValue(); }
+        TValue& operator=(const TValue& val) const
+        {
+            return const_cast<FlatDictionary*>(m_dict)->_set(Entry(_Move(m_key), val));
+        }
+        TValue& operator=(TValue&& val) const
+        {
+            return const_cast<FlatDictionary*>(m_dict)->_set(Entry(_Move(m_key), _Move(val)));
+        }
+
+    private:
+        const FlatDictionary* m_dict;
+        mutable TKey m_key;
+    };
+
+    Iterator begin() const { return Iterator(this, _findFull(0)); }
+    Iterator end() const { return Iterator(this, m_capacity); }
+
+    void Add(const TKey& key, const TValue& value) { _add(Entry(key, value)); }
+    void Add(TKey&& key, TValue&& value) { _add(Entry(_Move(key), _Move(value))); }
+    void Add(Entry&& entry) { _add(_Move(entry)); }
+
+    bool AddIfNotExists(const TKey& key, const TValue& value) { return _addIfNotExists(Entry(key, value)); }
+    bool AddIfNotExists(TKey&& key, TValue&& value) { return _addIfNotExists(Entry(_Move(key), _Move(value))); }
+
+    template<typename K>
+    void Remove(const K& key)
+    {
+        const Index pos = _find(key, _hash(key));
+        if (pos >= 0)
+        {
+            _erase(pos);
+        }
+    }
+
+    void Clear()
+    {
+        _destroyEntries();
+        if (m_capacity)
+        {
+            ::memset(m_ctrl, FlatHashGroup::kEmpty, size_t(m_capacity));
+        }
+        m_count = 0;
+        m_growthLeft = _getMaxLoad(m_capacity);
+    }
+
+        /// Make sure `count` entries can be held without growing the table
+    void reserve(Index count)
+    {
+        Index capacity = m_capacity ? m_capacity : FlatHashGroup::kWidth;
+        while (_getMaxLoad(capacity) < count)
+        {
+            capacity *= 2;
+        }
+        if (capacity > m_capacity)
+        {
+            _resize(capacity);
+        }
+    }
+
+        /// If `key` is in the dictionary returns its value, else adds `value` for `key` and returns nullptr
+    TValue* TryGetValueOrAdd(const TKey& key, const TValue& value)
+    {
+        const uint64_t hash = _hash(key);
+        const Index pos = _find(key, hash);
+        if (pos >= 0)
+        {
+            return &m_entries[pos].Value;
+        }
+        const Index newPos = _prepareInsert(hash);
+        new (m_entries + newPos) Entry(key, value);
+        return nullptr;
+    }
+
+        /// This differs from TryGetValueOrAdd, in that it always returns the Value held in the Dictionary.
+        /// If there isn't already an entry for 'key', a value is added with defaultValue.
+    TValue& GetOrAddValue(const TKey& key, const TValue& defaultValue)
+    {
+        const uint64_t hash = _hash(key);
+        Index pos = _find(key, hash);
+        if (pos < 0)
+        {
+            pos = _prepareInsert(hash);
+            new (m_entries + pos) Entry(key, defaultValue);
+        }
+        return m_entries[pos].Value;
+    }
+
+    void Set(const TKey& key, const TValue& value) { _set(Entry(key, value)); }
+
+    template<typename K>
+    bool ContainsKey(const K& key) const { return _find(key, _hash(key)) >= 0; }
+
+    template<typename K>
+    bool TryGetValue(const K& key, TValue& outValue) const
+    {
+        const Index pos = _find(key, _hash(key));
+        if (pos >= 0)
+        {
+            outValue = m_entries[pos].Value;
+            return true;
+        }
+        return false;
+    }
+
+    template<typename K>
+    TValue* TryGetValue(const K& key) const
+    {
+        const Index pos = _find(key, _hash(key));
+        return pos >= 0 ? &m_entries[pos].Value : nullptr;
+    }
+
+        /// Statistics about how far entries are from where their hash places them
+    struct ProbeStats
+    {
+        Index capacity = 0;             ///< The number of slots
+        Index count = 0;                ///< The number of entries
+        Index totalProbeLength = 0;     ///< The sum over all entries of the number of groups probed to find the entry
+        Index maxProbeLength = 0;       ///< The most groups probed to find any entry
+    };
+
+        /// Calculate the probe statistics of the table. Rehashes every key, so is not cheap.
+    ProbeStats calcProbeStats() const
+    {
+        ProbeStats stats;
+        stats.capacity = m_capacity;
+        stats.count = m_count;
+
+        const Index groupMask = _getGroupMask();
+        for (Index i = _findFull(0); i < m_capacity; i = _findFull(i + 1))
+        {
+            // Follow the probe sequence of the key until the group holding the entry
+            const Index entryGroup = i / FlatHashGroup::kWidth;
+            Index group = Index(_hash(m_entries[i].Key) >> 7) & groupMask;
+            Index length = 1;
+            for (Index probe = 1; group != entryGroup; ++probe)
+            {
+                group = (group + probe) & groupMask;
+                length++;
+            }
+
+            stats.totalProbeLength += length;
+            stats.maxProbeLength = (length > stats.maxProbeLength) ? length : stats.maxProbeLength;
+        }
+        return stats;
+    }
+
+    ItemProxy operator[](const TKey& key) const { return ItemProxy(key, this); }
+    ItemProxy operator[](TKey&& key) const { return ItemProxy(_Move(key), this); }
+
+    Index Count() const { return m_count; }
+
+    FlatDictionary() {}
+    template<typename Arg, typename... Args>
+    FlatDictionary(Arg arg, Args... args) { _init(arg, args...); }
+    FlatDictionary(const FlatDictionary& other) { *this = other; }
+    FlatDictionary(FlatDictionary&& other) { *this = _Move(other); }
+
+    FlatDictionary& operator=(const FlatDictionary& other)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+        _free();
+        if (other.m_capacity)
+        {
+            _allocate(other.m_capacity);
+            ::memcpy(m_ctrl, other.m_ctrl, size_t(m_capacity));
+            for (Index i = other._findFull(0); i < m_capacity; i = other._findFull(i + 1))
+            {
+                new (m_entries + i) Entry(other.m_entries[i]);
+            }
+            m_count = other.m_count;
+            m_growthLeft = other.m_growthLeft;
+        }
+        return *this;
+    }
+    FlatDictionary& operator=(FlatDictionary&& other)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+        _free();
+        m_ctrl = other.m_ctrl;
+        m_entries = other.m_entries;
+        m_capacity = other.m_capacity;
+        m_count = other.m_count;
+        m_growthLeft = other.m_growthLeft;
+
+        other.m_ctrl = nullptr;
+        other.m_entries = nullptr;
+        other.m_capacity = 0;
+        other.m_count = 0;
+        other.m_growthLeft = 0;
+        return *this;
+    }
+
+    ~FlatDictionary() { _free(); }
+
+private:
+    static_assert(SLANG_ALIGN_OF(Entry) <= FlatHashGroup::kWidth, "Entries must fit the alignment of the control bytes");
+
+        /// The maximum number of entries in a table with `capacity` slots (a 7/8 load factor)
+    static Index _getMaxLoad(Index capacity) { return capacity - capacity / 8; }
+
+    template<typename K>
+    static uint64_t _hash(const K& key)
+    {
+        // Mix the hash code, as `getHashCode` often has few bits set (or they are not spread) for
+        // small integers and pointers. The low 7 bits are stored in the control byte, the rest
+        // select the group.
+        uint64_t hash = uint64_t(getHashCode(const_cast<K&>(key))) * 0x9E3779B97F4A7C15ull;
+        return hash ^ (hash >> 29);
+    }
+    static int8_t _getH2(uint64_t hash) { return int8_t(hash & 0x7f); }
+    Index _getGroupMask() const { return m_capacity / FlatHashGroup::kWidth - 1; }
+
+        /// Find the first slot at or after `pos` holding an entry, or m_capacity if there is none
+    Index _findFull(Index pos) const
+    {
+        while (pos < m_capacity && m_ctrl[pos] < 0)
+        {
+            pos++;
+        }
+        return pos;
+    }
+
+    template<typename K>
+    Index _find(const K& key, uint64_t hash) const
+    {
+        if (m_count == 0)
+        {
+            return -1;
+        }
+
+        const int8_t h2 = _getH2(hash);
+        const Index groupMask = _getGroupMask();
+        Index group = Index(hash >> 7) & groupMask;
+
+        // Triangular probing visits every group when the group count is a power of 2. There is
+        // always an empty slot as the load factor is below 1, so the loop terminates.
+        for (Index probe = 1; ; ++probe)
+        {
+            const Index groupStart = group * FlatHashGroup::kWidth;
+            const int8_t* ctrl = m_ctrl + groupStart;
+            for (uint32_t mask = FlatHashGroup::match(ctrl, h2); mask; mask &= mask - 1)
+            {
+                const Index pos = groupStart + FlatHashGroup::lowestBit(mask);
+                if (m_entries[pos].Key == key)
+                {
+                    return pos;
+                }
+            }
+            if (FlatHashGroup::matchEmpty(ctrl))
+            {
+                return -1;
+            }
+            group = (group + probe) & groupMask;
+        }
+    }
+
+        /// Find the first empty or deleted slot in the probe sequence of `hash`
+    Index _findInsertSlot(uint64_t hash) const
+    {
+        const Index groupMask = _getGroupMask();
+        Index group = Index(hash >> 7) & groupMask;
+        for (Index probe = 1; ; ++probe)
+        {
+            const Index groupStart = group * FlatHashGroup::kWidth;
+            if (const uint32_t mask = FlatHashGroup::matchEmptyOrDeleted(m_ctrl + groupStart))
+            {
+                return groupStart + FlatHashGroup::lowestBit(mask);
+            }
+            group = (group + probe) & groupMask;
+        }
+    }
+
+        /// Mark a slot as used for a new entry with `hash`, growing the table if needed.
+        /// The caller must construct the entry at the returned slot (of m_entries as it is *after* the call).
+    Index _prepareInsert(uint64_t hash)
+    {
+        if (m_capacity == 0)
+        {
+            _resize(FlatHashGroup::kWidth);
+        }
+
+        Index pos = _findInsertSlot(hash);
+        if (m_growthLeft == 0 && m_ctrl[pos] == FlatHashGroup::kEmpty)
+        {
+            // If the table is mostly tombstones, rehash in place to remove them, else grow
+            _resize(m_count * 2 < _getMaxLoad(m_capacity) ? m_capacity : m_capacity * 2);
+            pos = _findInsertSlot(hash);
+        }
+
+        if (m_ctrl[pos] == FlatHashGroup::kEmpty)
+        {
+            m_growthLeft--;
+        }
+        m_ctrl[pos] = _getH2(hash);
+        m_count++;
+        return pos;
+    }
+
+    void _erase(Index pos)
+    {
+        m_entries[pos].~Entry();
+        m_count--;
+
+        // A lookup stops at the first group that has an empty slot. If the group of the slot
+        // already has an empty slot no lookup probes past it, so the slot can be empty again.
+        // Otherwise it has to be marked as deleted.
+        const Index groupStart = pos & ~(FlatHashGroup::kWidth - 1);
+        if (FlatHashGroup::matchEmpty(m_ctrl + groupStart))
+        {
+            m_ctrl[pos] = FlatHashGroup::kEmpty;
+            m_growthLeft++;
+        }
+        else
+        {
+            m_ctrl[pos] = FlatHashGroup::kDeleted;
+        }
+    }
+
+    bool _addIfNotExists(Entry&& entry)
+    {
+        const uint64_t hash = _hash(entry.Key);
+        if (_find(entry.Key, hash) >= 0)
+        {
+            return false;
+        }
+        const Index pos = _prepareInsert(hash);
+        new (m_entries + pos) Entry(_Move(entry));
+        return true;
+    }
+
+    void _add(Entry&& entry)
+    {
+        if (!_addIfNotExists(_Move(entry)))
+        {
+            SLANG_ASSERT_FAILURE("The key already exists in Dictionary.");
+        }
+    }
+
+    TValue& _set(Entry&& entry)
+    {
+        const uint64_t hash = _hash(entry.Key);
+        Index pos = _find(entry.Key, hash);
+        if (pos >= 0)
+        {
+            m_entries[pos].Value = _Move(entry.Value);
+        }
+        else
+        {
+            pos = _prepareInsert(hash);
+            new (m_entries + pos) Entry(_Move(entry));
+        }
+        return m_entries[pos].Value;
+    }
+
+    void _allocate(Index capacity)
+    {
+        SLANG_ASSERT(capacity >= FlatHashGroup::kWidth && (capacity & (capacity - 1)) == 0);
+
+        // The control bytes are followed by the entries. As the capacity is a multiple of the
+        // group width, the entries are suitably aligned.
+        uint8_t* memory = (uint8_t*)::operator new(size_t(capacity) * (1 + sizeof(Entry)));
+        m_ctrl = (int8_t*)memory;
+        m_entries = (Entry*)(memory + capacity);
+        m_capacity = capacity;
+        ::memset(m_ctrl, FlatHashGroup::kEmpty, size_t(capacity));
+        m_count = 0;
+        m_growthLeft = _getMaxLoad(capacity);
+    }
+
+    void _resize(Index newCapacity)
+    {
+        int8_t* oldCtrl = m_ctrl;
+        Entry* oldEntries = m_entries;
+        const Index oldCapacity = m_capacity;
+        const Index count = m_count;
+
+        _allocate(newCapacity);
+
+        for (Index i = 0; i < oldCapacity; ++i)
+        {
+            if (oldCtrl[i] >= 0)
+            {
+                Entry& entry = oldEntries[i];
+                const uint64_t hash = _hash(entry.Key);
+                const Index pos = _findInsertSlot(hash);
+                m_ctrl[pos] = _getH2(hash);
+                new (m_entries + pos) Entry(_Move(entry));
+                entry.~Entry();
+            }
+        }
+        m_count = count;
+        m_growthLeft -= count;
+
+        ::operator delete(oldCtrl);
+    }
+
+    void _destroyEntries()
+    {
+        for (Index i = _findFull(0); i < m_capacity; i = _findFull(i + 1))
+        {
+            m_entries[i].~Entry();
+        }
+    }
+
+    void _free()
+    {
+        if (m_ctrl)
+        {
+            _destroyEntries();
+            ::operator delete(m_ctrl);
+        }
+        m_ctrl = nullptr;
+        m_entries = nullptr;
+        m_capacity = 0;
+        m_count = 0;
+        m_growthLeft = 0;
+    }
+
+    template<typename... Args>
+    void _init(const Entry& entry, Args... args)
+    {
+        _add(Entry(entry));
+        _init(args...);
+    }
+    void _init() {}
+
+    int8_t* m_ctrl = nullptr;           ///< A control byte per slot
+    Entry* m_entries = nullptr;         ///< The entries, only constructed for full slots
+    Index m_capacity = 0;               ///< The number of slots, 0 or a power of 2 multiple of the group width
+    Index m_count = 0;                  ///< The number of entries
+    Index m_growthLeft = 0;             ///< The number of empty slots that can be used before the table is resized
+};
+
+template<typename T>
+class FlatHashSet : public HashSetBase<T, FlatDictionary<T, _DummyClass>>
+{
+public:
+    Index Count() const { return this->dict.Count(); }
+};
+
+} // namespace Slang
+
+#endif
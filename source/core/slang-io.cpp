@@ -62,6 +62,24 @@ namespace Slang
 #endif
     }
 
+    /* static */SlangResult File::rename(const String& fromFileName, const String& toFileName)
+    {
+#ifdef _WIN32
+        // https://docs.microsoft.com/en-us/windows/win32/api/winbase/nf-winbase-movefileexa
+        if (MoveFileExA(fromFileName.getBuffer(), toFileName.getBuffer(), MOVEFILE_REPLACE_EXISTING))
+        {
+            return SLANG_OK;
+        }
+        return SLANG_FAIL;
+#else
+        // https://linux.die.net/man/3/rename
+        if (::rename(fromFileName.getBuffer(), toFileName.getBuffer()) == 0)
+        {
+            return SLANG_OK;
+        }
+        return SLANG_FAIL;
+#endif
+    }
 
 #ifdef _WIN32
     /* static */SlangResult File::generateTemporary(const UnownedStringSlice& inPrefix, Slang::String& outFileName)
@@ -30,6 +30,10 @@ namespace Slang
 
         static SlangResult remove(const String& fileName);
 
+            /// Rename a file. If a file named toFileName already exists it is replaced.
+            /// Where supported by the platform, other processes either see the old or the new file.
+        static SlangResult rename(const String& fromFileName, const String& toFileName);
+
         static SlangResult makeExecutable(const String& fileName);
 
             /// Creates a temporary file typically in some way based on the prefix
@@ -3,12 +3,35 @@
 #include "../core/slang-io.h"
 #include "../core/slang-stream.h"
 #include "../core/slang-string-util.h"
+#include "../core/slang-char-util.h"
 #include "../core/slang-blob.h"
+#include "../core/slang-process.h"
 
 namespace Slang
 {
 
+struct CacheIndexHeader
+{
+    char magic[4];
+    uint32_t version;
+    // Changes each time the index file is rewritten
+    uint32_t generation;
+    uint32_t reserved;
+};
+
+static const char* kMagic = "SLS$";
+static const uint32_t kVersion = 2;
+
+// The journal is rewritten once it holds more than this many records per entry in the cache (plus
+// kMinCompactRecordCount), so the cost of rewriting it is amortized over many writes.
+static const Count kCompactRecordsPerEntry = 2;
+static const Count kMinCompactRecordCount = 1024;
+
+// Once this many records are pending, reads try to append them to the index (without blocking).
+static const Count kMaxPendingRecordCount = 256;
+
 PersistentCache::PersistentCache(const Desc& desc)
+    : m_tempFileCounter(0)
 {
     m_cacheDirectory = Path::simplify(desc.directory);
     Path::createDirectory(m_cacheDirectory);
@@ -19,6 +42,7 @@ PersistentCache::PersistentCache(const Desc& desc)
     m_lockFile.open(m_lockFileName);
 
     m_maxEntryCount = desc.maxEntryCount;
+    m_evictionBatchCount = desc.evictionBatchCount;
 
     resetStats();
 
@@ -27,6 +51,9 @@ PersistentCache::PersistentCache(const Desc& desc)
 
 PersistentCache::~PersistentCache()
 {
+    // Record the uses of entries that haven't been appended to the index yet.
+    std::lock_guard<std::mutex> mutexLock(m_mutex);
+    _flushPendingRecords(false);
 }
 
 SlangResult PersistentCache::clear()
@@ -63,6 +90,11 @@ SlangResult PersistentCache::clear()
     Visitor visitor(m_cacheDirectory, m_lockFileName);
     Path::find(m_cacheDirectory, nullptr, &visitor);
 
+    _resetEntries();
+    m_pendingRecords.clear();
+    m_indexFileSize = 0;
+    m_indexRecordCount = 0;
+
     m_stats.entryCount = 0;
 
     return SLANG_OK;
@@ -77,61 +109,40 @@ void PersistentCache::resetStats()
 
 SlangResult PersistentCache::readEntry(const Key& key, ISlangBlob** outData)
 {
-    // Be pessimistic and assume we have a cache miss.
-    ++m_stats.missCount;
-
-    if (!m_lockFile.isOpen())
-    {
-        return SLANG_E_CANNOT_OPEN;
-    }
-
-    // Acquire the exclusive lock.
-    std::lock_guard<std::mutex> mutexLock(m_mutex);
-    LockFileGuard fileLock(m_lockFile);
-
-    // Return if index does not exist.
-    if (!File::exists(m_indexFileName))
-    {
-        return SLANG_E_NOT_FOUND;
-    }
-
-    // Read the cache index.
-    CacheIndex cacheIndex;
-    SLANG_RETURN_ON_FAIL(readIndex(m_indexFileName, cacheIndex));
-
-    // Increase the age of all entries in the cache.
-    for (auto& entry : cacheIndex)
-    {
-        ++entry.age;
-    }
-
-    // Find the entry.
-    Index entryIndex = cacheIndex.findFirstIndex([&key] (const CacheEntry& entry) { return entry.key == key; });
-    if (entryIndex == -1)
-    {
-        return SLANG_E_NOT_FOUND;
-    }
-
-    // Read the entry.
+    // Reading the entry file doesn't need the lock, as entry files are replaced atomically.
     String entryFileName = getEntryFileName(key);
     ScopedAllocation data;
     SlangResult result = File::readAllBytes(entryFileName, data);
-    if (result == SLANG_OK)
+
+    std::lock_guard<std::mutex> mutexLock(m_mutex);
+
+    if (SLANG_SUCCEEDED(result))
     {
-        --m_stats.missCount;
         ++m_stats.hitCount;
-        cacheIndex[entryIndex].age = 0;
+        m_pendingRecords.add(IndexRecord{ key, RecordType::Use });
+
         auto blob = RawBlob::moveCreate(data);
         *outData = blob.detach();
     }
     else
     {
-        cacheIndex.removeAt(entryIndex);
+        ++m_stats.missCount;
+        result = SLANG_E_NOT_FOUND;
+
+        // If the entry is in the index, its file has been removed externally, so the index entry is stale.
+        Index* nodeIndex = m_entryNodes.TryGetValue(key);
+        if (!nodeIndex)
+        {
+            return result;
+        }
+        _removeEntry(*nodeIndex);
+        m_pendingRecords.add(IndexRecord{ key, RecordType::Remove });
     }
 
-    // Write the cache index.
-    SLANG_RETURN_ON_FAIL(writeIndex(m_indexFileName, cacheIndex));
-    m_stats.entryCount = (Count)cacheIndex.getCount();
+    if (m_pendingRecords.getCount() >= kMaxPendingRecordCount)
+    {
+        _flushPendingRecords(true);
+    }
 
     return result;
 }
@@ -145,53 +156,69 @@ SlangResult PersistentCache::writeEntry(const Key& key, ISlangBlob* data)
         return SLANG_E_CANNOT_OPEN;
     }
 
+    // Write the cache entry to a temporary file, and rename it, such that concurrent readers never see
+    // a partially written entry. Only the rename needs the lock, so it can't race with another
+    // process evicting the same entry.
+    String entryFileName = getEntryFileName(key);
+    StringBuilder tempFileName;
+    tempFileName << entryFileName << "." << uint32_t(++m_tempFileCounter) << "-" << Process::getClockTick() << ".tmp";
+    SLANG_RETURN_ON_FAIL(File::writeAllBytes(tempFileName, data->getBufferPointer(), data->getBufferSize()));
+
     // Acquire the exclusive lock.
     std::lock_guard<std::mutex> mutexLock(m_mutex);
     LockFileGuard fileLock(m_lockFile);
 
-    // Read the cache index.
-    // We ignore any errors when reading the index and just write a new one.
-    CacheIndex cacheIndex;
-    readIndex(m_indexFileName, cacheIndex);
-
-    // Increase the age of all entries in the cache and get the index of
-    // the oldest entry.
-    Index oldestEntryIndex = -1;
-    uint32_t oldestEntryAge = 0;
-    for (Index entryIndex = 0; entryIndex < cacheIndex.getCount(); ++entryIndex)
+    if (SLANG_FAILED(File::rename(tempFileName, entryFileName)))
     {
-        auto& entry = cacheIndex[entryIndex];
-        ++entry.age;
-        if (entry.age > oldestEntryAge)
+        // On some platforms the entry can't be replaced while it is being read. The entry
+        // holds the same value for the same key, so that is fine if the entry exists.
+        File::remove(tempFileName);
+        if (!File::exists(entryFileName))
         {
-            oldestEntryIndex = entryIndex;
-            oldestEntryAge = entry.age;
+            return SLANG_FAIL;
         }
     }
 
-    // Write the cache entry.
-    String entryFileName = getEntryFileName(key);
-    SLANG_RETURN_ON_FAIL(File::writeAllBytes(entryFileName, data->getBufferPointer(), data->getBufferSize()));
+    // Get up to date with what other processes wrote.
+    // We ignore any errors when reading the index, as the records are appended to a new one.
+    _readIndex();
 
-    // Update the index.
-    if (m_maxEntryCount > 0 && cacheIndex.getCount() >= m_maxEntryCount)
+    // The records to append are the pending ones, followed by those for this write.
+    List<IndexRecord> records = _Move(m_pendingRecords);
+    for (const auto& record : records)
     {
-        // Replace oldest entry.
-        SLANG_ASSERT(oldestEntryIndex >= 0);
-        File::remove(getEntryFileName(cacheIndex[oldestEntryIndex].key));
-        cacheIndex[oldestEntryIndex] = CacheEntry{ key, 0 };
+        _applyRecord(record);
     }
-    else
+
+    IndexRecord addRecord{ key, RecordType::Add };
+    _applyRecord(addRecord);
+    records.add(addRecord);
+
+    // Evict the least recently used entries, including an extra batch so eviction doesn't run on every write.
+    const Count entryCount = m_entryNodes.Count();
+    if (m_maxEntryCount > 0 && entryCount > m_maxEntryCount)
+    {
+        // Never evict the entry just written.
+        const Count evictCount = Math::Min(entryCount - m_maxEntryCount + m_evictionBatchCount, entryCount - 1);
+        for (Index i = 0; i < evictCount; ++i)
+        {
+            const Key evictKey = m_lruNodes[m_oldestNode].key;
+            File::remove(getEntryFileName(evictKey));
+            _removeEntry(m_oldestNode);
+            records.add(IndexRecord{ evictKey, RecordType::Remove });
+        }
+    }
+
+    SlangResult result = _appendIndex(records.getBuffer(), records.getCount());
+    if (SLANG_SUCCEEDED(result) &&
+        m_indexRecordCount > m_entryNodes.Count() * kCompactRecordsPerEntry + kMinCompactRecordCount)
     {
-        // Add new entry.
-        cacheIndex.add(CacheEntry{ key, 0 });
+        result = _writeIndex();
     }
 
-    // Write the cache index.
-    SlangResult result = writeIndex(m_indexFileName, cacheIndex);
-    if (result == SLANG_OK)
+    if (SLANG_SUCCEEDED(result))
     {
-        m_stats.entryCount = (Count)cacheIndex.getCount();
+        m_stats.entryCount = m_entryNodes.Count();
     }
     else
     {
@@ -213,11 +240,8 @@ SlangResult PersistentCache::initialize()
     std::lock_guard<std::mutex> mutexLock(m_mutex);
     LockFileGuard fileLock(m_lockFile);
 
-    CacheIndex cacheIndex;
-    if (SLANG_SUCCEEDED(readIndex(m_indexFileName, cacheIndex)))
-    {
-        m_stats.entryCount = (Count)cacheIndex.getCount();
-    }
+    SLANG_RETURN_ON_FAIL(_readIndex());
+    m_stats.entryCount = m_entryNodes.Count();
 
     return SLANG_OK;
 }
@@ -229,61 +253,281 @@ String PersistentCache::getEntryFileName(const Key& key)
     return str;
 }
 
-struct CacheIndexHeader
-{
-    char magic[4];
-    uint32_t version;
-    uint32_t count;
-    uint32_t reserved;
-};
-
-static const char* kMagic = "SLS$";
-static const uint32_t kVersion = 1;
-
-SlangResult PersistentCache::readIndex(const String& fileName, CacheIndex& outIndex)
+SlangResult PersistentCache::_readIndex()
 {
     FileStream fs;
-    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Open));
+    if (SLANG_FAILED(fs.init(m_indexFileName, FileMode::Open, FileAccess::Read, FileShare::ReadWrite)))
+    {
+        // The cache is new, or the index has been removed externally. Any entry files that
+        // exist are added to the new index.
+        return _rebuildIndex();
+    }
 
     // Get file size.
     SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::End, 0));
-    size_t fileSize = (size_t)fs.getPosition();
+    const uint64_t fileSize = (uint64_t)fs.getPosition();
     SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, 0));
 
     CacheIndexHeader header;
-    SLANG_RETURN_ON_FAIL(fs.readExactly(&header, sizeof(header)));
-    if (::memcmp(header.magic, kMagic, 4) != 0 || header.version != kVersion)
+    if (SLANG_FAILED(fs.readExactly(&header, sizeof(header))) ||
+        ::memcmp(header.magic, kMagic, 4) != 0 || header.version != kVersion ||
+        (fileSize - sizeof(header)) % sizeof(IndexRecord) != 0)
+    {
+        fs.close();
+        return _rebuildIndex();
+    }
+
+    // If the index was rewritten, the in memory index has to be read from scratch.
+    if (header.generation != m_indexGeneration || fileSize < m_indexFileSize)
     {
-        return SLANG_E_INTERNAL_FAIL;
+        _resetEntries();
+        m_indexGeneration = header.generation;
+        m_indexFileSize = sizeof(header);
+        m_indexRecordCount = 0;
     }
 
-    // Return if payload does not have the right size.
-    if (header.count * sizeof(CacheEntry) != fileSize - sizeof(header))
+    // Read just the records appended since the index was last read.
+    const Count newRecordCount = Count((fileSize - m_indexFileSize) / sizeof(IndexRecord));
+    if (newRecordCount == 0)
     {
-        return SLANG_E_INTERNAL_FAIL;
+        return SLANG_OK;
+    }
+
+    List<IndexRecord> records;
+    records.setCount(newRecordCount);
+    SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, (Int64)m_indexFileSize));
+    SLANG_RETURN_ON_FAIL(fs.readExactly(records.getBuffer(), newRecordCount * sizeof(IndexRecord)));
+
+    for (const auto& record : records)
+    {
+        if (record.type != RecordType::Add && record.type != RecordType::Use && record.type != RecordType::Remove)
+        {
+            fs.close();
+            return _rebuildIndex();
+        }
+        _applyRecord(record);
     }
 
-    outIndex.setCount(header.count);
-    SLANG_RETURN_ON_FAIL(fs.readExactly(outIndex.getBuffer(), header.count * sizeof(CacheEntry)));
-    
+    m_indexFileSize = fileSize;
+    m_indexRecordCount += newRecordCount;
+
     return SLANG_OK;
 }
 
-SlangResult PersistentCache::writeIndex(const String& fileName, const CacheIndex& index)
+SlangResult PersistentCache::_appendIndex(const IndexRecord* records, Count count)
 {
+    if (!File::exists(m_indexFileName))
+    {
+        // The records have been applied, so the new index holds them.
+        return _writeIndex();
+    }
+
     FileStream fs;
-    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Create));
+    SLANG_RETURN_ON_FAIL(fs.init(m_indexFileName, FileMode::Append, FileAccess::Write, FileShare::ReadWrite));
+    SLANG_RETURN_ON_FAIL(fs.write(records, count * sizeof(IndexRecord)));
+    SLANG_RETURN_ON_FAIL(fs.flush());
+
+    m_indexFileSize += count * sizeof(IndexRecord);
+    m_indexRecordCount += count;
+
+    return SLANG_OK;
+}
+
+SlangResult PersistentCache::_writeIndex()
+{
+    // Write the entries from least to most recently used, such that reading the index reproduces the LRU order.
+    List<IndexRecord> records;
+    records.reserve(m_entryNodes.Count());
+    for (Index nodeIndex = m_oldestNode; nodeIndex >= 0; nodeIndex = m_lruNodes[nodeIndex].newer)
+    {
+        records.add(IndexRecord{ m_lruNodes[nodeIndex].key, RecordType::Add });
+    }
 
     CacheIndexHeader header;
     ::memcpy(header.magic, kMagic, 4);
     header.version = kVersion;
-    header.count = (uint32_t)index.getCount();
+    // Make sure the generation differs from any previous one, including when the previous index was corrupt.
+    header.generation = m_indexGeneration + 1 + uint32_t(Process::getClockTick() & 0xffff);
     header.reserved = 0;
-    SLANG_RETURN_ON_FAIL(fs.write(&header, sizeof(header)));
 
-    SLANG_RETURN_ON_FAIL(fs.write(index.getBuffer(), index.getCount() * sizeof(CacheEntry)));
+    // Write to a temporary file and rename it, such that the index is always complete.
+    String tempFileName = m_indexFileName + ".tmp";
+    {
+        FileStream fs;
+        SLANG_RETURN_ON_FAIL(fs.init(tempFileName, FileMode::Create));
+        SLANG_RETURN_ON_FAIL(fs.write(&header, sizeof(header)));
+        SLANG_RETURN_ON_FAIL(fs.write(records.getBuffer(), records.getCount() * sizeof(IndexRecord)));
+    }
+    SLANG_RETURN_ON_FAIL(File::rename(tempFileName, m_indexFileName));
+
+    m_indexGeneration = header.generation;
+    m_indexFileSize = sizeof(header) + records.getCount() * sizeof(IndexRecord);
+    m_indexRecordCount = records.getCount();
 
     return SLANG_OK;
 }
 
+SlangResult PersistentCache::_rebuildIndex()
+{
+    struct Visitor : Path::Visitor
+    {
+        PersistentCache* cache;
+
+        Visitor(PersistentCache* cache)
+            : cache(cache)
+        {}
+
+        void accept(Path::Type type, const UnownedStringSlice& fileName) SLANG_OVERRIDE
+        {
+            if (type != Path::Type::File || fileName.getLength() != sizeof(Key) * 2)
+            {
+                return;
+            }
+            for (auto c : fileName)
+            {
+                if (!CharUtil::isHexDigit(c))
+                {
+                    return;
+                }
+            }
+            cache->_addNewestEntry(Key(fileName));
+        }
+    };
+
+    // The order in which entries were used is lost, so the entries are added in directory order.
+    _resetEntries();
+    Visitor visitor(this);
+    Path::find(m_cacheDirectory, nullptr, &visitor);
+
+    return _writeIndex();
+}
+
+void PersistentCache::_flushPendingRecords(bool tryLock)
+{
+    if (m_pendingRecords.getCount() == 0 || !m_lockFile.isOpen())
+    {
+        return;
+    }
+
+    if (tryLock)
+    {
+        if (SLANG_FAILED(m_lockFile.tryLock()))
+        {
+            // Leave the records pending, rather than waiting for the lock.
+            return;
+        }
+    }
+    else
+    {
+        m_lockFile.lock();
+    }
+
+    _readIndex();
+
+    List<IndexRecord> records = _Move(m_pendingRecords);
+    for (const auto& record : records)
+    {
+        _applyRecord(record);
+    }
+    _appendIndex(records.getBuffer(), records.getCount());
+
+    m_lockFile.unlock();
+}
+
+void PersistentCache::_applyRecord(const IndexRecord& record)
+{
+    Index* nodeIndex = m_entryNodes.TryGetValue(record.key);
+    switch (record.type)
+    {
+    case RecordType::Add:
+        if (nodeIndex)
+        {
+            _removeEntry(*nodeIndex);
+        }
+        _addNewestEntry(record.key);
+        break;
+    case RecordType::Use:
+        // A use of an entry that isn't in the index (such as one that was evicted since it was read) is ignored.
+        if (nodeIndex)
+        {
+            _removeEntry(*nodeIndex);
+            _addNewestEntry(record.key);
+        }
+        break;
+    case RecordType::Remove:
+        if (nodeIndex)
+        {
+            _removeEntry(*nodeIndex);
+        }
+        break;
+    }
+}
+
+void PersistentCache::_resetEntries()
+{
+    m_entryNodes.Clear();
+    m_lruNodes.clear();
+    m_oldestNode = -1;
+    m_newestNode = -1;
+    m_freeNode = -1;
+}
+
+void PersistentCache::_addNewestEntry(const Key& key)
+{
+    Index nodeIndex = m_freeNode;
+    if (nodeIndex >= 0)
+    {
+        m_freeNode = m_lruNodes[nodeIndex].newer;
+    }
+    else
+    {
+        nodeIndex = m_lruNodes.getCount();
+        m_lruNodes.add(LruNode());
+    }
+
+    LruNode& node = m_lruNodes[nodeIndex];
+    node.key = key;
+    node.older = m_newestNode;
+    node.newer = -1;
+
+    if (m_newestNode >= 0)
+    {
+        m_lruNodes[m_newestNode].newer = nodeIndex;
+    }
+    else
+    {
+        m_oldestNode = nodeIndex;
+    }
+    m_newestNode = nodeIndex;
+
+    m_entryNodes[key] = nodeIndex;
+}
+
+void PersistentCache::_removeEntry(Index nodeIndex)
+{
+    LruNode& node = m_lruNodes[nodeIndex];
+    m_entryNodes.Remove(node.key);
+
+    if (node.older >= 0)
+    {
+        m_lruNodes[node.older].newer = node.newer;
+    }
+    else
+    {
+        m_oldestNode = node.newer;
+    }
+    if (node.newer >= 0)
+    {
+        m_lruNodes[node.newer].older = node.older;
+    }
+    else
+    {
+        m_newestNode = node.older;
+    }
+
+    // Add to the free list, which is linked through `newer`
+    node.newer = m_freeNode;
+    m_freeNode = nodeIndex;
+}
+
 }
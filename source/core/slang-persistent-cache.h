@@ -1,28 +1,44 @@
 #pragma once
 #include "../../slang.h"
 #include "../core/slang-crypto.h"
+#include "../core/slang-dictionary.h"
 #include "../core/slang-io.h"
 #include "../core/slang-string.h"
 
+#include <atomic>
 #include <mutex>
 
 namespace Slang
 {
 
 /// Implements a simple persistent cache on the filesystem for storing key/value pairs.
-/// Keys are SHA1 hashes and values are arbitrary blobs of data.
-/// The cache is save for concurrent access from multiple threads/processes by using
-/// a lock file within the cache directory. Furthermore, the cache implements a LRU
+/// Keys are SHA1 hashes and values are arbitrary blobs of data, each stored in its own file.
+/// The cache is safe for concurrent access from multiple threads/processes, and implements a LRU
 /// eviction policy.
+///
+/// Reading an entry just reads its file, without reading the cache index or taking the lock file.
+/// Entry files are written to a temporary file that is then renamed, so a reader never sees a
+/// partially written entry.
+///
+/// The cache index is an append-only journal of records (an entry was added, used or removed),
+/// which is only accessed holding a lock file within the cache directory. Each cache object keeps
+/// the index in memory as a LRU list, and only reads the records appended (by any process) since
+/// it last did. Uses of entries are appended in batches, so tracking them doesn't need the lock
+/// on every read. When the cache holds more than the maximum number of entries, the least recently
+/// used entries are evicted in a batch. The journal is rewritten once it mostly consists of stale
+/// records.
 class PersistentCache : public RefObject
 {
 public:
     struct Desc
-    {   
+    {
         // The root directory for the cache.
         const char* directory = nullptr;
         // The maximum number of entries stored in the cache. By default, there is no limit.
         Count maxEntryCount = 0;
+        // The number of entries evicted beyond what is needed to get back to maxEntryCount, such
+        // that eviction only runs once per batch of writes.
+        Count evictionBatchCount = 0;
     };
 
     struct Stats
@@ -31,7 +47,7 @@ public:
         Count hitCount;
         // Number of cache misses since last resetting the stats.
         Count missCount;
-        // Current number of entries in the cache.
+        // Number of entries in the cache, as of the last write (or initialization).
         Count entryCount;
     };
 
@@ -48,27 +64,61 @@ public:
 
     /// Read an entry from the cache.
     /// Returns SLANG_OK if successful, SLANG_E_NOT_FOUND if the entry is not in the cache.
+    /// If the entry is in the index but its file has been removed, it is dropped from the index
+    /// and SLANG_E_NOT_FOUND is returned.
     SlangResult readEntry(const Key& key, ISlangBlob** outData);
-    
+
     /// Write an entry to the cache.
     /// Returns SLANG_OK if successful.
     SlangResult writeEntry(const Key& key, ISlangBlob* data);
 
 private:
-    struct CacheEntry
+    enum class RecordType : uint32_t
+    {
+        Add = 1,
+        Use,
+        Remove,
+    };
+
+    struct IndexRecord
     {
         Key key;
-        uint32_t age;
+        RecordType type;
     };
 
-    using CacheIndex = List<CacheEntry>;
+    struct LruNode
+    {
+        Key key;
+        Index older;
+        Index newer;
+    };
 
     SlangResult initialize();
 
     String getEntryFileName(const Key& key);
 
-    SlangResult readIndex(const String& fileName, CacheIndex& outIndex);
-    SlangResult writeIndex(const String& fileName, const CacheIndex& index);
+    // The following require m_mutex and the lock file to be held, except where noted.
+
+    /// Read the records appended to the index since it was last read.
+    /// If the index is missing or corrupt, it is rebuilt from the entry files.
+    SlangResult _readIndex();
+    /// Append records to the index. The records must have been applied already.
+    SlangResult _appendIndex(const IndexRecord* records, Count count);
+    /// Write the index with just the current entries, replacing the existing index.
+    SlangResult _writeIndex();
+    /// Rebuild the index from the entry files in the cache directory.
+    SlangResult _rebuildIndex();
+    /// Append the pending records, holding the lock file if `tryLock` is set and it's not held
+    /// already by someone else. Requires just m_mutex to be held.
+    void _flushPendingRecords(bool tryLock);
+
+    // The following only require m_mutex to be held.
+
+    /// Apply a record to the in memory index
+    void _applyRecord(const IndexRecord& record);
+    void _resetEntries();
+    void _addNewestEntry(const Key& key);
+    void _removeEntry(Index nodeIndex);
 
     String m_cacheDirectory;
     String m_lockFileName;
@@ -81,6 +131,28 @@ private:
     Slang::LockFile m_lockFile;
 
     Count m_maxEntryCount;
+    Count m_evictionBatchCount;
+
+    // The in memory index, maps keys to nodes in a list ordered from least to most recently used.
+    Dictionary<Key, Index> m_entryNodes;
+    List<LruNode> m_lruNodes;
+    Index m_oldestNode = -1;
+    Index m_newestNode = -1;
+    Index m_freeNode = -1;
+
+    // The generation of the index file the in memory index was read from. It changes each time
+    // the index file is rewritten, in which case the in memory index is read again from scratch.
+    uint32_t m_indexGeneration = 0;
+    // The size of the index file read so far.
+    uint64_t m_indexFileSize = 0;
+    // The number of records in the index file.
+    Count m_indexRecordCount = 0;
+
+    // Use and remove records from reads that are yet to be appended to the index.
+    List<IndexRecord> m_pendingRecords;
+
+    // Used to create unique names for temporary files.
+    std::atomic<uint32_t> m_tempFileCounter;
 
     Stats m_stats;
 
@@ -7,13 +7,18 @@
 
 #include "../../slang.h"
 
+#include <atomic>
+
 namespace Slang
 {
     // Base class for all reference-counted objects
+    //
+    // The reference count is atomic, such that objects (like the global session and the modules of
+    // the standard library) can be shared between threads.
     class SLANG_RT_API RefObject
     {
     private:
-        UInt referenceCount;
+        std::atomic<UInt> referenceCount;
 
     public:
         RefObject()
@@ -31,34 +36,34 @@ namespace Slang
 
         UInt addReference()
         {
-            return ++referenceCount;
+            return referenceCount.fetch_add(1, std::memory_order_relaxed) + 1;
         }
 
         UInt decreaseReference()
         {
-            return --referenceCount;
+            return referenceCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
         }
 
         UInt releaseReference()
         {
-            SLANG_ASSERT(referenceCount != 0);
-            if(--referenceCount == 0)
+            const UInt count = referenceCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+            SLANG_ASSERT(count != UInt(-1));
+            if(count == 0)
             {
                 delete this;
-                return 0;
             }
-            return referenceCount;
+            return count;
         }
 
         bool isUniquelyReferenced()
         {
-            SLANG_ASSERT(referenceCount != 0);
-            return referenceCount == 1;
+            SLANG_ASSERT(referenceCount.load(std::memory_order_relaxed) != 0);
+            return referenceCount.load(std::memory_order_acquire) == 1;
         }
 
         UInt debugGetReferenceCount()
         {
-            return referenceCount;
+            return referenceCount.load(std::memory_order_relaxed);
         }
     };
 
@@ -401,6 +401,31 @@ SLANG_API void spSetOptimizationLevel(
     request->setOptimizationLevel(level);
 }
 
+SLANG_API void spSetReportPerformance(
+    slang::ICompileRequest*    request,
+    bool                    enable)
+{
+    SLANG_ASSERT(request);
+    request->setReportPerformance(enable);
+}
+
+SLANG_API SlangResult spGetPerformanceReport(
+    slang::ICompileRequest*         request,
+    SlangPerformanceReportFormat    format,
+    ISlangBlob**                    outReport)
+{
+    SLANG_ASSERT(request);
+    return request->getPerformanceReport(format, outReport);
+}
+
+SLANG_API void spSetDownstreamCompileThreadCount(
+    slang::ICompileRequest*    request,
+    int                     count)
+{
+    SLANG_ASSERT(request);
+    request->setDownstreamCompileThreadCount(count);
+}
+
 SLANG_API void spSetOutputContainerFormat(
     slang::ICompileRequest*    request,
     SlangContainerFormat    format)
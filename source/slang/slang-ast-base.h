@@ -9,6 +9,8 @@
 
 #include "slang-serialize-reflection.h"
 
+#include <atomic>
+
 // This file defines the primary base classes for the hierarchy of
 // AST nodes and related objects. For example, this is where the
 // basic `Decl`, `Stmt`, `Expr`, `type`, etc. definitions come from.
@@ -26,10 +28,10 @@ class NodeBase
     {
         astNodeType = inAstNodeType;
 #ifdef _DEBUG
-        static uint32_t uidCounter = 0;
+        // Nodes can be created on multiple threads (see `ASTBuilder::enableSharedAccess`)
+        static std::atomic<uint32_t> uidCounter{0};
         static uint32_t breakValue = 0;
-        uidCounter++;
-        _debugUID = uidCounter;
+        _debugUID = ++uidCounter;
         if (breakValue != 0 && _debugUID == breakValue)
             SLANG_BREAKPOINT(0)
 #endif
@@ -148,6 +150,14 @@ class Val : public NodeBase
     bool _equalsValOverride(Val* val);
     void _toTextOverride(StringBuilder& out);
     HashCode _getHashCodeOverride();
+
+protected:
+    HashCode _computeHashCode();
+
+    SLANG_UNREFLECTED
+        /// The hash code, once it has been computed. 0 if it hasn't been (or happens to be 0).
+        /// Atomic as values (such as builtin types) can be shared between threads.
+    std::atomic<HashCode> m_hashCode{0};
 };
 
 struct ValSet
@@ -43,7 +43,7 @@ void SharedASTBuilder::init(Session* session)
         if (info)
         {
             m_sliceToTypeMap.Add(UnownedStringSlice(info->m_name), info);
-            Name* name = m_namePool->getName(String(info->m_name));
+            Name* name = m_namePool->getName(info->m_name);
             m_nameToTypeMap.Add(name, info);
         }
     }
@@ -81,74 +81,57 @@ SyntaxClass<NodeBase> SharedASTBuilder::findSyntaxClass(Name* name)
     return SyntaxClass<NodeBase>();
 }
 
-Type* SharedASTBuilder::getStringType()
+Type* SharedASTBuilder::_getOrCreateMagicDeclType(std::atomic<Type*>& ioType, const char* magicName)
 {
-    if (!m_stringType)
+    Type* type = ioType.load(std::memory_order_acquire);
+    if (!type)
     {
-        auto stringTypeDecl = findMagicDecl("StringType");
-        m_stringType = DeclRefType::create(m_astBuilder, makeDeclRef<Decl>(stringTypeDecl));
+        // The shared builder can be used from multiple threads once the standard library is loaded
+        ASTBuilder::SharedLock lock(m_astBuilder);
+        type = ioType.load(std::memory_order_relaxed);
+        if (!type)
+        {
+            auto decl = findMagicDecl(magicName);
+            type = DeclRefType::create(m_astBuilder, makeDeclRef<Decl>(decl));
+            ioType.store(type, std::memory_order_release);
+        }
     }
-    return m_stringType;
+    return type;
+}
+
+Type* SharedASTBuilder::getStringType()
+{
+    return _getOrCreateMagicDeclType(m_stringType, "StringType");
 }
 
 Type* SharedASTBuilder::getNativeStringType()
 {
-    if (!m_nativeStringType)
-    {
-        auto nativeStringTypeDecl = findMagicDecl("NativeStringType");
-        m_nativeStringType = DeclRefType::create(m_astBuilder, makeDeclRef<Decl>(nativeStringTypeDecl));
-    }
-    return m_nativeStringType;
+    return _getOrCreateMagicDeclType(m_nativeStringType, "NativeStringType");
 }
 
 Type* SharedASTBuilder::getEnumTypeType()
 {
-    if (!m_enumTypeType)
-    {
-        auto enumTypeTypeDecl = findMagicDecl("EnumTypeType");
-        m_enumTypeType = DeclRefType::create(m_astBuilder, makeDeclRef<Decl>(enumTypeTypeDecl));
-    }
-    return m_enumTypeType;
+    return _getOrCreateMagicDeclType(m_enumTypeType, "EnumTypeType");
 }
 
 Type* SharedASTBuilder::getDynamicType()
 {
-    if (!m_dynamicType)
-    {
-        auto dynamicTypeDecl = findMagicDecl("DynamicType");
-        m_dynamicType = DeclRefType::create(m_astBuilder, makeDeclRef<Decl>(dynamicTypeDecl));
-    }
-    return m_dynamicType;
+    return _getOrCreateMagicDeclType(m_dynamicType, "DynamicType");
 }
 
 Type* SharedASTBuilder::getNullPtrType()
 {
-    if (!m_nullPtrType)
-    {
-        auto nullPtrTypeDecl = findMagicDecl("NullPtrType");
-        m_nullPtrType = DeclRefType::create(m_astBuilder, makeDeclRef<Decl>(nullPtrTypeDecl));
-    }
-    return m_nullPtrType;
+    return _getOrCreateMagicDeclType(m_nullPtrType, "NullPtrType");
 }
 
 Type* SharedASTBuilder::getNoneType()
 {
-    if (!m_noneType)
-    {
-        auto noneTypeDecl = findMagicDecl("NoneType");
-        m_noneType = DeclRefType::create(m_astBuilder, makeDeclRef<Decl>(noneTypeDecl));
-    }
-    return m_noneType;
+    return _getOrCreateMagicDeclType(m_noneType, "NoneType");
 }
 
 Type* SharedASTBuilder::getDiffInterfaceType()
 {
-    if (!m_diffInterfaceType)
-    {
-        auto decl = findMagicDecl("DifferentiableType");
-        m_diffInterfaceType = DeclRefType::create(m_astBuilder, makeDeclRef<Decl>(decl));
-    }
-    return m_diffInterfaceType;
+    return _getOrCreateMagicDeclType(m_diffInterfaceType, "DifferentiableType");
 }
 
 SharedASTBuilder::~SharedASTBuilder()
@@ -225,6 +208,16 @@ ASTBuilder::ASTBuilder():
     m_name = "SharedASTBuilder::m_astBuilder";
 }
 
+void SharedASTBuilder::enableSharedAccess()
+{
+    m_astBuilder->enableSharedAccess();
+}
+
+void ASTBuilder::enableSharedAccess()
+{
+    m_sharedMutex = &m_sharedASTBuilder->m_sharedMutex;
+}
+
 ASTBuilder::~ASTBuilder()
 {
     for (NodeBase* node : m_dtorNodes)
@@ -407,9 +400,21 @@ Type* ASTBuilder::getAndType(Type* left, Type* right)
 
 Type* ASTBuilder::getModifiedType(Type* base, Count modifierCount, Val* const* modifiers)
 {
-    auto type = create<ModifiedType>();
-    type->base = base;
-    type->modifiers.addRange(modifiers, modifierCount);
+    // The type is filled in after it's created, so hold the lock for all of it
+    SharedLock lock(this);
+    NodeDesc desc;
+    desc.type = ModifiedType::kType;
+    desc.operands.add(base);
+    for (Index i = 0; i < modifierCount; ++i)
+    {
+        desc.operands.add(modifiers[i]);
+    }
+    auto type = (ModifiedType*)_getOrCreateImpl(desc, [this]() { return create<ModifiedType>(); });
+    if (!type->base)
+    {
+        type->base = base;
+        type->modifiers.addRange(modifiers, modifierCount);
+    }
     return type;
 }
 
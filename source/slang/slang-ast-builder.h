@@ -2,6 +2,8 @@
 #ifndef SLANG_AST_BUILDER_H
 #define SLANG_AST_BUILDER_H
 
+#include <atomic>
+#include <mutex>
 #include <type_traits>
 
 #include "slang-ast-support-types.h"
@@ -9,6 +11,7 @@
 
 #include "../core/slang-type-traits.h"
 #include "../core/slang-memory-arena.h"
+#include "../core/slang-flat-dictionary.h"
 
 namespace Slang
 {
@@ -61,11 +64,17 @@ public:
         /// Must be called before used
     void init(Session* session);
 
+        /// Allow the shared types to be created from multiple threads. See `ASTBuilder::enableSharedAccess`.
+    void enableSharedAccess();
+
     SharedASTBuilder();
 
     ~SharedASTBuilder();
 
 protected:
+        /// Get the type for the magic decl `magicName`, creating it if `ioType` isn't set yet
+    Type* _getOrCreateMagicDeclType(std::atomic<Type*>& ioType, const char* magicName);
+
     // State shared between ASTBuilders
 
     Type* m_errorType = nullptr;
@@ -81,13 +90,15 @@ protected:
     //
     // TODO(tfoley): These should really belong to the compilation context!
     //
-    Type* m_stringType = nullptr;
-    Type* m_nativeStringType = nullptr;
-    Type* m_enumTypeType = nullptr;
-    Type* m_dynamicType = nullptr;
-    Type* m_nullPtrType = nullptr;
-    Type* m_noneType = nullptr;
-    Type* m_diffInterfaceType = nullptr;
+    // They are atomic, as they can be created by any thread using the shared builder.
+    //
+    std::atomic<Type*> m_stringType = nullptr;
+    std::atomic<Type*> m_nativeStringType = nullptr;
+    std::atomic<Type*> m_enumTypeType = nullptr;
+    std::atomic<Type*> m_dynamicType = nullptr;
+    std::atomic<Type*> m_nullPtrType = nullptr;
+    std::atomic<Type*> m_noneType = nullptr;
+    std::atomic<Type*> m_diffInterfaceType = nullptr;
     Type* m_builtinTypes[Index(BaseType::CountOf)];
 
     Dictionary<String, Decl*> m_magicDecls;
@@ -102,7 +113,10 @@ protected:
     ASTBuilder* m_astBuilder = nullptr;
     Session* m_session = nullptr;
 
-    Index m_id = 1;
+    std::atomic<Index> m_id{1};
+
+    // Guards the ASTBuilders that are shared between threads
+    std::recursive_mutex m_sharedMutex;
 };
 
 class ASTBuilder : public RefObject
@@ -136,9 +150,37 @@ public:
         HashCode getHashCode() const;
     };
 
+        /// Holds the lock of a builder for a scope, if the builder is shared between threads.
+        /// The lock is recursive, as creating a node can create other nodes on the same builder.
+    class SharedLock
+    {
+    public:
+        SharedLock(ASTBuilder* builder)
+            : m_mutex(builder ? builder->m_sharedMutex : nullptr)
+        {
+            if (m_mutex)
+            {
+                m_mutex->lock();
+            }
+        }
+        ~SharedLock()
+        {
+            if (m_mutex)
+            {
+                m_mutex->unlock();
+            }
+        }
+    private:
+        SharedLock(const SharedLock&) = delete;
+        void operator=(const SharedLock&) = delete;
+
+        std::recursive_mutex* m_mutex;
+    };
+
     template<typename NodeCreateFunc>
     NodeBase* _getOrCreateImpl(NodeDesc const& desc, NodeCreateFunc createFunc)
     {
+        SharedLock lock(this);
         if (auto found = m_cachedNodes.TryGetValue(desc))
             return *found;
 
@@ -149,7 +191,7 @@ public:
 
     /// A cache for AST nodes that are entirely defined by their node type, with
     /// no need for additional state.
-    Dictionary<NodeDesc, NodeBase*> m_cachedNodes;
+    FlatDictionary<NodeDesc, NodeBase*> m_cachedNodes;
 
 public:
 
@@ -168,6 +210,7 @@ public:
     template <typename T>
     T* create()
     {
+        SharedLock lock(this);
         auto alloced = m_arena.allocate(sizeof(T));
         memset(alloced, 0, sizeof(T));
         return _initAndAdd(new (alloced) T);
@@ -176,6 +219,7 @@ public:
     template<typename T, typename... TArgs>
     T* create(TArgs... args)
     {
+        SharedLock lock(this);
         auto alloced = m_arena.allocate(sizeof(T));
         memset(alloced, 0, sizeof(T));
         return _initAndAdd(new (alloced) T(args...));
@@ -250,6 +294,8 @@ public:
 
     GenericSubstitution* getOrCreateGenericSubstitution(GenericDecl* decl, const List<Val*>& args, Substitutions* outer)
     {
+        // The substitution is filled in after it's created, so hold the lock for all of it
+        SharedLock lock(this);
         NodeDesc desc;
         desc.type = GenericSubstitution::kType;
         desc.operands.add(decl);
@@ -272,6 +318,7 @@ public:
 
     ThisTypeSubstitution* getOrCreateThisTypeSubstitution(InterfaceDecl* interfaceDecl, SubtypeWitness* subtypeWitness, Substitutions* outer)
     {
+        SharedLock lock(this);
         NodeDesc desc;
         desc.type = ThisTypeSubstitution::kType;
         desc.operands.add(interfaceDecl);
@@ -381,6 +428,18 @@ public:
         /// Get the shared AST builder
     SharedASTBuilder* getSharedASTBuilder() { return m_sharedASTBuilder; }
 
+        /// Allow nodes to be created on this builder from multiple threads.
+        ///
+        /// This is used for the builders holding the standard library, which is shared by all of the
+        /// linkages of a session. Nodes are still created on these builders after the standard library
+        /// is loaded (for example canonical types, or substitutions of standard library types), so
+        /// creating nodes and the caches of the builder are then guarded by a lock.
+    void enableSharedAccess();
+        /// Undo `enableSharedAccess`. Must only be called when no other thread can be using the builder.
+    void disableSharedAccess() { m_sharedMutex = nullptr; }
+        /// True if the builder may be used from multiple threads
+    bool isShared() const { return m_sharedMutex != nullptr; }
+
         /// Get the global session
     Session* getGlobalSession() { return m_sharedASTBuilder->m_session; }
 
@@ -422,6 +481,11 @@ protected:
 
     MemoryArena m_arena;
 
+        /// Set if the builder is shared between threads. All of the shared builders of a session use the
+        /// same mutex (held by the SharedASTBuilder), such that nodes can be created across them without
+        /// deadlocking.
+    std::recursive_mutex* m_sharedMutex = nullptr;
+
 };
 
 } // namespace Slang
@@ -319,7 +319,7 @@ struct ASTDumpContext
         m_writer->emit("NameLoc{");
         if (nameLoc.name)
         {
-            dump(nameLoc.name->text.getUnownedSlice());
+            dump(nameLoc.name->text);
         }
         else
         {
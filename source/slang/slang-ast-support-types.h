@@ -43,6 +43,7 @@ namespace Slang
     class SyntaxNode;
 
     class Decl;
+    class ContainerDecl;
     struct QualType;
     class Type;
     struct TypeExp;
@@ -206,7 +207,7 @@ namespace Slang
             Name* tokenName = token.getNameOrNull();
             if (tokenName)
             {
-                name = tokenName->text.getUnownedSlice();
+                name = tokenName->text;
             }
         }
     };
@@ -1386,6 +1387,9 @@ namespace Slang
         LookupMask          mask        = LookupMask::Default;
         LookupOptions       options     = LookupOptions::None;
 
+            /// If set, every container declaration searched for members is added to this list
+        List<ContainerDecl*>* searchedContainers = nullptr;
+
         bool isCompletionRequest() const { return ((int)options & (int)LookupOptions::Completion) != 0; }
     };
 
@@ -18,7 +18,15 @@ Type* Type::createCanonicalType()
 
 bool Type::equals(Type* type)
 {
-    return getCanonicalType()->equalsImpl(type->getCanonicalType());
+    Type* canType = getCanonicalType();
+    Type* otherCanType = type->getCanonicalType();
+
+    // Most types are deduplicated by the ASTBuilder, so equal types are usually the same node.
+    // Overload group and initializer list types are never equal, even to themselves.
+    if (canType == otherCanType && !dynamicCast<OverloadGroupType>(canType) && !dynamicCast<InitializerListType>(canType))
+        return true;
+
+    return canType->equalsImpl(otherCanType);
 }
 
 bool Type::equalsImpl(Type* type)
@@ -64,13 +72,27 @@ Val* Type::_substituteImplOverride(ASTBuilder* astBuilder, SubstitutionSet subst
 Type* Type::getCanonicalType()
 {
     Type* et = const_cast<Type*>(this);
+
+    // `canonicalType` is a reflected (and serialized) field, so it is a plain pointer rather than
+    // an atomic. The fences pair up, such that a thread seeing the pointer also sees the type.
+    Type* canType = et->canonicalType;
+    if (canType)
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return canType;
+    }
+
+    // Types of the standard library are shared between threads. Their canonical type is created
+    // on the (shared) builder of the type, so it is created and set holding the builder's lock.
+    ASTBuilder::SharedLock lock(et->m_astBuilder);
     if (!et->canonicalType)
     {
-        // TODO(tfoley): worry about thread safety here?
-        auto canType = et->createCanonicalType();
-        et->canonicalType = canType;
+        canType = et->createCanonicalType();
+        SLANG_ASSERT(canType);
 
-        SLANG_ASSERT(et->canonicalType);
+        // Make sure the canonical type is visible to other threads before the pointer to it
+        std::atomic_thread_fence(std::memory_order_release);
+        et->canonicalType = canType;
     }
     return et->canonicalType;
 }
@@ -23,6 +23,9 @@ Val* Val::substituteImpl(ASTBuilder* astBuilder, SubstitutionSet subst, int* ioD
 
 bool Val::equalsVal(Val* val)
 {
+    // Types have their own identity check, as some types are never equal (even to themselves).
+    if (val == this && !dynamicCast<Type>(this))
+        return true;
     SLANG_AST_NODE_VIRTUAL_CALL(Val, equalsVal, (val))
 }
 
@@ -39,6 +42,20 @@ String Val::toString()
 }
 
 HashCode Val::getHashCode()
+{
+    // Hashing is recursive over the structure of the value, and values are not changed once they
+    // are in use, so the hash is only computed once. Computing it is deterministic, so threads
+    // racing on a value shared between them store the same hash, and relaxed ordering is enough.
+    HashCode hashCode = m_hashCode.load(std::memory_order_relaxed);
+    if (hashCode == 0)
+    {
+        hashCode = _computeHashCode();
+        m_hashCode.store(hashCode, std::memory_order_relaxed);
+    }
+    return hashCode;
+}
+
+HashCode Val::_computeHashCode()
 {
     SLANG_AST_NODE_VIRTUAL_CALL(Val, getHashCode, ())
 }
@@ -1304,7 +1321,7 @@ HashCode FuncCallIntVal::_getHashCodeOverride()
 
 static bool nameIs(Name* name, const char* val)
 {
-    if (name && name->text.getUnownedSlice() == val)
+    if (name && name->text == val)
         return true;
     return false;
 }
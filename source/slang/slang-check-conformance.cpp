@@ -146,7 +146,9 @@ namespace Slang
                     m_astBuilder->getOrCreate<DeclaredSubtypeWitness>(
                         bb->sub, bb->sup, bb->declRef.decl, bb->declRef.substitutions.substitutions);
 
-                TransitiveSubtypeWitness* transitiveWitness = m_astBuilder->getOrCreateWithDefaultCtor<TransitiveSubtypeWitness>();
+                // The witness is filled in after it's created (`subToMid` is only known once the
+                // rest of the chain is built), so it can't be deduplicated.
+                TransitiveSubtypeWitness* transitiveWitness = m_astBuilder->create<TransitiveSubtypeWitness>();
                 transitiveWitness->sub = subType;
                 transitiveWitness->sup = bb->sup;
                 transitiveWitness->midToSup = declaredWitness;
@@ -276,6 +278,7 @@ namespace Slang
             else if( auto aggTypeDeclRef = declRef.as<AggTypeDecl>() )
             {
                 ensureDecl(aggTypeDeclRef, DeclCheckState::CanEnumerateBases);
+                getShared()->addSearchedContainer(aggTypeDeclRef.getDecl());
 
                 bool found = false;
                 foreachDirectOrExtensionMemberOfType<InheritanceDecl>(this, aggTypeDeclRef, [&](DeclRef<InheritanceDecl> const& inheritanceDeclRef)
@@ -350,6 +353,7 @@ namespace Slang
                 // satisfy the given interface..
                 auto genericDeclRef = genericTypeParamDeclRef.getParent().as<GenericDecl>();
                 SLANG_ASSERT(genericDeclRef);
+                getShared()->addSearchedContainer(genericDeclRef.getDecl());
 
                 for( auto constraintDeclRef : getMembersOfType<GenericTypeConstraintDecl>(genericDeclRef) )
                 {
@@ -497,11 +501,105 @@ namespace Slang
         return false;
     }
 
+        /// True if `type` only involves declarations from the standard library
+    static bool _isStdlibOnlyType(Type* type)
+    {
+        auto declRefType = as<DeclRefType>(type);
+        if (!declRefType || !isFromStdLib(declRefType->declRef.getDecl()))
+            return false;
+
+        for (auto subst = declRefType->declRef.substitutions.substitutions; subst; subst = subst->outer)
+        {
+            auto genericSubst = as<GenericSubstitution>(subst);
+            if (!genericSubst)
+                return false;
+
+            for (auto arg : genericSubst->getArgs())
+            {
+                if (as<ConstantIntVal>(arg))
+                    continue;
+                auto argType = as<Type>(arg);
+                if (!argType || !_isStdlibOnlyType(argType))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    bool SemanticsVisitor::_findSubtypeWitness(
+        Type*                   subType,
+        DeclRef<AggTypeDecl>    superTypeDeclRef,
+        Val**                   outWitness)
+    {
+        // Only subtypes that are declared types are cached, as those are the
+        // ones whose conformances are expensive to find, and can be compared
+        // cheaply.
+        //
+        auto declRefType = as<DeclRefType>(subType);
+        if (!declRefType)
+        {
+            return _isDeclaredSubtype(subType, subType, superTypeDeclRef, outWitness, nullptr);
+        }
+
+        SubtypeWitnessCacheKey key;
+        key.sub = declRefType;
+        key.sup = superTypeDeclRef;
+
+        // Questions that only involve standard library types have the same
+        // answer for every module (unless a module extends the types), so the
+        // answers can be shared.
+        //
+        const bool isStdlibOnly = isFromStdLib(superTypeDeclRef.getDecl()) && _isStdlibOnlyType(declRefType);
+
+        auto shared = getShared();
+        if (auto entry = shared->findCachedSubtypeWitness(key, isStdlibOnly))
+        {
+            // The containers searched for the cached answer were also (in effect)
+            // searched for any question currently being answered.
+            //
+            shared->addSearchedContainers(entry->searchedContainers);
+
+            if (outWitness)
+            {
+                *outWitness = entry->witness;
+            }
+            return entry->witness != nullptr;
+        }
+
+        // Searching can cause declarations to be checked, which can register new
+        // extensions. If that happens, the answer may not have seen all of them.
+        //
+        const Count invalidationCount = shared->getLookupCacheStats().invalidationCount;
+
+        List<ContainerDecl*> searchedContainers;
+        auto outerSearchedContainers = shared->setSearchedContainers(&searchedContainers);
+
+        Val* witness = nullptr;
+        _isDeclaredSubtype(subType, subType, superTypeDeclRef, &witness, nullptr);
+
+        shared->setSearchedContainers(outerSearchedContainers);
+        shared->addSearchedContainers(searchedContainers);
+
+        // If the question was asked while the bases of a type it searched were
+        // being checked, the answer may be incomplete, so it can't be reused.
+        //
+        if (shared->canCacheSearch(searchedContainers, invalidationCount))
+        {
+            shared->addCachedSubtypeWitness(key, isStdlibOnly, witness, searchedContainers);
+        }
+
+        if (outWitness)
+        {
+            *outWitness = witness;
+        }
+        return witness != nullptr;
+    }
+
     bool SemanticsVisitor::isDeclaredSubtype(
         Type*            subType,
         DeclRef<AggTypeDecl>    superTypeDeclRef)
     {
-        return _isDeclaredSubtype(subType, subType, superTypeDeclRef, nullptr, nullptr);
+        return _findSubtypeWitness(subType, superTypeDeclRef, nullptr);
     }
 
     bool SemanticsVisitor::isDeclaredSubtype(
@@ -511,7 +609,7 @@ namespace Slang
         if (auto declRefType = as<DeclRefType>(superType))
         {
             if (auto aggTypeDeclRef = declRefType->declRef.as<AggTypeDecl>())
-                return _isDeclaredSubtype(subType, subType, aggTypeDeclRef, nullptr, nullptr);
+                return _findSubtypeWitness(subType, aggTypeDeclRef, nullptr);
         }
         return false;
     }
@@ -536,7 +634,7 @@ namespace Slang
         DeclRef<AggTypeDecl>    superTypeDeclRef)
     {
         Val* result = nullptr;
-        _isDeclaredSubtype(subType, subType, superTypeDeclRef, &result, nullptr);
+        _findSubtypeWitness(subType, superTypeDeclRef, &result);
         return result;
     }
 
@@ -628,6 +628,9 @@ namespace Slang
         GenericDecl*            genericDecl,
         Substitutions*   outerSubst)
     {
+        // The cache is on the builder, which may be shared between threads
+        ASTBuilder::SharedLock lock(astBuilder);
+
         GenericSubstitution* cachedResult = nullptr;
         if (astBuilder->m_genericDefaultSubst.TryGetValue(genericDecl, cachedResult))
         {
@@ -2310,10 +2313,11 @@ namespace Slang
                 auto satisfyingConstraintDeclRef = satisfyingMemberDeclRef.as<GenericTypeConstraintDecl>();
                 SLANG_ASSERT(satisfyingConstraintDeclRef);
 
-                auto satisfyingWitness = m_astBuilder->getOrCreate<DeclaredSubtypeWitness>();
-                satisfyingWitness->sub = getSub(m_astBuilder, satisfyingConstraintDeclRef);
-                satisfyingWitness->sup = getSup(m_astBuilder, satisfyingConstraintDeclRef);
-                satisfyingWitness->declRef = satisfyingConstraintDeclRef;
+                auto satisfyingWitness = m_astBuilder->getOrCreate<DeclaredSubtypeWitness>(
+                    getSub(m_astBuilder, satisfyingConstraintDeclRef),
+                    getSup(m_astBuilder, satisfyingConstraintDeclRef),
+                    satisfyingConstraintDeclRef.getDecl(),
+                    satisfyingConstraintDeclRef.substitutions.substitutions);
 
                 requiredSubstArgs.add(satisfyingWitness);
             }
@@ -2618,7 +2622,7 @@ namespace Slang
         synFuncDecl->nameAndLoc = requiredMemberDeclRef.getDecl()->nameAndLoc;
         if (synFuncDecl->nameAndLoc.name)
         {
-            synFuncDecl->nameAndLoc.name = getSession()->getNameObj("$__syn_" + synFuncDecl->nameAndLoc.name->text);
+            synFuncDecl->nameAndLoc.name = getSession()->getNameObj("$__syn_" + getText(synFuncDecl->nameAndLoc.name));
         }
         // The result type of our synthesized method will be the expected
         // result type from the interface requirement.
@@ -3564,7 +3568,7 @@ namespace Slang
                     requiredInheritanceDeclRef.substitutions.substitutions);
             // ...
 
-            TransitiveSubtypeWitness* subIsReqWitness = m_astBuilder->getOrCreateWithDefaultCtor<TransitiveSubtypeWitness>(subType, reqType, interfaceIsReqWitness);
+            TransitiveSubtypeWitness* subIsReqWitness = m_astBuilder->getOrCreateWithDefaultCtor<TransitiveSubtypeWitness>(subType, reqType, subTypeConformsToSuperInterfaceWitness, interfaceIsReqWitness);
             subIsReqWitness->sub = subType;
             subIsReqWitness->sup = reqType;
             subIsReqWitness->subToMid = subTypeConformsToSuperInterfaceWitness;
@@ -6333,6 +6337,11 @@ namespace Slang
         importedModulesList.add(moduleDecl);
         importedModulesSet.Add(moduleDecl);
 
+        // Extensions in the imported module may apply to types that have
+        // already been looked up in.
+        //
+        getShared()->invalidateLookupCaches();
+
         // Create a new sub-scope to wire the module
         // into our lookup chain.
         auto subScope = getASTBuilder()->create<Scope>();
@@ -6462,6 +6471,71 @@ namespace Slang
         return entry->candidateExtensions;
     }
 
+    void SharedSemanticsContext::_buildCandidateExtensionLists()
+    {
+        if( m_candidateExtensionListsBuilt )
+            return;
+
+        m_candidateExtensionListsBuilt = true;
+
+        // We need to make sure that all extensions that were declared
+        // as part of our standard-library modules are always visible,
+        // even if they are not explicit `import`ed into user code.
+        //
+        for( auto module : getSession()->stdlibModules )
+        {
+            _addCandidateExtensionsFromModule(module->getModuleDecl());
+        }
+
+        // There are two primary modes in which the `SharedSemanticsContext`
+        // gets used.
+        //
+        // In the first mode, we are checking an entire `ModuelDecl`, and we
+        // need to always check things from the "point of view" of that module
+        // (so that the extensions that should be visible are based on what
+        // that module can access via `import`s).
+        //
+        // In the second mode, we are checking code related to API interactions
+        // by the user (e.g., parsing a type from a string, specializing an
+        // entry point to type arguments, etc.). In these cases there is no
+        // clear module that should determine the point of view for looking
+        // up extensions, and we instead need/want to consider any extensions
+        // from all modules loaded into the linkage.
+        //
+        // We differentiate these cases based on whether a "primary" module
+        // was set at the time the `SharedSemanticsContext` was constructed.
+        //
+        if( m_module )
+        {
+            // We have a "primary" module that is being checked, and we should
+            // look up extensions based on what would be visible to that
+            // module.
+            //
+            // We need to consider the extensions declared in the module itself,
+            // along with everything the module imported.
+            //
+            // Note: there is an implicit assumption here that the `importedModules`
+            // member on the `SharedSemanticsContext` is accurate in this case.
+            //
+            _addCandidateExtensionsFromModule(m_module->getModuleDecl());
+            for( auto moduleDecl : this->importedModulesList )
+            {
+                _addCandidateExtensionsFromModule(moduleDecl);
+            }
+        }
+        else
+        {
+            // We are in one of the many ad hoc checking modes where we really
+            // want to resolve things based on the totality of what is
+            // available/defined within the current linkage.
+            //
+            for( auto module : m_linkage->loadedModulesList )
+            {
+                _addCandidateExtensionsFromModule(module->getModuleDecl());
+            }
+        }
+    }
+
     List<ExtensionDecl*> const& SharedSemanticsContext::getCandidateExtensionsForTypeDecl(AggTypeDecl* decl)
     {
         // We are caching the lists of candidate extensions on the shared
@@ -6475,67 +6549,7 @@ namespace Slang
         // thing down. For now this potentially-quadratic behavior is acceptable
         // because there just aren't that many extension declarations being used.
         //
-        if( !m_candidateExtensionListsBuilt )
-        {
-            m_candidateExtensionListsBuilt = true;
-
-            // We need to make sure that all extensions that were declared
-            // as part of our standard-library modules are always visible,
-            // even if they are not explicit `import`ed into user code.
-            //
-            for( auto module : getSession()->stdlibModules )
-            {
-                _addCandidateExtensionsFromModule(module->getModuleDecl());
-            }
-
-            // There are two primary modes in which the `SharedSemanticsContext`
-            // gets used.
-            //
-            // In the first mode, we are checking an entire `ModuelDecl`, and we
-            // need to always check things from the "point of view" of that module
-            // (so that the extensions that should be visible are based on what
-            // that module can access via `import`s).
-            //
-            // In the second mode, we are checking code related to API interactions
-            // by the user (e.g., parsing a type from a string, specializing an
-            // entry point to type arguments, etc.). In these cases there is no
-            // clear module that should determine the point of view for looking
-            // up extensions, and we instead need/want to consider any extensions
-            // from all modules loaded into the linkage.
-            //
-            // We differentiate these cases based on whether a "primary" module
-            // was set at the time the `SharedSemanticsContext` was constructed.
-            //
-            if( m_module )
-            {
-                // We have a "primary" module that is being checked, and we should
-                // look up extensions based on what would be visible to that
-                // module.
-                //
-                // We need to consider the extensions declared in the module itself,
-                // along with everything the module imported.
-                //
-                // Note: there is an implicit assumption here that the `importedModules`
-                // member on the `SharedSemanticsContext` is accurate in this case.
-                //
-                _addCandidateExtensionsFromModule(m_module->getModuleDecl());
-                for( auto moduleDecl : this->importedModulesList )
-                {
-                    _addCandidateExtensionsFromModule(moduleDecl);
-                }
-            }
-            else
-            {
-                // We are in one of the many ad hoc checking modes where we really
-                // want to resolve things based on the totality of what is
-                // available/defined within the current linkage.
-                //
-                for( auto module : m_linkage->loadedModulesList )
-                {
-                    _addCandidateExtensionsFromModule(module->getModuleDecl());
-                }
-            }
-        }
+        _buildCandidateExtensionLists();
 
         // Once we are sure that the dictionary-of-arrays of extensions
         // has been populated, we return to the user the entry they
@@ -6568,14 +6582,256 @@ namespace Slang
         //
         m_candidateExtensionListsBuilt = false;
         m_mapTypeDeclToCandidateExtensions.Clear();
+        m_stdlibTypesWithUserExtensions.Clear();
+
+        // Any cached member lookup or subtype answer may have needed to
+        // search the new extension.
+        //
+        invalidateLookupCaches();
+    }
+
+    void SearchedContainerList::set(const List<ContainerDecl*>& containers)
+    {
+        m_memberCounts.clear();
+        for (auto containerDecl : containers)
+        {
+            m_memberCounts.add(KeyValuePair<ContainerDecl*, Index>(containerDecl, containerDecl->members.getCount()));
+        }
+    }
+
+    void SearchedContainerList::addTo(List<ContainerDecl*>& outContainers) const
+    {
+        for (const auto& pair : m_memberCounts)
+        {
+            outContainers.add(pair.Key);
+        }
+    }
+
+    bool SearchedContainerList::isUnchanged() const
+    {
+        for (const auto& pair : m_memberCounts)
+        {
+            ContainerDecl* containerDecl = pair.Key;
+            if (containerDecl->members.getCount() != pair.Value || !containerDecl->isMemberDictionaryValid())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool SharedSemanticsContext::canCacheSearch(const List<ContainerDecl*>& searchedContainers, Count invalidationCount) const
+    {
+        if (m_lookupCacheStats.invalidationCount != invalidationCount)
+        {
+            return false;
+        }
+        for (auto containerDecl : searchedContainers)
+        {
+            if (as<AggTypeDecl>(containerDecl) && !containerDecl->isChecked(DeclCheckState::CanEnumerateBases))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const SharedSemanticsContext::MemberLookupCacheEntry* SharedSemanticsContext::findCachedMemberLookup(const MemberLookupCacheKey& key)
+    {
+        auto entry = m_memberLookupCache.TryGetValue(key);
+        if (entry && !entry->searchedContainers.isUnchanged())
+        {
+            m_memberLookupCache.Remove(key);
+            entry = nullptr;
+        }
+
+        if (!entry)
+        {
+            m_lookupCacheStats.memberLookupMissCount++;
+            return nullptr;
+        }
+
+        m_lookupCacheStats.memberLookupHitCount++;
+        return entry;
+    }
+
+    void SharedSemanticsContext::addCachedMemberLookup(const MemberLookupCacheKey& key, const LookupResult& result, const List<ContainerDecl*>& searchedContainers)
+    {
+        MemberLookupCacheEntry entry;
+        entry.result = result;
+        entry.searchedContainers.set(searchedContainers);
+        m_memberLookupCache[key] = _Move(entry);
+    }
+
+    bool SharedSemanticsContext::_isSameForAllModules(const SubtypeWitnessCacheEntry& entry)
+    {
+        // An answer that only involves standard library types can still depend on the module,
+        // if the module can see an extension of one of the types from outside the standard
+        // library.
+        //
+        _buildCandidateExtensionLists();
+        if (m_stdlibTypesWithUserExtensions.Count() == 0)
+        {
+            return true;
+        }
+        for (const auto& pair : entry.searchedContainers.m_memberCounts)
+        {
+            if (m_stdlibTypesWithUserExtensions.Contains(pair.Key))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const SubtypeWitnessCacheEntry* SharedSemanticsContext::findCachedSubtypeWitness(const SubtypeWitnessCacheKey& key, bool isStdlibOnly)
+    {
+        if (auto entry = m_subtypeWitnessCache.TryGetValue(key))
+        {
+            if (entry->searchedContainers.isUnchanged())
+            {
+                m_lookupCacheStats.subtypeWitnessHitCount++;
+                return entry;
+            }
+            m_subtypeWitnessCache.Remove(key);
+        }
+
+        if (isStdlibOnly)
+        {
+            // Answers found while checking the standard library are held by the session, and
+            // are never changed once the standard library has been loaded.
+            //
+            TypeCheckingCache* caches[] =
+            {
+                m_linkage->getTypeCheckingCache(),
+                getSession()->getStdlibTypeCheckingCache(),
+            };
+            for (auto cache : caches)
+            {
+                if (!cache)
+                    continue;
+
+                auto entry = cache->stdlibSubtypeWitnessCache.TryGetValue(key);
+                if (entry && entry->searchedContainers.isUnchanged() && _isSameForAllModules(*entry))
+                {
+                    m_lookupCacheStats.subtypeWitnessHitCount++;
+                    m_lookupCacheStats.subtypeWitnessSharedHitCount++;
+                    return entry;
+                }
+            }
+        }
+
+        m_lookupCacheStats.subtypeWitnessMissCount++;
+        return nullptr;
+    }
+
+    void SharedSemanticsContext::addCachedSubtypeWitness(const SubtypeWitnessCacheKey& key, bool isStdlibOnly, Val* witness, const List<ContainerDecl*>& searchedContainers)
+    {
+        SubtypeWitnessCacheEntry entry;
+        entry.witness = witness;
+        entry.searchedContainers.set(searchedContainers);
+
+        if (isStdlibOnly && _isSameForAllModules(entry))
+        {
+            m_linkage->getTypeCheckingCache()->stdlibSubtypeWitnessCache[key] = _Move(entry);
+        }
+        else
+        {
+            m_subtypeWitnessCache[key] = _Move(entry);
+        }
+    }
+
+    bool CallOverloadCacheKey::operator==(const CallOverloadCacheKey& rhs) const
+    {
+        if (exprType != rhs.exprType ||
+            leftValueMask != rhs.leftValueMask ||
+            callees.getCount() != rhs.callees.getCount() ||
+            argTypes.getCount() != rhs.argTypes.getCount())
+        {
+            return false;
+        }
+        if (baseType != rhs.baseType && (!baseType || !rhs.baseType || !baseType->equals(rhs.baseType)))
+        {
+            return false;
+        }
+        for (Index i = 0; i < callees.getCount(); ++i)
+        {
+            if (!callees[i].equals(rhs.callees[i]))
+                return false;
+        }
+        for (Index i = 0; i < argTypes.getCount(); ++i)
+        {
+            if (argTypes[i] != rhs.argTypes[i] && !argTypes[i]->equals(rhs.argTypes[i]))
+                return false;
+        }
+        return true;
     }
-    
+
+    HashCode CallOverloadCacheKey::getHashCode() const
+    {
+        HashCode hash = combineHash(HashCode(exprType), HashCode(leftValueMask));
+        for (const auto& callee : callees)
+        {
+            hash = combineHash(hash, callee.getHashCode());
+        }
+        if (baseType)
+        {
+            hash = combineHash(hash, baseType->getHashCode());
+        }
+        for (auto argType : argTypes)
+        {
+            hash = combineHash(hash, argType->getHashCode());
+        }
+        return hash;
+    }
+
+    const CallOverloadCacheEntry* SharedSemanticsContext::findCachedCallOverload(const CallOverloadCacheKey& key)
+    {
+        auto entry = m_callOverloadCache.TryGetValue(key);
+        if (entry && !entry->searchedContainers.isUnchanged())
+        {
+            m_callOverloadCache.Remove(key);
+            entry = nullptr;
+        }
+
+        if (!entry)
+        {
+            m_lookupCacheStats.callOverloadMissCount++;
+            return nullptr;
+        }
+
+        m_lookupCacheStats.callOverloadHitCount++;
+        return entry;
+    }
+
+    void SharedSemanticsContext::addCachedCallOverload(const CallOverloadCacheKey& key, const OverloadCandidate& candidate, const List<ContainerDecl*>& searchedContainers)
+    {
+        CallOverloadCacheEntry entry;
+        entry.candidate = candidate;
+        entry.searchedContainers.set(searchedContainers);
+        m_callOverloadCache[key] = _Move(entry);
+    }
+
+    void SharedSemanticsContext::invalidateLookupCaches()
+    {
+        m_memberLookupCache.Clear();
+        m_subtypeWitnessCache.Clear();
+        m_callOverloadCache.Clear();
+        m_lookupCacheStats.invalidationCount++;
+    }
+
     void SharedSemanticsContext::_addCandidateExtensionsFromModule(ModuleDecl* moduleDecl)
     {
+        const bool isStdlibModule = isFromStdLib(moduleDecl);
         for( auto& entry : moduleDecl->mapTypeToCandidateExtensions )
         {
             auto& list = _getCandidateExtensionList(entry.Key, m_mapTypeDeclToCandidateExtensions);
             list.addRange(entry.Value->candidateExtensions);
+
+            if( !isStdlibModule && isFromStdLib(entry.Key) )
+            {
+                m_stdlibTypesWithUserExtensions.Add(entry.Key);
+            }
         }
     }
 
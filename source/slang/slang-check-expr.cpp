@@ -2859,7 +2859,7 @@ namespace Slang
             suggestions.elementCount[1] = baseElementColCount;
         }
 
-        String swizzleText = getText(memberRefExpr->name);
+        const UnownedTerminatedStringSlice swizzleText = memberRefExpr->name->text;
         auto cursor = swizzleText.begin();
 
         // The contents of the string are 0-terminated
@@ -3031,7 +3031,7 @@ namespace Slang
             suggestions.elementCount[0] = baseElementCount;
             suggestions.elementCount[1] = 0;
         }
-        auto swizzleText = getText(memberRefExpr->name);
+        auto swizzleText = getUnownedStringSliceText(memberRefExpr->name);
 
         for (Index i = 0; i < swizzleText.getLength(); i++)
         {
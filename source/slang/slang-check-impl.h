@@ -213,10 +213,96 @@ namespace Slang
         Substitutions*   subst = nullptr;
     };
 
+        /// A list of containers searched by a lookup, along with their member counts at the time.
+        /// Checking can add members to a container after it has been searched (for example when
+        /// synthesizing the requirements of an interface), so results of a lookup can only be
+        /// reused if none of the containers have changed.
+    struct SearchedContainerList
+    {
+            /// Set from the current member counts of `containers`
+        void set(const List<ContainerDecl*>& containers);
+            /// Add the searched containers to `outContainers`
+        void addTo(List<ContainerDecl*>& outContainers) const;
+            /// True if no container has had members added or removed since `set`
+        bool isUnchanged() const;
+
+        List<KeyValuePair<ContainerDecl*, Index>> m_memberCounts;
+    };
+
+        /// Identifies the question "is `sub` a subtype of `sup`, and what is the witness" for the
+        /// subtype witness caches. `sub` is a canonical `DeclRefType`, and keys are equal if their types are.
+    struct SubtypeWitnessCacheKey
+    {
+        DeclRefType* sub = nullptr;
+        DeclRef<AggTypeDecl> sup;
+
+        bool operator==(const SubtypeWitnessCacheKey& rhs) const
+        {
+            return sup.equals(rhs.sup) && (sub == rhs.sub || sub->equals(rhs.sub));
+        }
+        HashCode getHashCode() const
+        {
+            return combineHash(sub->getHashCode(), sup.getHashCode());
+        }
+    };
+
+        /// A cached answer to a subtype question. `witness` is nullptr if `sub` is not a subtype of `sup`.
+    struct SubtypeWitnessCacheEntry
+    {
+        Val* witness = nullptr;
+        SearchedContainerList searchedContainers;
+    };
+
+        /// A cached resolution of a call. `candidate` is the unique applicable candidate.
+    struct CallOverloadCacheEntry
+    {
+        OverloadCandidate candidate;
+        SearchedContainerList searchedContainers;
+    };
+
     struct TypeCheckingCache
     {
         Dictionary<OperatorOverloadCacheKey, OverloadCandidate> resolvedOperatorOverloadCache;
         Dictionary<BasicTypeKeyPair, ConversionCost> conversionCostCache;
+
+            /// Answers to subtype questions that only involve standard library types, so are the same
+            /// for every module. See `SharedSemanticsContext::findCachedSubtypeWitness`.
+        Dictionary<SubtypeWitnessCacheKey, SubtypeWitnessCacheEntry> stdlibSubtypeWitnessCache;
+    };
+
+        /// Identifies a lookup of a member `name` in `type`, for `SharedSemanticsContext`'s member lookup cache.
+        /// `type` is a canonical `DeclRefType`, and keys are equal if their types are.
+    struct MemberLookupCacheKey
+    {
+        DeclRefType* type = nullptr;
+        Name* name = nullptr;
+        LookupMask mask = LookupMask::Default;
+        LookupOptions options = LookupOptions::None;
+
+        bool operator==(const MemberLookupCacheKey& rhs) const
+        {
+            return name == rhs.name && mask == rhs.mask && options == rhs.options &&
+                (type == rhs.type || type->equals(rhs.type));
+        }
+        HashCode getHashCode() const
+        {
+            return combineHash(type->getHashCode(), Slang::getHashCode(name), HashCode((int(mask) << 8) | int(options)));
+        }
+    };
+
+        /// Identifies a call for `SharedSemanticsContext`'s call overload cache: the kind of call expression,
+        /// the declarations being called, and the canonical types of the base expression (if any) and arguments.
+        /// Keys are equal if their types are.
+    struct CallOverloadCacheKey
+    {
+        ASTNodeType exprType = ASTNodeType(0);
+        List<DeclRef<Decl>> callees;
+        DeclRefType* baseType = nullptr;
+        List<DeclRefType*> argTypes;
+        uint32_t leftValueMask = 0;             ///< Bit 0 is set if the base is an l-value, bit n + 1 if argument n is
+
+        bool operator==(const CallOverloadCacheKey& rhs) const;
+        HashCode getHashCode() const;
     };
 
         /// Shared state for a semantics-checking session.
@@ -289,6 +375,86 @@ namespace Slang
 
         List<RefPtr<DeclAssociation>> const& getAssociatedDeclsForDecl(Decl* decl);
 
+        struct LookupCacheStats
+        {
+            Count memberLookupHitCount = 0;         ///< Member lookups answered from the cache
+            Count memberLookupMissCount = 0;        ///< Member lookups that had to be performed
+            Count subtypeWitnessHitCount = 0;       ///< Subtype questions answered from a cache
+            Count subtypeWitnessSharedHitCount = 0; ///< The part of `subtypeWitnessHitCount` answered from caches shared by all modules
+            Count subtypeWitnessMissCount = 0;      ///< Subtype questions that had to be answered by searching
+            Count callOverloadHitCount = 0;         ///< Calls whose overload resolution was read from the cache
+            Count callOverloadMissCount = 0;        ///< Calls that had to be resolved
+            Count overloadCandidateSkipCount = 0;   ///< Overload candidates skipped as they can't be applicable
+            Count invalidationCount = 0;            ///< Times the caches of this context were discarded
+        };
+
+        struct MemberLookupCacheEntry
+        {
+            LookupResult result;
+            SearchedContainerList searchedContainers;
+        };
+
+            /// Find the cached result of the member lookup `key`.
+            /// Returns nullptr if there isn't one, or if any container it searched has had members added since.
+        const MemberLookupCacheEntry* findCachedMemberLookup(const MemberLookupCacheKey& key);
+            /// Cache `result` of the member lookup `key`, which searched the members of `searchedContainers`
+        void addCachedMemberLookup(const MemberLookupCacheKey& key, const LookupResult& result, const List<ContainerDecl*>& searchedContainers);
+
+            /// Find the cached answer to the subtype question `key`.
+            /// If `isStdlibOnly` (all the types involved are from the standard library), answers shared by all
+            /// modules of the linkage, and those found while checking the standard library, are also used.
+            /// Returns nullptr if there isn't an answer, or if any container searched for it has changed since.
+        const SubtypeWitnessCacheEntry* findCachedSubtypeWitness(const SubtypeWitnessCacheKey& key, bool isStdlibOnly);
+            /// Cache the answer `witness` (nullptr if not a subtype) to the subtype question `key`
+        void addCachedSubtypeWitness(const SubtypeWitnessCacheKey& key, bool isStdlibOnly, Val* witness, const List<ContainerDecl*>& searchedContainers);
+
+            /// Find the cached resolution of the call `key`.
+            /// Returns nullptr if there isn't one, or if any container searched for it has changed since.
+        const CallOverloadCacheEntry* findCachedCallOverload(const CallOverloadCacheKey& key);
+            /// Cache `candidate` as the resolution of the call `key`
+        void addCachedCallOverload(const CallOverloadCacheKey& key, const OverloadCandidate& candidate, const List<ContainerDecl*>& searchedContainers);
+
+            /// Record that `count` overload candidates were skipped without being checked
+        void addSkippedOverloadCandidates(Count count) { m_lookupCacheStats.overloadCandidateSkipCount += count; }
+
+            /// Set the list containers searched for the answer currently being found (such as to a subtype
+            /// question, or a call resolution) are added to. Returns the previous list.
+        List<ContainerDecl*>* setSearchedContainers(List<ContainerDecl*>* containers)
+        {
+            auto previous = m_searchedContainers;
+            m_searchedContainers = containers;
+            return previous;
+        }
+            /// Record that `containerDecl` was searched for the current answer
+        void addSearchedContainer(ContainerDecl* containerDecl)
+        {
+            if (m_searchedContainers)
+                m_searchedContainers->add(containerDecl);
+        }
+            /// Record that `containers` were searched for the current answer
+        void addSearchedContainers(const SearchedContainerList& containers)
+        {
+            if (m_searchedContainers)
+                containers.addTo(*m_searchedContainers);
+        }
+        void addSearchedContainers(const List<ContainerDecl*>& containers)
+        {
+            if (m_searchedContainers)
+                m_searchedContainers->addRange(containers);
+        }
+
+            /// True if an answer found by searching `searchedContainers` can be cached. `invalidationCount` is
+            /// the invalidation count from before the search.
+            /// An answer can't be cached if the caches were invalidated during the search, or if a type searched
+            /// was still having its bases checked (and so the answer may be incomplete).
+        bool canCacheSearch(const List<ContainerDecl*>& searchedContainers, Count invalidationCount) const;
+
+            /// Discard all cached lookups, subtype answers and call resolutions of this context.
+            /// Needed when the extensions visible to lookup may have changed.
+        void invalidateLookupCaches();
+
+        const LookupCacheStats& getLookupCacheStats() const { return m_lookupCacheStats; }
+
         bool isDifferentiableFunc(FunctionDeclBase* func);
         bool isBackwardDifferentiableFunc(FunctionDeclBase* func);
         FunctionDifferentiableLevel _getFuncDifferentiableLevelImpl(FunctionDeclBase* func, int recurseLimit);
@@ -314,6 +480,32 @@ namespace Slang
             /// Add associated decls declared in `moduleDecl` to `m_mapDeclToAssociatedDecls`
         void _addDeclAssociationsFromModule(ModuleDecl* moduleDecl);
 
+            /// Build `m_mapTypeDeclToCandidateExtensions` if it isn't valid
+        void _buildCandidateExtensionLists();
+
+            /// True if none of the containers searched for `entry` are standard library types extended by
+            /// code outside of the standard library, so that the entry is the same for every module
+        bool _isSameForAllModules(const SubtypeWitnessCacheEntry& entry);
+
+            /// Standard library types that have extensions declared outside of the standard library.
+            /// Built along with `m_mapTypeDeclToCandidateExtensions`.
+        HashSet<ContainerDecl*> m_stdlibTypesWithUserExtensions;
+
+            /// Results of `lookUpMember`, which are valid for as long as the visible extensions
+            /// and the members of the searched containers don't change
+        Dictionary<MemberLookupCacheKey, MemberLookupCacheEntry> m_memberLookupCache;
+
+            /// Answers to subtype questions, with the same validity as `m_memberLookupCache`
+        Dictionary<SubtypeWitnessCacheKey, SubtypeWitnessCacheEntry> m_subtypeWitnessCache;
+
+            /// Resolutions of calls, with the same validity as `m_memberLookupCache`
+        Dictionary<CallOverloadCacheKey, CallOverloadCacheEntry> m_callOverloadCache;
+
+            /// Where containers searched for the current answer are added, or nullptr
+        List<ContainerDecl*>* m_searchedContainers = nullptr;
+
+        LookupCacheStats m_lookupCacheStats;
+
     };
 
         /// Local/scoped state of the semantic-checking system
@@ -1428,6 +1620,14 @@ namespace Slang
             Val**            outWitness,
             TypeWitnessBreadcrumb*  inBreadcrumbs);
 
+            /// Check whether `subType` is a sub-type of `superTypeDeclRef`, using the subtype witness
+            /// caches of the shared context where possible. If it is, `outWitness` (if set) is set
+            /// to a witness to the relationship.
+        bool _findSubtypeWitness(
+            Type*                   subType,
+            DeclRef<AggTypeDecl>    superTypeDeclRef,
+            Val**                   outWitness);
+
             /// Check whether `subType` is a sub-type of `superTypeDeclRef`.
         bool isDeclaredSubtype(
             Type*            subType,
@@ -1765,6 +1965,12 @@ namespace Slang
             LookupResultItem		item,
             OverloadResolveContext&	context);
 
+            /// Is the callable `item` certainly not applicable to the arguments of `context`?
+            /// Only checks that don't need `item` to be checked are made.
+        bool isCertainlyNotApplicable(
+            LookupResultItem const& item,
+            OverloadResolveContext& context);
+
         void AddOverloadCandidates(
             LookupResult const&     result,
             OverloadResolveContext&	context);
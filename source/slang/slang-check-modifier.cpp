@@ -154,7 +154,7 @@ namespace Slang
         // If the attribute was `[Something(...)]` then we will
         // look for a `struct` named `SomethingAttribute`.
         //
-        LookupResult lookupResult = lookUp(m_astBuilder, this, m_astBuilder->getGlobalSession()->getNameObj(attributeName->text + "Attribute"), scope, LookupMask::type);
+        LookupResult lookupResult = lookUp(m_astBuilder, this, m_astBuilder->getGlobalSession()->getNameObj(getText(attributeName) + "Attribute"), scope, LookupMask::type);
         //
         // If we didn't find a matching type name, then we give up.
         //
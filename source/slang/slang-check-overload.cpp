@@ -1446,12 +1446,114 @@ namespace Slang
         }
     }
 
+    bool SemanticsVisitor::isCertainlyNotApplicable(
+        LookupResultItem const& item,
+        OverloadResolveContext& context)
+    {
+        Decl* decl = item.declRef.getDecl();
+        if (auto genericDecl = as<GenericDecl>(decl))
+            decl = genericDecl->inner;
+
+        auto callableDecl = as<CallableDecl>(decl);
+        if (!callableDecl)
+            return false;
+
+        // The same checks as `TryCheckOverloadCandidateArity`, but
+        // without needing the declaration to be checked, or generic
+        // arguments to be inferred.
+        //
+        UInt allowedCount = 0;
+        UInt requiredCount = 0;
+        for (auto paramDecl : callableDecl->getMembersOfType<ParamDecl>())
+        {
+            allowedCount++;
+            if (!paramDecl->initExpr)
+                requiredCount++;
+        }
+        const UInt argCount = UInt(context.getArgCount());
+        if (argCount < requiredCount || argCount > allowedCount)
+            return true;
+
+        // The same checks as `TryCheckOverloadCandidateFixity`.
+        //
+        if (as<PrefixExpr>(context.originalExpr) && !callableDecl->hasModifier<PrefixModifier>())
+            return true;
+        if (as<PostfixExpr>(context.originalExpr) && !callableDecl->hasModifier<PostfixModifier>())
+            return true;
+
+        // A mutating method can't be called on an r-value (as checked by
+        // `TryCheckOverloadCandidateDirections`). Attributes such as
+        // `[mutating]` can only be relied on once modifiers are checked.
+        //
+        if (context.baseExpr && !context.baseExpr->type.isLeftValue &&
+            callableDecl->isChecked(DeclCheckState::ModifiersChecked) &&
+            !isEffectivelyStatic(callableDecl) &&
+            isEffectivelyMutating(callableDecl))
+        {
+            return true;
+        }
+
+        return false;
+    }
+
     void SemanticsVisitor::AddOverloadCandidates(
         LookupResult const&     result,
         OverloadResolveContext&	context)
     {
         if(result.isOverloaded())
         {
+            // Large overload groups (such as the initializers of vector types)
+            // are narrowed down to the items that might be applicable, so that
+            // the rest don't need to be checked or have their generic arguments
+            // inferred.
+            //
+            const Index itemCount = result.items.getCount();
+            List<bool> skipItems;
+            skipItems.setCount(itemCount);
+            Count skipCount = 0;
+            for (Index i = 0; i < itemCount; ++i)
+            {
+                skipItems[i] = isCertainlyNotApplicable(result.items[i], context);
+                skipCount += Count(skipItems[i]);
+            }
+
+            if (skipCount == 0)
+            {
+                for(auto item : result.items)
+                {
+                    AddDeclRefOverloadCandidates(item, context);
+                }
+                return;
+            }
+
+            const OverloadCandidate bestCandidateStorage = context.bestCandidateStorage;
+            const bool hadBestCandidate = (context.bestCandidate != nullptr);
+            const List<OverloadCandidate> bestCandidates = context.bestCandidates;
+
+            for (Index i = 0; i < itemCount; ++i)
+            {
+                if (!skipItems[i])
+                {
+                    AddDeclRefOverloadCandidates(result.items[i], context);
+                }
+            }
+
+            // The skipped items only matter for the diagnostics when there isn't
+            // a unique applicable candidate, in which case resolution is repeated
+            // with all of the items.
+            //
+            if (context.bestCandidate &&
+                context.bestCandidates.getCount() == 0 &&
+                context.bestCandidate->status == OverloadCandidate::Status::Applicable)
+            {
+                getShared()->addSkippedOverloadCandidates(skipCount);
+                return;
+            }
+
+            context.bestCandidateStorage = bestCandidateStorage;
+            context.bestCandidate = hadBestCandidate ? &context.bestCandidateStorage : nullptr;
+            context.bestCandidates = bestCandidates;
+
             for(auto item : result.items)
             {
                 AddDeclRefOverloadCandidates(item, context);
@@ -1647,6 +1749,83 @@ namespace Slang
         return argsListBuilder.ProduceString();
     }
 
+        /// Calculate the key to cache the overload resolution of the call `expr` of `funcExpr` in `context`.
+        /// Returns false if the resolution can't be cached.
+    static bool _calcCallOverloadCacheKey(
+        InvokeExpr*                                 expr,
+        Expr*                                       funcExpr,
+        SemanticsVisitor::OverloadResolveContext&   context,
+        CallOverloadCacheKey&                       outKey)
+    {
+        // Whether a `new` call is valid depends on the type constructed.
+        if (as<NewExpr>(expr))
+            return false;
+
+        const Index argCount = context.getArgCount();
+        if (argCount >= 31)
+            return false;
+
+        while (auto parenExpr = as<ParenExpr>(funcExpr))
+        {
+            funcExpr = parenExpr->base;
+        }
+
+        outKey.exprType = expr->astNodeType;
+        outKey.leftValueMask = 0;
+
+        if (auto declRefExpr = as<DeclRefExpr>(funcExpr))
+        {
+            outKey.callees.add(declRefExpr->declRef);
+        }
+        else if (auto overloadedExpr = as<OverloadedExpr>(funcExpr))
+        {
+            // Items found through a base type or constraint are
+            // called through expressions that depend on more than
+            // the declaration.
+            //
+            for (auto item : overloadedExpr->lookupResult2)
+            {
+                if (item.breadcrumbs)
+                    return false;
+                outKey.callees.add(item.declRef);
+            }
+        }
+        else
+        {
+            return false;
+        }
+
+        if (auto baseExpr = context.baseExpr)
+        {
+            if (!baseExpr->type.type)
+                return false;
+            outKey.baseType = as<DeclRefType>(baseExpr->type.type->getCanonicalType());
+            if (!outKey.baseType)
+                return false;
+            if (baseExpr->type.isLeftValue)
+                outKey.leftValueMask |= 1;
+        }
+
+        for (Index i = 0; i < argCount; ++i)
+        {
+            Expr* arg = context.getArg(i);
+
+            // Coercing these depends on more than their type.
+            if (as<OverloadedExpr>(arg) || as<OverloadedExpr2>(arg) || as<InitializerListExpr>(arg))
+                return false;
+
+            Type* argType = arg->type.type;
+            auto argDeclRefType = argType ? as<DeclRefType>(argType->getCanonicalType()) : nullptr;
+            if (!argDeclRefType)
+                return false;
+
+            outKey.argTypes.add(argDeclRefType);
+            if (arg->type.isLeftValue)
+                outKey.leftValueMask |= uint32_t(1) << (i + 1);
+        }
+        return true;
+    }
+
     Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr * expr)
     {
         OverloadResolveContext context;
@@ -1731,7 +1910,52 @@ namespace Slang
         // `visitTypeCastExpr`) would allow us to continue to ensure
         // equivalent in (almost) all cases.
 
-        if (!context.bestCandidate)
+        // Calls of the same declarations with the same argument types
+        // resolve to the same candidate, so other calls are cached on the
+        // shared semantics context. The result depends on any containers
+        // searched along the way (such as for initializers, or to find
+        // the conformances needed by a generic callee).
+        //
+        auto shared = getShared();
+        CallOverloadCacheKey callKey;
+        bool shouldAddToCallCache = false;
+        if (!context.bestCandidate && !shouldAddToCache &&
+            _calcCallOverloadCacheKey(expr, funcExpr, context, callKey))
+        {
+            if (auto entry = shared->findCachedCallOverload(callKey))
+            {
+                shared->addSearchedContainers(entry->searchedContainers);
+                context.bestCandidateStorage = entry->candidate;
+                context.bestCandidate = &context.bestCandidateStorage;
+            }
+            else
+            {
+                shouldAddToCallCache = true;
+            }
+        }
+
+        if (shouldAddToCallCache)
+        {
+            const Count invalidationCount = shared->getLookupCacheStats().invalidationCount;
+
+            List<ContainerDecl*> searchedContainers;
+            auto outerSearchedContainers = shared->setSearchedContainers(&searchedContainers);
+
+            AddOverloadCandidates(funcExpr, context);
+
+            shared->setSearchedContainers(outerSearchedContainers);
+            shared->addSearchedContainers(searchedContainers);
+
+            if (context.bestCandidate &&
+                context.bestCandidates.getCount() == 0 &&
+                context.bestCandidate->status == OverloadCandidate::Status::Applicable &&
+                context.bestCandidate->flavor != OverloadCandidate::Flavor::Expr &&
+                shared->canCacheSearch(searchedContainers, invalidationCount))
+            {
+                shared->addCachedCallOverload(callKey, *context.bestCandidate, searchedContainers);
+            }
+        }
+        else if (!context.bestCandidate)
         {
             AddOverloadCandidates(funcExpr, context);
         }
@@ -794,6 +794,8 @@ namespace Slang
         auto linkage = getLinkage();
         auto sink = getSink();
 
+        CompileProfiler::Scope profileScope(linkage->getProfiler(), "checkEntryPoints");
+
         // The validation of entry points here will be modal, and controlled
         // by whether the user specified any entry points directly via
         // API or command-line options.
@@ -839,68 +841,71 @@ namespace Slang
             // This ensures that downstream code only has to consider
             // the central list of entry point requests, and doesn't
             // have to know where they came from.
-
-            // TODO: A comprehensive approach here would need to search
-            // recursively for entry points, because they might appear
-            // as, e.g., member function of a `struct` type.
             //
-            // For now we'll start with an extremely basic approach that
-            // should work for typical HLSL code.
-            //
-            Index translationUnitCount = translationUnits.getCount();
-            for(Index tt = 0; tt < translationUnitCount; ++tt)
+            for (auto translationUnit : translationUnits)
             {
-                auto translationUnit = translationUnits[tt];
-                for( auto globalDecl : translationUnit->getModuleDecl()->members )
-                {
-                    auto maybeFuncDecl = globalDecl;
-                    if( auto genericDecl = as<GenericDecl>(maybeFuncDecl) )
-                    {
-                        maybeFuncDecl = genericDecl->inner;
-                    }
+                translationUnit->module->_discoverEntryPoints(sink);
+            }
+        }
+    }
+
+    void Module::_discoverEntryPoints(DiagnosticSink* sink)
+    {
+        // TODO: A comprehensive approach here would need to search
+        // recursively for entry points, because they might appear
+        // as, e.g., member function of a `struct` type.
+        //
+        // For now we'll start with an extremely basic approach that
+        // should work for typical HLSL code.
+        //
+        for( auto globalDecl : m_moduleDecl->members )
+        {
+            auto maybeFuncDecl = globalDecl;
+            if( auto genericDecl = as<GenericDecl>(maybeFuncDecl) )
+            {
+                maybeFuncDecl = genericDecl->inner;
+            }
 
-                    auto funcDecl = as<FuncDecl>(maybeFuncDecl);
-                    if(!funcDecl)
-                        continue;
+            auto funcDecl = as<FuncDecl>(maybeFuncDecl);
+            if(!funcDecl)
+                continue;
 
-                    auto entryPointAttr = funcDecl->findModifier<EntryPointAttribute>();
-                    if(!entryPointAttr)
-                        continue;
+            auto entryPointAttr = funcDecl->findModifier<EntryPointAttribute>();
+            if(!entryPointAttr)
+                continue;
 
-                    // We've discovered a valid entry point. It is a function (possibly
-                    // generic) that has a `[shader(...)]` attribute to mark it as an
-                    // entry point.
-                    //
-                    // We will now register that entry point as an `EntryPoint`
-                    // with an appropriately chosen profile.
-                    //
-                    // The profile will only include a stage, so that the profile "family"
-                    // and "version" are left unspecified. Downstream code will need
-                    // to be able to handle this case.
-                    //
-                    Profile profile;
-                    profile.setStage(entryPointAttr->stage);
+            // We've discovered a valid entry point. It is a function (possibly
+            // generic) that has a `[shader(...)]` attribute to mark it as an
+            // entry point.
+            //
+            // We will now register that entry point as an `EntryPoint`
+            // with an appropriately chosen profile.
+            //
+            // The profile will only include a stage, so that the profile "family"
+            // and "version" are left unspecified. Downstream code will need
+            // to be able to handle this case.
+            //
+            Profile profile;
+            profile.setStage(entryPointAttr->stage);
 
-                    RefPtr<EntryPoint> entryPoint = EntryPoint::create(
-                        linkage,
-                        makeDeclRef(funcDecl),
-                        profile);
+            RefPtr<EntryPoint> entryPoint = EntryPoint::create(
+                getLinkage(),
+                makeDeclRef(funcDecl),
+                profile);
 
-                    validateEntryPoint(entryPoint, sink);
+            validateEntryPoint(entryPoint, sink);
 
-                    // Note: in the case that the user didn't explicitly
-                    // specify entry points and we are instead compiling
-                    // a shader "library," then we do not want to automatically
-                    // combine the entry points into groups in the generated
-                    // `Program`, since that would be slightly too magical.
-                    //
-                    // Instead, each entry point will end up in a singleton
-                    // group, so that its entry-point parameters lay out
-                    // independent of the others.
-                    //
-                    translationUnit->module->_addEntryPoint(entryPoint);
-                }
-            }
+            // Note: in the case that the user didn't explicitly
+            // specify entry points and we are instead compiling
+            // a shader "library," then we do not want to automatically
+            // combine the entry points into groups in the generated
+            // `Program`, since that would be slightly too magical.
+            //
+            // Instead, each entry point will end up in a singleton
+            // group, so that its entry-point parameters lay out
+            // independent of the others.
+            //
+            _addEntryPoint(entryPoint);
         }
     }
 
@@ -60,6 +60,8 @@ namespace Slang
 
     void Session::_setSharedLibraryLoader(ISlangSharedLibraryLoader* loader)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+
         if (m_sharedLibraryLoader != loader)
         {
             // Need to clear all of the libraries
@@ -78,6 +80,8 @@ namespace Slang
 
     void Session::resetDownstreamCompiler(PassThroughMode type)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+
         // Mark as initialized
         m_downstreamCompilerInitialized &= ~(1 << int(type));
         m_downstreamCompilers[int(type)].setNull();
@@ -85,6 +89,8 @@ namespace Slang
 
     IDownstreamCompiler* Session::getOrLoadDownstreamCompiler(PassThroughMode type, DiagnosticSink* sink)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+
         if (m_downstreamCompilerInitialized & (1 << int(type)))
         {
             return m_downstreamCompilers[int(type)];
@@ -164,6 +170,9 @@ namespace Slang
         TranslationUnitRequest* translationUnit,
         LoadedModuleDictionary& loadedModules)
     {
+        CompileProfiler* profiler = translationUnit->compileRequest->getLinkage()->getProfiler();
+        CompileProfiler::Scope profileScope(profiler, "checkTranslationUnit");
+
         SharedSemanticsContext sharedSemanticsContext(
             translationUnit->compileRequest->getLinkage(),
             translationUnit->getModule(),
@@ -178,6 +187,20 @@ namespace Slang
 
         visitor.checkModule(translationUnit->getModuleDecl());
 
+        if (profiler)
+        {
+            const auto& stats = sharedSemanticsContext.getLookupCacheStats();
+            profiler->addToCounter("member lookup cache hits", stats.memberLookupHitCount);
+            profiler->addToCounter("member lookup cache misses", stats.memberLookupMissCount);
+            profiler->addToCounter("subtype witness cache hits", stats.subtypeWitnessHitCount);
+            profiler->addToCounter("subtype witness shared cache hits", stats.subtypeWitnessSharedHitCount);
+            profiler->addToCounter("subtype witness cache misses", stats.subtypeWitnessMissCount);
+            profiler->addToCounter("call overload cache hits", stats.callOverloadHitCount);
+            profiler->addToCounter("call overload cache misses", stats.callOverloadMissCount);
+            profiler->addToCounter("overload candidates skipped", stats.overloadCandidateSkipCount);
+            profiler->addToCounter("lookup cache invalidations", stats.invalidationCount);
+        }
+
         translationUnit->getModule()->_collectShaderParams();
     }
 
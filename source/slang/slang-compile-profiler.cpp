@@ -0,0 +1,427 @@
+// slang-compile-profiler.cpp
+#include "slang-compile-profiler.h"
+
+#include "../core/slang-blob.h"
+#include "../core/slang-process.h"
+#include "../core/slang-string-util.h"
+
+#include "../compiler-core/slang-json-parser.h"
+
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+/* static */Count CompileProfiler::calcIRInstCount(IRModule* module)
+{
+    if (!module)
+    {
+        return 0;
+    }
+
+    Count count = 0;
+
+    List<IRInst*> workList;
+    workList.add(module->getModuleInst());
+
+    while (workList.getCount())
+    {
+        IRInst* inst = workList.getLast();
+        workList.removeLast();
+
+        ++count;
+
+        for (IRInst* child = inst->getFirstDecorationOrChild(); child; child = child->getNextInst())
+        {
+            workList.add(child);
+        }
+    }
+
+    return count;
+}
+
+Index CompileProfiler::beginEntry(const char* name)
+{
+    const Index parent = m_currentEntry;
+
+    // Look for an existing entry with the same name under the current parent
+    Index* link = (parent >= 0) ? &m_entries[parent].firstChild : &m_firstRoot;
+    while (*link >= 0)
+    {
+        const Entry& entry = m_entries[*link];
+        if (entry.name == name || ::strcmp(entry.name, name) == 0)
+        {
+            m_currentEntry = *link;
+            return m_currentEntry;
+        }
+        link = &m_entries[*link].nextSibling;
+    }
+
+    // Not found so add it to the end of the sibling list.
+    // Note that `link` may point into m_entries, so we must update it before adding.
+    const Index entryIndex = m_entries.getCount();
+    *link = entryIndex;
+
+    Entry entry;
+    entry.name = name;
+    entry.parent = parent;
+    m_entries.add(entry);
+
+    m_currentEntry = entryIndex;
+    return entryIndex;
+}
+
+void CompileProfiler::endEntry(Index entryIndex, uint64_t startTick, IRModule* irModule)
+{
+    Entry& entry = m_entries[entryIndex];
+
+    entry.invocationCount++;
+    entry.totalTicks += Process::getClockTick() - startTick;
+
+    if (irModule)
+    {
+        entry.irInstCount = calcIRInstCount(irModule);
+        entry.irArenaBytes = Count(irModule->getMemoryArena().calcTotalMemoryUsed());
+    }
+
+    m_currentEntry = entry.parent;
+}
+
+void CompileProfiler::addToCounter(const char* name, Count value)
+{
+    if (!isOwningThread())
+    {
+        return;
+    }
+
+    for (auto& counter : m_counters)
+    {
+        if (counter.name == name || ::strcmp(counter.name, name) == 0)
+        {
+            counter.value += value;
+            return;
+        }
+    }
+
+    Counter counter;
+    counter.name = name;
+    counter.value = value;
+    m_counters.add(counter);
+}
+
+void CompileProfiler::addIRDeduplicationCounters(IRModule* module)
+{
+    if (!module || !isOwningThread())
+    {
+        return;
+    }
+
+    IRDeduplicationContext* context = module->getDeduplicationContext();
+    const auto& stats = context->getStats();
+    const auto probeStats = context->getGlobalValueNumberingMap().calcProbeStats();
+
+    addToCounter("IR dedup lookups", stats.lookupCount);
+    addToCounter("IR dedup hits", stats.hitCount);
+    addToCounter("IR dedup map entries", probeStats.count);
+    addToCounter("IR dedup map capacity", probeStats.capacity);
+    addToCounter("IR dedup map probes", probeStats.totalProbeLength);
+
+    // A maximum over all modules, rather than a sum
+    const char* maxProbeName = "IR dedup map max probe length";
+    Count currentMax = 0;
+    for (const auto& counter : m_counters)
+    {
+        if (::strcmp(counter.name, maxProbeName) == 0)
+        {
+            currentMax = counter.value;
+        }
+    }
+    if (probeStats.maxProbeLength > currentMax)
+    {
+        addToCounter(maxProbeName, probeStats.maxProbeLength - currentMax);
+    }
+}
+
+void CompileProfiler::addIRMemoryCounters(IRModule* module)
+{
+    if (!module || !isOwningThread())
+    {
+        return;
+    }
+
+    // A 4 byte operand count and 4 byte hash in IRInst
+    const size_t inlineCountAndHashSize = sizeof(uint32_t) + sizeof(HashCode);
+
+    Count instCount = 0;
+    Count instBytes = 0;
+    Count inlineCountAndHashBytes = 0;
+
+    List<IRInst*> workList;
+    workList.add(module->getModuleInst());
+
+    while (workList.getCount())
+    {
+        IRInst* inst = workList.getLast();
+        workList.removeLast();
+
+        const size_t operandsSize = inst->getOperandCount() * sizeof(IRUse);
+        const size_t prefixSize = (inst->m_op & kIROpMeta_ExplicitOperandCount) ? IRInst::kOperandCountPrefixSize : 0;
+
+        ++instCount;
+        instBytes += Count(prefixSize + sizeof(IRInst) + operandsSize);
+        inlineCountAndHashBytes += Count(sizeof(IRInst) + inlineCountAndHashSize + operandsSize);
+
+        for (IRInst* child = inst->getFirstDecorationOrChild(); child; child = child->getNextInst())
+        {
+            workList.add(child);
+        }
+    }
+
+    addToCounter("IR insts", instCount);
+    addToCounter("IR inst bytes", instBytes);
+    addToCounter("IR inst bytes (count and hash inline)", inlineCountAndHashBytes);
+}
+
+void CompileProfiler::clear()
+{
+    m_entries.clear();
+    m_counters.clear();
+    m_firstRoot = -1;
+    m_currentEntry = -1;
+}
+
+double CompileProfiler::_getMilliseconds(uint64_t ticks) const
+{
+    return double(ticks) * 1000.0 / double(Process::getClockFrequency());
+}
+
+uint64_t CompileProfiler::_getChildTicks(Index entryIndex) const
+{
+    uint64_t ticks = 0;
+    for (Index child = m_entries[entryIndex].firstChild; child >= 0; child = m_entries[child].nextSibling)
+    {
+        ticks += m_entries[child].totalTicks;
+    }
+    return ticks;
+}
+
+void CompileProfiler::_appendTableRec(Index entryIndex, Index depth, StringBuilder& out) const
+{
+    for (; entryIndex >= 0; entryIndex = m_entries[entryIndex].nextSibling)
+    {
+        const Entry& entry = m_entries[entryIndex];
+
+        StringBuilder name;
+        for (Index i = 0; i < depth; ++i)
+        {
+            name << "  ";
+        }
+        name << entry.name;
+
+        const double totalMs = _getMilliseconds(entry.totalTicks);
+        const double selfMs = _getMilliseconds(entry.totalTicks - _getChildTicks(entryIndex));
+
+        StringUtil::appendFormat(out, "%-48s %8d %12.3f %12.3f", name.getBuffer(), int(entry.invocationCount), totalMs, selfMs);
+
+        if (entry.isPass)
+        {
+            StringUtil::appendFormat(out, " %8d %8d", int(entry.changeCount), int(entry.skipCount));
+        }
+        else
+        {
+            StringUtil::appendFormat(out, " %8s %8s", "-", "-");
+        }
+
+        if (entry.irInstCount >= 0)
+        {
+            StringUtil::appendFormat(out, " %10d %12lld", int(entry.irInstCount), (long long)entry.irArenaBytes);
+        }
+        out << "\n";
+
+        _appendTableRec(entry.firstChild, depth + 1, out);
+    }
+}
+
+void CompileProfiler::appendTable(StringBuilder& out) const
+{
+    StringUtil::appendFormat(out, "%-48s %8s %12s %12s %8s %8s %10s %12s\n", "Phase", "Calls", "Total (ms)", "Self (ms)", "Changed", "Skipped", "IR insts", "IR bytes");
+    _appendTableRec(m_firstRoot, 0, out);
+
+    if (m_counters.getCount())
+    {
+        StringUtil::appendFormat(out, "\n%-48s %12s\n", "Counter", "Value");
+        for (const auto& counter : m_counters)
+        {
+            StringUtil::appendFormat(out, "%-48s %12lld\n", counter.name, (long long)counter.value);
+        }
+    }
+}
+
+void CompileProfiler::appendJSON(StringBuilder& out) const
+{
+    JSONWriter writer(JSONWriter::IndentationStyle::KNR);
+
+    // Entries are written with an explicit stack, so that deep hierarchies don't recurse
+    writer.startObject(SourceLoc());
+    writer.addUnquotedKey(toSlice("phases"), SourceLoc());
+    writer.startArray(SourceLoc());
+
+    List<Index> stack;
+    Index entryIndex = m_firstRoot;
+    while (true)
+    {
+        if (entryIndex < 0)
+        {
+            // Close the children array of the parent, and move onto its sibling
+            if (stack.getCount() == 0)
+            {
+                break;
+            }
+            writer.endArray(SourceLoc());
+            writer.endObject(SourceLoc());
+
+            entryIndex = m_entries[stack.getLast()].nextSibling;
+            stack.removeLast();
+            continue;
+        }
+
+        const Entry& entry = m_entries[entryIndex];
+
+        writer.startObject(SourceLoc());
+
+        writer.addUnquotedKey(toSlice("name"), SourceLoc());
+        writer.addStringValue(UnownedStringSlice(entry.name), SourceLoc());
+        writer.addUnquotedKey(toSlice("calls"), SourceLoc());
+        writer.addIntegerValue(int64_t(entry.invocationCount), SourceLoc());
+        writer.addUnquotedKey(toSlice("totalMs"), SourceLoc());
+        writer.addFloatValue(_getMilliseconds(entry.totalTicks), SourceLoc());
+        writer.addUnquotedKey(toSlice("selfMs"), SourceLoc());
+        writer.addFloatValue(_getMilliseconds(entry.totalTicks - _getChildTicks(entryIndex)), SourceLoc());
+
+        if (entry.isPass)
+        {
+            writer.addUnquotedKey(toSlice("changes"), SourceLoc());
+            writer.addIntegerValue(int64_t(entry.changeCount), SourceLoc());
+            writer.addUnquotedKey(toSlice("skips"), SourceLoc());
+            writer.addIntegerValue(int64_t(entry.skipCount), SourceLoc());
+        }
+
+        if (entry.irInstCount >= 0)
+        {
+            writer.addUnquotedKey(toSlice("irInstCount"), SourceLoc());
+            writer.addIntegerValue(int64_t(entry.irInstCount), SourceLoc());
+            writer.addUnquotedKey(toSlice("irArenaBytes"), SourceLoc());
+            writer.addIntegerValue(int64_t(entry.irArenaBytes), SourceLoc());
+        }
+
+        if (entry.firstChild >= 0)
+        {
+            writer.addUnquotedKey(toSlice("children"), SourceLoc());
+            writer.startArray(SourceLoc());
+
+            stack.add(entryIndex);
+            entryIndex = entry.firstChild;
+        }
+        else
+        {
+            writer.endObject(SourceLoc());
+            entryIndex = entry.nextSibling;
+        }
+    }
+
+    writer.endArray(SourceLoc());
+
+    if (m_counters.getCount())
+    {
+        writer.addUnquotedKey(toSlice("counters"), SourceLoc());
+        writer.startObject(SourceLoc());
+        for (const auto& counter : m_counters)
+        {
+            writer.addUnquotedKey(UnownedStringSlice(counter.name), SourceLoc());
+            writer.addIntegerValue(int64_t(counter.value), SourceLoc());
+        }
+        writer.endObject(SourceLoc());
+    }
+
+    writer.endObject(SourceLoc());
+
+    out << writer.getBuilder();
+}
+
+SlangResult CompileProfiler::writeReport(SlangPerformanceReportFormat format, ISlangBlob** outBlob) const
+{
+    StringBuilder buf;
+    switch (format)
+    {
+        case SLANG_PERFORMANCE_REPORT_FORMAT_TEXT:  appendTable(buf); break;
+        case SLANG_PERFORMANCE_REPORT_FORMAT_JSON:  appendJSON(buf); break;
+        default: return SLANG_E_INVALID_ARG;
+    }
+
+    *outBlob = StringBlob::moveCreate(buf).detach();
+    return SLANG_OK;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! CompileProfiler::Scope !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+CompileProfiler::Scope::Scope(CompileProfiler* profiler, const char* name)
+    : m_profiler((profiler && profiler->isOwningThread()) ? profiler : nullptr)
+{
+    if (m_profiler)
+    {
+        m_entryIndex = m_profiler->beginEntry(name);
+        m_startTick = Process::getClockTick();
+    }
+}
+
+CompileProfiler::Scope::~Scope()
+{
+    if (m_profiler)
+    {
+        m_profiler->endEntry(m_entryIndex, m_startTick, m_irModule);
+    }
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! CompileProfiler::PassSequence !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+void CompileProfiler::PassSequence::beginPass(const char* name)
+{
+    if (m_profiler)
+    {
+        endPass();
+        m_entryIndex = m_profiler->beginEntry(name);
+        m_profiler->m_entries[m_entryIndex].isPass = true;
+        m_startEditCount = getIREditCount();
+        m_startTick = Process::getClockTick();
+    }
+}
+
+void CompileProfiler::PassSequence::endPass()
+{
+    if (m_profiler && m_entryIndex >= 0)
+    {
+        if (getIREditCount() != m_startEditCount)
+        {
+            m_profiler->m_entries[m_entryIndex].changeCount++;
+        }
+        m_profiler->endEntry(m_entryIndex, m_startTick, m_irModule);
+        m_entryIndex = -1;
+    }
+}
+
+void CompileProfiler::PassSequence::skipPass(const char* name)
+{
+    if (m_profiler)
+    {
+        endPass();
+
+        // Find or add the entry without making it current
+        const Index entryIndex = m_profiler->beginEntry(name);
+        Entry& entry = m_profiler->m_entries[entryIndex];
+        entry.isPass = true;
+        entry.skipCount++;
+        m_profiler->m_currentEntry = entry.parent;
+    }
+}
+
+}
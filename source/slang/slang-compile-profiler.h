@@ -0,0 +1,164 @@
+// slang-compile-profiler.h
+#ifndef SLANG_COMPILE_PROFILER_H
+#define SLANG_COMPILE_PROFILER_H
+
+#include "../core/slang-basic.h"
+#include "../../slang.h"
+
+#include <thread>
+
+namespace Slang
+{
+
+struct IRModule;
+
+/* Accumulates hierarchical timing information for the phases of a compilation.
+
+A phase is identified by its name together with the phase that was active when it
+started. Repeated invocations of the same phase (such as `simplifyIR` being run several
+times from `linkAndOptimizeIR`, or each `import`ed module being parsed) are accumulated
+into a single entry.
+
+Phase names are expected to be string literals - only the pointer is held.
+
+Counters record statistics that aren't times, such as how many `#include`s were skipped.
+Like phases, counters are identified by a name and accumulated.
+
+The profiler is not thread safe. Only phases and counters on the thread that created the profiler
+are recorded, those on other threads (such as those used for parallel downstream compilation) are ignored. */
+class CompileProfiler : public RefObject
+{
+public:
+    struct Entry
+    {
+        const char* name = nullptr;
+        Index parent = -1;                  ///< Index of the parent entry, or -1 for a root
+        Index firstChild = -1;              ///< First child entry, in order of first invocation
+        Index nextSibling = -1;             ///< Next entry with the same parent
+
+        Count invocationCount = 0;
+        uint64_t totalTicks = 0;            ///< Total ticks spent in the phase, including child phases
+
+            /// Set for passes timed by a `PassSequence`
+        bool isPass = false;
+        Count changeCount = 0;              ///< Invocations of a pass that changed IR
+        Count skipCount = 0;                ///< Times a pass wasn't run as it couldn't have anything to do
+
+            /// IR statistics sampled at the end of the most recent invocation.
+            /// Only set for phases that operate on an IR module, otherwise -1.
+        Count irInstCount = -1;
+        Count irArenaBytes = -1;
+    };
+
+    struct Counter
+    {
+        const char* name = nullptr;
+        Count value = 0;
+    };
+
+        /// Times a phase for the lifetime of the scope. Does nothing if `profiler` is null.
+    struct Scope
+    {
+        Scope(CompileProfiler* profiler, const char* name);
+        ~Scope();
+
+            /// IR statistics will be sampled from `module` when the scope ends.
+        void setIRModule(IRModule* module) { m_irModule = module; }
+
+    protected:
+        CompileProfiler* m_profiler;
+        Index m_entryIndex = -1;
+        uint64_t m_startTick = 0;
+        IRModule* m_irModule = nullptr;
+    };
+
+        /// Times a sequence of passes that run over the same IR module.
+        /// Beginning a pass ends the pass that was previously active, so a pass
+        /// can be marked with a single line in front of the call that performs it.
+        /// Invocations of a pass that change IR (see `getIREditCount`) are counted.
+        /// Does nothing if `profiler` is null.
+    struct PassSequence
+    {
+        PassSequence(CompileProfiler* profiler, IRModule* module = nullptr)
+            : m_profiler((profiler && profiler->isOwningThread()) ? profiler : nullptr)
+            , m_irModule(module)
+        {}
+        ~PassSequence() { endPass(); }
+
+        void setIRModule(IRModule* module) { m_irModule = module; }
+
+            /// Start timing the pass `name`, ending the current pass if there is one.
+        void beginPass(const char* name);
+            /// End the current pass (if there is one).
+        void endPass();
+            /// Record that the pass `name` was skipped, ending the current pass if there is one.
+        void skipPass(const char* name);
+
+    protected:
+        CompileProfiler* m_profiler;
+        IRModule* m_irModule;
+        Index m_entryIndex = -1;
+        uint64_t m_startTick = 0;
+        uint64_t m_startEditCount = 0;
+    };
+
+        /// Start an invocation of the phase `name` as a child of the current phase.
+        /// Returns the index of the entry.
+    Index beginEntry(const char* name);
+        /// End an invocation of the entry at `entryIndex` that started at `startTick`.
+        /// If `irModule` is set, its statistics are recorded on the entry.
+    void endEntry(Index entryIndex, uint64_t startTick, IRModule* irModule);
+
+        /// True if the current thread is the one that created the profiler
+    bool isOwningThread() const { return std::this_thread::get_id() == m_owningThreadId; }
+
+        /// Get all entries. Entries appear in the order they were first invoked.
+    const List<Entry>& getEntries() const { return m_entries; }
+
+        /// Add `value` to the counter `name`. Does nothing if not called on the owning thread.
+    void addToCounter(const char* name, Count value);
+        /// Get all counters, in the order they were first added to.
+    const List<Counter>& getCounters() const { return m_counters; }
+
+        /// Add the statistics of the deduplication map of hoistable instructions in `module` to counters.
+        /// The mean probe length is the "probes" counter divided by the "entries" counter.
+    void addIRDeduplicationCounters(IRModule* module);
+
+        /// Add the number of instructions in `module`, and the bytes they take, to counters. The bytes are
+        /// those of each instruction and its operands, and of any operand count held ahead of it (see
+        /// `IRInst::getOperandCount`), but not payloads such as the text of string constants. For comparison
+        /// the bytes the instructions would take if each held its operand count and structural hash are
+        /// also added.
+    void addIRMemoryCounters(IRModule* module);
+
+        /// Discard all recorded entries
+    void clear();
+
+        /// Append a human readable table of the recorded phases
+    void appendTable(StringBuilder& out) const;
+        /// Append the recorded phases as JSON
+    void appendJSON(StringBuilder& out) const;
+
+        /// Write a report in the specified format into a blob
+    SlangResult writeReport(SlangPerformanceReportFormat format, ISlangBlob** outBlob) const;
+
+        /// Count all the instructions (including decorations) in `module`
+    static Count calcIRInstCount(IRModule* module);
+
+protected:
+    double _getMilliseconds(uint64_t ticks) const;
+    uint64_t _getChildTicks(Index entryIndex) const;
+
+    void _appendTableRec(Index entryIndex, Index depth, StringBuilder& out) const;
+
+    List<Entry> m_entries;
+    List<Counter> m_counters;
+    Index m_firstRoot = -1;
+    Index m_currentEntry = -1;
+
+    std::thread::id m_owningThreadId = std::this_thread::get_id();
+};
+
+}
+
+#endif
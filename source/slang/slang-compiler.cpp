@@ -8,6 +8,7 @@
 #include "../core/slang-riff.h"
 #include "../core/slang-type-text-util.h"
 #include "../core/slang-type-convert-util.h"
+#include "../core/slang-file-system.h"
 
 #include "slang-check.h"
 #include "slang-compiler.h"
@@ -1181,7 +1182,13 @@ namespace Slang
 
         // Set the source type
         options.sourceLanguage = SlangSourceLanguage(sourceLanguage);
-        
+
+        // Emitted C++ starts with the prelude, which downstream compilers may be able to precompile
+        if (!isPassThroughEnabled() && sourceLanguage == SourceLanguage::CPP)
+        {
+            options.sourcePrelude = allocator.allocate(getSession()->getPreludeForLanguage(sourceLanguage));
+        }
+
         // Disable exceptions and security checks
         options.flags &= ~(CompileOptions::Flag::EnableExceptionHandling | CompileOptions::Flag::EnableSecurityChecks);
 
@@ -1406,7 +1413,71 @@ namespace Slang
         // Compile
         ComPtr<IArtifact> artifact;
         auto downstreamStartTime = std::chrono::high_resolution_clock::now();
-        SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
+        {
+            auto linkage = getLinkage();
+            CompileProfiler::Scope profileScope(linkage->getProfiler(), "downstreamCompile");
+
+            // If code is being generated in parallel, state shared between the tasks that isn't otherwise
+            // guarded must only be accessed whilst holding the shared state lock.
+            ParallelDownstreamCompile* parallelDownstreamCompile = getParallelDownstreamCompile();
+
+            // If the same source has been compiled with the same options and compiler before, the
+            // result can be taken from the cache.
+            DownstreamCompileCache* downstreamCache = linkage->getDownstreamCompileCache();
+            DownstreamCompileCache::Key downstreamCacheKey;
+            const bool useDownstreamCache = SLANG_SUCCEEDED(DownstreamCompileCache::calcKey(compiler, options, downstreamCacheKey));
+
+            bool foundInCache = false;
+            if (useDownstreamCache)
+            {
+                ParallelDownstreamCompile::SharedStateLock sharedStateLock(parallelDownstreamCompile);
+                foundInCache = SLANG_SUCCEEDED(downstreamCache->findArtifact(downstreamCacheKey, artifact.writeRef()));
+            }
+
+            if (foundInCache)
+            {
+                if (auto profiler = linkage->getProfiler())
+                {
+                    profiler->addToCounter("downstream compiles read from cache", 1);
+                }
+            }
+            else
+            {
+                // The downstream compiler can run concurrently with other tasks as long as the compile only
+                // accesses state owned by this task. That rules out pass-through (which compiles from the
+                // linkage's source files) and module libraries (which are shared between tasks), for which
+                // the shared state lock is held. Otherwise the downstream compiler is given its own source
+                // manager, and accesses the OS file system directly rather than through the linkage's cache,
+                // which is only possible if the application hasn't set a file system.
+                ParallelDownstreamCompile* lockingParallelDownstreamCompile = nullptr;
+                SourceManager taskSourceManager;
+                if (parallelDownstreamCompile)
+                {
+                    if (isPassThroughEnabled() || linkage->m_libModules.getCount() || linkage->m_fileSystem)
+                    {
+                        lockingParallelDownstreamCompile = parallelDownstreamCompile;
+                    }
+                    else
+                    {
+                        taskSourceManager.initialize(nullptr, OSFileSystem::getExtSingleton());
+                        options.sourceManager = &taskSourceManager;
+                        options.fileSystemExt = OSFileSystem::getExtSingleton();
+                    }
+                }
+
+                {
+                    ParallelDownstreamCompile::SharedStateLock sharedStateLock(lockingParallelDownstreamCompile);
+                    SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
+                }
+
+                // Failing to store isn't an error, some artifacts (such as those with debug info) can't be cached.
+                if (useDownstreamCache)
+                {
+                    ParallelDownstreamCompile::SharedStateLock sharedStateLock(parallelDownstreamCompile);
+                    downstreamCache->storeArtifact(downstreamCacheKey, artifact);
+                }
+            }
+        }
         auto downstreamElapsedTime =
             (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
         getSession()->addDownstreamCompileTime(downstreamElapsedTime);
@@ -1693,7 +1764,8 @@ namespace Slang
 
     IArtifact* TargetProgram::_createWholeProgramResult(
         DiagnosticSink* sink,
-        EndToEndCompileRequest* endToEndReq)
+        EndToEndCompileRequest* endToEndReq,
+        ParallelDownstreamCompile* parallelDownstreamCompile)
     {
         // We want to call `emitEntryPoints` function to generate code that contains
         // all the entrypoints defined in `m_program`.
@@ -1706,7 +1778,7 @@ namespace Slang
         for (Index i = 0; i < entryPointIndices.getCount(); i++)
             entryPointIndices[i] = i;
     
-        CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq);
+        CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq, parallelDownstreamCompile);
         CodeGenContext codeGenContext(&sharedCodeGenContext);
 
         if (SLANG_FAILED(codeGenContext.emitEntryPoints(m_wholeProgramResult)))
@@ -1720,7 +1792,8 @@ namespace Slang
     IArtifact* TargetProgram::_createEntryPointResult(
         Int                     entryPointIndex,
         DiagnosticSink*         sink,
-        EndToEndCompileRequest* endToEndReq)
+        EndToEndCompileRequest* endToEndReq,
+        ParallelDownstreamCompile* parallelDownstreamCompile)
     {
         // It is possible that entry points got added to the `Program`
         // *after* we created this `TargetProgram`, so there might be
@@ -1737,7 +1810,7 @@ namespace Slang
         CodeGenContext::EntryPointIndices entryPointIndices;
         entryPointIndices.add(entryPointIndex);
 
-        CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq);
+        CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq, parallelDownstreamCompile);
         CodeGenContext codeGenContext(&sharedCodeGenContext);
 
         codeGenContext.emitEntryPoints(m_entryPointResults[entryPointIndex]);
@@ -2166,6 +2239,39 @@ namespace Slang
         // has specified, and generate code for each of them.
         //
         auto linkage = getLinkage();
+
+        // If there is more than one entry point or target to generate code for, and more than one thread
+        // to do so, generate code for all the entry points on all the targets concurrently.
+        Count taskCount = 0;
+        for (auto targetReq : linkage->targets)
+        {
+            taskCount += targetReq->isWholeProgramRequest() ? 1 : program->getEntryPointCount();
+        }
+
+        if (ParallelDownstreamCompile::calcThreadCount(m_downstreamCompileThreadCount, taskCount) > 1)
+        {
+            ParallelDownstreamCompile parallelDownstreamCompile;
+            for (auto targetReq : linkage->targets)
+            {
+                auto targetProgram = program->getTargetProgram(targetReq);
+                if (targetReq->isWholeProgramRequest())
+                {
+                    parallelDownstreamCompile.addTask(targetProgram, -1);
+                }
+                else
+                {
+                    for (Index ii = 0; ii < program->getEntryPointCount(); ++ii)
+                    {
+                        parallelDownstreamCompile.addTask(targetProgram, ii);
+                    }
+                }
+            }
+
+            CompileProfiler::Scope profileScope(linkage->getProfiler(), "parallelDownstreamCompile");
+            parallelDownstreamCompile.execute(m_downstreamCompileThreadCount, this, getSink());
+            return;
+        }
+
         for (auto targetReq : linkage->targets)
         {
             auto targetProgram = program->getTargetProgram(targetReq);
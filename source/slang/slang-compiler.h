@@ -7,6 +7,7 @@
 
 #include "../compiler-core/slang-downstream-compiler.h"
 #include "../compiler-core/slang-downstream-compiler-util.h"
+#include "../compiler-core/slang-downstream-compile-cache.h"
 
 #include "../compiler-core/slang-name.h"
 #include "../compiler-core/slang-include-system.h"
@@ -17,7 +18,10 @@
 #include "../../slang-com-ptr.h"
 
 #include "slang-capability.h"
+#include "slang-compile-profiler.h"
 #include "slang-diagnostics.h"
+#include "slang-module-cache.h"
+#include "slang-parallel-downstream-compile.h"
 
 #include "slang-preprocessor.h"
 #include "slang-profile.h"
@@ -159,6 +163,7 @@ namespace Slang
     class Linkage;
     class Module;
     class TranslationUnitRequest;
+    class IRLinkSymbolTable;
 
         /// Information collected about global or entry-point shader parameters
     struct ShaderParamInfo
@@ -299,6 +304,17 @@ namespace Slang
         SLANG_NO_THROW SlangResult SLANG_MCALL renameEntryPoint(
             const char* newName,
             slang::IComponentType** outEntryPoint) SLANG_OVERRIDE;
+        SLANG_NO_THROW SlangResult SLANG_MCALL getPerformanceReport(
+            SlangPerformanceReportFormat format,
+            ISlangBlob** outReport) SLANG_OVERRIDE;
+        SLANG_NO_THROW SlangResult SLANG_MCALL getSpecializedEntryPointCodes(
+            slang::SpecializationArg const* specializationArgs,
+            SlangInt                        specializationArgCount,
+            SlangInt                        specializationArgSetCount,
+            SlangInt                        entryPointIndex,
+            SlangInt                        targetIndex,
+            slang::IBlob**                  outCodes,
+            slang::IBlob**                  outDiagnostics) SLANG_OVERRIDE;
         SLANG_NO_THROW SlangResult SLANG_MCALL link(
             slang::IComponentType** outLinkedComponentType,
             ISlangBlob**            outDiagnostics) SLANG_OVERRIDE;
@@ -725,6 +741,31 @@ namespace Slang
             return Super::renameEntryPoint(newName, outEntryPoint);
         }
 
+        SLANG_NO_THROW SlangResult SLANG_MCALL getPerformanceReport(
+            SlangPerformanceReportFormat format, ISlangBlob** outReport) SLANG_OVERRIDE
+        {
+            return Super::getPerformanceReport(format, outReport);
+        }
+
+        SLANG_NO_THROW SlangResult SLANG_MCALL getSpecializedEntryPointCodes(
+            slang::SpecializationArg const* specializationArgs,
+            SlangInt specializationArgCount,
+            SlangInt specializationArgSetCount,
+            SlangInt entryPointIndex,
+            SlangInt targetIndex,
+            slang::IBlob** outCodes,
+            slang::IBlob** outDiagnostics) SLANG_OVERRIDE
+        {
+            return Super::getSpecializedEntryPointCodes(
+                specializationArgs,
+                specializationArgCount,
+                specializationArgSetCount,
+                entryPointIndex,
+                targetIndex,
+                outCodes,
+                outDiagnostics);
+        }
+
         SLANG_NO_THROW SlangResult SLANG_MCALL link(
             slang::IComponentType** outLinkedComponentType,
             ISlangBlob** outDiagnostics) SLANG_OVERRIDE
@@ -864,6 +905,31 @@ namespace Slang
             return Super::renameEntryPoint(newName, outEntryPoint);
         }
 
+        SLANG_NO_THROW SlangResult SLANG_MCALL getPerformanceReport(
+            SlangPerformanceReportFormat format, ISlangBlob** outReport) SLANG_OVERRIDE
+        {
+            return Super::getPerformanceReport(format, outReport);
+        }
+
+        SLANG_NO_THROW SlangResult SLANG_MCALL getSpecializedEntryPointCodes(
+            slang::SpecializationArg const* specializationArgs,
+            SlangInt specializationArgCount,
+            SlangInt specializationArgSetCount,
+            SlangInt entryPointIndex,
+            SlangInt targetIndex,
+            slang::IBlob** outCodes,
+            slang::IBlob** outDiagnostics) SLANG_OVERRIDE
+        {
+            return Super::getSpecializedEntryPointCodes(
+                specializationArgs,
+                specializationArgCount,
+                specializationArgSetCount,
+                entryPointIndex,
+                targetIndex,
+                outCodes,
+                outDiagnostics);
+        }
+
         SLANG_NO_THROW SlangResult SLANG_MCALL link(
             slang::IComponentType**         outLinkedComponentType,
             ISlangBlob**                    outDiagnostics) SLANG_OVERRIDE
@@ -1080,6 +1146,31 @@ namespace Slang
             return Super::renameEntryPoint(newName, outEntryPoint);
         }
 
+        SLANG_NO_THROW SlangResult SLANG_MCALL getPerformanceReport(
+            SlangPerformanceReportFormat format, ISlangBlob** outReport) SLANG_OVERRIDE
+        {
+            return Super::getPerformanceReport(format, outReport);
+        }
+
+        SLANG_NO_THROW SlangResult SLANG_MCALL getSpecializedEntryPointCodes(
+            slang::SpecializationArg const* specializationArgs,
+            SlangInt specializationArgCount,
+            SlangInt specializationArgSetCount,
+            SlangInt entryPointIndex,
+            SlangInt targetIndex,
+            slang::IBlob** outCodes,
+            slang::IBlob** outDiagnostics) SLANG_OVERRIDE
+        {
+            return Super::getSpecializedEntryPointCodes(
+                specializationArgs,
+                specializationArgCount,
+                specializationArgSetCount,
+                entryPointIndex,
+                targetIndex,
+                outCodes,
+                outDiagnostics);
+        }
+
         SLANG_NO_THROW SlangResult SLANG_MCALL link(
             slang::IComponentType** outLinkedComponentType,
             ISlangBlob** outDiagnostics) SLANG_OVERRIDE
@@ -1234,6 +1325,31 @@ namespace Slang
             return Super::renameEntryPoint(newName, outEntryPoint);
         }
 
+        SLANG_NO_THROW SlangResult SLANG_MCALL getPerformanceReport(
+            SlangPerformanceReportFormat format, ISlangBlob** outReport) SLANG_OVERRIDE
+        {
+            return Super::getPerformanceReport(format, outReport);
+        }
+
+        SLANG_NO_THROW SlangResult SLANG_MCALL getSpecializedEntryPointCodes(
+            slang::SpecializationArg const* specializationArgs,
+            SlangInt specializationArgCount,
+            SlangInt specializationArgSetCount,
+            SlangInt entryPointIndex,
+            SlangInt targetIndex,
+            slang::IBlob** outCodes,
+            slang::IBlob** outDiagnostics) SLANG_OVERRIDE
+        {
+            return Super::getSpecializedEntryPointCodes(
+                specializationArgs,
+                specializationArgCount,
+                specializationArgSetCount,
+                entryPointIndex,
+                targetIndex,
+                outCodes,
+                outDiagnostics);
+        }
+
         SLANG_NO_THROW SlangResult SLANG_MCALL link(
             slang::IComponentType**         outLinkedComponentType,
             ISlangBlob**                    outDiagnostics) SLANG_OVERRIDE
@@ -1297,8 +1413,15 @@ namespace Slang
             /// Get the AST for the module (if it has been parsed)
         ModuleDecl* getModuleDecl() { return m_moduleDecl; }
 
-            /// The the IR for the module (if it has been generated)
-        IRModule* getIRModule() { return m_irModule; }
+            /// The the IR for the module (if it has been generated).
+            ///
+            /// If the module's global instructions are read lazily, they are all read first.
+        IRModule* getIRModule();
+
+            /// The IR for the module, without reading any global instructions that are read lazily.
+            ///
+            /// Linking only reads the globals it uses, through `IRModule::getLazyGlobalReader`.
+        IRModule* getIRModuleForLinking() { return m_irModule; }
 
             /// Get the list of other modules this module depends on
         List<Module*> const& getModuleDependencyList() { return m_moduleDependencyList.getModuleList(); }
@@ -1376,6 +1499,8 @@ namespace Slang
 
         List<RefPtr<EntryPoint>> const& getEntryPoints() { return m_entryPoints; }
         void _addEntryPoint(EntryPoint* entryPoint);
+            /// Add an entry point for each function of the module marked with a `[shader(...)]` attribute.
+        void _discoverEntryPoints(DiagnosticSink* sink);
         void _processFindDeclsExportSymbolsRec(Decl* decl);
 
     protected:
@@ -1746,6 +1871,23 @@ namespace Slang
 
         slang::SessionFlags m_flag = 0;
         void setFlags(slang::SessionFlags flags) { m_flag = flags; }
+
+            /// Enable or disable recording of per-phase timing information.
+        void setReportPerformance(bool enable);
+            /// Get the profiler recording per-phase timing information, or nullptr if not enabled.
+        CompileProfiler* getProfiler() { return m_profiler; }
+
+            /// Set the directory used to cache modules loaded via `import`. An empty path disables the cache.
+        void setModuleCachePath(const String& path);
+            /// Get the module cache, or nullptr if not enabled.
+        ModuleCache* getModuleCache() { return m_moduleCache; }
+            /// Get the cache of tokens lexed from files included during preprocessing.
+        PreprocessorTokenCache* getPreprocessorTokenCache() { return m_preprocessorTokenCache; }
+            /// Set the directory used to store the outputs of downstream compilers, in addition to memory.
+            /// An empty path means outputs are only cached in memory.
+        void setDownstreamCompileCachePath(const String& path) { m_downstreamCompileCache->setDirectory(path); }
+            /// Get the cache of outputs produced by downstream compilers
+        DownstreamCompileCache* getDownstreamCompileCache() { return m_downstreamCompileCache; }
         bool isInLanguageServer() { return contentAssistInfo.checkingMode != ContentAssistCheckingMode::None; }
 
             /// Get the parent session for this linkage
@@ -1858,6 +2000,13 @@ namespace Slang
             DiagnosticSink*     sink,
             const LoadedModuleDictionary* additionalLoadedModules);
 
+            /// Implements `loadModuleFromSource`, reporting diagnostics to `sink`
+        RefPtr<Module> loadModuleFromSource(
+            const char*     moduleName,
+            const char*     path,
+            ISlangBlob*     source,
+            DiagnosticSink* sink);
+
         void loadParsedModule(
             RefPtr<FrontEndCompileRequest>  compileRequest,
             RefPtr<TranslationUnitRequest>  translationUnit,
@@ -1972,6 +2121,17 @@ namespace Slang
 
         List<Type*> m_specializedTypes;
 
+            /// Records per-phase timing information. Only set if performance reporting is enabled.
+        RefPtr<CompileProfiler> m_profiler;
+
+            /// On-disk cache of checked modules. Only set if module caching is enabled.
+        RefPtr<ModuleCache> m_moduleCache;
+
+            /// Tokens lexed from included files, so they can be replayed rather than lexed again.
+        RefPtr<PreprocessorTokenCache> m_preprocessorTokenCache;
+
+            /// Outputs of downstream compilers, so identical compiles don't need to invoke the compiler again.
+        RefPtr<DownstreamCompileCache> m_downstreamCompileCache;
     };
 
         /// Shared functionality between front- and back-end compile requests.
@@ -2199,6 +2359,7 @@ namespace Slang
         TargetProgram(
             ComponentType*  componentType,
             TargetRequest*  targetReq);
+        ~TargetProgram();
 
             /// Get the underlying program
         ComponentType* getProgram() { return m_program; }
@@ -2250,7 +2411,8 @@ namespace Slang
 
         IArtifact* _createWholeProgramResult(
             DiagnosticSink*         sink,
-            EndToEndCompileRequest* endToEndReq = nullptr);
+            EndToEndCompileRequest* endToEndReq = nullptr,
+            ParallelDownstreamCompile* parallelDownstreamCompile = nullptr);
 
             /// Internal helper for `getOrCreateEntryPointResult`.
             ///
@@ -2259,10 +2421,21 @@ namespace Slang
             ///
             /// Shouldn't be called directly by most code.
             ///
+            /// If `parallelDownstreamCompile` is set, the result is being generated by one of its tasks.
+            ///
         IArtifact* _createEntryPointResult(
             Int                     entryPointIndex,
             DiagnosticSink*         sink,
-            EndToEndCompileRequest* endToEndReq = nullptr);
+            EndToEndCompileRequest* endToEndReq = nullptr,
+            ParallelDownstreamCompile* parallelDownstreamCompile = nullptr);
+
+            /// Make space to hold the result for `entryPointIndex`, such that `_createEntryPointResult`
+            /// doesn't need to. Used to create results for different entry points concurrently.
+        void _reserveEntryPointResult(Int entryPointIndex)
+        {
+            if (entryPointIndex >= m_entryPointResults.getCount())
+                m_entryPointResults.setCount(entryPointIndex + 1);
+        }
 
         RefPtr<IRModule> getOrCreateIRModuleForLayout(DiagnosticSink* sink);
 
@@ -2271,6 +2444,11 @@ namespace Slang
             return m_irModuleForLayout;
         }
 
+            /// Set symbols that have been built for the first IR modules linked for this program,
+            /// such that linking doesn't need to build them again (see `IRLinkSymbolTable`).
+        void setLinkSymbolTable(IRLinkSymbolTable* symbolTable);
+        IRLinkSymbolTable* getLinkSymbolTable() { return m_linkSymbolTable; }
+
     private:
         RefPtr<IRModule> createIRModuleForLayout(DiagnosticSink* sink);
 
@@ -2290,6 +2468,8 @@ namespace Slang
         List<ComPtr<IArtifact>> m_entryPointResults;
 
         RefPtr<IRModule> m_irModuleForLayout;
+
+        RefPtr<IRLinkSymbolTable> m_linkSymbolTable;
     };
 
         /// A back-end-specific object to track optional feaures/capabilities/extensions
@@ -2335,11 +2515,13 @@ namespace Slang
                 TargetProgram*              targetProgram,
                 EntryPointIndices const&    entryPointIndices,
                 DiagnosticSink*             sink,
-                EndToEndCompileRequest*     endToEndReq)
+                EndToEndCompileRequest*     endToEndReq,
+                ParallelDownstreamCompile*  parallelDownstreamCompile = nullptr)
                 : targetProgram(targetProgram)
                 , entryPointIndices(entryPointIndices)
                 , sink(sink)
                 , endToEndReq(endToEndReq)
+                , parallelDownstreamCompile(parallelDownstreamCompile)
             {}
 
 //            Shared(
@@ -2350,6 +2532,8 @@ namespace Slang
             EntryPointIndices       entryPointIndices;
             DiagnosticSink*         sink = nullptr;
             EndToEndCompileRequest* endToEndReq = nullptr;
+                /// Set if code is being generated by a task of a ParallelDownstreamCompile
+            ParallelDownstreamCompile* parallelDownstreamCompile = nullptr;
         };
 
         CodeGenContext(
@@ -2439,6 +2623,12 @@ namespace Slang
             return m_shared->endToEndReq;
         }
 
+            /// Get the ParallelDownstreamCompile that is generating code, or nullptr if code is being generated serially
+        ParallelDownstreamCompile* getParallelDownstreamCompile()
+        {
+            return m_shared->parallelDownstreamCompile;
+        }
+
         EndToEndCompileRequest* isPassThroughEnabled();
 
         Count getEntryPointCount()
@@ -2613,6 +2803,9 @@ namespace Slang
         virtual SLANG_NO_THROW SlangDiagnosticFlags SLANG_MCALL getDiagnosticFlags() SLANG_OVERRIDE;
         virtual SLANG_NO_THROW void SLANG_MCALL setDiagnosticFlags(SlangDiagnosticFlags flags) SLANG_OVERRIDE;
         virtual SLANG_NO_THROW void SLANG_MCALL setDebugInfoFormat(SlangDebugInfoFormat format) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW void SLANG_MCALL setReportPerformance(bool enable) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getPerformanceReport(SlangPerformanceReportFormat format, ISlangBlob** outReport) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW void SLANG_MCALL setDownstreamCompileThreadCount(int count) SLANG_OVERRIDE;
 
         EndToEndCompileRequest(
             Session* session);
@@ -2684,6 +2877,15 @@ namespace Slang
         
         String m_dependencyOutputPath;
 
+            /// If set, a table of per-phase timings is written to standard output after a command line compile
+        bool m_reportPerformance = false;
+            /// If set, per-phase timings are written as JSON to this path after a command line compile
+        String m_performanceReportOutputPath;
+
+            /// The number of threads used to generate code for entry points/targets.
+            /// 1 generates code serially, 0 (the default) uses a thread per hardware thread.
+        int m_downstreamCompileThreadCount = 0;
+
             /// Writes the modules in a container to the stream
         SlangResult writeContainerToStream(Stream* stream);
         
@@ -2779,6 +2981,9 @@ namespace Slang
         SlangResult _createContainer();
         SlangResult _completeContainer();
 
+            /// Write out the performance reports requested on the command line
+        SlangResult _writePerformanceReports();
+
         Session*                        m_session = nullptr;
         RefPtr<Linkage>                 m_linkage;
         DiagnosticSink                  m_sink;
@@ -2908,6 +3113,7 @@ namespace Slang
         SLANG_NO_THROW SlangPassThrough SLANG_MCALL getDownstreamCompilerForTransition(SlangCompileTarget source, SlangCompileTarget target) override;
         SLANG_NO_THROW double SLANG_MCALL getDownstreamCompilerElapsedTime() override
         {
+            std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
             return m_downstreamCompileTime;
         }
         
@@ -2976,6 +3182,10 @@ namespace Slang
             /// Get the built in linkage -> handy to get the stdlibs from
         Linkage* getBuiltinLinkage() const { return m_builtinLinkage; }
 
+            /// Get the type checking cache filled in while checking the stdlib, or nullptr if the stdlib
+            /// wasn't checked (for example because it was loaded). It isn't changed once the stdlib is loaded.
+        TypeCheckingCache* getStdlibTypeCheckingCache() const { return m_stdlibTypeCheckingCache; }
+
         Name* getCompletionRequestTokenName() const { return m_completionTokenName; }
 
         void init();
@@ -2986,7 +3196,11 @@ namespace Slang
             ISlangBlob*             sourceBlob);
         ~Session();
 
-        void addDownstreamCompileTime(double time) { m_downstreamCompileTime += time; }
+        void addDownstreamCompileTime(double time)
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+            m_downstreamCompileTime += time;
+        }
 
         ComPtr<ISlangSharedLibraryLoader> m_sharedLibraryLoader;                    ///< The shared library loader (never null)
 
@@ -2995,6 +3209,9 @@ namespace Slang
         RefPtr<DownstreamCompilerSet> m_downstreamCompilerSet;                                  ///< Information about all available downstream compilers.
         ComPtr<IDownstreamCompiler> m_downstreamCompilers[int(PassThroughMode::CountOf)];        ///< A downstream compiler for a pass through
         DownstreamCompilerLocatorFunc m_downstreamCompilerLocators[int(PassThroughMode::CountOf)];
+            /// Guards loading the downstream compilers, as linkages on different threads may need them.
+            /// Recursive as loading the generic C/C++ compiler loads the specific ones.
+        std::recursive_mutex m_downstreamCompilerMutex;
         Name* m_completionTokenName = nullptr; ///< The name of a completion request token.
 
     private:
@@ -3003,11 +3220,17 @@ namespace Slang
 
         SlangResult _readBuiltinModule(ISlangFileSystem* fileSystem, Scope* scope, String moduleName);
 
+            /// Make the stdlib safe to use from linkages on multiple threads, once it has been loaded or compiled.
+        void _prepareStdLibForSharedUse();
+
         SlangResult _loadRequest(EndToEndCompileRequest* request, const void* data, size_t size);
 
             /// Linkage used for all built-in (stdlib) code.
         RefPtr<Linkage> m_builtinLinkage;
 
+            /// The type checking cache of `m_builtinLinkage` once the stdlib has been loaded
+        TypeCheckingCache* m_stdlibTypeCheckingCache = nullptr;
+
         String m_downstreamCompilerPaths[int(PassThroughMode::CountOf)];         ///< Paths for each pass through
         String m_languagePreludes[int(SourceLanguage::CountOf)];                  ///< Prelude for each source language
         PassThroughMode m_defaultDownstreamCompilers[int(SourceLanguage::CountOf)];
@@ -82,6 +82,7 @@ DIAGNOSTIC(    26, Error, unknownOptimiziationLevel, "unknown optimization level
 DIAGNOSTIC(    27, Error, unknownDebugInfoLevel, "unknown debug info level '$0'")
 
 DIAGNOSTIC(    28, Error, unableToGenerateCodeForTarget, "unable to generate code for target '$0'")
+DIAGNOSTIC(    29, Error, invalidDownstreamCompileThreadCount, "invalid downstream compile thread count '$0'")
 
 DIAGNOSTIC(    30, Warning, sameStageSpecifiedMoreThanOnce, "the stage '$0' was specified more than once for entry point '$1'")
 DIAGNOSTIC(    31, Error, conflictingStagesForEntryPoint, "conflicting stages have been specified for entry point '$0'")
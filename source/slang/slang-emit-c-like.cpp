@@ -476,7 +476,7 @@ void CLikeSourceEmitter::emitTypeImpl(IRType* type, const StringSliceLoc* nameAn
 void CLikeSourceEmitter::emitType(IRType* type, Name* name)
 {
     SLANG_ASSERT(name);
-    StringSliceLoc nameAndLoc(name->text.getUnownedSlice());
+    StringSliceLoc nameAndLoc(name->text);
     emitType(type, &nameAndLoc);
 }
 
@@ -497,7 +497,7 @@ void CLikeSourceEmitter::emitType(IRType* type, Name* name, SourceLoc const& nam
 
     StringSliceLoc nameAndLoc;
     nameAndLoc.loc = nameLoc;
-    nameAndLoc.name = name->text.getUnownedSlice();
+    nameAndLoc.name = name->text;
     
     emitType(type, &nameAndLoc);
 }
@@ -3614,7 +3614,7 @@ void CLikeSourceEmitter::ensureInstOperandsRec(ComputeEmitActionsContext* ctx, I
 {
     ensureInstOperand(ctx, inst->getFullType());
 
-    UInt operandCount = inst->operandCount;
+    UInt operandCount = inst->getOperandCount();
     auto requiredLevel = EmitAction::Definition;
     switch (inst->getOp())
     {
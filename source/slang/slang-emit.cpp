@@ -36,6 +36,7 @@
 #include "slang-ir-lower-reinterpret.h"
 #include "slang-ir-loop-unroll.h"
 #include "slang-ir-metadata.h"
+#include "slang-ir-pass-manager.h"
 #include "slang-ir-optix-entry-point-uniforms.h"
 #include "slang-ir-restructure.h"
 #include "slang-ir-restructure-scoping.h"
@@ -201,6 +202,13 @@ Result linkAndOptimizeIR(
     // Get the artifact desc for the target 
     const auto artifactDesc = ArtifactDescUtil::makeDescForCompileTarget(asExternal(target));
 
+    // Time each pass, sampling the IR statistics of the linked module after each one
+    CompileProfiler* profiler = codeGenContext->getLinkage()->getProfiler();
+    CompileProfiler::Scope profileScope(profiler, "linkAndOptimizeIR");
+    CompileProfiler::PassSequence passes(profiler);
+    // Skips passes that can't have any new work, and passes that are run repeatedly
+    IRPassManager passManager(&passes);
+
     // We start out by performing "linking" at the level of the IR.
     // This step will create a fresh IR module to be used for
     // code generation, and will copy in any IR definitions that
@@ -209,10 +217,19 @@ Result linkAndOptimizeIR(
     // modules, and also select between the definitions of
     // any "profile-overloaded" symbols.
     //
+    passes.beginPass("linkIR");
     outLinkedIR = linkIR(codeGenContext);
     auto irModule = outLinkedIR.module;
     auto irEntryPoints = outLinkedIR.entryPoints;
 
+    passes.setIRModule(irModule);
+
+    if (profiler)
+    {
+        // Measured before specialization and optimization change the linked IR
+        profiler->addIRMemoryCounters(irModule);
+    }
+
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "LINKED");
 #endif
@@ -226,6 +243,7 @@ Result linkAndOptimizeIR(
 
     // Replace any global constants with their values.
     //
+    passes.beginPass("replaceGlobalConstants");
     replaceGlobalConstants(irModule);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL CONSTANTS REPLACED");
@@ -240,6 +258,7 @@ Result linkAndOptimizeIR(
     // shader parameters for those slots, to be wired up to
     // use sites.
     //
+    passes.beginPass("bindExistentialSlots");
     bindExistentialSlots(irModule, sink);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "EXISTENTIALS BOUND");
@@ -264,6 +283,7 @@ Result linkAndOptimizeIR(
     // can assume that all ordinary/uniform data is strictly
     // passed using constant buffers.
     //
+    passes.beginPass("collectGlobalUniformParameters");
     collectGlobalUniformParameters(irModule, outLinkedIR.globalScopeVarLayout);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL UNIFORMS COLLECTED");
@@ -285,6 +305,7 @@ Result linkAndOptimizeIR(
         case CodeGenTarget::HostCPPSource:
             break;
         case CodeGenTarget::CUDASource:
+            passes.beginPass("collectOptiXEntryPointUniformParams");
             collectOptiXEntryPointUniformParams(irModule);
             #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "OPTIX ENTRY POINT UNIFORMS COLLECTED");
@@ -295,6 +316,7 @@ Result linkAndOptimizeIR(
         case CodeGenTarget::CPPSource:
             passOptions.alwaysCreateCollectedParam = true;
         default:
+            passes.beginPass("collectEntryPointUniformParams");
             collectEntryPointUniformParams(irModule, passOptions);
         #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "ENTRY POINT UNIFORMS COLLECTED");
@@ -307,6 +329,7 @@ Result linkAndOptimizeIR(
     switch( target )
     {
     default:
+        passes.beginPass("moveEntryPointUniformParamsToGlobalScope");
         moveEntryPointUniformParamsToGlobalScope(irModule);
     #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "ENTRY POINT UNIFORMS MOVED");
@@ -319,16 +342,20 @@ Result linkAndOptimizeIR(
         break;
     }
 
+    passes.beginPass("lowerOptionalType");
     lowerOptionalType(irModule, sink);
-    simplifyIR(irModule);
+    passManager.run("simplifyIR", IRPassManager::Flag::Idempotent, [&]() { simplifyIR(irModule); });
 
     switch (target)
     {
     case CodeGenTarget::CPPSource:
     case CodeGenTarget::HostCPPSource:
     {
+        passes.beginPass("lowerComInterfaces");
         lowerComInterfaces(irModule, artifactDesc.style, sink);
+        passes.beginPass("generateDllImportFuncs");
         generateDllImportFuncs(codeGenContext->getTargetReq(), irModule, sink);
+        passes.beginPass("generateDllExportFuncs");
         generateDllExportFuncs(irModule, sink);
         break;
     }
@@ -336,11 +363,13 @@ Result linkAndOptimizeIR(
     }
 
     // Lower `Result<T,E>` types into ordinary struct types.
+    passes.beginPass("lowerResultType");
     lowerResultType(irModule, sink);
 
     // Desguar any union types, since these will be illegal on
     // various targets.
     //
+    passes.beginPass("desugarUnionTypes");
     desugarUnionTypes(irModule);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "UNIONS DESUGARED");
@@ -372,30 +401,36 @@ Result linkAndOptimizeIR(
     {
         bool changed = false;
 
+        // Each pass is skipped if nothing has changed since it last ran without finding
+        // anything to do, so a later iteration only repeats passes that can have new work.
         dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-SPECIALIZE");
         if (!codeGenContext->isSpecializationDisabled())
-            changed |= specializeModule(irModule);
+        {
+            passManager.run("specializeModule", IRPassManager::Flag::Idempotent, [&]() { changed |= specializeModule(irModule); });
+        }
         dumpIRIfEnabled(codeGenContext, irModule, "AFTER-SPECIALIZE");
 
-        eliminateDeadCode(irModule);
+        passManager.run("eliminateDeadCode", IRPassManager::Flag::Idempotent, [&]() { eliminateDeadCode(irModule); });
 
         validateIRModuleIfEnabled(codeGenContext, irModule);
     
         // Inline calls to any functions marked with [__unsafeInlineEarly] again,
         // since we may be missing out cases prevented by the functions that we just specialzied.
-        performMandatoryEarlyInlining(irModule);
+        passManager.run("performMandatoryEarlyInlining", [&]() { performMandatoryEarlyInlining(irModule); });
 
         // Unroll loops.
         if (codeGenContext->getSink()->getErrorCount() == 0)
         {
-            if (!unrollLoopsInModule(irModule, codeGenContext->getSink()))
+            bool unrolled = true;
+            passManager.run("unrollLoopsInModule", [&]() { unrolled = unrollLoopsInModule(irModule, codeGenContext->getSink()); });
+            if (!unrolled)
                 return SLANG_FAIL;
         }
 
 
         dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-AUTODIFF");
         enableIRValidationAtInsert();
-        changed |= processAutodiffCalls(irModule, sink);
+        passManager.run("processAutodiffCalls", [&]() { changed |= processAutodiffCalls(irModule, sink); });
         disableIRValidationAtInsert();
         dumpIRIfEnabled(codeGenContext, irModule, "AFTER-AUTODIFF");
 
@@ -403,16 +438,20 @@ Result linkAndOptimizeIR(
             break;
     }
 
+    passes.beginPass("finalizeAutoDiffPass");
     finalizeAutoDiffPass(irModule);
 
+    passes.beginPass("finalizeSpecialization");
     finalizeSpecialization(irModule);
 
     switch (target)
     {
     case CodeGenTarget::PyTorchCppBinding:
+        passes.beginPass("generatePyTorchCppBinding");
         generatePyTorchCppBinding(irModule, sink);
         break;
     case CodeGenTarget::CUDASource:
+        passes.beginPass("removeTorchKernels");
         removeTorchKernels(irModule);
         break;
     default:
@@ -426,18 +465,21 @@ Result linkAndOptimizeIR(
     {
         // We could fail because
         // 1) It's not inlinable for some reason (for example if it's recursive)
+        passes.beginPass("performStringInlining");
         SLANG_RETURN_ON_FAIL(performStringInlining(irModule, sink));
     }
 
+    passes.beginPass("lowerReinterpret");
     lowerReinterpret(targetRequest, irModule, sink);
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
-    simplifyIR(irModule);
+    passManager.run("simplifyIR", IRPassManager::Flag::Idempotent, [&]() { simplifyIR(irModule); });
 
     if (!ArtifactDescUtil::isCpuLikeTarget(artifactDesc))
     {
         // We could fail because (perhaps, somehow) end up with getStringHash that the operand is not a string literal
+        passes.beginPass("checkGetStringHashInsts");
         SLANG_RETURN_ON_FAIL(checkGetStringHashInsts(irModule, sink));
     }
 
@@ -445,6 +487,7 @@ Result linkAndOptimizeIR(
     // generics / interface types to ordinary functions and types using
     // function pointers.
     dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-LOWER-GENERICS");
+    passes.beginPass("lowerGenerics");
     lowerGenerics(targetRequest, irModule, sink);
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER-LOWER-GENERICS");
 
@@ -460,13 +503,14 @@ Result linkAndOptimizeIR(
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Inline calls to any functions marked with [__unsafeInlineEarly] or [ForceInline].
+    passes.beginPass("performForceInlining");
     performForceInlining(irModule);
 
     // Specialization can introduce dead code that could trip
     // up downstream passes like type legalization, so we
     // will run a DCE pass to clean up after the specialization.
     //
-    simplifyIR(irModule);
+    passManager.run("simplifyIR", IRPassManager::Flag::Idempotent, [&]() { simplifyIR(irModule); });
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER DCE");
@@ -502,9 +546,11 @@ Result linkAndOptimizeIR(
         //  we need to replace it with just an `X`, after which we
         //  will have (more) legal shader code.
         //
+        passes.beginPass("legalizeExistentialTypeLayout");
         legalizeExistentialTypeLayout(
             irModule,
             sink);
+        passes.beginPass("eliminateDeadCode");
         eliminateDeadCode(irModule);
 
 #if 0
@@ -523,9 +569,11 @@ Result linkAndOptimizeIR(
         // What used to be individual variables/parameters/arguments/etc.
         // then become multiple variables/parameters/arguments/etc.
         //
+        passes.beginPass("legalizeResourceTypes");
         legalizeResourceTypes(
             irModule,
             sink);
+        passes.beginPass("eliminateDeadCode");
         eliminateDeadCode(irModule);
 
         //  Debugging output of legalization
@@ -540,7 +588,7 @@ Result linkAndOptimizeIR(
     // to see if we can clean up any temporaries created by legalization.
     // (e.g., things that used to be aggregated might now be split up,
     // so that we can work with the individual fields).
-    simplifyIR(irModule);
+    passManager.run("simplifyIR", IRPassManager::Flag::Idempotent, [&]() { simplifyIR(irModule); });
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER SSA");
@@ -556,23 +604,27 @@ Result linkAndOptimizeIR(
     // resource types can be used, so that having them as
     // function parameters, reults, etc. is invalid.
     // We clean up the usages of resource values here.
+    passes.beginPass("specializeResourceUsage");
     specializeResourceUsage(codeGenContext, irModule);
+    passes.beginPass("specializeFuncsForBufferLoadArgs");
     specializeFuncsForBufferLoadArgs(codeGenContext, irModule);
 
     //
-    simplifyIR(irModule);
+    passManager.run("simplifyIR", IRPassManager::Flag::Idempotent, [&]() { simplifyIR(irModule); });
 
     // For GLSL targets, we also want to specialize calls to functions that
     // takes array parameters if possible, to avoid performance issues on
     // those platforms.
     if (isKhronosTarget(targetRequest))
     {
+        passes.beginPass("specializeArrayParameters");
         specializeArrayParameters(codeGenContext, irModule);
-        simplifyIR(irModule);
+        passManager.run("simplifyIR", IRPassManager::Flag::Idempotent, [&]() { simplifyIR(irModule); });
     }
 
     // Rewrite functions that return arrays to return them via `out` parameter,
     // since our target languages doesn't allow returning arrays.
+    passes.beginPass("legalizeArrayReturnType");
     legalizeArrayReturnType(irModule);
 
 #if 0
@@ -592,6 +644,7 @@ Result linkAndOptimizeIR(
     {
     case CodeGenTarget::HLSL:
         {
+            passes.beginPass("wrapStructuredBuffersOfMatrices");
             wrapStructuredBuffersOfMatrices(irModule);
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "STRUCTURED BUFFERS WRAPPED");
@@ -689,6 +742,7 @@ Result linkAndOptimizeIR(
             break;
         }
 
+        passes.beginPass("legalizeByteAddressBufferOps");
         legalizeByteAddressBufferOps(session, targetRequest, irModule, byteAddressBufferOptions);
     }
 
@@ -701,6 +755,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CUDASource:
     case CodeGenTarget::PTX:
         {
+            passes.beginPass("synthesizeActiveMask");
             synthesizeActiveMask(
                 irModule,
                 codeGenContext->getSink());
@@ -730,6 +785,7 @@ Result linkAndOptimizeIR(
     {
         auto glslExtensionTracker = as<GLSLExtensionTracker>(options.sourceEmitter->getExtensionTracker());
 
+        passes.beginPass("legalizeEntryPointsForGLSL");
         legalizeEntryPointsForGLSL(
             session,
             irModule,
@@ -747,12 +803,14 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CSource:
     case CodeGenTarget::CPPSource:
         {
+            passes.beginPass("legalizeEntryPointVaryingParamsForCPU");
             legalizeEntryPointVaryingParamsForCPU(irModule, codeGenContext->getSink());
         }
         break;
 
     case CodeGenTarget::CUDASource:
         {
+            passes.beginPass("legalizeEntryPointVaryingParamsForCUDA");
             legalizeEntryPointVaryingParamsForCUDA(irModule, codeGenContext->getSink());
         }
         break;
@@ -766,6 +824,7 @@ Result linkAndOptimizeIR(
     {
     case CodeGenTarget::GLSL:
         {
+            passes.beginPass("legalizeImageSubscriptForGLSL");
             legalizeImageSubscriptForGLSL(irModule);
         }
         break;
@@ -780,10 +839,13 @@ Result linkAndOptimizeIR(
 
     case CodeGenTarget::CPPSource:
     case CodeGenTarget::CUDASource:
+        passes.beginPass("moveGlobalVarInitializationToEntryPoints");
         moveGlobalVarInitializationToEntryPoints(irModule);
+        passes.beginPass("introduceExplicitGlobalContext");
         introduceExplicitGlobalContext(irModule, target);
         if(target == CodeGenTarget::CPPSource)
         {
+            passes.beginPass("convertEntryPointPtrParamsToRawPtrs");
             convertEntryPointPtrParamsToRawPtrs(irModule);
         }
     #if 0
@@ -793,11 +855,13 @@ Result linkAndOptimizeIR(
         break;
     }
 
+    passes.beginPass("stripCachedDictionaries");
     stripCachedDictionaries(irModule);
 
     // TODO: our current dynamic dispatch pass will remove all uses of witness tables.
     // If we are going to support function-pointer based, "real" modular dynamic dispatch,
     // we will need to disable this pass.
+    passes.beginPass("stripWitnessTables");
     stripWitnessTables(irModule);
 
 #if 0
@@ -813,12 +877,13 @@ Result linkAndOptimizeIR(
     //
     // We run IR simplification passes again to clean things up.
     //
-    simplifyIR(irModule);
+    passManager.run("simplifyIR", IRPassManager::Flag::Idempotent, [&]() { simplifyIR(irModule); });
 
     if (isKhronosTarget(targetRequest))
     {
         // As a fallback, if the above specialization steps failed to remove resource type parameters, we will
         // inline the functions in question to make sure we can produce valid GLSL.
+        passes.beginPass("performGLSLResourceReturnFunctionInlining");
         performGLSLResourceReturnFunctionInlining(irModule);
     }
 #if 0
@@ -826,6 +891,7 @@ Result linkAndOptimizeIR(
 #endif
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
+    passes.beginPass("cleanUpVoidType");
     cleanUpVoidType(irModule);
 
     // For some small improvement in type safety we represent these as opaque
@@ -833,13 +899,16 @@ Result linkAndOptimizeIR(
     //
     // If any have survived this far, change them back to regular (decorated)
     // arrays that the emitters can deal with.
+    passes.beginPass("legalizeMeshOutputTypes");
     legalizeMeshOutputTypes(irModule);
 
     // Lower all bit_cast operations on complex types into leaf-level
     // bit_cast on basic types.
+    passes.beginPass("lowerBitCast");
     lowerBitCast(targetRequest, irModule);
-    simplifyIR(irModule);
+    passManager.run("simplifyIR", IRPassManager::Flag::Idempotent, [&]() { simplifyIR(irModule); });
 
+    passes.beginPass("eliminateMultiLevelBreak");
     eliminateMultiLevelBreak(irModule);
 
     // As a late step, we need to take the SSA-form IR and move things *out*
@@ -849,6 +918,8 @@ Result linkAndOptimizeIR(
     // complexities of blocks with parameters.
     //
     {
+        passes.beginPass("eliminatePhis");
+
         // Get the liveness mode.
         const LivenessMode livenessMode = codeGenContext->shouldTrackLiveness() ? LivenessMode::Enabled : LivenessMode::Disabled;
         //
@@ -906,11 +977,13 @@ Result linkAndOptimizeIR(
     {
         if (isKhronosTarget(targetRequest))
         {
+            passes.beginPass("applyGLSLLiveness");
             applyGLSLLiveness(irModule);
         }
     }
 
     // Run a final round of simplifications to clean up unused things after phi-elimination.
+    passes.beginPass("simplifyNonSSAIR");
     simplifyNonSSAIR(irModule);
 
     // We include one final step to (optionally) dump the IR and validate
@@ -925,10 +998,16 @@ Result linkAndOptimizeIR(
     auto metadata = new ArtifactPostEmitMetadata;
     outLinkedIR.metadata = metadata;
 
+    passes.beginPass("collectMetadata");
     collectMetadata(irModule, *metadata);
 
     outLinkedIR.metadata = metadata;
 
+    if (profiler)
+    {
+        profiler->addIRDeduplicationCounters(irModule);
+    }
+
     return SLANG_OK;
 }
 
@@ -942,6 +1021,9 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
     auto target = getTargetFormat();
     auto targetRequest = getTargetReq();
 
+    CompileProfiler* profiler = getLinkage()->getProfiler();
+    CompileProfiler::Scope profileScope(profiler, "emitEntryPointsSourceFromIR");
+
     auto lineDirectiveMode = targetRequest->getLineDirectiveMode();
     // To try to make the default behavior reasonable, we will
     // always use C-style line directives (to give the user
@@ -1053,8 +1135,11 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
             linkedIR));
         
         auto irModule = linkedIR.module;
-        
+
+        CompileProfiler::PassSequence passes(profiler, irModule);
+
         // Perform final simplifications to help emit logic to generate more compact code.
+        passes.beginPass("simplifyForEmit");
         simplifyForEmit(irModule, targetRequest);
 
         metadata = linkedIR.metadata;
@@ -1063,6 +1148,7 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
         // passes have been performed, we can emit target code from
         // the IR module.
         //
+        passes.beginPass("emitModule");
         sourceEmitter->emitModule(irModule, sink);
     }
 
@@ -1192,7 +1278,10 @@ SlangResult emitSPIRVForEntryPointsDirectly(
     auto irEntryPoints = linkedIR.entryPoints;
 
     List<uint8_t> spirv;
-    emitSPIRVFromIR(codeGenContext, irModule, irEntryPoints, spirv);
+    {
+        CompileProfiler::Scope profileScope(codeGenContext->getLinkage()->getProfiler(), "emitSPIRVFromIR");
+        emitSPIRVFromIR(codeGenContext, irModule, irEntryPoints, spirv);
+    }
 
     auto artifact = ArtifactUtil::createArtifactForCompileTarget(asExternal(codeGenContext->getTargetFormat()));
     artifact->addRepresentationUnknown(ListBlob::moveCreate(spirv));
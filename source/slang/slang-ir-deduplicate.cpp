@@ -9,6 +9,7 @@ namespace Slang
 
         m_globalValueNumberingMap.Clear();
         m_constantMap.Clear();
+        m_stats = Stats();
     }
 
     void IRDeduplicationContext::removeHoistableInstFromGlobalNumberingMap(IRInst* instToRemove)
@@ -22,12 +22,6 @@ EntryPointLayout* findEntryPointLayout(
     ProgramLayout*          programLayout,
     EntryPoint*             entryPoint);
 
-struct IRSpecSymbol : RefObject
-{
-    IRInst*                 irGlobalValue;
-    RefPtr<IRSpecSymbol>    nextWithSameName;
-};
-
 struct IRSpecEnv
 {
     IRSpecEnv*  parent = nullptr;
@@ -54,6 +48,10 @@ struct IRSharedSpecContext
     typedef Dictionary<String, RefPtr<IRSpecSymbol>> SymbolDictionary;
     SymbolDictionary symbols;
 
+    // If set, holds the symbols of the first modules being linked,
+    // and `symbols` only holds the symbols of the remaining modules.
+    IRLinkSymbolTable* baseSymbols = nullptr;
+
     IRBuilder builderStorage;
 
     // The "global" specialization environment.
@@ -68,7 +66,16 @@ struct IRSpecContextBase
 
     IRModule* getModule() { return getShared()->module; }
 
-    IRSharedSpecContext::SymbolDictionary& getSymbols() { return getShared()->symbols; }
+    // Get the symbols with `mangledName`, or nullptr if there are none.
+    IRSpecSymbol* findSymbols(String const& mangledName)
+    {
+        auto shared = getShared();
+        if (auto sym = shared->symbols.TryGetValue(mangledName))
+            return *sym;
+        if (shared->baseSymbols)
+            return shared->baseSymbols->findSymbols(mangledName);
+        return nullptr;
+    }
 
     // The current specialization environment to use.
     IRSpecEnv* env = nullptr;
@@ -137,7 +144,7 @@ void registerClonedValue(
     registerClonedValue(context, clonedValue, originalValues.originalVal);
     for( auto s = originalValues.sym; s; s = s->nextWithSameName )
     {
-        registerClonedValue(context, clonedValue, s->irGlobalValue);
+        registerClonedValue(context, clonedValue, s->getGlobalValue());
     }
 }
 
@@ -484,7 +491,7 @@ static void cloneExtraDecorations(
 
     for(auto sym = originalValues.sym; sym; sym = sym->nextWithSameName)
     {
-        cloneExtraDecorationsFromInst(context, builder, clonedInst, sym->irGlobalValue);
+        cloneExtraDecorationsFromInst(context, builder, clonedInst, sym->getGlobalValue());
     }
 }
 
@@ -577,7 +584,7 @@ IRGeneric* cloneGenericImpl(
     for (auto originalSym = originalValues.sym; originalSym;
         originalSym = originalSym->nextWithSameName.get())
     {
-        auto originalGeneric = as<IRGeneric>(originalSym->irGlobalValue);
+        auto originalGeneric = as<IRGeneric>(originalSym->getGlobalValue());
         if (!originalGeneric)
             continue;
         auto originalInnerVal = findGenericReturnVal(originalGeneric);
@@ -890,12 +897,13 @@ IRFunc* specializeIRForEntryPoint(
     // so that the mangled name of the decl-ref is
     // not the same as the mangled name of the decl.
     //
-    RefPtr<IRSpecSymbol> sym;
-    if (!context->getSymbols().TryGetValue(mangledName, sym))
+    RefPtr<IRSpecSymbol> sym = context->findSymbols(mangledName);
+    if (!sym)
     {
         String hashedName = getHashedName(mangledName.getUnownedSlice());
 
-        if (!context->getSymbols().TryGetValue(hashedName, sym))
+        sym = context->findSymbols(hashedName);
+        if (!sym)
         {
             SLANG_UNEXPECTED("no matching IR symbol");
             return nullptr;
@@ -911,7 +919,7 @@ IRFunc* specializeIRForEntryPoint(
     // follow the linkage decoration and discover the
     // other values on its own.
     //
-    auto originalVal = sym->irGlobalValue;
+    auto originalVal = sym->getGlobalValue();
 
     // We will start by cloning the entry point reference
     // like any other global value.
@@ -1262,8 +1270,8 @@ IRInst* cloneGlobalValueWithLinkage(
     // to pick the "best" one for our target.
 
     auto mangledName = String(originalLinkage->getMangledName());
-    RefPtr<IRSpecSymbol> sym;
-    if( !context->getSymbols().TryGetValue(mangledName, sym) )
+    RefPtr<IRSpecSymbol> sym = context->findSymbols(mangledName);
+    if( !sym )
     {
         if(!originalVal)
             return nullptr;
@@ -1282,7 +1290,7 @@ IRInst* cloneGlobalValueWithLinkage(
     IRInst* bestVal = nullptr;
     for(IRSpecSymbol* ss = sym; ss; ss = ss->nextWithSameName )
     {
-        IRInst* newVal = ss->irGlobalValue;
+        IRInst* newVal = ss->getGlobalValue();
         if (isBetterForTarget(context, newVal, bestVal))
             bestVal = newVal;
     }
@@ -1320,33 +1328,87 @@ IRInst* cloneGlobalValue(IRSpecContext* context, IRInst* originalVal)
         originalVal->findDecoration<IRLinkageDecoration>());
 }
 
-void insertGlobalValueSymbol(
-    IRSharedSpecContext*    sharedContext,
-    IRInst*                 gv)
+static RefPtr<IRSpecSymbol> _createSymbol(IRInst* gv)
 {
-    auto linkage = gv->findDecoration<IRLinkageDecoration>();
-
-    // Don't try to register a symbol for global values
-    // that don't have linkage.
-    //
-    if (!linkage)
-        return;
-
-    auto mangledName = String(linkage->getMangledName());
-
     RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
     sym->irGlobalValue = gv;
+    return sym;
+}
 
+    /// Create a symbol for the global at `index` in `reader`, which is only read when used
+static RefPtr<IRSpecSymbol> _createLazySymbol(IRLazyGlobalReader* reader, Index index)
+{
+    RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
+    sym->lazyReader = reader;
+    sym->lazyGlobalIndex = index;
+    return sym;
+}
+
+static void _insertSymbol(
+    IRSharedSpecContext::SymbolDictionary&  symbols,
+    String const&                           mangledName,
+    IRSpecSymbol*                           sym)
+{
     RefPtr<IRSpecSymbol> prev;
-    if (sharedContext->symbols.TryGetValue(mangledName, prev))
+    if (symbols.TryGetValue(mangledName, prev))
     {
         sym->nextWithSameName = prev->nextWithSameName;
         prev->nextWithSameName = sym;
     }
     else
     {
-        sharedContext->symbols.Add(mangledName, sym);
+        symbols.Add(mangledName, sym);
+    }
+}
+
+static void _insertSharedSymbol(
+    IRSharedSpecContext*    sharedContext,
+    String const&           mangledName,
+    IRSpecSymbol*           sym)
+{
+    // The symbols in the base table are shared between links, so can't
+    // be modified. If the name has symbols there, we start from a copy
+    // of them (in the same order) so the result is as if all the
+    // symbols had been added here.
+    //
+    if (sharedContext->baseSymbols && !sharedContext->symbols.ContainsKey(mangledName))
+    {
+        if (auto baseSym = sharedContext->baseSymbols->findSymbols(mangledName))
+        {
+            RefPtr<IRSpecSymbol> head;
+            IRSpecSymbol* tail = nullptr;
+            for (auto ss = baseSym; ss; ss = ss->nextWithSameName)
+            {
+                RefPtr<IRSpecSymbol> copy = new IRSpecSymbol();
+                copy->irGlobalValue = ss->irGlobalValue;
+                copy->lazyReader = ss->lazyReader;
+                copy->lazyGlobalIndex = ss->lazyGlobalIndex;
+                if (tail)
+                    tail->nextWithSameName = copy;
+                else
+                    head = copy;
+                tail = copy;
+            }
+            sharedContext->symbols.Add(mangledName, head);
+        }
     }
+
+    _insertSymbol(sharedContext->symbols, mangledName, sym);
+}
+
+void insertGlobalValueSymbol(
+    IRSharedSpecContext*    sharedContext,
+    IRInst*                 gv)
+{
+    auto linkage = gv->findDecoration<IRLinkageDecoration>();
+
+    // Don't try to register a symbol for global values
+    // that don't have linkage.
+    //
+    if (!linkage)
+        return;
+
+    _insertSharedSymbol(sharedContext, String(linkage->getMangledName()), _createSymbol(gv));
 }
 
 void insertGlobalValueSymbols(
@@ -1356,6 +1418,24 @@ void insertGlobalValueSymbols(
     if (!originalModule)
         return;
 
+    // If the globals of the module are read lazily, the symbols are
+    // created from what is known about them before they are read, and
+    // a global is only read if its symbol is used.
+    //
+    if (auto reader = originalModule->getLazyGlobalReader())
+    {
+        const Index count = reader->getGlobalCount();
+        for (Index i = 0; i < count; ++i)
+        {
+            const auto mangledName = reader->getGlobalMangledName(i);
+            if (mangledName.getLength())
+            {
+                _insertSharedSymbol(sharedContext, String(mangledName), _createLazySymbol(reader, i));
+            }
+        }
+        return;
+    }
+
     for(auto ii : originalModule->getGlobalInsts())
     {
         insertGlobalValueSymbol(sharedContext, ii);
@@ -1423,6 +1503,158 @@ static bool _isPublicOrHLSLExported(IRInst* inst)
     return false;
 }
 
+    /// Get the globals of `module` that every link against it uses, in module order. These are
+    /// found by iterating over the globals of the module rather than by symbol: generic parameter
+    /// bindings, public or exported globals, and hashed string literals.
+    ///
+    /// If the globals of `module` are read lazily, only these are read. The globals of the module
+    /// instruction aren't iterated, as another link may be reading globals into it.
+static void _findGlobalsUsedByEveryLink(IRModule* module, List<IRInst*>& outInsts)
+{
+    if (!module)
+        return;
+
+    if (auto reader = module->getLazyGlobalReader())
+    {
+        const Index count = reader->getGlobalCount();
+        for (Index i = 0; i < count; ++i)
+        {
+            const auto op = reader->getGlobalOp(i);
+            if (op == kIROp_BindGlobalGenericParam ||
+                op == kIROp_GlobalHashedStringLiterals ||
+                reader->globalHasDecoration(i, kIROp_PublicDecoration) ||
+                reader->globalHasDecoration(i, kIROp_HLSLExportDecoration))
+            {
+                outInsts.add(reader->readGlobal(i));
+            }
+        }
+        return;
+    }
+
+    for (auto inst : module->getGlobalInsts())
+    {
+        if (as<IRBindGlobalGenericParam>(inst) ||
+            as<IRGlobalHashedStringLiterals>(inst) ||
+            _isPublicOrHLSLExported(inst))
+        {
+            outInsts.add(inst);
+        }
+    }
+}
+
+    /// Add the strings of the hashed string literals in `insts` to `ioPool`
+static void _addHashedStringLiterals(List<IRInst*> const& insts, StringSlicePool& ioPool)
+{
+    for (auto inst : insts)
+    {
+        if (auto hashedStringLits = as<IRGlobalHashedStringLiterals>(inst))
+        {
+            const Index count = hashedStringLits->getOperandCount();
+            for (Index i = 0; i < count; ++i)
+            {
+                ioPool.add(as<IRStringLit>(hashedStringLits->getOperand(i))->getStringSlice());
+            }
+        }
+    }
+}
+
+    /// Add the stdlib modules, followed by the modules of `program`, to `ioModules`
+static void _addStdLibAndProgramIRModules(
+    ComponentType*      program,
+    List<IRModule*>&    ioModules)
+{
+    auto linkage = program->getLinkage();
+
+    auto& stdlibModules = static_cast<Session*>(linkage->getGlobalSession())->stdlibModules;
+    for (auto& m : stdlibModules)
+        ioModules.add(m->getIRModuleForLinking());
+
+    program->enumerateIRModules([&](IRModule* irModule)
+    {
+        ioModules.add(irModule);
+    });
+}
+
+void IRLinkSymbolTable::addModule(IRModule* module)
+{
+    m_modules.add(module);
+    if (!module)
+        return;
+
+    // If the globals of the module are read lazily, a global is only
+    // read when its symbol is first used.
+    //
+    if (auto reader = module->getLazyGlobalReader())
+    {
+        const Index count = reader->getGlobalCount();
+        for (Index i = 0; i < count; ++i)
+        {
+            const auto mangledName = reader->getGlobalMangledName(i);
+            if (mangledName.getLength())
+            {
+                _insertSymbol(m_symbols, String(mangledName), _createLazySymbol(reader, i));
+            }
+        }
+    }
+    else
+    {
+        for (auto inst : module->getGlobalInsts())
+        {
+            if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+            {
+                _insertSymbol(m_symbols, String(linkage->getMangledName()), _createSymbol(inst));
+            }
+        }
+    }
+
+    List<IRInst*> insts;
+    _findGlobalsUsedByEveryLink(module, insts);
+    for (auto inst : insts)
+    {
+        if (as<IRBindGlobalGenericParam>(inst))
+        {
+            m_bindGlobalGenericParams.add(inst);
+        }
+        if (_isPublicOrHLSLExported(inst))
+        {
+            m_publicOrExportedInsts.add(inst);
+        }
+    }
+    _addHashedStringLiterals(insts, m_hashedStringLiterals);
+}
+
+bool IRLinkSymbolTable::isPrefixOf(List<IRModule*> const& modules) const
+{
+    const Index count = m_modules.getCount();
+    if (count > modules.getCount())
+        return false;
+    for (Index i = 0; i < count; ++i)
+    {
+        if (m_modules[i].Ptr() != modules[i])
+            return false;
+    }
+    return true;
+}
+
+IRSpecSymbol* IRLinkSymbolTable::findSymbols(String const& mangledName)
+{
+    auto sym = m_symbols.TryGetValue(mangledName);
+    return sym ? sym->Ptr() : nullptr;
+}
+
+RefPtr<IRLinkSymbolTable> createLinkSymbolTable(ComponentType* program)
+{
+    List<IRModule*> irModules;
+    _addStdLibAndProgramIRModules(program, irModules);
+
+    RefPtr<IRLinkSymbolTable> symbolTable = new IRLinkSymbolTable();
+    for (IRModule* irModule : irModules)
+    {
+        symbolTable->addModule(irModule);
+    }
+    return symbolTable;
+}
+
 LinkedIR linkIR(
     CodeGenContext* codeGenContext)
 {
@@ -1463,16 +1695,10 @@ LinkedIR linkIR(
 
     List<IRModule*> irModules;
 
-    // Link stdlib modules.
-    auto& stdlibModules = static_cast<Session*>(linkage->getGlobalSession())->stdlibModules;
-    for (auto& m : stdlibModules)
-        irModules.add(m->getIRModule());
+    // Link stdlib modules and modules in the program.
+    _addStdLibAndProgramIRModules(program, irModules);
 
-    // Link modules in the program.
-    program->enumerateIRModules([&](IRModule* irModule)
-    {
-        irModules.add(irModule);
-    });
+    // Add any modules that were loaded as libraries
     for (IArtifact* artifact : linkage->m_libModules)
     {
         if (auto library = findRepresentation<ModuleLibrary>(artifact))
@@ -1480,11 +1706,31 @@ LinkedIR linkIR(
             irModules.addRange(library->m_modules.getBuffer()->readRef(), library->m_modules.getCount());
         }
     }
-    
-    // Add any modules that were loaded as libraries
-    for (IRModule* irModule : irModules)
+
+    // If a symbol table has been built for the first modules (such
+    // as when linking many specializations of the same program), we
+    // use it for those, and only need to add the remaining modules.
+    //
+    auto symbolTable = targetProgram->getLinkSymbolTable();
+    if (symbolTable && !symbolTable->isPrefixOf(irModules))
+    {
+        symbolTable = nullptr;
+    }
+    const Index firstUnsharedModuleIndex = symbolTable ? symbolTable->getModules().getCount() : 0;
+    sharedContext->baseSymbols = symbolTable;
+
+    for (Index i = firstUnsharedModuleIndex; i < irModules.getCount(); ++i)
+    {
+        insertGlobalValueSymbols(sharedContext, irModules[i]);
+    }
+
+    // The globals of the modules not in the symbol table that are used by
+    // every link (see `_findGlobalsUsedByEveryLink`).
+    //
+    List<IRInst*> unsharedInstsUsedByEveryLink;
+    for (Index i = firstUnsharedModuleIndex; i < irModules.getCount(); ++i)
     {
-        insertGlobalValueSymbols(sharedContext, irModule);
+        _findGlobalsUsedByEveryLink(irModules[i], unsharedInstsUsedByEveryLink);
     }
 
     // We will also insert the IR global symbols from the IR module
@@ -1500,10 +1746,14 @@ LinkedIR linkIR(
     // Combine all of the contents of IRGlobalHashedStringLiterals
     {
         StringSlicePool pool(StringSlicePool::Style::Empty);
-        for (IRModule* irModule : irModules)
+        if (symbolTable)
         {
-            findGlobalHashedStringLiterals(irModule, pool);
+            for (auto slice : symbolTable->getHashedStringLiterals().getAdded())
+            {
+                pool.add(slice);
+            }
         }
+        _addHashedStringLiterals(unsharedInstsUsedByEveryLink, pool);
         addGlobalHashedStringLiterals(pool, state->irModule);
     }
 
@@ -1562,30 +1812,42 @@ LinkedIR linkIR(
     // instructions in all the input modules.
     //
     
-    for (IRModule* irModule : irModules)
+    if (symbolTable)
     {
-        for (auto inst : irModule->getGlobalInsts())
+        for (auto bindInst : symbolTable->getBindGlobalGenericParams())
         {
-            if (auto bindInst = as<IRBindGlobalGenericParam>(inst))
-            {
-                cloneValue(context, bindInst);
-            }
+            cloneValue(context, bindInst);
+        }
+    }
+    for (auto inst : unsharedInstsUsedByEveryLink)
+    {
+        if (auto bindInst = as<IRBindGlobalGenericParam>(inst))
+        {
+            cloneValue(context, bindInst);
         }
     }
 
-    for (IRModule* irModule : irModules)
+    auto clonePublicOrExported = [&](IRInst* inst)
     {
-        for (auto inst : irModule->getGlobalInsts())
+        auto cloned = cloneValue(context, inst);
+        if (!cloned->findDecorationImpl(kIROp_KeepAliveDecoration))
         {
-            // Is it `public` or (HLSL) `export` clone
-            if (_isPublicOrHLSLExported(inst))
-            {
-                auto cloned = cloneValue(context, inst);
-                if (!cloned->findDecorationImpl(kIROp_KeepAliveDecoration))
-                {
-                    context->builder->addKeepAliveDecoration(cloned);
-                }
-            }
+            context->builder->addKeepAliveDecoration(cloned);
+        }
+    };
+    if (symbolTable)
+    {
+        for (auto inst : symbolTable->getPublicOrExportedInsts())
+        {
+            clonePublicOrExported(inst);
+        }
+    }
+    for (auto inst : unsharedInstsUsedByEveryLink)
+    {
+        // Is it `public` or (HLSL) `export` clone
+        if (_isPublicOrHLSLExported(inst))
+        {
+            clonePublicOrExported(inst);
         }
     }
 
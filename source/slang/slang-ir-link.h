@@ -2,6 +2,9 @@
 #pragma once
 
 #include "slang-compiler.h"
+#include "slang-ir.h"
+
+#include "../core/slang-string-slice-pool.h"
 
 #include "../compiler-core/slang-artifact-associated.h"
 
@@ -9,6 +12,66 @@ namespace Slang
 {
     struct IRVarLayout;
 
+    struct IRSpecSymbol : RefObject
+    {
+            /// Get the global value, reading it first if it is in a module that is read lazily
+        IRInst* getGlobalValue() { return lazyReader ? lazyReader->readGlobal(lazyGlobalIndex) : irGlobalValue; }
+
+        IRInst*                 irGlobalValue = nullptr;
+        IRLazyGlobalReader*     lazyReader = nullptr;       ///< If set, the global value is read from here
+        Index                   lazyGlobalIndex = -1;       ///< The index of the global value in the lazyReader
+        RefPtr<IRSpecSymbol>    nextWithSameName;
+    };
+
+        /// The symbols of the global values of a list of IR modules, for use by `linkIR`.
+        ///
+        /// Linking has to be able to find the definitions of every global value in the modules
+        /// being linked, which are the stdlib modules and the modules of the program. Building the
+        /// symbols for all of those is a large part of the cost of linking a small program, and is
+        /// the same for each specialization of the same program. The symbols can therefore be
+        /// built once and set on the `TargetProgram` of each specialization (see
+        /// `TargetProgram::setLinkSymbolTable`).
+        ///
+        /// The table is only used by a link if its modules are the first modules of the link, in
+        /// the same order. The remaining modules are added by the link itself, such that the
+        /// result is the same as when not using the table.
+    class IRLinkSymbolTable : public RefObject
+    {
+    public:
+        typedef Dictionary<String, RefPtr<IRSpecSymbol>> SymbolDictionary;
+
+            /// Add the symbols of `module`
+        void addModule(IRModule* module);
+
+            /// True if the modules of this table are the first modules of `modules`
+        bool isPrefixOf(List<IRModule*> const& modules) const;
+
+        List<RefPtr<IRModule>> const& getModules() const { return m_modules; }
+
+            /// Get the symbols with `mangledName`, or nullptr if there are none.
+        IRSpecSymbol* findSymbols(String const& mangledName);
+
+            /// The `IRBindGlobalGenericParam` insts in the modules, in module order.
+        List<IRInst*> const& getBindGlobalGenericParams() const { return m_bindGlobalGenericParams; }
+            /// The public or (HLSL) exported insts in the modules, in module order.
+        List<IRInst*> const& getPublicOrExportedInsts() const { return m_publicOrExportedInsts; }
+            /// The hashed string literals in the modules
+        StringSlicePool const& getHashedStringLiterals() const { return m_hashedStringLiterals; }
+
+        IRLinkSymbolTable() : m_hashedStringLiterals(StringSlicePool::Style::Empty) {}
+
+    protected:
+        List<RefPtr<IRModule>> m_modules;
+        SymbolDictionary m_symbols;
+        List<IRInst*> m_bindGlobalGenericParams;
+        List<IRInst*> m_publicOrExportedInsts;
+        StringSlicePool m_hashedStringLiterals;
+    };
+
+        /// Create a symbol table holding the modules that are linked for `program` and for any
+        /// specialization of it: the stdlib modules followed by the modules of `program`.
+    RefPtr<IRLinkSymbolTable> createLinkSymbolTable(ComponentType* program);
+
     struct LinkedIR
     {
         RefPtr<IRModule>                    module;
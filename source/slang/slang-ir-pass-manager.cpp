@@ -0,0 +1,66 @@
+// slang-ir-pass-manager.cpp
+#include "slang-ir-pass-manager.h"
+
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+Index IRPassManager::_findOrAddPass(const char* name, Flags flags)
+{
+    const Index count = m_passStates.getCount();
+    for (Index i = 0; i < count; ++i)
+    {
+        const PassState& state = m_passStates[i];
+        if (state.name == name || ::strcmp(state.name, name) == 0)
+        {
+            return i;
+        }
+    }
+
+    PassState state;
+    state.name = name;
+    state.flags = flags;
+    m_passStates.add(state);
+    return count;
+}
+
+bool IRPassManager::_beginPass(const char* name, Flags flags)
+{
+    SLANG_ASSERT(m_currentPass < 0);
+
+    const uint64_t editCount = getIREditCount();
+
+    const Index passIndex = _findOrAddPass(name, flags);
+    const PassState& state = m_passStates[passIndex];
+
+    if (state.hasRun &&
+        state.editCountAtEnd == editCount &&
+        (!state.madeChanges || (state.flags & Flag::Idempotent)))
+    {
+        m_skipCount++;
+        m_passes->skipPass(name);
+        return false;
+    }
+
+    m_currentPass = passIndex;
+    m_startEditCount = editCount;
+    m_passes->beginPass(name);
+    return true;
+}
+
+void IRPassManager::_endPass()
+{
+    SLANG_ASSERT(m_currentPass >= 0);
+
+    m_passes->endPass();
+
+    PassState& state = m_passStates[m_currentPass];
+    state.hasRun = true;
+    state.editCountAtEnd = getIREditCount();
+    state.madeChanges = (state.editCountAtEnd != m_startEditCount);
+
+    m_currentPass = -1;
+}
+
+}
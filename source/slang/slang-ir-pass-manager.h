@@ -0,0 +1,85 @@
+// slang-ir-pass-manager.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+#include "slang-compile-profiler.h"
+
+namespace Slang
+{
+
+/* Runs passes over an IR module, skipping passes that can't have any new work.
+
+Every change to IR increments the count returned by `getIREditCount`. If the count hasn't
+changed since a pass last finished, the IR is the same as it was then. If that run of the pass
+didn't change anything, running it again can't either, so the pass is skipped.
+
+Some passes iterate until there is nothing left for them to do (such as `simplifyIR` and
+`specializeModule`). These can be marked `Idempotent`, and are then also skipped if their last
+run made changes but nothing has changed since.
+
+The state of each pass is identified by its name, so the same pass run from different places
+(such as `simplifyIR`, which is run many times by `linkAndOptimizeIR`) shares it.
+
+Passes are timed through `passes`, which records how many times each pass changed IR and how
+many times it was skipped. */
+class IRPassManager
+{
+public:
+    typedef uint32_t Flags;
+    struct Flag
+    {
+        enum Enum : Flags
+        {
+            Idempotent = 0x1,           ///< Running the pass again straight after it has run finds nothing to do
+        };
+    };
+
+        /// Run the pass `name` by invoking `func`, unless the pass can't have any new work.
+        /// Returns true if the pass was run.
+    template<typename F>
+    bool run(const char* name, Flags flags, const F& func)
+    {
+        if (!_beginPass(name, flags))
+        {
+            return false;
+        }
+        func();
+        _endPass();
+        return true;
+    }
+    template<typename F>
+    bool run(const char* name, const F& func) { return run(name, 0, func); }
+
+        /// Get the number of times a pass has been skipped
+    Count getSkipCount() const { return m_skipCount; }
+
+        /// Ctor. `passes` can be disabled, in which case passes are still skipped but not timed.
+    IRPassManager(CompileProfiler::PassSequence* passes) : m_passes(passes) {}
+
+protected:
+    struct PassState
+    {
+        const char* name = nullptr;
+        Flags flags = 0;
+        bool hasRun = false;
+        uint64_t editCountAtEnd = 0;    ///< The edit count when the pass last finished
+        bool madeChanges = false;       ///< True if the last run of the pass changed IR
+    };
+
+    bool _beginPass(const char* name, Flags flags);
+    void _endPass();
+
+    Index _findOrAddPass(const char* name, Flags flags);
+
+    CompileProfiler::PassSequence* m_passes;
+
+    List<PassState> m_passStates;
+
+    Index m_currentPass = -1;
+    uint64_t m_startEditCount = 0;
+
+    Count m_skipCount = 0;
+};
+
+}
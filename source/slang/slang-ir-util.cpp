@@ -703,8 +703,7 @@ struct GenericChildrenMigrationContextImpl
                 inst && inst != insertBefore;
                 inst = inst->getNextInst())
             {
-                IRInstKey key = { inst };
-                deduplicateContext.deduplicateMap.AddIfNotExists(key, inst);
+                deduplicateContext.deduplicateMap.AddIfNotExists(IRInstKey::create(inst), inst);
             }
         }
     }
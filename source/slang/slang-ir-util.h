@@ -44,8 +44,7 @@ struct DeduplicateContext
         if (!value) return nullptr;
         if (!shouldDeduplicate(value))
             return value;
-        IRInstKey key = { value };
-        if (auto newValue = deduplicateMap.TryGetValue(key))
+        if (auto newValue = deduplicateMap.TryGetValue(IRInstKey::create(value)))
             return *newValue;
         for (UInt i = 0; i < value->getOperandCount(); i++)
         {
@@ -56,6 +55,8 @@ struct DeduplicateContext
         auto deduplicatedType = (IRType*)deduplicate(value->getFullType(), shouldDeduplicate);
         if (deduplicatedType != value->getFullType())
             value->setFullType(deduplicatedType);
+        // The operands or type may have changed, so the key is created again
+        const IRInstKey key = IRInstKey::create(value);
         if (auto newValue = deduplicateMap.TryGetValue(key))
             return *newValue;
         deduplicateMap[key] = value;
@@ -94,6 +94,16 @@ namespace Slang
     { kIROp_Invalid,{ "invalid", 0, 0 } },
     };
 
+    const uint32_t kIROpFixedArgCounts[] =
+    {
+#define INST(ID, MNEMONIC, ARG_COUNT, FLAGS)  \
+    ARG_COUNT,
+#include "slang-ir-inst-defs.h"
+
+    // kIROp_Invalid
+    0,
+    };
+
     IROpInfo getIROpInfo(IROp opIn)
     {
         const int op = opIn & kIROpMeta_OpMask;
@@ -122,7 +132,19 @@ namespace Slang
         return IROp(kIROp_Invalid);
     }
 
-    
+    // IR is only ever modified by one thread at a time, but different threads can be
+    // modifying different modules, so the count is per thread.
+    static thread_local uint64_t _irEditCount = 0;
+
+    SLANG_FORCE_INLINE static void _addIREdit()
+    {
+        _irEditCount++;
+    }
+
+    uint64_t getIREditCount()
+    {
+        return _irEditCount;
+    }
 
     //
 
@@ -151,6 +173,7 @@ namespace Slang
     void IRUse::init(IRInst* u, IRInst* v)
     {
         clear();
+        _addIREdit();
         user = u;
         usedValue = v;
         if(v)
@@ -191,6 +214,7 @@ namespace Slang
 #ifdef SLANG_ENABLE_FULL_IR_VALIDATION
             auto uv = usedValue;
 #endif
+            _addIREdit();
             *prevLink = nextUse;
             if(nextUse)
             {
@@ -1256,7 +1280,7 @@ namespace Slang
         use->init(user, newValue);
 
         IRInst* existingVal = nullptr;
-        if (builder->getGlobalValueNumberingMap().TryGetValue(IRInstKey{ user }, existingVal))
+        if (builder->getGlobalValueNumberingMap().TryGetValue(IRInstKey::create(user), existingVal))
         {
             user->replaceUsesWith(existingVal);
             return existingVal;
@@ -1432,13 +1456,23 @@ namespace Slang
         size_t defaultSize = sizeof(IRInst) + (operandCount) * sizeof(IRUse);
         size_t totalSize = minSizeInBytes > defaultSize ? minSizeInBytes : defaultSize;
 
-        IRInst* inst = (IRInst*) m_memoryArena.allocateAndZero(totalSize);
+        // The operand count is only stored (ahead of the instruction) if it isn't the
+        // fixed argument count of the op.
+        //
+        const bool hasExplicitOperandCount = UInt(operandCount) != kIROpFixedArgCounts[op & kIROpMeta_OpMask];
+        const size_t prefixSize = hasExplicitOperandCount ? IRInst::kOperandCountPrefixSize : 0;
+
+        IRInst* inst = (IRInst*) ((char*)m_memoryArena.allocateAndZero(prefixSize + totalSize) + prefixSize);
 
         // TODO: Is it actually important to run a constructor here?
         new(inst) IRInst();
 
-        inst->operandCount = uint32_t(operandCount);
         inst->m_op = op;
+        if (hasExplicitOperandCount)
+        {
+            inst->m_op = IROp(op | kIROpMeta_ExplicitOperandCount);
+            inst->_getExplicitOperandCount() = uint32_t(operandCount);
+        }
 
         return inst;
     }
@@ -1964,11 +1998,12 @@ namespace Slang
 
     bool operator==(IRInstKey const& left, IRInstKey const& right)
     {
+        if(left.hash != right.hash) return false;
         if(left.inst->getOp() != right.inst->getOp()) return false;
         if(left.inst->getFullType() != right.inst->getFullType()) return false;
-        if(left.inst->operandCount != right.inst->operandCount) return false;
+        if(left.inst->getOperandCount() != right.inst->getOperandCount()) return false;
 
-        auto argCount = left.inst->operandCount;
+        auto argCount = left.inst->getOperandCount();
         auto leftArgs = left.inst->getOperands();
         auto rightArgs = right.inst->getOperands();
         for( UInt aa = 0; aa < argCount; ++aa )
@@ -1980,7 +2015,7 @@ namespace Slang
         return true;
     }
 
-    HashCode IRInstKey::getHashCode()
+    /* static */HashCode IRInstKey::calcHashCode(IRInst* inst)
     {
         auto code = Slang::getHashCode(inst->getOp());
         code = combineHash(code, Slang::getHashCode(inst->getFullType()));
@@ -2410,8 +2445,13 @@ namespace Slang
         // We are going to create a 'dummy' instruction on the memoryArena
         // which can be used as a key for lookup, so see if we
         // already have an equivalent instruction available to use.
+        // As in `IRModule::_allocateInst`, the operand count is only stored if it isn't
+        // the fixed argument count of the op.
+        const bool hasExplicitOperandCount = operandCount != kIROpFixedArgCounts[op & kIROpMeta_OpMask];
+        const size_t prefixSize = hasExplicitOperandCount ? IRInst::kOperandCountPrefixSize : 0;
+
         size_t keySize = sizeof(IRInst) + operandCount * sizeof(IRUse);
-        IRInst* inst = (IRInst*) memoryArena.allocateAndZero(keySize);
+        IRInst* inst = (IRInst*) ((char*)memoryArena.allocateAndZero(prefixSize + keySize) + prefixSize);
         
         void* endCursor = memoryArena.getCursor();
         // Mark as 'unused' cos it is unused on release builds. 
@@ -2423,7 +2463,11 @@ namespace Slang
 #endif
         inst->m_op = op;
         inst->typeUse.usedValue = type;
-        inst->operandCount = (uint32_t) operandCount;
+        if (hasExplicitOperandCount)
+        {
+            inst->m_op = IROp(op | kIROpMeta_ExplicitOperandCount);
+            inst->_getExplicitOperandCount() = uint32_t(operandCount);
+        }
 
         // Don't link up as we may free (if we already have this key)
         {
@@ -2450,7 +2494,12 @@ namespace Slang
 
         // Find or add the key/inst
         {
-            IRInstKey key = { inst };
+            // The hash is calculated once. It's used for the lookup, and if the inst is added
+            // whenever the map is resized.
+            IRInstKey key = IRInstKey::create(inst);
+
+            auto& stats = m_dedupContext->getStats();
+            stats.lookupCount++;
 
             // Ideally we would add if not found, else return if was found instead of testing & then adding.
             IRInst** found = m_dedupContext->getGlobalValueNumberingMap().TryGetValueOrAdd(key, inst);
@@ -2458,6 +2507,7 @@ namespace Slang
             // If it's found, just return, and throw away the instruction
             if (found)
             {
+                stats.hitCount++;
                 memoryArena.rewindToCursor(cursor);
 
                 // If the found inst is defined in the same parent as current insert location but
@@ -6761,13 +6811,14 @@ namespace Slang
                 
                 // Swap this use over to use the other value.
                 uu->usedValue = other;
+                _addIREdit();
 
                 if (userIsHoistable)
                 {
                     // Is the updated inst already exists in the global numbering map?
                     // If so, we need to continue work on replacing the updated inst with the existing value.
                     IRInst* existingVal = nullptr;
-                    if (dedupContext->getGlobalValueNumberingMap().TryGetValue(IRInstKey{ user }, existingVal))
+                    if (dedupContext->getGlobalValueNumberingMap().TryGetValue(IRInstKey::create(user), existingVal))
                     {
                         addToWorkList(user, existingVal);
                     }
@@ -6851,6 +6902,7 @@ namespace Slang
     {
         // Make sure this instruction has been removed from any previous parent
         this->removeFromParent();
+        _addIREdit();
 
         SLANG_ASSERT(inParent);
         SLANG_ASSERT(!inPrev || (inPrev->getNextInst() == inNext) && (inPrev->getParent() == inParent));
@@ -6938,6 +6990,8 @@ namespace Slang
         if(!oldParent)
             return;
 
+        _addIREdit();
+
         auto pp = getPrevInst();
         auto nn = getNextInst();
 
@@ -6969,6 +7023,7 @@ namespace Slang
     void IRInst::removeArguments()
     {
         typeUse.clear();
+        const UInt operandCount = getOperandCount();
         for( UInt aa = 0; aa < operandCount; ++aa )
         {
             IRUse& use = getOperands()[aa];
@@ -6978,6 +7033,10 @@ namespace Slang
 
     void IRInst::removeOperand(Index index)
     {
+        // Only instructions with more than the fixed operands of their op have any to remove
+        SLANG_ASSERT(m_op & kIROpMeta_ExplicitOperandCount);
+        uint32_t& operandCount = _getExplicitOperandCount();
+
         for (Index i = index; i < (Index)operandCount - 1; i++)
         {
             getOperands()[i].set(getOperand(i + 1));
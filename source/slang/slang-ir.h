@@ -10,6 +10,7 @@
 #include <functional>
 
 #include "../core/slang-basic.h"
+#include "../core/slang-flat-dictionary.h"
 #include "../core/slang-memory-arena.h"
 
 #include "../compiler-core/slang-source-loc.h"
@@ -79,6 +80,10 @@ enum IROpMeta
 {
     kIROpMeta_OtherShift = 10,   ///< Number of bits for op (shift right by this to get the other bits)
     kIROpMeta_OpMask = 0x3ff,    ///< Mask for just opcode
+
+        /// Set in `IRInst::m_op` (but not in the result of `IRInst::getOp`) if the operand count of
+        /// the instruction is held ahead of it (see `IRInst::getOperandCount`).
+    kIROpMeta_ExplicitOperandCount = 0x40000000,
 };
 
 IROp findIROp(const UnownedStringSlice& name);
@@ -103,6 +108,16 @@ struct IROpInfo
 // Look up the info for an op
 IROpInfo getIROpInfo(IROp op);
 
+// The `IROpInfo::fixedArgCount` of each op, indexed by the op masked by `kIROpMeta_OpMask`
+extern const uint32_t kIROpFixedArgCounts[];
+
+    /// Get the number of edits made to IR on the current thread.
+    ///
+    /// Changing the type or an operand of an instruction, inserting, moving or removing an
+    /// instruction all increment the count. If the count is the same before and after some
+    /// code runs, that code didn't change any IR.
+uint64_t getIREditCount();
+
 // A use of another value/inst within an IR operation
 struct IRUse
 {
@@ -531,25 +546,27 @@ private:
 //
 struct IRInst
 {
-    // The operation that this value represents
+    // The operation that this value represents. Has `kIROpMeta_ExplicitOperandCount`
+    // set if the operand count is held ahead of the instruction.
     IROp m_op;
 
-    IROp getOp() const { return m_op; }
+    IROp getOp() const { return IROp(m_op & ~kIROpMeta_ExplicitOperandCount); }
 
-    // The total number of operands of this instruction.
+    // Most instructions have exactly the fixed number of operands of their op, so
+    // the operand count isn't stored on the instruction. Instructions that need
+    // "vararg" support instead have the count allocated in the
+    // `kOperandCountPrefixSize` bytes ahead of the `this` pointer.
     //
-    // TODO: We shouldn't need to allocate this on
-    // all instructions. Instead we should have
-    // instructions that need "vararg" support to
-    // allocate this field ahead of the `this`
-    // pointer.
-    uint32_t operandCount = 0;
+    static const size_t kOperandCountPrefixSize = sizeof(void*);
 
     UInt getOperandCount()
     {
-        return operandCount;
+        return (m_op & kIROpMeta_ExplicitOperandCount) ? _getExplicitOperandCount() : kIROpFixedArgCounts[m_op & kIROpMeta_OpMask];
     }
 
+        /// The operand count held ahead of an instruction with `kIROpMeta_ExplicitOperandCount` set
+    uint32_t& _getExplicitOperandCount() { return *(uint32_t*)((char*)this - kOperandCountPrefixSize); }
+
     // Source location information for this value, if any
     SourceLoc sourceLoc;
 
@@ -748,6 +765,7 @@ struct IRInst
     // Remove operand `index` from operand list.
     // For example, if the inst is `op(a,b,c)`, calling removeOperand(inst, 1) will result
     // `op(a,c)`.
+    // Only operands beyond the fixed argument count of the op can be removed.
     void removeOperand(Index index);
 
         /// Transfer any decorations of this instruction to the `target` instruction.
@@ -1934,12 +1952,23 @@ struct IRModuleInst : IRInst
 
 struct IRModule;
 
-// Description of an instruction to be used for global value numbering
+// Description of an instruction to be used for global value numbering.
+//
+// The hash is calculated once when the key is created, so that it isn't recalculated on
+// every comparison or when the map holding the key is resized. A key therefore has to be
+// created again once the type or operands of `inst` change.
 struct IRInstKey
 {
     IRInst* inst;
+    HashCode hash;
 
-    HashCode getHashCode();
+        /// Create the key for `inst` with its current type and operands
+    static IRInstKey create(IRInst* inst) { return IRInstKey{ inst, calcHashCode(inst) }; }
+
+    HashCode getHashCode() const { return hash; }
+
+        /// Calculate the hash of the opcode, type and operands of `inst`
+    static HashCode calcHashCode(IRInst* inst);
 };
 
 bool operator==(IRInstKey const& left, IRInstKey const& right);
@@ -1978,32 +2007,47 @@ public:
 
     void tryHoistInst(IRInst* inst);
 
-    typedef Dictionary<IRInstKey, IRInst*> GlobalValueNumberingMap;
-    typedef Dictionary<IRConstantKey, IRConstant*> ConstantMap;
+    // These maps are looked up every time an inst is created, and are never iterated, so use
+    // the open addressing dictionary.
+    typedef FlatDictionary<IRInstKey, IRInst*> GlobalValueNumberingMap;
+    typedef FlatDictionary<IRConstantKey, IRConstant*> ConstantMap;
+    typedef FlatDictionary<IRInst*, IRInst*> InstReplacementMap;
 
     GlobalValueNumberingMap& getGlobalValueNumberingMap() { return m_globalValueNumberingMap; }
-    Dictionary<IRInst*, IRInst*>& getInstReplacementMap() { return m_instReplacementMap; }
+    InstReplacementMap& getInstReplacementMap() { return m_instReplacementMap; }
 
     void _addGlobalNumberingEntry(IRInst* inst)
     {
-        m_globalValueNumberingMap.Add(IRInstKey{ inst }, inst);
+        m_globalValueNumberingMap.Add(IRInstKey::create(inst), inst);
         m_instReplacementMap.Remove(inst);
         tryHoistInst(inst);
     }
     void _removeGlobalNumberingEntry(IRInst* inst)
     {
+        // This is done before the type or operands of `inst` change, so the key matches
+        // the one it was added with
+        const IRInstKey key = IRInstKey::create(inst);
         IRInst* value = nullptr;
-        if (m_globalValueNumberingMap.TryGetValue(IRInstKey{ inst }, value))
+        if (m_globalValueNumberingMap.TryGetValue(key, value))
         {
             if (value == inst)
             {
-                m_globalValueNumberingMap.Remove(IRInstKey{ inst });
+                m_globalValueNumberingMap.Remove(key);
             }
         }
     }
 
     ConstantMap& getConstantMap() { return m_constantMap; }
 
+        /// Statistics of the lookups made when creating hoistable instructions
+    struct Stats
+    {
+        Count lookupCount = 0;          ///< Times a hoistable instruction was looked up
+        Count hitCount = 0;             ///< Times an existing instruction was found and used
+    };
+
+    Stats& getStats() { return m_stats; }
+
 private:
     // The module that will own all of the IR
     IRModule* m_module;
@@ -2015,9 +2059,39 @@ private:
 
     // Duplicate insts that are still alive and needs to be replaced in m_globalValueNumberMap
     // when used as an operand to create another inst.
-    Dictionary<IRInst*, IRInst*> m_instReplacementMap;
+    InstReplacementMap m_instReplacementMap;
 
     ConstantMap m_constantMap;
+
+    Stats m_stats;
+};
+
+    /// Reads the global instructions of an `IRModule` when they are first needed.
+    ///
+    /// Used for modules read from a serialized form (see `IRSerialLazyModule`), such that linking
+    /// against a large module (such as the stdlib) only reads the global instructions that are
+    /// used. The module initially only holds the decorations of its module instruction. What a
+    /// global instruction is (its op, mangled name and decorations) is known before it is read.
+    ///
+    /// Can be used from multiple threads.
+class IRLazyGlobalReader : public RefObject
+{
+public:
+        /// Get the number of global instructions, read or not
+    virtual Index getGlobalCount() = 0;
+        /// Get the op of the global instruction at `index`
+    virtual IROp getGlobalOp(Index index) = 0;
+        /// Get the mangled name of the linkage decoration of the global instruction at `index`.
+        /// Empty if it doesn't have a linkage decoration.
+    virtual UnownedStringSlice getGlobalMangledName(Index index) = 0;
+        /// True if the global instruction at `index` has a decoration with `decorationOp`
+    virtual bool globalHasDecoration(Index index, IROp decorationOp) = 0;
+
+        /// Get the global instruction at `index`, reading it if it hasn't been read yet. Reading
+        /// a global instruction also reads the global instructions it refers to.
+    virtual IRInst* readGlobal(Index index) = 0;
+        /// Read all the global instructions that haven't been read yet
+    virtual void readAllGlobals() = 0;
 };
 
 struct IRModule : RefObject
@@ -2041,6 +2115,13 @@ public:
 
     IRInstListBase getGlobalInsts() const { return getModuleInst()->getChildren(); }
 
+        /// If set, the global instructions of this module are only read when first needed, and
+        /// `getGlobalInsts` only holds those read so far. Use `readLazyGlobals` to read them all.
+    IRLazyGlobalReader* getLazyGlobalReader() const { return m_lazyGlobalReader; }
+    void setLazyGlobalReader(IRLazyGlobalReader* reader) { m_lazyGlobalReader = reader; }
+        /// Read any global instructions that haven't been read yet (see `getLazyGlobalReader`)
+    void readLazyGlobals() { if (m_lazyGlobalReader) m_lazyGlobalReader->readAllGlobals(); }
+
         /// Create an empty instruction with the `op` opcode and space for
         /// a number of operands given by `operandCount`.
         ///
@@ -2106,6 +2187,9 @@ private:
 
         /// Holds the obfuscated source map for this module if applicable
     RefPtr<SourceMap> m_obfuscatedSourceMap;
+
+        /// Reads the global instructions when first needed, if set
+    RefPtr<IRLazyGlobalReader> m_lazyGlobalReader;
 };
 
 struct IRSpecializationDictionaryItem : public IRInst
@@ -42,6 +42,16 @@ ArrayView<const char*> getCommitChars()
     return makeArrayView(_commitCharsArray, SLANG_COUNT_OF(_commitCharsArray));
 }
 
+static LanguageServer::TraceOptions _getTraceOptions(const String& str)
+{
+    if (str == "messages")
+        return LanguageServer::TraceOptions::Messages;
+    else if (str == "verbose")
+        return LanguageServer::TraceOptions::Verbose;
+    else
+        return LanguageServer::TraceOptions::Off;
+}
+
 SlangResult LanguageServer::init(const InitializeParams& args)
 {
     SLANG_RETURN_ON_FAIL(m_connection->initWithStdStreams(JSONRPCConnection::CallStyle::Object));
@@ -49,6 +59,7 @@ SlangResult LanguageServer::init(const InitializeParams& args)
     m_typeMap = JSONNativeUtil::getTypeFuncsMap();
 
     m_workspaceFolders = args.workspaceFolders;
+    m_traceOptions = _getTraceOptions(args.trace);
     m_workspace = new Workspace();
     List<URI> rootUris;
     for (auto& wd : m_workspaceFolders)
@@ -437,7 +448,7 @@ SlangResult LanguageServer::hover(
     Index line, col;
     doc->zeroBasedUTF16LocToOneBasedUTF8Loc(args.position.line, args.position.character, line, col);
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -616,7 +627,7 @@ SlangResult LanguageServer::gotoDefinition(
     Index line, col;
     doc->zeroBasedUTF16LocToOneBasedUTF8Loc(args.position.line, args.position.character, line, col);
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -904,7 +915,7 @@ SlangResult LanguageServer::semanticTokens(
         return SLANG_OK;
     }
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -948,7 +959,7 @@ String LanguageServer::getExprDeclSignature(Expr* expr, String* outDocumentation
     if (!funcType)
         return String();
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
 
     SignatureInformation sigInfo;
 
@@ -1009,7 +1020,7 @@ String LanguageServer::getExprDeclSignature(Expr* expr, String* outDocumentation
 
 String LanguageServer::getDeclRefSignature(DeclRef<Decl> declRef, String* outDocumentation, List<Slang::Range<Index>>* outParamRanges)
 {
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     ASTPrinter printer(
         version->linkage->getASTBuilder(),
         ASTPrinter::OptionFlag::ParamNames | ASTPrinter::OptionFlag::NoInternalKeywords |
@@ -1044,7 +1055,7 @@ SlangResult LanguageServer::signatureHelp(
     Index line, col;
     doc->zeroBasedUTF16LocToOneBasedUTF8Loc(args.position.line, args.position.character, line, col);
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -1254,7 +1265,7 @@ SlangResult LanguageServer::documentSymbol(
         m_connection->sendResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -1275,7 +1286,7 @@ SlangResult LanguageServer::inlayHint(const LanguageServerProtocol::InlayHintPar
         m_connection->sendResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -1384,6 +1395,28 @@ SlangResult LanguageServer::onTypeFormatting(const LanguageServerProtocol::Docum
     return SLANG_OK;
 }
 
+static bool _isSamePosition(const LanguageServerProtocol::Position& a, const LanguageServerProtocol::Position& b)
+{
+    return a.line == b.line && a.character == b.character;
+}
+
+static bool _isSameDiagnostics(
+    const List<LanguageServerProtocol::Diagnostic>& published,
+    const OrderedHashSet<LanguageServerProtocol::Diagnostic>& messages)
+{
+    if (published.getCount() != messages.Count())
+        return false;
+    Index i = 0;
+    for (auto& d : messages)
+    {
+        auto& p = published[i++];
+        if (!(p == d) || p.severity != d.severity || !_isSamePosition(p.range.start, d.range.start) ||
+            !_isSamePosition(p.range.end, d.range.end))
+            return false;
+    }
+    return true;
+}
+
 void LanguageServer::publishDiagnostics()
 {
 
@@ -1393,7 +1426,7 @@ void LanguageServer::publishDiagnostics()
     }
     m_lastDiagnosticUpdateTime = std::chrono::system_clock::now();
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     // Send updates to clear diagnostics for files that no longer have any messages.
     List<String> filesToRemove;
     for (auto& file : m_lastPublishedDiagnostics)
@@ -1414,14 +1447,14 @@ void LanguageServer::publishDiagnostics()
     for (auto& list : version->diagnostics)
     {
         auto lastPublished = m_lastPublishedDiagnostics.TryGetValue(list.Key);
-        if (!lastPublished || *lastPublished != list.Value.originalOutput)
+        if (!lastPublished || !_isSameDiagnostics(*lastPublished, list.Value.messages))
         {
             PublishDiagnosticsParams args;
             args.uri = URI::fromLocalFilePath(list.Key.getUnownedSlice()).uri;
             for (auto& d : list.Value.messages)
                 args.diagnostics.add(d);
             m_connection->sendCall(UnownedStringSlice("textDocument/publishDiagnostics"), &args);
-            m_lastPublishedDiagnostics[list.Key] = list.Value.originalOutput;
+            m_lastPublishedDiagnostics[list.Key] = _Move(args.diagnostics);
         }
     }
 }
@@ -1549,12 +1582,7 @@ void LanguageServer::updateTraceOptions(const JSONValue& value)
         String str;
         if (SLANG_SUCCEEDED(converter.convert(value, &str)))
         {
-            if (str == "messages")
-                m_traceOptions = TraceOptions::Messages;
-            else if (str == "verbose")
-                m_traceOptions = TraceOptions::Verbose;
-            else
-                m_traceOptions = TraceOptions::Off;
+            m_traceOptions = _getTraceOptions(str);
         }
     }
 }
@@ -1612,6 +1640,22 @@ void LanguageServer::logMessage(int type, String message)
     m_connection->sendCall(LanguageServerProtocol::LogMessageParams::methodName, &args);
 }
 
+WorkspaceVersion* LanguageServer::getCurrentWorkspaceVersion()
+{
+    bool isNewVersion = !m_workspace->hasCurrentVersion();
+    auto version = m_workspace->getCurrentVersion();
+    if (isNewVersion && version->reusedModuleCount > 0 && m_traceOptions == TraceOptions::Verbose)
+    {
+        StringBuilder msgBuilder;
+        msgBuilder << "Workspace version reused " << version->reusedModuleCount
+                   << " module(s) and the diagnostics of " << version->reusedDiagnosticsFileCount
+                   << " file(s), retaining " << version->retainedLinkages.getCount()
+                   << " earlier linkage(s)";
+        logMessage(3, msgBuilder.ProduceString());
+    }
+    return version;
+}
+
 SlangResult LanguageServer::tryGetMacroHoverInfo(
     WorkspaceVersion* version, DocumentVersion* doc, Index line, Index col, JSONValue responseId)
 {
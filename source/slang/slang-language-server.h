@@ -94,7 +94,7 @@ public:
     RefPtr<JSONRPCConnection> m_connection;
     ComPtr<slang::IGlobalSession> m_session;
     RefPtr<Workspace> m_workspace;
-    Dictionary<String, String> m_lastPublishedDiagnostics;
+    Dictionary<String, List<LanguageServerProtocol::Diagnostic>> m_lastPublishedDiagnostics;
     std::chrono::time_point<std::chrono::system_clock> m_lastDiagnosticUpdateTime;
     FormatOptions m_formatOptions;
     Slang::InlayHintOptions m_inlayHintOptions;
@@ -151,6 +151,8 @@ private:
     void sendConfigRequest();
     void registerCapability(const char* methodName);
     void logMessage(int type, String message);
+        /// Get the current workspace version, logging the modules it reused if it is created
+    WorkspaceVersion* getCurrentWorkspaceVersion();
 
     SlangResult tryGetMacroHoverInfo(
         WorkspaceVersion* version,
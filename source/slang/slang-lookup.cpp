@@ -155,6 +155,10 @@ static void _lookUpDirectAndTransparentMembers(
 {
     ContainerDecl* containerDecl = containerDeclRef.getDecl();
 
+    if (request.searchedContainers)
+    {
+        request.searchedContainers->add(containerDecl);
+    }
 
     if (request.isCompletionRequest())
     {
@@ -966,7 +970,53 @@ LookupResult lookUpMember(
 {
     LookupResult result;
     LookupRequest request = initLookupRequest(semantics, name, mask, options, nullptr);
+
+    // Checking asks for the same members of the same types many times (such
+    // as `x` in a `float4`), so results are cached on the shared semantics
+    // context. Only lookups in declared types are cached, as those are the
+    // ones that are expensive and can be compared cheaply.
+    //
+    DeclRefType* cacheType = nullptr;
+    if (semantics && !request.isCompletionRequest() && type)
+    {
+        cacheType = as<DeclRefType>(type->getCanonicalType());
+    }
+    if (!cacheType)
+    {
+        _lookUpMembersInType(astBuilder, name, type, request, result, nullptr);
+        return result;
+    }
+
+    MemberLookupCacheKey key;
+    key.type = cacheType;
+    key.name = name;
+    key.mask = mask;
+    key.options = request.options;
+
+    auto shared = semantics->getShared();
+    if (auto entry = shared->findCachedMemberLookup(key))
+    {
+        // Anything currently being cached depends on the containers the lookup searched.
+        shared->addSearchedContainers(entry->searchedContainers);
+        return entry->result;
+    }
+
+    // Lookup can cause declarations to be checked, which can register new
+    // extensions. If that happens, the result may not have seen all of them.
+    // The result is also incomplete if a searched type was still having its
+    // bases checked.
+    //
+    const Count invalidationCount = shared->getLookupCacheStats().invalidationCount;
+
+    List<ContainerDecl*> searchedContainers;
+    request.searchedContainers = &searchedContainers;
     _lookUpMembersInType(astBuilder, name, type, request, result, nullptr);
+
+    shared->addSearchedContainers(searchedContainers);
+    if (shared->canCacheSearch(searchedContainers, invalidationCount))
+    {
+        shared->addCachedMemberLookup(key, result, searchedContainers);
+    }
     return result;
 }
 
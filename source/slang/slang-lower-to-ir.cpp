@@ -1171,45 +1171,45 @@ static void addLinkageDecoration(
             auto libraryName = dllImportModifier->modulePath;
             auto functionName = dllImportModifier->functionName.getLength()
                 ? dllImportModifier->functionName.getUnownedSlice()
-                : decl->getName()->text.getUnownedSlice();
+                : decl->getName()->text;
             builder->addDllImportDecoration(inst, libraryName.getUnownedSlice(), functionName);
         }
         else if (as<DllExportAttribute>(modifier))
         {
-            builder->addDllExportDecoration(inst, decl->getName()->text.getUnownedSlice());
+            builder->addDllExportDecoration(inst, decl->getName()->text);
             builder->addPublicDecoration(inst);
         }
         else if (as<CudaDeviceExportAttribute>(modifier))
         {
-            builder->addCudaDeviceExportDecoration(inst, decl->getName()->text.getUnownedSlice());
+            builder->addCudaDeviceExportDecoration(inst, decl->getName()->text);
             builder->addPublicDecoration(inst);
-            builder->addExternCppDecoration(inst, decl->getName()->text.getUnownedSlice());
+            builder->addExternCppDecoration(inst, decl->getName()->text);
         }
         else if (as<CudaHostAttribute>(modifier))
         {
             builder->addCudaHostDecoration(inst);
-            builder->addExternCppDecoration(inst, decl->getName()->text.getUnownedSlice());
+            builder->addExternCppDecoration(inst, decl->getName()->text);
         }
         else if (as<CudaKernelAttribute>(modifier))
         {
             builder->addCudaKernelDecoration(inst);
-            builder->addExternCppDecoration(inst, decl->getName()->text.getUnownedSlice());
+            builder->addExternCppDecoration(inst, decl->getName()->text);
             builder->addPublicDecoration(inst);
             builder->addKeepAliveDecoration(inst);
         }
         else if (as<TorchEntryPointAttribute>(modifier))
         {
-            builder->addTorchEntryPointDecoration(inst, decl->getName()->text.getUnownedSlice());
+            builder->addTorchEntryPointDecoration(inst, decl->getName()->text);
             builder->addCudaHostDecoration(inst);
             builder->addPublicDecoration(inst);
-            builder->addExternCppDecoration(inst, decl->getName()->text.getUnownedSlice());
+            builder->addExternCppDecoration(inst, decl->getName()->text);
         }
     }
     if (as<InterfaceDecl>(decl->parentDecl) &&
         decl->parentDecl->hasModifier<ComInterfaceAttribute>() &&
         !inst->findDecoration<IRExternCppDecoration>())
     {
-        builder->addExternCppDecoration(inst, decl->getName()->text.getUnownedSlice());
+        builder->addExternCppDecoration(inst, decl->getName()->text);
     }
 }
 
@@ -7463,7 +7463,7 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
 
         if (auto semanticModifier = fieldDecl->findModifier<HLSLSimpleSemantic>())
         {
-            builder->addSemanticDecoration(irFieldKey, semanticModifier->name.getName()->text.getUnownedSlice());
+            builder->addSemanticDecoration(irFieldKey, semanticModifier->name.getName()->text);
         }
 
         if( auto readModifier = fieldDecl->findModifier<RayPayloadReadSemantic>() )
@@ -7918,7 +7918,7 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
 
         if(auto nvapiMod = decl->findModifier<NVAPIMagicModifier>())
         {
-            builder->addNVAPIMagicDecoration(irInst, decl->getName()->text.getUnownedSlice());
+            builder->addNVAPIMagicDecoration(irInst, decl->getName()->text);
         }
     }
 
@@ -9064,7 +9064,7 @@ static void lowerFrontEndEntryPointToIR(
 
     {
         Name* entryPointName = entryPoint->getFuncDecl()->getName();
-        builder->addEntryPointDecoration(instToDecorate, entryPoint->getProfile(), entryPointName->text.getUnownedSlice(), moduleName.getUnownedSlice());
+        builder->addEntryPointDecoration(instToDecorate, entryPoint->getProfile(), entryPointName->text, moduleName.getUnownedSlice());
     }
 
     // Go through the entry point parameters creating decorations from layout as appropriate
@@ -9201,6 +9201,9 @@ RefPtr<IRModule> generateIRForTranslationUnit(
     auto session = translationUnit->getSession();
     auto compileRequest = translationUnit->compileRequest;
 
+    CompileProfiler* profiler = compileRequest->getLinkage()->getProfiler();
+    CompileProfiler::Scope profileScope(profiler, "generateIRForTranslationUnit");
+
     SharedIRGenContext sharedContextStorage(
         session,
         translationUnit->compileRequest->getSink(),
@@ -9218,6 +9221,9 @@ RefPtr<IRModule> generateIRForTranslationUnit(
 
     context->irBuilder = builder;
 
+    CompileProfiler::PassSequence passes(profiler, module);
+    passes.beginPass("lowerDeclsToIR");
+
     // We need to emit IR for all public/exported symbols
     // in the translation unit.
     //
@@ -9295,13 +9301,17 @@ RefPtr<IRModule> generateIRForTranslationUnit(
     // This includes lowering throwing functions into functions that
     // returns a `Result<T,E>` value, translating `tryCall` into
     // normal `call` + `ifElse`, etc.
+    passes.beginPass("lowerErrorHandling");
     lowerErrorHandling(module, compileRequest->getSink());
 
     // Next, attempt to promote local variables to SSA
     // temporaries and do basic simplifications.
     //
+    passes.beginPass("constructSSA");
     constructSSA(module);
+    passes.beginPass("simplifyCFG");
     simplifyCFG(module);
+    passes.beginPass("applySparseConditionalConstantPropagation");
     applySparseConditionalConstantPropagation(module);
 
     // Next, inline calls to any functions that have been
@@ -9315,25 +9325,32 @@ RefPtr<IRModule> generateIRForTranslationUnit(
     // are eliminated from the callee, and not copied into
     // call sites.
     //
+    passes.beginPass("performMandatoryEarlyInlining");
     performMandatoryEarlyInlining(module);
 
     // Next, attempt to promote local variables to SSA
     // temporaries and do basic simplifications.
     //
+    passes.beginPass("constructSSA");
     constructSSA(module);
+    passes.beginPass("simplifyCFG");
     simplifyCFG(module);
+    passes.beginPass("applySparseConditionalConstantPropagation");
     applySparseConditionalConstantPropagation(module);
 
     // Propagate `constexpr`-ness through the dataflow graph (and the
     // call graph) based on constraints imposed by different instructions.
+    passes.beginPass("propagateConstExpr");
     propagateConstExpr(module, compileRequest->getSink());
 
     // TODO: give error messages if any `undefined` or
     // `unreachable` instructions remain.
 
+    passes.beginPass("checkForMissingReturns");
     checkForMissingReturns(module, compileRequest->getSink());
 
     // Check for invalid differentiable function body.
+    passes.beginPass("checkAutoDiffUsages");
     checkAutoDiffUsages(module, compileRequest->getSink());
 
     // The "mandatory" optimization passes may make use of the
@@ -9372,6 +9389,7 @@ RefPtr<IRModule> generateIRForTranslationUnit(
         // change what locs are actually needed, we need to be sure 
         // that if we have obfuscation enabled we don't forget to obfuscate.
         stripOptions.stripSourceLocs = linkage->m_obfuscateCode && !linkage->m_generateSourceMap;
+        passes.beginPass("stripFrontEndOnlyInstructions");
         stripFrontEndOnlyInstructions(module, stripOptions);
     
         // Stripping out decorations could leave some dead code behind
@@ -9384,14 +9402,22 @@ RefPtr<IRModule> generateIRForTranslationUnit(
         //
         IRDeadCodeEliminationOptions options;
         options.keepExportsAlive = true;
+        passes.beginPass("eliminateDeadCode");
         eliminateDeadCode(module, options);
 
         if (linkage->m_obfuscateCode && linkage->m_generateSourceMap)
         {
             // The obfuscated source map is stored on the module
+            passes.beginPass("obfuscateModuleLocs");
             obfuscateModuleLocs(module, compileRequest->getSourceManager());
         }
     }
+    passes.endPass();
+
+    if (profiler)
+    {
+        profiler->addIRDeduplicationCounters(module);
+    }
 
     // TODO: consider doing some more aggressive optimizations
     // (in particular specialization of generics) here, so
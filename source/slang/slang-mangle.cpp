@@ -123,8 +123,7 @@ namespace Slang
         ManglingContext*    context,
         Name*               name)
     {
-        String str = getText(name);
-        emitNameImpl(context, str.getUnownedSlice());
+        emitNameImpl(context, getUnownedStringSliceText(name));
     }
 
     void emitVal(
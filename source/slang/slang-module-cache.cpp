@@ -0,0 +1,372 @@
+// slang-module-cache.cpp
+#include "slang-module-cache.h"
+
+#include "../core/slang-blob.h"
+#include "../core/slang-stream.h"
+#include "../core/slang-string-util.h"
+
+#include "slang-compiler.h"
+#include "slang-serialize-container.h"
+
+namespace Slang
+{
+
+// Must be incremented whenever the layout of a cache entry changes. Changes to the AST/IR
+// serialization formats are covered by the compiler build tag which is part of the key.
+static const uint32_t kModuleCacheVersion = 1;
+
+ModuleCache::ModuleCache(const String& directory)
+    : m_directory(directory)
+{
+    PersistentCache::Desc desc;
+    desc.directory = m_directory.getBuffer();
+    m_cache = new PersistentCache(desc);
+}
+
+PersistentCache::Key ModuleCache::_calcKey(Linkage* linkage, Name* name, const PathInfo& pathInfo, ISlangBlob* sourceBlob)
+{
+    DigestBuilder<SHA1> builder;
+
+    builder.append(kModuleCacheVersion);
+    builder.append(String(getBuildTagString()));
+
+    // The module itself
+    builder.append(getText(name));
+    builder.append(pathInfo.getMostUniqueIdentity());
+    builder.append(sourceBlob);
+
+    // Options that can change the result of parsing, checking or lowering to IR.
+    // Preprocessor definitions are sorted, so the key doesn't depend on dictionary ordering.
+    {
+        List<String> defines;
+        for (const auto& pair : linkage->preprocessorDefinitions)
+        {
+            StringBuilder buf;
+            buf << pair.Key << "=" << pair.Value;
+            defines.add(buf.ProduceString());
+        }
+        defines.sort();
+        for (const auto& define : defines)
+        {
+            builder.append(define);
+        }
+    }
+
+    for (const auto& searchDir : linkage->getSearchDirectories().searchDirectories)
+    {
+        builder.append(searchDir.path);
+    }
+
+    builder.append(linkage->defaultMatrixLayoutMode);
+    builder.append(linkage->debugInfoLevel);
+    builder.append(linkage->optimizationLevel);
+    builder.append(linkage->m_obfuscateCode);
+    builder.append(linkage->m_useFalcorCustomSharedKeywordSemantics);
+
+    return builder.finalize();
+}
+
+/* static */void ModuleCache::_writeDependencies(const Dependencies& deps, StringBuilder& out)
+{
+    // Each line is a tab delimited record
+    for (const auto& importName : deps.importNames)
+    {
+        out << "import\t" << importName << "\n";
+    }
+    for (const auto& file : deps.files)
+    {
+        out << "file\t" << file.digest.toString() << "\t" << (file.isOwnFile ? "1" : "0") << "\t" << file.foundPath << "\t" << file.uniqueIdentity << "\n";
+    }
+}
+
+/* static */SlangResult ModuleCache::_readDependencies(const UnownedStringSlice& text, Dependencies& outDeps)
+{
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(text, lines);
+
+    List<UnownedStringSlice> fields;
+    for (const auto& line : lines)
+    {
+        if (line.getLength() == 0)
+        {
+            continue;
+        }
+
+        fields.clear();
+        StringUtil::split(line, '\t', fields);
+
+        if (fields[0] == toSlice("import") && fields.getCount() == 2)
+        {
+            outDeps.importNames.add(fields[1]);
+        }
+        else if (fields[0] == toSlice("file") && fields.getCount() == 5)
+        {
+            FileDependency file;
+            file.digest = SHA1::Digest(fields[1]);
+            file.isOwnFile = fields[2] == toSlice("1");
+            file.foundPath = fields[3];
+            file.uniqueIdentity = fields[4];
+            outDeps.files.add(file);
+        }
+        else
+        {
+            return SLANG_FAIL;
+        }
+    }
+    return SLANG_OK;
+}
+
+RefPtr<Module> ModuleCache::tryLoadModule(
+    Linkage*            linkage,
+    Name*               name,
+    const PathInfo&     pathInfo,
+    ISlangBlob*         sourceBlob,
+    SourceLoc const&    loc,
+    DiagnosticSink*     sink)
+{
+    CompileProfiler::Scope profileScope(linkage->getProfiler(), "loadModuleFromCache");
+
+    RefPtr<Module> module = _tryLoadModule(linkage, name, pathInfo, sourceBlob, loc, sink);
+
+    if (auto profiler = linkage->getProfiler())
+    {
+        profiler->addToCounter(module ? "module cache hits" : "module cache misses", 1);
+    }
+    return module;
+}
+
+RefPtr<Module> ModuleCache::_tryLoadModule(
+    Linkage*            linkage,
+    Name*               name,
+    const PathInfo&     pathInfo,
+    ISlangBlob*         sourceBlob,
+    SourceLoc const&    loc,
+    DiagnosticSink*     sink)
+{
+    const auto key = _calcKey(linkage, name, pathInfo, sourceBlob);
+
+    ComPtr<ISlangBlob> entryBlob;
+    if (SLANG_FAILED(m_cache->readEntry(key, entryBlob.writeRef())))
+    {
+        m_stats.missCount++;
+        return nullptr;
+    }
+
+    RiffContainer riffContainer;
+    {
+        MemoryStreamBase stream(FileAccess::Read, entryBlob->getBufferPointer(), entryBlob->getBufferSize());
+        if (SLANG_FAILED(RiffUtil::read(&stream, riffContainer)))
+        {
+            m_stats.missCount++;
+            return nullptr;
+        }
+    }
+
+    RiffContainer::ListChunk* entryChunk = riffContainer.getRoot();
+    RiffContainer::Data* dependencyData = (entryChunk && entryChunk->getSubType() == ModuleCacheBinary::kEntryFourCc) ?
+        entryChunk->findContainedData(ModuleCacheBinary::kDependenciesFourCc) : nullptr;
+
+    Dependencies deps;
+    if (!dependencyData ||
+        SLANG_FAILED(_readDependencies(UnownedStringSlice((const char*)dependencyData->getPayload(), dependencyData->getSize()), deps)))
+    {
+        m_stats.missCount++;
+        return nullptr;
+    }
+
+    // Check that none of the files in the dependency chain have changed. We hold onto the contents of
+    // the module's own files, so that they can be registered as file dependencies of the loaded module.
+    List<ComPtr<ISlangBlob>> fileContents;
+    for (const auto& file : deps.files)
+    {
+        ComPtr<ISlangBlob> contents;
+        if (SLANG_FAILED(linkage->getFileSystemExt()->loadFile(file.foundPath.getBuffer(), contents.writeRef())) ||
+            SHA1::compute(contents->getBufferPointer(), contents->getBufferSize()) != file.digest)
+        {
+            m_stats.staleCount++;
+            return nullptr;
+        }
+        fileContents.add(contents);
+    }
+
+    // Load the imported modules first, in the order they were originally imported.
+    // This mirrors what checking an `ImportDecl` does, and also means that symbols imported
+    // by the serialized AST can be resolved.
+    List<Module*> importedModules;
+    for (const auto& importName : deps.importNames)
+    {
+        auto importedModule = linkage->findOrImportModule(linkage->getNamePool()->getName(importName), loc, sink);
+        if (!importedModule)
+        {
+            m_stats.missCount++;
+            return nullptr;
+        }
+        importedModules.add(importedModule);
+    }
+
+    SerialContainerData containerData;
+    {
+        SerialContainerUtil::ReadOptions options;
+        options.namePool = linkage->getNamePool();
+        options.session = linkage->getSessionImpl();
+        options.sharedASTBuilder = linkage->getASTBuilder()->getSharedASTBuilder();
+        options.sourceManager = linkage->getSourceManager();
+        options.linkage = linkage;
+        options.sink = sink;
+
+        if (SLANG_FAILED(SerialContainerUtil::read(&riffContainer, options, containerData)) ||
+            containerData.modules.getCount() != 1)
+        {
+            m_stats.missCount++;
+            return nullptr;
+        }
+    }
+
+    auto& srcModule = containerData.modules[0];
+    ModuleDecl* moduleDecl = as<ModuleDecl>(srcModule.astRootNode);
+    if (!moduleDecl || !srcModule.irModule)
+    {
+        m_stats.missCount++;
+        return nullptr;
+    }
+
+    RefPtr<Module> module(new Module(linkage, srcModule.astBuilder));
+
+    moduleDecl->module = module;
+    module->setModuleDecl(moduleDecl);
+    module->setIRModule(srcModule.irModule);
+
+    // The `ImportDecl`s reference the decls of other modules, which are not serialized, so
+    // set them up from the modules we just imported.
+    for (auto importDecl : moduleDecl->getMembersOfType<ImportDecl>())
+    {
+        RefPtr<LoadedModule> importedModule;
+        if (linkage->mapNameToLoadedModules.TryGetValue(importDecl->moduleNameAndLoc.name, importedModule) && importedModule)
+        {
+            importDecl->importedModuleDecl = importedModule->getModuleDecl();
+        }
+    }
+
+    for (auto importedModule : importedModules)
+    {
+        module->addModuleDependency(importedModule);
+    }
+
+    SourceManager* sourceManager = linkage->getSourceManager();
+    for (Index i = 0; i < deps.files.getCount(); ++i)
+    {
+        const auto& file = deps.files[i];
+        if (!file.isOwnFile)
+        {
+            continue;
+        }
+
+        const PathInfo filePathInfo = file.uniqueIdentity.getLength() ?
+            PathInfo::makeNormal(file.foundPath, file.uniqueIdentity) :
+            PathInfo::makePath(file.foundPath);
+
+        module->addFileDependency(sourceManager->createSourceFileWithBlob(filePathInfo, fileContents[i]));
+    }
+
+    // Entry points aren't serialized, so find them as checking would have done
+    module->_discoverEntryPoints(sink);
+    module->_collectShaderParams();
+
+    m_stats.hitCount++;
+    return module;
+}
+
+SlangResult ModuleCache::storeModule(
+    Linkage*            linkage,
+    Name*               name,
+    const PathInfo&     pathInfo,
+    ISlangBlob*         sourceBlob,
+    Module*             module)
+{
+    CompileProfiler::Scope profileScope(linkage->getProfiler(), "storeModuleInCache");
+
+    ModuleDecl* moduleDecl = module->getModuleDecl();
+    if (!moduleDecl || !module->getIRModule())
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    Dependencies deps;
+
+    // Files that are dependencies of imported modules. They are checked when the entry
+    // is loaded, but registered via the imported module.
+    HashSet<SourceFile*> importedFiles;
+
+    for (auto importDecl : moduleDecl->getMembersOfType<ImportDecl>())
+    {
+        // The imported module must be available by name on the linkage, otherwise it
+        // can't be imported when the entry is loaded.
+        Name* importName = importDecl->moduleNameAndLoc.name;
+
+        RefPtr<LoadedModule> importedModule;
+        if (!linkage->mapNameToLoadedModules.TryGetValue(importName, importedModule) ||
+            !importedModule ||
+            importedModule->getModuleDecl() != importDecl->importedModuleDecl)
+        {
+            return SLANG_E_NOT_AVAILABLE;
+        }
+
+        deps.importNames.add(getText(importName));
+
+        for (auto sourceFile : importedModule->getFileDependencyList())
+        {
+            importedFiles.Add(sourceFile);
+        }
+    }
+
+    for (auto sourceFile : module->getFileDependencyList())
+    {
+        const PathInfo& filePathInfo = sourceFile->getPathInfo();
+        ISlangBlob* contents = sourceFile->getContentBlob();
+        if (!filePathInfo.hasFileFoundPath() || !contents)
+        {
+            return SLANG_E_NOT_AVAILABLE;
+        }
+
+        FileDependency file;
+        file.digest = SHA1::compute(contents->getBufferPointer(), contents->getBufferSize());
+        file.isOwnFile = !importedFiles.Contains(sourceFile);
+        file.foundPath = filePathInfo.foundPath;
+        file.uniqueIdentity = filePathInfo.uniqueIdentity;
+        deps.files.add(file);
+    }
+
+    RiffContainer container;
+    {
+        RiffContainer::ScopeChunk scopeEntry(&container, RiffContainer::Chunk::Kind::List, ModuleCacheBinary::kEntryFourCc);
+
+        {
+            StringBuilder buf;
+            _writeDependencies(deps, buf);
+            container.addDataChunk(ModuleCacheBinary::kDependenciesFourCc, buf.getBuffer(), buf.getLength());
+        }
+
+        SerialContainerUtil::WriteOptions options;
+        options.compressionType = linkage->serialCompressionType;
+        options.optionFlags |= SerialOptionFlag::SourceLocation;
+        options.sourceManager = linkage->getSourceManager();
+
+        SerialContainerData data;
+        SLANG_RETURN_ON_FAIL(SerialContainerUtil::addModuleToData(module, options, data));
+        SLANG_RETURN_ON_FAIL(SerialContainerUtil::write(data, options, &container));
+    }
+
+    OwnedMemoryStream stream(FileAccess::Write);
+    SLANG_RETURN_ON_FAIL(RiffUtil::write(container.getRoot(), true, &stream));
+
+    List<uint8_t> contents;
+    contents.addRange(stream.getContents().getBuffer(), stream.getContents().getCount());
+    auto entryBlob = ListBlob::moveCreate(contents);
+
+    SLANG_RETURN_ON_FAIL(m_cache->writeEntry(_calcKey(linkage, name, pathInfo, sourceBlob), entryBlob));
+
+    m_stats.storeCount++;
+    return SLANG_OK;
+}
+
+}
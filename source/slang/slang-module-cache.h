@@ -0,0 +1,122 @@
+// slang-module-cache.h
+#ifndef SLANG_MODULE_CACHE_H
+#define SLANG_MODULE_CACHE_H
+
+#include "../core/slang-basic.h"
+#include "../core/slang-persistent-cache.h"
+#include "../core/slang-riff.h"
+
+#include "../compiler-core/slang-source-loc.h"
+
+namespace Slang
+{
+
+class Linkage;
+class Module;
+class Name;
+class DiagnosticSink;
+
+/* Holds RIFF FourCC codes for module cache entries */
+struct ModuleCacheBinary
+{
+        /// Cache entry LIST container. Holds the dependencies followed by a serial container
+        /// holding the checked AST and IR of the module.
+    static const FourCC kEntryFourCc = SLANG_FOUR_CC('S', 'M', 'c', 'e');
+        /// Dependency data. Text, one dependency per line.
+    static const FourCC kDependenciesFourCc = SLANG_FOUR_CC('S', 'M', 'c', 'd');
+};
+
+/* An on-disk cache of modules loaded through `import` (or `ISession::loadModule`).
+
+An entry holds the checked AST and IR of a module, serialized with the slang-serialize-container
+machinery. Entries are keyed on the module name, the source contents of the module and the linkage
+options that influence front-end compilation. Each entry additionally records
+
+* The modules directly `import`ed by the module
+* Every source file the module depends on (including those of imported modules) along with a hash of its contents
+
+A lookup only succeeds if all the recorded source files are unchanged, so an entry goes stale if any
+file in its dependency chain is modified. Imported modules are loaded before the cached module
+(potentially from the cache themselves), such that a hit never requires parsing or checking.
+
+Entry points are found again from their `[shader(...)]` attributes when a module is loaded. Diagnostics
+are not stored, so a module that produced any (such as warnings) is not cached. */
+class ModuleCache : public RefObject
+{
+public:
+    struct Stats
+    {
+        Count hitCount = 0;             ///< Modules loaded from the cache
+        Count missCount = 0;            ///< Modules not found in the cache
+        Count staleCount = 0;           ///< Modules found in the cache whose dependencies had changed
+        Count storeCount = 0;           ///< Modules written to the cache
+    };
+
+        /// Try to load the module `name` with contents `sourceBlob` from the cache.
+        /// Returns nullptr if there is no valid entry, in which case the module should be loaded from source.
+        /// Hits and misses are counted by the linkage's profiler, if it has one.
+    RefPtr<Module> tryLoadModule(
+        Linkage*            linkage,
+        Name*               name,
+        const PathInfo&     pathInfo,
+        ISlangBlob*         sourceBlob,
+        SourceLoc const&    loc,
+        DiagnosticSink*     sink);
+
+        /// Write `module` (which must have been successfully checked and lowered to IR) into the cache.
+        /// Returns SLANG_E_NOT_AVAILABLE if the module cannot be cached, for example
+        /// because it depends on source that didn't come from a file.
+    SlangResult storeModule(
+        Linkage*            linkage,
+        Name*               name,
+        const PathInfo&     pathInfo,
+        ISlangBlob*         sourceBlob,
+        Module*             module);
+
+        /// Remove all entries from the cache
+    SlangResult clear() { return m_cache->clear(); }
+
+    const Stats& getStats() const { return m_stats; }
+
+        /// Get the directory the cache is stored in
+    const String& getDirectory() const { return m_directory; }
+
+        /// Ctor. The cache is stored in `directory`, which will be created if it doesn't exist.
+    ModuleCache(const String& directory);
+
+protected:
+    struct FileDependency
+    {
+        SHA1::Digest digest;            ///< The digest of the file contents
+        bool isOwnFile = false;         ///< True if the file isn't a dependency of an imported module
+        String foundPath;
+        String uniqueIdentity;
+    };
+
+    struct Dependencies
+    {
+        List<String> importNames;       ///< The names of the directly imported modules, in import order
+        List<FileDependency> files;
+    };
+
+    RefPtr<Module> _tryLoadModule(
+        Linkage*            linkage,
+        Name*               name,
+        const PathInfo&     pathInfo,
+        ISlangBlob*         sourceBlob,
+        SourceLoc const&    loc,
+        DiagnosticSink*     sink);
+
+    PersistentCache::Key _calcKey(Linkage* linkage, Name* name, const PathInfo& pathInfo, ISlangBlob* sourceBlob);
+
+    static void _writeDependencies(const Dependencies& deps, StringBuilder& out);
+    static SlangResult _readDependencies(const UnownedStringSlice& text, Dependencies& outDeps);
+
+    String m_directory;
+    RefPtr<PersistentCache> m_cache;
+    Stats m_stats;
+};
+
+}
+
+#endif
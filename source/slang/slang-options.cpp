@@ -527,6 +527,9 @@ struct OptionsParser
             "      c, cpp, c++, cxx, slang, glsl, hlsl, cu, cuda\n"
             "  -matrix-layout-column-major: Set the default matrix layout to column-major.\n"
             "  -matrix-layout-row-major: Set the default matrix layout to row-major.\n"
+            "  -module-cache-path <path>: Cache modules loaded via 'import' in the\n"
+            "    directory <path>. A cached module is only used if none of the files it\n"
+            "    depends on have changed, and the options it was compiled with match.\n"
             "  -module-name <name>: Set the module name to use when compiling multiple\n"
             "    .slang source files into a single module.\n"
             "  -o <path>: Specify a path where generated output should be written.\n"
@@ -596,6 +599,9 @@ struct OptionsParser
             "  -O<N>: Set the optimization level.\n"
             "    N is the amount of optimization, 0..3, default is 1\n"
             "  -obfuscate: Remove all source file information from outputs.\n"
+            "  -downstream-compile-threads <N>: Generate code for entry points and targets on N threads,\n"
+            "      including linking, IR passes, emit and downstream compiles. 1 generates code serially,\n"
+            "      0 (the default) uses a thread per hardware thread.\n"
             "\n"
             "Downstream compiler options:\n"
             "\n"
@@ -612,6 +618,10 @@ struct OptionsParser
             "      llvm\n"
             "  -default-downstream-compiler <language> <compiler>: Set a default compiler\n"
             "      for the given language. See -lang for the list of languages.\n"
+            "  -downstream-compile-cache-path <path>: Store the outputs of downstream\n"
+            "      compilers in the directory <path>, so identical compiles in later runs\n"
+            "      don't need to invoke the compiler. The most recently used outputs are\n"
+            "      also cached in memory.\n"
             "  -X<compiler> <option>: Pass arguments to downstream <compiler>.\n"
             "\n"
             "Compiler debugging/instrumentation options:\n"
@@ -636,6 +646,10 @@ struct OptionsParser
             "      existing compiler <name>. Accepted compilers are:\n"
             "      fxc, glslang, dxc\n"
             "  -repro-file-system <name>\n"
+            "  -report-perf: Print the time spent in each phase of compilation and each IR pass,\n"
+            "      along with the IR size after each pass.\n"
+            "  -report-perf-json <path>: Write the information reported by -report-perf as JSON\n"
+            "      to a file.\n"
             "  -serial-ir: Serialize the IR between front-end and back-end.\n"
             "  -skip-codegen: Skip the code generation phase.\n"
             "  -validate-ir: Validate the IR between the phases.\n"
@@ -975,6 +989,31 @@ struct OptionsParser
                 {
                     requestImpl->getFrontEndReq()->shouldDumpAST = true;
                 }
+                else if (argValue == "-report-perf")
+                {
+                    requestImpl->m_reportPerformance = true;
+                    compileRequest->setReportPerformance(true);
+                }
+                else if (argValue == "-downstream-compile-threads")
+                {
+                    CommandLineArg countArg;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(countArg));
+
+                    Int count = 0;
+                    if (SLANG_FAILED(StringUtil::parseInt(countArg.value.getUnownedSlice(), count)) || count < 0)
+                    {
+                        sink->diagnose(countArg.loc, Diagnostics::invalidDownstreamCompileThreadCount, countArg.value);
+                        return SLANG_FAIL;
+                    }
+                    compileRequest->setDownstreamCompileThreadCount(int(count));
+                }
+                else if (argValue == "-report-perf-json")
+                {
+                    CommandLineArg reportPath;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(reportPath));
+                    requestImpl->m_performanceReportOutputPath = reportPath.value;
+                    compileRequest->setReportPerformance(true);
+                }
                 else if (argValue == "-doc")
                 {
                     // If compiling stdlib is enabled, will write out documentation
@@ -1015,6 +1054,20 @@ struct OptionsParser
 
                     compileRequest->setDefaultModuleName(moduleName.value.getBuffer());
                 }
+                else if (argValue == "-module-cache-path")
+                {
+                    CommandLineArg cachePath;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(cachePath));
+
+                    requestImpl->getLinkage()->setModuleCachePath(cachePath.value);
+                }
+                else if (argValue == "-downstream-compile-cache-path")
+                {
+                    CommandLineArg cachePath;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(cachePath));
+
+                    requestImpl->getLinkage()->setDownstreamCompileCachePath(cachePath.value);
+                }
                 else if(argValue == "-load-repro")
                 {
                     CommandLineArg reproName;
@@ -0,0 +1,185 @@
+// slang-parallel-downstream-compile.cpp
+#include "slang-parallel-downstream-compile.h"
+
+#include "slang-compiler.h"
+
+#include <thread>
+
+namespace Slang
+{
+
+ParallelDownstreamCompile::SharedStateLock::SharedStateLock(ParallelDownstreamCompile* parallelDownstreamCompile)
+    : m_parallelDownstreamCompile(parallelDownstreamCompile)
+{
+    if (parallelDownstreamCompile)
+    {
+        parallelDownstreamCompile->m_sharedStateMutex.lock();
+    }
+}
+
+ParallelDownstreamCompile::SharedStateLock::~SharedStateLock()
+{
+    if (m_parallelDownstreamCompile)
+    {
+        m_parallelDownstreamCompile->m_sharedStateMutex.unlock();
+    }
+}
+
+void ParallelDownstreamCompile::addTask(TargetProgram* targetProgram, Index entryPointIndex)
+{
+    Task task;
+    task.targetProgram = targetProgram;
+    task.entryPointIndex = entryPointIndex;
+    m_tasks.add(task);
+}
+
+/* static */Count ParallelDownstreamCompile::calcThreadCount(Count requestedThreadCount, Count taskCount)
+{
+    Count threadCount = requestedThreadCount;
+    if (threadCount <= 0)
+    {
+        // hardware_concurrency can return 0 if the value can't be determined
+        threadCount = Count(std::thread::hardware_concurrency());
+    }
+    return Math::Max(Count(1), Math::Min(threadCount, taskCount));
+}
+
+void ParallelDownstreamCompile::_prepareTasks(const List<Linkage*>& linkages)
+{
+    for (auto& task : m_tasks)
+    {
+        TargetProgram* targetProgram = task.targetProgram;
+
+        // Creates the layout too. If it fails, the diagnostics are the same as if the task had run.
+        try
+        {
+            task.isReady = targetProgram->getOrCreateIRModuleForLayout(&task.sink) != nullptr;
+        }
+        catch (...)
+        {
+            task.exception = std::current_exception();
+        }
+
+        // Results are stored by index, so the list mustn't grow whilst tasks are running
+        if (task.entryPointIndex >= 0)
+        {
+            targetProgram->_reserveEntryPointResult(task.entryPointIndex);
+        }
+    }
+
+    // Found on first use, for example when emitting a #line directive or reporting a diagnostic
+    for (auto linkage : linkages)
+    {
+        for (SourceFile* sourceFile : linkage->getSourceManager()->getSourceFiles())
+        {
+            sourceFile->getLineBreakOffsets();
+        }
+    }
+}
+
+void ParallelDownstreamCompile::_runTasks(EndToEndCompileRequest* endToEndReq)
+{
+    const Index taskCount = m_tasks.getCount();
+    while (true)
+    {
+        const Index taskIndex = m_nextTaskIndex++;
+        if (taskIndex >= taskCount)
+        {
+            break;
+        }
+
+        Task& task = m_tasks[taskIndex];
+        if (!task.isReady)
+        {
+            continue;
+        }
+
+        try
+        {
+            if (task.entryPointIndex < 0)
+            {
+                task.targetProgram->_createWholeProgramResult(&task.sink, endToEndReq, this);
+            }
+            else
+            {
+                task.targetProgram->_createEntryPointResult(task.entryPointIndex, &task.sink, endToEndReq, this);
+            }
+        }
+        catch (...)
+        {
+            task.exception = std::current_exception();
+        }
+    }
+}
+
+void ParallelDownstreamCompile::execute(Count requestedThreadCount, EndToEndCompileRequest* endToEndReq, DiagnosticSink* sink)
+{
+    // Each task gets a sink configured like `sink`, but which buffers its output
+    for (auto& task : m_tasks)
+    {
+        task.sink = *sink;
+        task.sink.reset();
+        task.sink.writer = nullptr;
+        task.sink.setParentSink(nullptr);
+    }
+
+    List<Linkage*> linkages;
+    for (auto& task : m_tasks)
+    {
+        Linkage* linkage = task.targetProgram->getTargetReq()->getLinkage();
+        if (linkages.indexOf(linkage) < 0)
+        {
+            linkages.add(linkage);
+        }
+    }
+
+    _prepareTasks(linkages);
+
+    // The tasks share the AST builder of their linkage, so it is guarded whilst they run
+    List<ASTBuilder*> sharedASTBuilders;
+    for (auto linkage : linkages)
+    {
+        ASTBuilder* astBuilder = linkage->getASTBuilder();
+        if (!astBuilder->isShared())
+        {
+            astBuilder->enableSharedAccess();
+            sharedASTBuilders.add(astBuilder);
+        }
+    }
+
+    m_nextTaskIndex = 0;
+
+    const Count threadCount = calcThreadCount(requestedThreadCount, m_tasks.getCount());
+    if (threadCount <= 1)
+    {
+        _runTasks(endToEndReq);
+    }
+    else
+    {
+        List<std::thread> threads;
+        for (Index i = 0; i < threadCount; ++i)
+        {
+            threads.add(std::thread([this, endToEndReq]() { _runTasks(endToEndReq); }));
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    for (auto astBuilder : sharedASTBuilders)
+    {
+        astBuilder->disableSharedAccess();
+    }
+
+    for (auto& task : m_tasks)
+    {
+        sink->appendBufferedDiagnostics(&task.sink);
+        if (task.exception)
+        {
+            std::rethrow_exception(task.exception);
+        }
+    }
+}
+
+}
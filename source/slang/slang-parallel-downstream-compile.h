@@ -0,0 +1,89 @@
+// slang-parallel-downstream-compile.h
+#ifndef SLANG_PARALLEL_DOWNSTREAM_COMPILE_H
+#define SLANG_PARALLEL_DOWNSTREAM_COMPILE_H
+
+#include "../core/slang-basic.h"
+
+#include "../compiler-core/slang-diagnostic-sink.h"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+
+namespace Slang
+{
+
+class Linkage;
+class TargetProgram;
+class EndToEndCompileRequest;
+
+/* Runs the back end for the entry points and targets of a request on a pool of threads.
+
+Each task generates code for a single entry point of a target (or the whole program for a target that
+is a whole program request), in exactly the same way as the serial path does. Linking, the IR passes,
+emit and the downstream compile of a task all run concurrently with the other tasks.
+
+A task creates its own IR module and emitters, so most of the state it touches is its own. The state that
+is shared between tasks is
+
+* The layout and IR of each TargetProgram, and its list of entry point results. These are created lazily,
+  so are created for all tasks before any task runs, and are only read afterwards.
+* The IR of the modules being linked, which is only read. The lazily loaded stdlib IR is guarded by its own lock.
+* The linkage's AST builder, which is made shared (see `ASTBuilder::enableSharedAccess`) whilst the tasks run,
+  and its name pool, which is always guarded.
+* The source files of the linkage, whose line breaks are found before any task runs.
+* The linkage's downstream compile cache and file system. Accesses are guarded by the 'shared state lock' (see
+  `SharedStateLock`).
+
+Each task reports diagnostics to its own sink. Once all tasks have completed, the diagnostics are output
+in task order, such that the output is the same as if the tasks had been run serially. */
+class ParallelDownstreamCompile
+{
+public:
+        /// Holds the shared state lock for the lifetime of the scope.
+        /// Does nothing if `parallelDownstreamCompile` is null.
+    struct SharedStateLock
+    {
+        SharedStateLock(ParallelDownstreamCompile* parallelDownstreamCompile);
+        ~SharedStateLock();
+
+    protected:
+        ParallelDownstreamCompile* m_parallelDownstreamCompile;
+    };
+
+        /// Add a task to generate code for the entry point at `entryPointIndex` of `targetProgram`.
+        /// If `entryPointIndex` is -1, code is generated for the whole program.
+    void addTask(TargetProgram* targetProgram, Index entryPointIndex);
+
+        /// Run all the added tasks on up to `threadCount` threads (0 uses a thread per hardware thread).
+        /// Diagnostics are output to `sink` in the order the tasks were added. If a task throws,
+        /// diagnostics of subsequent tasks are discarded, and the exception is rethrown.
+    void execute(Count threadCount, EndToEndCompileRequest* endToEndReq, DiagnosticSink* sink);
+
+        /// Get the number of threads that will be used for `requestedThreadCount` and `taskCount` tasks.
+    static Count calcThreadCount(Count requestedThreadCount, Count taskCount);
+
+protected:
+    struct Task
+    {
+        TargetProgram* targetProgram = nullptr;
+        Index entryPointIndex = -1;
+        DiagnosticSink sink;                    ///< Diagnostics for the task. Buffered, without a parent.
+        std::exception_ptr exception;           ///< Set if the task threw
+        bool isReady = false;                   ///< Set if the layout and IR of the target program could be created
+    };
+
+        /// Create the state shared by the tasks that is otherwise created lazily. Run before any task.
+    void _prepareTasks(const List<Linkage*>& linkages);
+
+        /// Run tasks until there are none left. Called on each thread of the pool.
+    void _runTasks(EndToEndCompileRequest* endToEndReq);
+
+    List<Task> m_tasks;
+    std::atomic<Index> m_nextTaskIndex;
+    std::mutex m_sharedStateMutex;
+};
+
+}
+
+#endif
@@ -6172,6 +6172,8 @@ namespace Slang
         DiagnosticSink*                 sink,
         Scope*                          outerScope)
     {
+        CompileProfiler::Scope profileScope(translationUnit->compileRequest->getLinkage()->getProfiler(), "parseSourceFile");
+
         Parser parser(astBuilder, tokens, sink, outerScope);
         parser.namePool = translationUnit->getNamePool();
         parser.sourceLanguage = translationUnit->sourceLanguage;
@@ -6398,7 +6400,7 @@ namespace Slang
         while (!AdvanceIfMatch(parser, MatchedTokenType::Parentheses))
         {
             auto nameAndLoc = expectIdentifier(parser);
-            const String& nameText = nameAndLoc.name->text;
+            const UnownedStringSlice nameText = nameAndLoc.name->text;
 
             const char localSizePrefix[] = "local_size_";
 
@@ -495,13 +495,18 @@ private:
 // take responsibility for actually emitting those diagnostics.
 
     /// An input stream that reads tokens directly using the Slang `Lexer`
+    ///
+    /// If the tokens of the file were previously lexed and are held in the `PreprocessorTokenCache`
+    /// they are read from the cache instead. As cached files produce no lexer diagnostics, this
+    /// gives the same results.
 struct LexerInputStream : InputStream
 {
     typedef InputStream Super;
 
     LexerInputStream(
-        Preprocessor*   preprocessor,
-        SourceView*     sourceView);
+        Preprocessor*       preprocessor,
+        SourceView*         sourceView,
+        const List<Token>*  cachedTokens);
 
     Lexer* getLexer() { return &m_lexer; }
 
@@ -525,6 +530,11 @@ private:
         /// Read a token from the lexer, bypassing lookahead
     Token _readTokenImpl()
     {
+        if (m_cachedTokens)
+        {
+            return _readCachedTokenImpl();
+        }
+
         for(;;)
         {
             Token token = m_lexer.lexToken();
@@ -541,9 +551,27 @@ private:
         }
     }
 
+        /// Read a token from the cached tokens, bypassing lookahead
+    Token _readCachedTokenImpl()
+    {
+        // The last token is the `EndOfFile`, which is returned for every read at the end
+        Token token = (*m_cachedTokens)[m_cachedTokenIndex];
+        if (m_cachedTokenIndex < m_cachedTokens->getCount() - 1)
+        {
+            m_cachedTokenIndex++;
+        }
+        // Cached locations are offsets from the start of the file
+        token.loc = m_lexer.m_startLoc + Int(token.loc.getRaw());
+        return token;
+    }
+
         /// The lexer state that will provide input
     Lexer m_lexer;
 
+        /// If set, tokens are read from here rather than from `m_lexer`
+    const List<Token>* m_cachedTokens = nullptr;
+    Index m_cachedTokenIndex = 0;
+
         /// One token of lookahead
     Token m_lookaheadToken;
 };
@@ -910,8 +938,9 @@ private:
 struct InputFile
 {
     InputFile(
-        Preprocessor*   preprocessor,
-        SourceView*     sourceView);
+        Preprocessor*       preprocessor,
+        SourceView*         sourceView,
+        const List<Token>*  cachedTokens = nullptr);
 
     ~InputFile();
 
@@ -947,8 +976,50 @@ struct InputFile
 
     ExpansionInputStream* getExpansionStream() { return m_expansionStream; }
 
+    SourceView* getSourceView() { return m_sourceView; }
+
     bool isIncludedFile() { return m_parent != nullptr; }
 
+        /// Note that a token or directive was read outside of any conditional
+    void noteTopLevelContent()
+    {
+        if (m_includeGuardState != IncludeGuardState::InGuard)
+            m_includeGuardState = IncludeGuardState::NotGuarded;
+    }
+
+        /// Note a `#ifndef` of `name` outside of any conditional, which began `conditional`
+    void noteTopLevelIfNDef(Name* name, Conditional* conditional)
+    {
+        if (m_includeGuardState != IncludeGuardState::Start)
+            return;
+        m_includeGuardState = IncludeGuardState::InGuard;
+        m_includeGuardName = name;
+        m_includeGuardConditional = conditional;
+    }
+
+        /// Note a `#else` or `#elif` of `conditional`
+    void noteElse(Conditional* conditional)
+    {
+        if (conditional == m_includeGuardConditional)
+            m_includeGuardState = IncludeGuardState::NotGuarded;
+    }
+
+        /// Note a `#endif` of `conditional`
+    void noteEndIf(Conditional* conditional)
+    {
+        if (m_includeGuardState == IncludeGuardState::InGuard && conditional == m_includeGuardConditional)
+        {
+            m_includeGuardState = IncludeGuardState::AfterGuard;
+            m_includeGuardConditional = nullptr;
+        }
+    }
+
+        /// If the whole file (so far) is inside an include guard, get the name of the guard macro.
+    Name* getIncludeGuardName()
+    {
+        return m_includeGuardState == IncludeGuardState::AfterGuard ? m_includeGuardName : nullptr;
+    }
+
 private:
     friend struct Preprocessor;
 
@@ -970,6 +1041,23 @@ private:
 
         /// An input stream that applies macro expansion to `m_lexerStream`
     ExpansionInputStream* m_expansionStream;
+
+    SourceView* m_sourceView = nullptr;
+
+        /// Detection of the include guard idiom, where everything in the file is inside
+        /// a `#ifndef X` ... `#endif` without a `#else`. If such a file is included again
+        /// whilst `X` is defined, it produces no tokens, so doesn't need to be read.
+    enum class IncludeGuardState
+    {
+        Start,              ///< Nothing has been read at the top level
+        InGuard,            ///< Inside the `#ifndef` that is the first thing in the file
+        AfterGuard,         ///< After the `#endif`, with nothing read since
+        NotGuarded,         ///< Not an include guard
+    };
+
+    IncludeGuardState m_includeGuardState = IncludeGuardState::Start;
+    Name* m_includeGuardName = nullptr;
+    Conditional* m_includeGuardConditional = nullptr;
 };
 
     /// State of the preprocessor
@@ -1003,6 +1091,16 @@ struct Preprocessor
         /// stop them from being included again.
     HashSet<String>                         pragmaOnceUniqueIdentities;
 
+        /// Maps the unique identities of paths that have been found to be wrapped in an
+        /// include guard to the name of the guard macro.
+    Dictionary<String, Name*>               includeGuardUniqueIdentities;
+
+        /// The number of `#include`s that were skipped because of an include guard
+    Count                                   includeGuardSkipCount = 0;
+
+        /// Cache of lexed tokens that included files are read from, if set
+    PreprocessorTokenCache*                 tokenCache = nullptr;
+
         /// Name pool to use when creating `Name`s from strings
     NamePool*                               namePool = nullptr;
 
@@ -1092,9 +1190,11 @@ DiagnosticSink* InputStream::getSink()
 //
 
 LexerInputStream::LexerInputStream(
-    Preprocessor*   preprocessor,
-    SourceView*     sourceView)
+    Preprocessor*       preprocessor,
+    SourceView*         sourceView,
+    const List<Token>*  cachedTokens)
     : Super(preprocessor)
+    , m_cachedTokens(cachedTokens)
 {
     MemoryArena* memoryArena = sourceView->getSourceManager()->getMemoryArena();
     m_lexer.initialize(sourceView, GetSink(preprocessor), preprocessor->getNamePool(), memoryArena);
@@ -1102,12 +1202,14 @@ LexerInputStream::LexerInputStream(
 }
 
 InputFile::InputFile(
-    Preprocessor*   preprocessor,
-    SourceView*     sourceView)
+    Preprocessor*       preprocessor,
+    SourceView*         sourceView,
+    const List<Token>*  cachedTokens)
 {
     m_preprocessor = preprocessor;
+    m_sourceView = sourceView;
 
-    m_lexerStream = new LexerInputStream(preprocessor, sourceView);
+    m_lexerStream = new LexerInputStream(preprocessor, sourceView, cachedTokens);
     m_expansionStream = new ExpansionInputStream(preprocessor, m_lexerStream);
 }
 
@@ -2804,8 +2906,16 @@ static void HandleIfNDefDirective(PreprocessorDirectiveContext* context)
         return;
     Name* name = nameToken.getName();
 
+    InputFile* inputFile = getInputFile(context);
+    const bool isTopLevel = inputFile->getInnerMostConditional() == nullptr;
+
     // Check if the name is defined.
     beginConditional(context, LookupMacro(context, name) == NULL);
+
+    if (isTopLevel)
+    {
+        inputFile->noteTopLevelIfNDef(name, inputFile->getInnerMostConditional());
+    }
 }
 
 // Handle a `#else` directive
@@ -2831,6 +2941,8 @@ static void HandleElseDirective(PreprocessorDirectiveContext* context)
     }
     conditional->elseToken = context->m_directiveToken;
 
+    inputFile->noteElse(conditional);
+
     switch (conditional->state)
     {
     case Conditional::State::Before:
@@ -2888,6 +3000,8 @@ static void HandleElifDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    inputFile->noteElse(conditional);
+
     switch (conditional->state)
     {
     case Conditional::State::Before:
@@ -2920,6 +3034,7 @@ static void HandleEndIfDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    inputFile->noteEndIf(conditional);
     inputFile->popConditional();
 
     updateLexerFlagsForConditionals(inputFile);
@@ -3027,6 +3142,18 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    // Check whether we've previously included this file and found that it is wrapped in an
+    // include guard. If the guard macro is still defined, including it again would produce
+    // nothing, so there is no need to read it.
+    if (auto guardName = context->m_preprocessor->includeGuardUniqueIdentities.TryGetValue(filePathInfo.uniqueIdentity))
+    {
+        if (LookupMacro(context, *guardName))
+        {
+            context->m_preprocessor->includeGuardSkipCount++;
+            return;
+        }
+    }
+
     // Simplify the path
     filePathInfo.foundPath = includeSystem->simplifyPath(filePathInfo.foundPath);
 
@@ -3062,7 +3189,15 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
     // This is a new parse (even if it's a pre-existing source file), so create a new SourceView
     SourceView* sourceView = sourceManager->createSourceView(sourceFile, &filePathInfo, directiveLoc);
 
-    InputFile* inputFile = new InputFile(context->m_preprocessor, sourceView);
+    // Headers are commonly included by many translation units, so read them from the token cache
+    // if there is one
+    const List<Token>* cachedTokens = nullptr;
+    if (auto tokenCache = context->m_preprocessor->tokenCache)
+    {
+        cachedTokens = tokenCache->findOrLexTokens(sourceView);
+    }
+
+    InputFile* inputFile = new InputFile(context->m_preprocessor, sourceView, cachedTokens);
 
     context->m_preprocessor->pushInputFile(inputFile);
 }
@@ -3778,6 +3913,18 @@ void Preprocessor::popInputFile()
         GetSink(this)->diagnose(conditional->ifToken, Diagnostics::seeDirective, conditional->ifToken.getContent());
     }
 
+    // If the file was wrapped in an include guard, record it so that later
+    // `#include`s of the file can be skipped whilst the guard macro is defined.
+    //
+    if (auto guardName = inputFile->getIncludeGuardName())
+    {
+        const String& uniqueIdentity = inputFile->getSourceView()->getSourceFile()->getPathInfo().uniqueIdentity;
+        if (uniqueIdentity.getLength())
+        {
+            includeGuardUniqueIdentities[uniqueIdentity] = guardName;
+        }
+    }
+
     // We will update the current file to the parent of whatever
     // the `inputFile` was (usually the file that `#include`d it).
     //
@@ -3829,8 +3976,15 @@ static Token ReadToken(Preprocessor* preprocessor)
             directiveContext.m_haveDoneEndOfDirectiveChecks = false;
             directiveContext.m_inputFile = inputFile;
 
+            const bool isTopLevel = inputFile->getInnerMostConditional() == nullptr;
+
             // Parse and handle the directive
             HandleDirective(&directiveContext);
+
+            if (isTopLevel)
+            {
+                inputFile->noteTopLevelContent();
+            }
             continue;
         }
 
@@ -3848,6 +4002,12 @@ static Token ReadToken(Preprocessor* preprocessor)
             continue;
         }
 
+        // Blank lines don't affect whether the file is wrapped in an include guard
+        if (token.type != TokenType::NewLine && !inputFile->getInnerMostConditional())
+        {
+            inputFile->noteTopLevelContent();
+        }
+
         expansionStream->readToken();
         return token;
     }
@@ -3983,6 +4143,78 @@ Result findMacroValue(
     return SLANG_OK;
 }
 
+PreprocessorTokenCache::PreprocessorTokenCache(NamePool* namePool)
+    : m_namePool(namePool)
+    , m_memoryArena(4096)
+{
+}
+
+const List<Token>* PreprocessorTokenCache::findOrLexTokens(SourceView* sourceView)
+{
+    SourceFile* sourceFile = sourceView->getSourceFile();
+    ISlangBlob* contentBlob = sourceFile->getContentBlob();
+    if (!contentBlob)
+    {
+        return nullptr;
+    }
+
+    const UnownedStringSlice content = sourceFile->getContent();
+    if (RefPtr<Entry>* found = m_entries.TryGetValue(content))
+    {
+        Entry* entry = *found;
+        if (entry->m_tokens.getCount() == 0)
+        {
+            return nullptr;
+        }
+        m_hitCount++;
+        return &entry->m_tokens;
+    }
+
+    RefPtr<Entry> entry = new Entry;
+    // Hold the blob, so the contents of the tokens and the key remain valid
+    entry->m_contentBlob = contentBlob;
+
+    // Lex with a sink of our own, so we can tell if there are any diagnostics. Scrubbed token
+    // contents are allocated from the cache's arena, so they live as long as the cache.
+    DiagnosticSink sink(sourceView->getSourceManager(), nullptr);
+
+    Lexer lexer;
+    lexer.initialize(sourceView, &sink, m_namePool, &m_memoryArena);
+
+    const SourceLoc startLoc = lexer.m_startLoc;
+    for (;;)
+    {
+        Token token = lexer.lexToken();
+        switch (token.type)
+        {
+            case TokenType::WhiteSpace:
+            case TokenType::BlockComment:
+            case TokenType::LineComment:
+                continue;
+            default:
+                break;
+        }
+
+        token.loc = SourceLoc::fromRaw(SourceLoc::RawValue(token.loc.getRaw() - startLoc.getRaw()));
+        entry->m_tokens.add(token);
+
+        if (token.type == TokenType::EndOfFile)
+        {
+            break;
+        }
+    }
+
+    // If lexing produced any diagnostics, they must be reported where they arise in the
+    // preprocessor, which may suppress them, so the file has to be lexed as usual.
+    if (sink.outputBuffer.getLength() != 0)
+    {
+        entry->m_tokens.clear();
+    }
+
+    m_entries.Add(content, entry);
+    return entry->m_tokens.getCount() ? &entry->m_tokens : nullptr;
+}
+
 TokenList preprocessSource(
     SourceFile*                         file,
     DiagnosticSink*                     sink,
@@ -3991,6 +4223,8 @@ TokenList preprocessSource(
     Linkage*                            linkage,
     PreprocessorHandler*                handler)
 {
+    CompileProfiler::Scope profileScope(linkage->getProfiler(), "preprocessSource");
+
     PreprocessorDesc desc;
 
     desc.sink           = sink;
@@ -4007,6 +4241,9 @@ TokenList preprocessSource(
     {
         desc.contentAssistInfo = &linkage->contentAssistInfo.preprocessorInfo;
     }
+    desc.profiler = linkage->getProfiler();
+    desc.tokenCache = linkage->getPreprocessorTokenCache();
+
     return preprocessSource(file, desc);
 }
 
@@ -4027,6 +4264,10 @@ TokenList preprocessSource(
     preprocessor.endOfFileToken.flags = TokenFlag::AtStartOfLine;
     preprocessor.contentAssistInfo = desc.contentAssistInfo;
 
+    SLANG_ASSERT(desc.tokenCache == nullptr || desc.tokenCache->getNamePool() == desc.namePool);
+    preprocessor.tokenCache = desc.tokenCache;
+    const Count tokenCacheStartHitCount = desc.tokenCache ? desc.tokenCache->getHitCount() : 0;
+
     // Add builtin macros
     {
         auto namePool = desc.namePool;
@@ -4081,6 +4322,15 @@ TokenList preprocessSource(
         handler->handleEndOfTranslationUnit(&preprocessor);
     }
 
+    if (desc.profiler)
+    {
+        desc.profiler->addToCounter("includes skipped by include guard", preprocessor.includeGuardSkipCount);
+        if (desc.tokenCache)
+        {
+            desc.profiler->addToCounter("includes read from token cache", desc.tokenCache->getHitCount() - tokenCacheStartHitCount);
+        }
+    }
+
     // debugging: build the pre-processed source back together
 #if 0
     StringBuilder sb;
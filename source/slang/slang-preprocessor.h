@@ -11,6 +11,7 @@ namespace Slang {
 
 class DiagnosticSink;
 class Linkage;
+class CompileProfiler;
 struct PreprocessorContentAssistInfo;
 
 namespace preprocessor
@@ -31,6 +32,51 @@ struct PreprocessorHandler
     virtual void handleFileDependency(SourceFile* sourceFile);
 };
 
+    /// A cache of the tokens lexed from the contents of source files.
+    ///
+    /// Included files with the same contents as a file that was lexed before (in the same or an
+    /// earlier translation unit) are replayed from the cache instead of being lexed again. The
+    /// cached tokens hold `Name`s from `namePool`, so the cache can only be used when preprocessing
+    /// with that pool.
+    ///
+    /// Cached tokens have locations that are offsets from the start of the file, so need to be
+    /// offset by the start of the `SourceView` they are read through.
+class PreprocessorTokenCache : public RefObject
+{
+public:
+        /// Get the tokens lexed from the contents of `sourceView`, lexing them if they are not already cached.
+        ///
+        /// The tokens don't include whitespace or comments, and end with an `EndOfFile` token.
+        /// Returns nullptr if the contents can't be cached, because lexing them produces diagnostics.
+    const List<Token>* findOrLexTokens(SourceView* sourceView);
+
+    NamePool* getNamePool() const { return m_namePool; }
+
+        /// The number of times tokens were found in the cache
+    Count getHitCount() const { return m_hitCount; }
+
+    PreprocessorTokenCache(NamePool* namePool);
+
+protected:
+    struct Entry : RefObject
+    {
+            /// Holds the contents that the (non-name) token contents point into
+        ComPtr<ISlangBlob> m_contentBlob;
+            /// The tokens, or empty if the contents can't be cached
+        List<Token> m_tokens;
+    };
+
+    NamePool* m_namePool;
+
+        /// Storage for the contents of tokens that had to be scrubbed of escaped newlines
+    MemoryArena m_memoryArena;
+
+        /// Maps file contents to the entry. The key refers to the contents held by the entry.
+    Dictionary<UnownedStringSlice, RefPtr<Entry>> m_entries;
+
+    Count m_hitCount = 0;
+};
+
     /// Description of a preprocessor options/dependencies
 struct PreprocessorDesc
 {
@@ -57,6 +103,12 @@ struct PreprocessorDesc
 
         /// Optional: additional information for code assist.
     PreprocessorContentAssistInfo* contentAssistInfo = nullptr;
+
+        /// Optional: profiler that statistics of the preprocessing are reported to
+    CompileProfiler* profiler = nullptr;
+
+        /// Optional: cache of lexed tokens to replay included files from. Must use `namePool`.
+    PreprocessorTokenCache* tokenCache = nullptr;
 };
 
     /// Take a source `file` and preprocess it into a list of tokens.
@@ -914,7 +914,7 @@ SLANG_API SlangInt spReflectionTypeLayout_findFieldIndexByName(SlangReflectionTy
         for(Index f = 0; f < fieldCount; ++f)
         {
             auto field = structTypeLayout->fields[f];
-            if(getReflectionName(field->varDecl)->text.getUnownedSlice() == name)
+            if(getReflectionName(field->varDecl)->text == name)
                 return f;
         }
     }
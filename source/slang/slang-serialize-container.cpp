@@ -356,13 +356,24 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
 
             if (auto irChunk = as<RiffContainer::ListChunk>(chunk, IRSerialBinary::kIRModuleFourCc))
             {
-                IRSerialData serialData;
+                if (options.readIRLazily)
+                {
+                    IRSerialData serialData;
+                    SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &serialData));
 
-                SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &serialData));
+                    // The global instructions are only read when first used
+                    SLANG_RETURN_ON_FAIL(IRSerialLazyModule::create(options.session, sourceLocReader, serialData, irModule));
+                }
+                else
+                {
+                    IRSerialData serialData;
 
-                // Read IR back from serialData
-                IRSerialReader reader;
-                SLANG_RETURN_ON_FAIL(reader.read(serialData, options.session, sourceLocReader, irModule));
+                    SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &serialData));
+
+                    // Read IR back from serialData
+                    IRSerialReader reader;
+                    SLANG_RETURN_ON_FAIL(reader.read(serialData, options.session, sourceLocReader, irModule));
+                }
 
                 // Onto next chunk
                 chunk = chunk->m_next;
@@ -92,6 +92,7 @@ struct SerialContainerUtil
         ASTBuilder* astBuilder = nullptr; // Optional. If not provided will create one in SerialContainerData.
         Linkage* linkage = nullptr;
         DiagnosticSink* sink = nullptr;
+        bool readIRLazily = false;  ///< If set the global instructions of IR modules are only read when first used (see IRSerialLazyModule)
     };
 
         /// Add module to outData
@@ -258,7 +258,7 @@ Result IRSerialWriter::write(IRModule* module, SerialSourceLocWriter* sourceLocW
             // ModuleInst is different, in so far as it holds a pointer to IRModule, but we don't need 
             // to save that off in a special way, so can just use regular path
              
-            const int numOperands = int(srcInst->operandCount);
+            const int numOperands = int(srcInst->getOperandCount());
             Ser::InstIndex* dstOperands = nullptr;
 
             if (numOperands <= Ser::Inst::kMaxOperands)
@@ -676,6 +676,188 @@ static Result _readInstArrayChunk(SerialCompressionType containerCompressionType
     return SLANG_OK;
 }
 
+// Allocate the instruction for `srcInst` in `module`, without its type, operands or children.
+// Returns nullptr if the instruction can't be represented.
+static IRInst* _createInst(IRModule* module, const StringSlicePool& stringTable, const IRSerialData::Inst& srcInst)
+{
+    typedef IRSerialData Ser;
+    typedef Ser::Inst::PayloadType PayloadType;
+
+    const IROp op((IROp)srcInst.m_op);
+
+    if (_isConstant(op))
+    {
+        // Handling of constants
+
+        // Calculate the minimum object size (ie not including the payload of value)    
+        const size_t prefixSize = SLANG_OFFSET_OF(IRConstant, value);
+
+        // All IR constants have zero operands.
+        Int operandCount = 0;
+
+        IRConstant* irConst = nullptr;
+        switch (op)
+        {                    
+            case kIROp_BoolLit:
+            {
+                // TODO: Most of these cases could use the templated `_allocateInst<T>`
+                // *if* we had distinct `IRConstant` subtypes to represent these
+                // cases and their subtype-specific payloads.
+
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::UInt32);
+                irConst = static_cast<IRConstant*>(module->_allocateInst(op, operandCount, prefixSize + sizeof(IRIntegerValue)));
+                irConst->value.intVal = srcInst.m_payload.m_uint32 != 0;
+                break;
+            }
+            case kIROp_IntLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
+                irConst = static_cast<IRConstant*>(module->_allocateInst(op, operandCount, prefixSize + sizeof(IRIntegerValue)));
+                irConst->value.intVal = srcInst.m_payload.m_int64; 
+                break;
+            }
+            case kIROp_PtrLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
+                irConst = static_cast<IRConstant*>(module->_allocateInst(op, operandCount, prefixSize + sizeof(void*)));
+                irConst->value.ptrVal = (void*) (intptr_t) srcInst.m_payload.m_int64; 
+                break;
+            }
+            case kIROp_FloatLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Float64);
+                irConst = static_cast<IRConstant*>(module->_allocateInst(op, operandCount,  prefixSize + sizeof(IRFloatingPointValue)));
+                irConst->value.floatVal = srcInst.m_payload.m_float64;
+                break;
+            }
+            case kIROp_VoidLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Empty);
+                irConst = static_cast<IRConstant*>(module->_allocateInst(
+                    op, operandCount, prefixSize));
+                break;
+            }
+            case kIROp_StringLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::String_1);
+
+                const UnownedStringSlice slice = stringTable.getSlice(StringSlicePool::Handle(srcInst.m_payload.m_stringIndices[0]));
+                    
+                const size_t sliceSize = slice.getLength();
+                const size_t instSize = prefixSize + SLANG_OFFSET_OF(IRConstant::StringValue, chars) + sliceSize;
+
+                irConst = static_cast<IRConstant*>(module->_allocateInst(op, operandCount, instSize));
+
+                IRConstant::StringValue& dstString = irConst->value.stringVal;
+
+                dstString.numChars = uint32_t(sliceSize);
+                // Turn into pointer to avoid warning of array overrun
+                char* dstChars = dstString.chars;
+                // Copy the chars
+                memcpy(dstChars, slice.begin(), sliceSize);
+                break;
+            }
+            default:
+            {
+                SLANG_ASSERT(!"Unknown constant type");
+                return nullptr;
+            }
+        }
+
+        return irConst;
+    }
+    else if (_isTextureTypeBase(op))
+    {
+        // TODO: We should clean up the IR encoding of texture types so that
+        // they do not need to have special-case suport in the serialization layer.
+
+        // All IR texture types currently have a single operand
+        Int operandCount = 1;
+        IRTextureTypeBase* inst = module->_allocateInst<IRTextureTypeBase>(op, operandCount);
+        SLANG_ASSERT(srcInst.m_payloadType == PayloadType::OperandAndUInt32);
+
+        // Reintroduce the texture type bits into the the
+        const uint32_t other = srcInst.m_payload.m_operandAndUInt32.m_uint32;
+        inst->m_op = IROp(uint32_t(inst->m_op) | (other << kIROpMeta_OtherShift));
+
+        return inst;
+    }
+    else
+    {
+        int numOperands = srcInst.getNumOperands();
+        return module->_allocateInst(op, numOperands);
+    }
+}
+
+// Calculate the source location of each instruction of `data`. `outSourceLocs` is left empty if
+// there are no source locations.
+static void _calcSourceLocs(const IRSerialData& data, SerialSourceLocReader* sourceLocReader, List<SourceLoc>& outSourceLocs)
+{
+    typedef IRSerialData Ser;
+
+    const Index numInsts = data.m_insts.getCount();
+    outSourceLocs.clear();
+
+    // Re-add source locations, if they are defined
+    if (data.m_rawSourceLocs.getCount() == numInsts)
+    {
+        outSourceLocs.setCount(numInsts);
+        const Ser::RawSourceLoc* srcLocs = data.m_rawSourceLocs.begin();
+        for (Index i = 0; i < numInsts; ++i)
+        {
+            outSourceLocs[i].setRaw(Slang::SourceLoc::RawValue(srcLocs[i]));
+        }
+    }
+
+    // We now need to apply the runs
+    if (sourceLocReader && data.m_debugSourceLocRuns.getCount())
+    {
+        if (outSourceLocs.getCount() != numInsts)
+        {
+            outSourceLocs.setCount(numInsts);
+            for (auto& sourceLoc : outSourceLocs)
+            {
+                sourceLoc = SourceLoc();
+            }
+        }
+
+        List<IRSerialData::SourceLocRun> sourceRuns(data.m_debugSourceLocRuns);
+        // They are now in source location order
+        sourceRuns.sort();
+
+        // Just guess initially 0 for the source file that contains the initial run
+        SerialSourceLocData::SourceRange range = SerialSourceLocData::SourceRange::getInvalid();
+        int fix = 0;
+        
+        const Index numRuns = sourceRuns.getCount();
+        for (Index i = 0; i < numRuns; ++i)
+        {
+            const auto& run = sourceRuns[i];
+
+            // Work out the fixed source location
+            SourceLoc sourceLoc;
+            if (run.m_sourceLoc)
+            {
+                if (!range.contains(run.m_sourceLoc))
+                {
+                    fix = sourceLocReader->calcFixSourceLoc(run.m_sourceLoc, range);
+                }
+                sourceLoc = sourceLocReader->calcFixedLoc(run.m_sourceLoc, fix, range);
+            }
+
+            // Write to all the instructions
+            SLANG_ASSERT(Index(uint32_t(run.m_startInstIndex) + run.m_numInst) <= numInsts);
+            SourceLoc* dstSourceLocs = outSourceLocs.getBuffer() + int(run.m_startInstIndex);
+
+            const int runSize = int(run.m_numInst);
+            for (int j = 0; j < runSize; ++j)
+            {
+                dstSourceLocs[j] = sourceLoc;
+            }
+        }
+    }
+}
+
 Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule)
 {
     typedef Ser::Inst::PayloadType PayloadType;
@@ -751,111 +933,10 @@ Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSo
 
     for (Index i = 2; i < numInsts; ++i)
     {
-        const Ser::Inst& srcInst = data.m_insts[i];
-
-        const IROp op((IROp)srcInst.m_op);
-
-        if (_isConstant(op))
+        insts[i] = _createInst(module, m_stringTable, data.m_insts[i]);
+        if (!insts[i])
         {
-            // Handling of constants
-
-            // Calculate the minimum object size (ie not including the payload of value)    
-            const size_t prefixSize = SLANG_OFFSET_OF(IRConstant, value);
-
-            // All IR constants have zero operands.
-            Int operandCount = 0;
-
-            IRConstant* irConst = nullptr;
-            switch (op)
-            {                    
-                case kIROp_BoolLit:
-                {
-                    // TODO: Most of these cases could use the templated `_allocateInst<T>`
-                    // *if* we had distinct `IRConstant` subtypes to represent these
-                    // cases and their subtype-specific payloads.
-
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::UInt32);
-                    irConst = static_cast<IRConstant*>(module->_allocateInst(op, operandCount, prefixSize + sizeof(IRIntegerValue)));
-                    irConst->value.intVal = srcInst.m_payload.m_uint32 != 0;
-                    break;
-                }
-                case kIROp_IntLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
-                    irConst = static_cast<IRConstant*>(module->_allocateInst(op, operandCount, prefixSize + sizeof(IRIntegerValue)));
-                    irConst->value.intVal = srcInst.m_payload.m_int64; 
-                    break;
-                }
-                case kIROp_PtrLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
-                    irConst = static_cast<IRConstant*>(module->_allocateInst(op, operandCount, prefixSize + sizeof(void*)));
-                    irConst->value.ptrVal = (void*) (intptr_t) srcInst.m_payload.m_int64; 
-                    break;
-                }
-                case kIROp_FloatLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Float64);
-                    irConst = static_cast<IRConstant*>(module->_allocateInst(op, operandCount,  prefixSize + sizeof(IRFloatingPointValue)));
-                    irConst->value.floatVal = srcInst.m_payload.m_float64;
-                    break;
-                }
-                case kIROp_VoidLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Empty);
-                    irConst = static_cast<IRConstant*>(module->_allocateInst(
-                        op, operandCount, prefixSize));
-                    break;
-                }
-                case kIROp_StringLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::String_1);
-
-                    const UnownedStringSlice slice = m_stringTable.getSlice(StringSlicePool::Handle(srcInst.m_payload.m_stringIndices[0]));
-                        
-                    const size_t sliceSize = slice.getLength();
-                    const size_t instSize = prefixSize + SLANG_OFFSET_OF(IRConstant::StringValue, chars) + sliceSize;
-
-                    irConst = static_cast<IRConstant*>(module->_allocateInst(op, operandCount, instSize));
-
-                    IRConstant::StringValue& dstString = irConst->value.stringVal;
-
-                    dstString.numChars = uint32_t(sliceSize);
-                    // Turn into pointer to avoid warning of array overrun
-                    char* dstChars = dstString.chars;
-                    // Copy the chars
-                    memcpy(dstChars, slice.begin(), sliceSize);
-                    break;
-                }
-                default:
-                {
-                    SLANG_ASSERT(!"Unknown constant type");
-                    return SLANG_FAIL;
-                }
-            }
-
-            insts[i] = irConst;
-        }
-        else if (_isTextureTypeBase(op))
-        {
-            // TODO: We should clean up the IR encoding of texture types so that
-            // they do not need to have special-case suport in the serialization layer.
-
-            // All IR texture types currently have a single operand
-            Int operandCount = 1;
-            IRTextureTypeBase* inst = module->_allocateInst<IRTextureTypeBase>(op, operandCount);
-            SLANG_ASSERT(srcInst.m_payloadType == PayloadType::OperandAndUInt32);
-
-            // Reintroduce the texture type bits into the the
-            const uint32_t other = srcInst.m_payload.m_operandAndUInt32.m_uint32;
-            inst->m_op = IROp(uint32_t(inst->getOp()) | (other << kIROpMeta_OtherShift));
-
-            insts[i] = inst;
-        }
-        else
-        {
-            int numOperands = srcInst.getNumOperands();
-            insts[i] = module->_allocateInst(op, numOperands);
+            return SLANG_FAIL;
         }
     }
 
@@ -911,58 +992,331 @@ Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSo
         }
     }
 
-    // Re-add source locations, if they are defined
-    if (m_serialData->m_rawSourceLocs.getCount() == numInsts)
+    List<SourceLoc> sourceLocs;
+    _calcSourceLocs(data, sourceLocReader, sourceLocs);
+    if (sourceLocs.getCount())
     {
-        const Ser::RawSourceLoc* srcLocs = m_serialData->m_rawSourceLocs.begin();
         for (Index i = 1; i < numInsts; ++i)
         {
-            IRInst* dstInst = insts[i];
-            
-            dstInst->sourceLoc.setRaw(Slang::SourceLoc::RawValue(srcLocs[i]));
+            insts[i]->sourceLoc = sourceLocs[i];
         }
     }
 
-    // We now need to apply the runs
-    if (sourceLocReader && m_serialData->m_debugSourceLocRuns.getCount())
+    return SLANG_OK;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! IRSerialLazyModule !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/* static */Result IRSerialLazyModule::create(Session* session, SerialSourceLocReader* sourceLocReader, IRSerialData& ioData, RefPtr<IRModule>& outModule)
+{
+    RefPtr<IRSerialLazyModule> reader = new IRSerialLazyModule;
+    reader->m_serialData = _Move(ioData);
+
+    RefPtr<IRModule> module = IRModule::create(session);
+    reader->m_module = module;
+    module->setLazyGlobalReader(reader);
+
+    SLANG_RETURN_ON_FAIL(reader->_init(sourceLocReader));
+
+    outModule = module;
+    return SLANG_OK;
+}
+
+Result IRSerialLazyModule::_init(SerialSourceLocReader* sourceLocReader)
+{
+    const IRSerialData& data = m_serialData;
+    const Index numInsts = data.m_insts.getCount();
+    if (numInsts < 2 || data.m_insts[1].m_op != kIROp_Module)
     {
-        List<IRSerialData::SourceLocRun> sourceRuns(m_serialData->m_debugSourceLocRuns);
-        // They are now in source location order
-        sourceRuns.sort();
+        return SLANG_FAIL;
+    }
 
-        // Just guess initially 0 for the source file that contains the initial run
-        SerialSourceLocData::SourceRange range = SerialSourceLocData::SourceRange::getInvalid();
-        int fix = 0;
-        
-        const Index numRuns = sourceRuns.getCount();
-        for (Index i = 0; i < numRuns; ++i)
+    SerialStringTableUtil::decodeStringTable(data.m_stringTable.getBuffer(), data.m_stringTable.getCount(), m_stringTable);
+
+    // Instructions are only created when read, so check up front that they can be
+    for (Index i = 2; i < numInsts; ++i)
+    {
+        const IROp op = IROp(data.m_insts[i].m_op);
+        if (_isConstant(op))
         {
-            const auto& run = sourceRuns[i];
+            switch (op)
+            {
+                case kIROp_BoolLit:
+                case kIROp_IntLit:
+                case kIROp_PtrLit:
+                case kIROp_FloatLit:
+                case kIROp_VoidLit:
+                case kIROp_StringLit:
+                    break;
+                default:
+                    return SLANG_FAIL;
+            }
+        }
+    }
 
-            // Work out the fixed source location
-            SourceLoc sourceLoc;
-            if (run.m_sourceLoc)
+    m_insts.setCount(numInsts);
+    for (auto& inst : m_insts)
+    {
+        inst = nullptr;
+    }
+    m_insts[1] = m_module->getModuleInst();
+
+    // The children of an instruction are a single run, and runs are held in the order that the
+    // instructions are added, so the parent of a run is always seen before its own children.
+    m_childRunIndices.setCount(numInsts);
+    m_globalIndices.setCount(numInsts);
+    for (Index i = 0; i < numInsts; ++i)
+    {
+        m_childRunIndices[i] = 0;
+        m_globalIndices[i] = 0;
+    }
+
+    const Index numChildRuns = data.m_childRuns.getCount();
+    for (Index i = 0; i < numChildRuns; ++i)
+    {
+        const auto& run = data.m_childRuns[i];
+        const Index parentIndex = Index(run.m_parentIndex);
+        const Index startIndex = Index(run.m_startInstIndex);
+
+        m_childRunIndices[parentIndex] = uint32_t(i + 1);
+
+        if (parentIndex == 1)
+        {
+            // The children of the module instruction are the globals
+            m_firstGlobalInstIndex = startIndex;
+            m_globals.setCount(Index(run.m_numChildren));
+            for (Index j = 0; j < Index(run.m_numChildren); ++j)
             {
-                if (!range.contains(run.m_sourceLoc))
+                m_globalIndices[startIndex + j] = uint32_t(j);
+            }
+        }
+        else
+        {
+            for (Index j = 0; j < Index(run.m_numChildren); ++j)
+            {
+                m_globalIndices[startIndex + j] = m_globalIndices[parentIndex];
+            }
+        }
+    }
+
+    // Find what is needed to link against a global without reading it. Decorations are the first
+    // children of an instruction.
+    const Index globalCount = m_globals.getCount();
+    for (Index i = 0; i < globalCount; ++i)
+    {
+        const Index instIndex = m_firstGlobalInstIndex + i;
+
+        Global& global = m_globals[i];
+        global.op = IROp(data.m_insts[instIndex].m_op);
+        global.decorationOpsStart = m_decorationOps.getCount();
+
+        if (const uint32_t childRunIndex = m_childRunIndices[instIndex])
+        {
+            const auto& run = data.m_childRuns[childRunIndex - 1];
+            for (Index j = 0; j < Index(run.m_numChildren); ++j)
+            {
+                const Ser::Inst& decoration = data.m_insts[Index(run.m_startInstIndex) + j];
+                const IROp decorationOp = IROp(decoration.m_op);
+                if (!IRDecoration::isaImpl(decorationOp))
                 {
-                    fix = sourceLocReader->calcFixSourceLoc(run.m_sourceLoc, range);
+                    break;
+                }
+                m_decorationOps.add(decorationOp);
+
+                const Ser::InstIndex* operandIndices;
+                if (IRLinkageDecoration::isaImpl(decorationOp) &&
+                    data.getOperands(decoration, &operandIndices) > 0)
+                {
+                    const Ser::Inst& mangledName = data.m_insts[Index(operandIndices[0])];
+                    if (mangledName.m_op == kIROp_StringLit)
+                    {
+                        global.mangledName = m_stringTable.getSlice(StringSlicePool::Handle(mangledName.m_payload.m_stringIndices[0]));
+                    }
                 }
-                sourceLoc = sourceLocReader->calcFixedLoc(run.m_sourceLoc, fix, range);
             }
+        }
+        global.decorationOpsCount = m_decorationOps.getCount() - global.decorationOpsStart;
+    }
+    m_unreadGlobalCount = globalCount;
 
-            // Write to all the instructions
-            SLANG_ASSERT(Index(uint32_t(run.m_startInstIndex) + run.m_numInst) <= insts.getCount());
-            IRInst** dstInsts = insts.getBuffer() + int(run.m_startInstIndex);
+    _calcSourceLocs(data, sourceLocReader, m_sourceLocs);
 
-            const int runSize = int(run.m_numInst);
-            for (int j = 0; j < runSize; ++j)
+    // The decorations of the module instruction are read up front, as they apply to the whole
+    // module. They come before any other global.
+    List<Index> globalIndices;
+    for (Index i = 0; i < globalCount && IRDecoration::isaImpl(m_globals[i].op); ++i)
+    {
+        globalIndices.add(i);
+    }
+    _readGlobals(globalIndices);
+
+    return SLANG_OK;
+}
+
+bool IRSerialLazyModule::globalHasDecoration(Index index, IROp decorationOp)
+{
+    const Global& global = m_globals[index];
+    for (Index i = 0; i < global.decorationOpsCount; ++i)
+    {
+        if (m_decorationOps[global.decorationOpsStart + i] == decorationOp)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+IRInst* IRSerialLazyModule::readGlobal(Index index)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_globals[index].inst)
+    {
+        List<Index> globalIndices;
+        globalIndices.add(index);
+        _readGlobals(globalIndices);
+    }
+    return m_globals[index].inst;
+}
+
+void IRSerialLazyModule::readAllGlobals()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_unreadGlobalCount)
+    {
+        List<Index> globalIndices;
+        for (Index i = m_globals.getCount() - 1; i >= 0; --i)
+        {
+            if (!m_globals[i].inst)
             {
-                dstInsts[j]->sourceLoc = sourceLoc;
+                globalIndices.add(i);
             }
         }
+        _readGlobals(globalIndices);
     }
+}
 
-    return SLANG_OK;
+void IRSerialLazyModule::_addGlobalOf(Ser::InstIndex instIndex, List<Index>& ioGlobalIndices)
+{
+    // 0 is null, and 1 is the module instruction
+    const Index index = Index(instIndex);
+    if (index > 1 && !m_insts[index])
+    {
+        ioGlobalIndices.add(Index(m_globalIndices[index]));
+    }
+}
+
+void IRSerialLazyModule::_readGlobals(List<Index>& ioGlobalIndices)
+{
+    const IRSerialData& data = m_serialData;
+
+    // As in `IRSerialReader::read`, the instructions are created first, and the types, operands
+    // and children are set once all the instructions they refer to exist. A global is always read
+    // along with all of its descendants.
+    List<Index> newInstIndices;
+    List<Index> newGlobalIndices;
+    List<Index> stack;
+    while (ioGlobalIndices.getCount())
+    {
+        const Index globalIndex = ioGlobalIndices.getLast();
+        ioGlobalIndices.removeLast();
+
+        const Index globalInstIndex = m_firstGlobalInstIndex + globalIndex;
+        if (m_insts[globalInstIndex])
+        {
+            continue;
+        }
+        newGlobalIndices.add(globalIndex);
+
+        const Index firstNewInstIndex = newInstIndices.getCount();
+        stack.add(globalInstIndex);
+        while (stack.getCount())
+        {
+            const Index instIndex = stack.getLast();
+            stack.removeLast();
+
+            m_insts[instIndex] = _createInst(m_module, m_stringTable, data.m_insts[instIndex]);
+            newInstIndices.add(instIndex);
+
+            if (const uint32_t childRunIndex = m_childRunIndices[instIndex])
+            {
+                const auto& run = data.m_childRuns[childRunIndex - 1];
+                for (Index j = 0; j < Index(run.m_numChildren); ++j)
+                {
+                    stack.add(Index(run.m_startInstIndex) + j);
+                }
+            }
+        }
+
+        // The globals the new instructions refer to are read too
+        for (Index i = firstNewInstIndex; i < newInstIndices.getCount(); ++i)
+        {
+            const Ser::Inst& srcInst = data.m_insts[newInstIndices[i]];
+            _addGlobalOf(srcInst.m_resultTypeIndex, ioGlobalIndices);
+
+            const Ser::InstIndex* srcOperandIndices;
+            const int numOperands = data.getOperands(srcInst, &srcOperandIndices);
+            for (int j = 0; j < numOperands; ++j)
+            {
+                _addGlobalOf(srcOperandIndices[j], ioGlobalIndices);
+            }
+        }
+    }
+
+    for (Index instIndex : newInstIndices)
+    {
+        const Ser::Inst& srcInst = data.m_insts[instIndex];
+        IRInst* dstInst = m_insts[instIndex];
+
+        if (srcInst.m_resultTypeIndex != Ser::InstIndex(0))
+        {
+            dstInst->setFullType(static_cast<IRType*>(m_insts[Index(srcInst.m_resultTypeIndex)]));
+        }
+
+        const Ser::InstIndex* srcOperandIndices;
+        const int numOperands = data.getOperands(srcInst, &srcOperandIndices);
+        auto dstOperands = dstInst->getOperands();
+        for (int j = 0; j < numOperands; ++j)
+        {
+            dstOperands[j].init(dstInst, m_insts[Index(srcOperandIndices[j])]);
+        }
+
+        if (const uint32_t childRunIndex = m_childRunIndices[instIndex])
+        {
+            const auto& run = data.m_childRuns[childRunIndex - 1];
+            for (Index j = 0; j < Index(run.m_numChildren); ++j)
+            {
+                m_insts[Index(run.m_startInstIndex) + j]->insertAtEnd(dstInst);
+            }
+        }
+
+        if (m_sourceLocs.getCount())
+        {
+            dstInst->sourceLoc = m_sourceLocs[instIndex];
+        }
+    }
+
+    // Globals are added to the module in the order they were serialized in, after those read before
+    newGlobalIndices.sort();
+    IRModuleInst* moduleInst = m_module->getModuleInst();
+    for (Index globalIndex : newGlobalIndices)
+    {
+        IRInst* inst = m_insts[m_firstGlobalInstIndex + globalIndex];
+        inst->insertAtEnd(moduleInst);
+        m_globals[globalIndex].inst = inst;
+    }
+
+    m_unreadGlobalCount -= newGlobalIndices.getCount();
+    if (m_unreadGlobalCount == 0)
+    {
+        // Everything is read, so the serialized data is no longer needed
+        m_serialData = IRSerialData();
+        m_insts = List<IRInst*>();
+        m_globalIndices = List<uint32_t>();
+        m_childRunIndices = List<uint32_t>();
+        m_sourceLocs = List<SourceLoc>();
+    }
 }
 
 } // namespace Slang
@@ -9,6 +9,8 @@
 #include "slang-ir.h"
 #include "slang-serialize-source-loc.h"
 
+#include <mutex>
+
 // For TranslationUnitRequest
 // and FrontEndCompileRequest::ExtraEntryPointInfo
 #include "slang-compiler.h"
@@ -89,6 +91,65 @@ struct IRSerialReader
     IRModule* m_module;
 };
 
+/// Reads the global instructions of a serialized IR module when they are first used (see
+/// `IRLazyGlobalReader`). Used for the stdlib modules, where linking only uses a small part of
+/// the IR.
+class IRSerialLazyModule : public IRLazyGlobalReader
+{
+public:
+    typedef IRSerialData Ser;
+
+        /// Create the IR module for `ioData`, which is taken over. Only the decorations of the module
+        /// instruction are read, the global instructions are read when first used through the
+        /// reader set on the module.
+    static Result create(Session* session, SerialSourceLocReader* sourceLocReader, IRSerialData& ioData, RefPtr<IRModule>& outModule);
+
+    // IRLazyGlobalReader
+    virtual Index getGlobalCount() SLANG_OVERRIDE { return m_globals.getCount(); }
+    virtual IROp getGlobalOp(Index index) SLANG_OVERRIDE { return m_globals[index].op; }
+    virtual UnownedStringSlice getGlobalMangledName(Index index) SLANG_OVERRIDE { return m_globals[index].mangledName; }
+    virtual bool globalHasDecoration(Index index, IROp decorationOp) SLANG_OVERRIDE;
+    virtual IRInst* readGlobal(Index index) SLANG_OVERRIDE;
+    virtual void readAllGlobals() SLANG_OVERRIDE;
+
+protected:
+    struct Global
+    {
+        IROp op;                            ///< The op of the instruction
+        UnownedStringSlice mangledName;     ///< From the linkage decoration, empty if there is none
+        Index decorationOpsStart;           ///< The ops of the decorations are in m_decorationOps from here
+        Index decorationOpsCount;
+        IRInst* inst = nullptr;             ///< Set once read
+    };
+
+    Result _init(SerialSourceLocReader* sourceLocReader);
+        /// Read the globals in `ioGlobalIndices` (which is used as a work list), and the globals they refer to
+    void _readGlobals(List<Index>& ioGlobalIndices);
+        /// If `instIndex` is in a global that hasn't been read, add the global to `ioGlobalIndices`
+    void _addGlobalOf(Ser::InstIndex instIndex, List<Index>& ioGlobalIndices);
+
+    std::mutex m_mutex;                     ///< Guards reading
+
+    IRModule* m_module = nullptr;           ///< The module being read into, which owns this reader
+
+    List<Global> m_globals;
+    List<IROp> m_decorationOps;
+    StringSlicePool m_stringTable;          ///< Holds the strings of the serialized data (including mangled names)
+    Index m_unreadGlobalCount = 0;
+
+    // The following are released once all the globals have been read
+
+    IRSerialData m_serialData;              ///< The serialized IR
+    Index m_firstGlobalInstIndex = 0;       ///< The index of the instruction of the first global
+    List<IRInst*> m_insts;                  ///< The instruction for each serialized instruction, if read
+    List<uint32_t> m_globalIndices;         ///< The index of the global each instruction is part of
+    List<uint32_t> m_childRunIndices;       ///< The index + 1 of the child run of each instruction, or 0
+    List<SourceLoc> m_sourceLocs;           ///< The source location of each instruction. Empty if there are none.
+
+public:
+    IRSerialLazyModule() : m_stringTable(StringSlicePool::Style::Default) {}
+};
+
 } // namespace Slang
 
 #endif
@@ -352,10 +352,6 @@ SerialIndex SerialWriter::addPointer(const RefObject* obj)
         m_ptrMap.Add(obj, Index(index));
         return index;
     }
-    else if (auto name = dynamicCast<const Name>(obj))
-    {
-        return addName(name);
-    }
 
     if (m_filter)
     {
@@ -738,21 +734,20 @@ String SerialReader::getString(SerialIndex index)
         return String();
     }
 
-    RefObject* obj = m_objects[Index(index)].dynamicCast<RefObject>();
+    SerialPointer& ptr = m_objects[Index(index)];
 
-    if (obj)
+    if (Name* name = ptr.getName())
     {
-        StringRepresentation* stringRep = dynamicCast<StringRepresentation>(obj);
-        if (stringRep)
-        {
-            return String(stringRep);
-        }
-        // Must be a name then
-        Name* name = dynamicCast<Name>(obj);
-        SLANG_ASSERT(name);
         return name->text;
     }
 
+    if (RefObject* obj = ptr.dynamicCast<RefObject>())
+    {
+        StringRepresentation* stringRep = dynamicCast<StringRepresentation>(obj);
+        SLANG_ASSERT(stringRep);
+        return String(stringRep);
+    }
+
     // Okay we need to construct as a string
     UnownedStringSlice slice = getStringSlice(index);
 
@@ -787,30 +782,13 @@ Name* SerialReader::getName(SerialIndex index)
         return nullptr;
     }
 
-    RefObject* obj = m_objects[Index(index)].dynamicCast<RefObject>();
-
-    if (obj)
+    if (Name* name = m_objects[Index(index)].getName())
     {
-        Name* name = dynamicCast<Name>(obj);
-        if (name)
-        {
-            return name;
-        }
-        // Can only be a string then
-        StringRepresentation* stringRep = dynamicCast<StringRepresentation>(obj);
-        SLANG_ASSERT(stringRep);
-
-        // I don't need to scope, as scoped in NamePool
-        name = m_namePool->getName(String(stringRep));
-
-        // Store as name, as can always access the inner string if needed
-        m_objects[Index(index)] = name;
         return name;
     }
 
-    UnownedStringSlice slice = getStringSlice(index);
-    String string(slice);
-    Name* name = m_namePool->getName(string);
+    // Looking up the name from the slice doesn't allocate if the name already exists
+    Name* name = m_namePool->getName(getStringSlice(index));
     // Don't need to add to scope, because scoped on the pool
     m_objects[Index(index)] = name;
     return name;
@@ -160,6 +160,15 @@ struct SerialPointer
         m_ptr((void*)in)
     {
     }
+        /// A `Name` read from a string entry. Names aren't RefObjects, so they are identified by the String kind.
+    SerialPointer(Name* in) :
+        m_kind(SerialTypeKind::String),
+        m_ptr((void*)in)
+    {
+    }
+
+        /// Get the name, or nullptr if the pointer is not to a `Name`
+    Name* getName() const { return m_kind == SerialTypeKind::String ? reinterpret_cast<Name*>(m_ptr) : nullptr; }
 
         /// True if the ptr is set
     SLANG_FORCE_INLINE operator bool() const { return m_ptr != nullptr; }
@@ -480,10 +480,24 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
     {
         declRef = createDefaultSubstitutionsIfNeeded(astBuilder, nullptr, declRef);
 
+        // Most of the types below are found or created through the builder's node cache, and then
+        // have their fields set if they were just created (a node found in the cache is never changed).
+        // The builder can be shared between threads, so hold its lock until a type is filled in.
+        ASTBuilder::SharedLock lock(astBuilder);
+
         if (auto builtinMod = declRef.getDecl()->findModifier<BuiltinTypeModifier>())
         {
-            auto type = astBuilder->create<BasicExpressionType>(builtinMod->tag);
-            type->declRef = declRef;
+            // The builtin types are created once on the shared builder when the standard
+            // library is loaded, so that they are the same node in every module.
+            if (auto builtinType = as<BasicExpressionType>(astBuilder->getBuiltinType(builtinMod->tag)))
+            {
+                if (builtinType->declRef.equals(declRef))
+                    return builtinType;
+            }
+
+            auto type = astBuilder->getOrCreate<BasicExpressionType>(builtinMod->tag);
+            if (!type->declRef.decl)
+                type->declRef = declRef;
             return type;
         }
         else if (auto magicMod = declRef.getDecl()->findModifier<MagicTypeModifier>())
@@ -501,23 +515,28 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
             if (magicMod->magicName == "SamplerState")
             {
                 auto type = astBuilder->getOrCreate<SamplerStateType>(SamplerStateFlavor(magicMod->tag));
-                type->declRef = declRef;
+                if (!type->declRef.decl)
+                    type->declRef = declRef;
                 return type;
             }
             else if (magicMod->magicName == "Vector")
             {
                 SLANG_ASSERT(subst && subst->getArgs().getCount() == 2);
                 auto vecType = astBuilder->getOrCreate<VectorExpressionType>(ExtractGenericArgType(subst->getArgs()[0]), ExtractGenericArgInteger(subst->getArgs()[1]));
-                vecType->declRef = declRef;
-                vecType->elementType = ExtractGenericArgType(subst->getArgs()[0]);
-                vecType->elementCount = ExtractGenericArgInteger(subst->getArgs()[1]);
+                if (!vecType->declRef.decl)
+                {
+                    vecType->declRef = declRef;
+                    vecType->elementType = ExtractGenericArgType(subst->getArgs()[0]);
+                    vecType->elementCount = ExtractGenericArgInteger(subst->getArgs()[1]);
+                }
                 return vecType;
             }
             else if (magicMod->magicName == "ArrayType")
             {
                 SLANG_ASSERT(subst && subst->getArgs().getCount() == 2);
                 auto vecType = astBuilder->getOrCreate<ArrayExpressionType>(ExtractGenericArgType(subst->getArgs()[0]), ExtractGenericArgInteger(subst->getArgs()[1]));
-                vecType->declRef = declRef;
+                if (!vecType->declRef.decl)
+                    vecType->declRef = declRef;
                 return vecType;
             }
             else if (magicMod->magicName == "Matrix")
@@ -527,14 +546,16 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
                     ExtractGenericArgType(subst->getArgs()[0]),
                     ExtractGenericArgInteger(subst->getArgs()[1]),
                     ExtractGenericArgInteger(subst->getArgs()[2]));
-                matType->declRef = declRef;
+                if (!matType->declRef.decl)
+                    matType->declRef = declRef;
                 return matType;
             }
             else if (magicMod->magicName == "TensorViewType")
             {
                 SLANG_ASSERT(subst && subst->getArgs().getCount() == 1);
                 auto vecType = astBuilder->getOrCreate<TensorViewType>(ExtractGenericArgType(subst->getArgs()[0]));
-                vecType->declRef = declRef;
+                if (!vecType->declRef.decl)
+                    vecType->declRef = declRef;
                 return vecType;
             }
             else if (magicMod->magicName == "Texture")
@@ -543,16 +564,18 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
                 auto textureType = astBuilder->getOrCreate<TextureType>(
                     TextureFlavor(magicMod->tag),
                     ExtractGenericArgType(subst->getArgs()[0]));
-                textureType->declRef = declRef;
+                if (!textureType->declRef.decl)
+                    textureType->declRef = declRef;
                 return textureType;
             }
             else if (magicMod->magicName == "TextureSampler")
             {
                 SLANG_ASSERT(subst && subst->getArgs().getCount() >= 1);
-                auto textureType = astBuilder->create<TextureSamplerType>(
+                auto textureType = astBuilder->getOrCreate<TextureSamplerType>(
                     TextureFlavor(magicMod->tag),
                     ExtractGenericArgType(subst->getArgs()[0]));
-                textureType->declRef = declRef;
+                if (!textureType->declRef.decl)
+                    textureType->declRef = declRef;
                 return textureType;
             }
             else if (magicMod->magicName == "GLSLImageType")
@@ -561,15 +584,19 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
                 auto textureType = astBuilder->getOrCreate<GLSLImageType>(
                     TextureFlavor(magicMod->tag),
                     ExtractGenericArgType(subst->getArgs()[0]));
-                textureType->declRef = declRef;
+                if (!textureType->declRef.decl)
+                    textureType->declRef = declRef;
                 return textureType;
             }
             else if (magicMod->magicName == "FeedbackType")
             {
                 SLANG_ASSERT(subst == nullptr);
                 auto type = astBuilder->getOrCreateWithDefaultCtor<FeedbackType>(magicMod->tag);
-                type->declRef = declRef;
-                type->kind = FeedbackType::Kind(magicMod->tag);
+                if (!type->declRef.decl)
+                {
+                    type->declRef = declRef;
+                    type->kind = FeedbackType::Kind(magicMod->tag);
+                }
                 return type;
             }
 
@@ -582,7 +609,8 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
             {                                                           \
                 auto type = astBuilder->getOrCreateWithDefaultCtor<T>(  \
                     declRef.decl, declRef.substitutions.substitutions); \
-                type->declRef = declRef;                                \
+                if (!type->declRef.decl)                                \
+                    type->declRef = declRef;                            \
                 return type;                                            \
             }
 
@@ -597,8 +625,11 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
                 SLANG_ASSERT(subst && subst->getArgs().getCount() == 1);                                   \
                 auto type =                                                                           \
                     astBuilder->getOrCreateWithDefaultCtor<T>(ExtractGenericArgType(subst->getArgs()[0])); \
-                type->elementType = ExtractGenericArgType(subst->getArgs()[0]);                            \
-                type->declRef = declRef;                                                              \
+                if (!type->declRef.decl)                                                              \
+                {                                                                                     \
+                    type->elementType = ExtractGenericArgType(subst->getArgs()[0]);                        \
+                    type->declRef = declRef;                                                          \
+                }                                                                                     \
                 return type;                                                                          \
             }
 
@@ -625,7 +656,8 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
             #define CASE(n,T)													\
                 else if(magicMod->magicName == #n) {		     				\
                     auto type = astBuilder->getOrCreate<T>();					\
-                    type->declRef = declRef;									\
+                    if (!type->declRef.decl)									\
+                        type->declRef = declRef;								\
                     return type;												\
                 }
 
@@ -646,7 +678,14 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
                     SLANG_UNEXPECTED("unhandled type");
                 }
 
-                NodeBase* type = classInfo.createInstance(astBuilder);
+                ASTBuilder::NodeDesc desc;
+                desc.type = ASTNodeType(classInfo.classInfo->m_classId);
+                desc.operands.add(declRef.decl);
+                if (auto substitutions = declRef.substitutions.substitutions)
+                {
+                    desc.operands.add(substitutions);
+                }
+                NodeBase* type = astBuilder->_getOrCreateImpl(desc, [&]() { return classInfo.createInstance(astBuilder); });
                 if (!type)
                 {
                     SLANG_UNEXPECTED("constructor failure");
@@ -657,7 +696,8 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
                 {
                     SLANG_UNEXPECTED("expected a declaration reference type");
                 }
-                declRefType->declRef = declRef;
+                if (!declRefType->declRef.decl)
+                    declRefType->declRef = declRef;
                 return declRefType;
             }
         }
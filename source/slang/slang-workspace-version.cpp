@@ -188,68 +188,51 @@ void Workspace::init(List<URI> rootDirURI, slang::IGlobalSession* globalSession)
     slangGlobalSession = globalSession;
 }
 
-void Workspace::invalidate() { currentVersion = nullptr; }
+void Workspace::invalidate()
+{
+    if (currentVersion)
+    {
+        previousVersion = currentVersion;
+    }
+    currentVersion = nullptr;
+}
 
-void WorkspaceVersion::parseDiagnostics(String compilerOutput)
+static LanguageServerProtocol::DiagnosticSeverity _getDiagnosticSeverity(Severity severity)
 {
-    List<UnownedStringSlice> lines;
-    StringUtil::calcLines(compilerOutput.getUnownedSlice(), lines);
-    for (Index lineIndex = 0; lineIndex < lines.getCount(); lineIndex++)
+    switch (severity)
     {
-        auto line = lines[lineIndex];
-        Index colonIndex = line.indexOf(UnownedStringSlice("):"));
-        if (colonIndex == -1)
-            continue;
-        Index lparentIndex = line.indexOf('(');
-        if (lparentIndex > colonIndex)
+    case Severity::Note:        return LanguageServerProtocol::kDiagnosticsSeverityInformation;
+    case Severity::Warning:     return LanguageServerProtocol::kDiagnosticsSeverityWarning;
+    default:                    return LanguageServerProtocol::kDiagnosticsSeverityError;
+    }
+}
+
+void WorkspaceVersion::addDiagnostics(const List<RecordedDiagnostic>& recordedDiagnostics)
+{
+    auto sourceManager = linkage->getSourceManager();
+    for (const auto& recordedDiagnostic : recordedDiagnostics)
+    {
+        auto sourceView = sourceManager->findSourceViewRecursively(recordedDiagnostic.range.begin);
+        if (!sourceView)
             continue;
-        String fileName = line.subString(0, lparentIndex);
+        auto humaneLoc = sourceView->getHumaneLoc(recordedDiagnostic.range.begin);
+
+        String fileName = humaneLoc.pathInfo.foundPath;
         Path::getCanonical(fileName, fileName);
         auto& diagnosticList = diagnostics.GetOrAddValue(fileName, DocumentDiagnostics());
+        if (diagnosticList.messages.Count() >= 1000)
+            continue;
 
+        // Diagnostics are reported for a single token, so the range ends on the same line.
         LanguageServerProtocol::Diagnostic diagnostic;
-        Index pos = lparentIndex + 1;
-        int lineLoc = StringUtil::parseIntAndAdvancePos(line, pos);
-        if (lineLoc == 0)
-            lineLoc = 1;
-        diagnostic.range.end.line = diagnostic.range.start.line = lineLoc;
-        pos++;
-        int colLoc = StringUtil::parseIntAndAdvancePos(line, pos);
-        if (colLoc == 0)
-            colLoc = 1;
-        diagnostic.range.end.character = diagnostic.range.start.character = colLoc;
-        if (pos >= line.getLength())
-            continue;
-        line = line.tail(colonIndex + 3);
-        colonIndex = line.indexOf(':');
-        if (colonIndex == -1)
-            continue;
-        if (line.startsWith("error"))
-        {
-            diagnostic.severity = LanguageServerProtocol::kDiagnosticsSeverityError;
-        }
-        else if (line.startsWith("warning"))
-        {
-            diagnostic.severity = LanguageServerProtocol::kDiagnosticsSeverityWarning;
-        }
-        else if (line.startsWith("note"))
-        {
-            diagnostic.severity = LanguageServerProtocol::kDiagnosticsSeverityInformation;
-        }
-        else
-        {
-            continue;
-        }
-        pos = line.indexOf(' ');
-        diagnostic.code = StringUtil::parseIntAndAdvancePos(line, pos);
-        diagnostic.message = line.tail(colonIndex + 2);
-        if (lineIndex + 1 < lines.getCount() && lines[lineIndex].startsWith("^+"))
-        {
-            lineIndex++;
-            pos = 2;
-            auto tokenLength = StringUtil::parseIntAndAdvancePos(line, pos);
-            diagnostic.range.end.character += tokenLength;
-        }
+        diagnostic.severity = _getDiagnosticSeverity(recordedDiagnostic.severity);
+        diagnostic.code = recordedDiagnostic.code;
+        diagnostic.message = recordedDiagnostic.message;
+        diagnostic.range.start.line = (int)Math::Max(humaneLoc.line, Int(1));
+        diagnostic.range.start.character = (int)Math::Max(humaneLoc.column, Int(1));
+        diagnostic.range.end.line = diagnostic.range.start.line;
+        diagnostic.range.end.character =
+            diagnostic.range.start.character + (int)recordedDiagnostic.range.getSize();
 
         if (auto doc = workspace->openedDocuments.TryGetValue(fileName))
         {
@@ -273,12 +256,10 @@ void WorkspaceVersion::parseDiagnostics(String compilerOutput)
             diagnostic.range.end.character--;
         }
         diagnosticList.messages.Add(diagnostic);
-        if (diagnosticList.messages.Count() >= 1000)
-            break;
     }
 }
 
-RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
+RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion(WorkspaceVersion* reuseFromVersion)
 {
     RefPtr<WorkspaceVersion> version = new WorkspaceVersion();
     version->workspace = this;
@@ -320,10 +301,22 @@ RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
     }
     desc.preprocessorMacros = macroDescs.getBuffer();
 
+    StringBuilder configKey;
+    for (auto path : searchPathsRaw)
+        configKey << path << "\n";
+    for (auto& macro : predefinedMacros)
+        configKey << "-D" << macro.name << "=" << macro.value << "\n";
+    version->configKey = configKey.ProduceString();
+
     ComPtr<slang::ISession> session;
     slangGlobalSession->createSession(desc, session.writeRef());
     version->linkage = static_cast<Linkage*>(session.get());
     version->linkage->contentAssistInfo.checkingMode = ContentAssistCheckingMode::General;
+
+    if (reuseFromVersion && reuseFromVersion->configKey == version->configKey)
+    {
+        version->reuseModules(reuseFromVersion);
+    }
     return version;
 }
 
@@ -342,12 +335,17 @@ SlangResult Workspace::loadFile(const char* path, ISlangBlob** outBlob)
 WorkspaceVersion* Workspace::getCurrentVersion()
 {
     if (!currentVersion)
-        currentVersion = createWorkspaceVersion();
+    {
+        currentVersion = createWorkspaceVersion(previousVersion);
+        previousVersion = nullptr;
+    }
     return currentVersion.Ptr();
 }
 WorkspaceVersion* Workspace::createVersionForCompletion()
 {
-    currentCompletionVersion = createWorkspaceVersion();
+    // Completion versions only reuse modules from the previous completion version, as modules
+    // are checked differently depending on the checking mode.
+    currentCompletionVersion = createWorkspaceVersion(currentCompletionVersion);
     currentCompletionVersion->linkage->contentAssistInfo.checkingMode =
         ContentAssistCheckingMode::Completion;
     return currentCompletionVersion.Ptr();
@@ -504,7 +502,6 @@ Module* WorkspaceVersion::getOrLoadModule(String path)
     auto doc = workspace->openedDocuments.TryGetValue(path);
     if (!doc)
         return nullptr;
-    ComPtr<ISlangBlob> diagnosticBlob;
     auto sourceBlob = StringBlob::create((*doc)->getText());
 
     auto moduleName = getMangledNameFromNameString(path.getUnownedSlice());
@@ -518,24 +515,281 @@ Module* WorkspaceVersion::getOrLoadModule(String path)
     // trying to reuse the existing one through `findOrImportModule`, this will result in
     // redundant parsing and storage, but it saves us from the hassle of handling
     // incremental/lazy checking on a previously loaded module.
-    auto parsedModule = linkage->loadModuleFromSource(
+
+    // Diagnostics are recorded as data by the sink, instead of being formatted as text.
+    DiagnosticSink sink(linkage->getSourceManager(), Lexer::sourceLocationLexer);
+    sink.setFlags(
+        DiagnosticSink::Flag::HumaneLoc | DiagnosticSink::Flag::LanguageServer |
+        DiagnosticSink::Flag::RecordDiagnostics);
+    RefPtr<Module> parsedModule = linkage->loadModuleFromSource(
         moduleName.getBuffer(),
         path.getBuffer(),
         sourceBlob,
-        diagnosticBlob.writeRef());
+        &sink);
     if (parsedModule)
     {
-        modules[path] = static_cast<Module*>(parsedModule);
+        modules[path] = parsedModule;
+    }
+    addDiagnostics(sink.getRecordedDiagnostics());
+    return parsedModule;
+}
+
+bool WorkspaceVersion::_isFileUnchanged(SourceFile* sourceFile, Dictionary<String, bool>& ioUnchangedFiles)
+{
+    const PathInfo& pathInfo = sourceFile->getPathInfo();
+    if (!pathInfo.hasFoundPath())
+    {
+        return false;
+    }
+
+    bool isUnchanged = false;
+    if (ioUnchangedFiles.TryGetValue(pathInfo.foundPath, isUnchanged))
+    {
+        return isUnchanged;
+    }
+
+    ComPtr<ISlangBlob> blob;
+    if (SLANG_SUCCEEDED(workspace->loadFile(pathInfo.foundPath.getBuffer(), blob.writeRef())))
+    {
+        isUnchanged = sourceFile->getContent() == StringUtil::getSlice(blob);
+    }
+    ioUnchangedFiles.Add(pathInfo.foundPath, isUnchanged);
+    return isUnchanged;
+}
+
+// Remove the modules that aren't in `modulesToKeep` from the lists of loaded modules of `linkage`.
+static void _releaseModules(Linkage* linkage, const HashSet<Module*>& modulesToKeep)
+{
+    List<Name*> names;
+    for (const auto& pair : linkage->mapNameToLoadedModules)
+    {
+        if (!modulesToKeep.Contains(pair.Value))
+        {
+            names.add(pair.Key);
+        }
+    }
+    for (Name* name : names)
+    {
+        linkage->mapNameToLoadedModules.Remove(name);
+    }
+
+    List<String> paths;
+    for (const auto& pair : linkage->mapPathToLoadedModule)
+    {
+        if (!modulesToKeep.Contains(pair.Value))
+        {
+            paths.add(pair.Key);
+        }
+    }
+    for (const String& path : paths)
+    {
+        linkage->mapPathToLoadedModule.Remove(path);
+    }
+
+    List<RefPtr<LoadedModule>> loadedModules;
+    for (const auto& module : linkage->loadedModulesList)
+    {
+        if (modulesToKeep.Contains(module))
+        {
+            loadedModules.add(module);
+        }
+    }
+    linkage->loadedModulesList.swapWith(loadedModules);
+}
+
+void WorkspaceVersion::reuseModules(WorkspaceVersion* previousVersion)
+{
+    Linkage* previousLinkage = previousVersion->linkage;
+    SourceManager* builtinSourceManager = linkage->getSessionImpl()->getBuiltinSourceManager();
+
+    // The modules a new linkage starts with are builtin, and can always be depended on.
+    HashSet<Module*> reusableModules;
+    for (const auto& pair : linkage->mapNameToLoadedModules)
+    {
+        reusableModules.Add(pair.Value);
+    }
+
+    // Modules loaded for open documents are always loaded afresh, see `getOrLoadModule`.
+    HashSet<Module*> primaryModules;
+    for (const auto& pair : previousVersion->modules)
+    {
+        primaryModules.Add(pair.Value);
+    }
+
+    // A module can be reused if its source files are unchanged, and all the modules it imports can
+    // be reused. The file dependencies of a module include those of the modules it imports, so
+    // editing a document invalidates the modules that (transitively) import it.
+    //
+    // Modules are added to `loadedModulesList` once checked, which is after the modules they
+    // import, so a single pass in that order sees the imports of a module first.
+    Dictionary<String, bool> unchangedFiles;
+    List<Module*> modulesToReuse;
+    for (Module* module : previousLinkage->loadedModulesList)
+    {
+        if (reusableModules.Contains(module) || primaryModules.Contains(module))
+        {
+            continue;
+        }
+
+        bool isReusable = true;
+        for (Module* importedModule : module->getModuleDependencyList())
+        {
+            if (importedModule != module && !reusableModules.Contains(importedModule))
+            {
+                isReusable = false;
+                break;
+            }
+        }
+        for (SourceFile* sourceFile : module->getFileDependencyList())
+        {
+            if (!isReusable)
+            {
+                break;
+            }
+            isReusable = _isFileUnchanged(sourceFile, unchangedFiles);
+        }
+
+        if (isReusable)
+        {
+            reusableModules.Add(module);
+            modulesToReuse.add(module);
+        }
+    }
+
+    if (modulesToReuse.getCount() == 0)
+    {
+        return;
     }
-    if (diagnosticBlob)
+
+    // A reused module refers to the linkage that loaded it, as the nodes created while checking
+    // it are owned by the AST builder of that linkage. It also refers to the source managers that
+    // own the files it depends on. Only the earlier linkages that are referred to are retained,
+    // the others are released along with the previous version.
+    HashSet<Linkage*> referencedLinkages;
+    HashSet<SourceManager*> referencedSourceManagers;
+    for (Module* module : modulesToReuse)
+    {
+        referencedLinkages.Add(module->getLinkage());
+        for (SourceFile* sourceFile : module->getFileDependencyList())
+        {
+            referencedSourceManagers.Add(sourceFile->getSourceManager());
+        }
+    }
+
+    List<Linkage*> earlierLinkages;
+    earlierLinkages.add(previousLinkage);
+    for (const auto& retainedLinkage : previousVersion->retainedLinkages)
+    {
+        earlierLinkages.add(retainedLinkage);
+    }
+    for (Linkage* earlierLinkage : earlierLinkages)
+    {
+        if (referencedLinkages.Contains(earlierLinkage) ||
+            referencedSourceManagers.Contains(earlierLinkage->getSourceManager()))
+        {
+            retainedLinkages.add(earlierLinkage);
+        }
+    }
+
+    // The source managers of the retained linkages are chained together, skipping those of the
+    // linkages that are released. Locations in a released source manager are no longer referred
+    // to, and the locations of a source manager always follow those of the managers before it.
+    SourceManager* parentSourceManager = builtinSourceManager;
+    for (Index i = retainedLinkages.getCount() - 1; i >= 0; --i)
     {
-        auto diagnosticString = String((const char*)diagnosticBlob->getBufferPointer());
-        parseDiagnostics(diagnosticString);
-        auto docDiagnostic = diagnostics.TryGetValue(path);
-        if (docDiagnostic)
-            docDiagnostic->originalOutput = diagnosticString;
+        SourceManager* retainedSourceManager = retainedLinkages[i]->getSourceManager();
+        retainedSourceManager->setParent(parentSourceManager);
+        parentSourceManager = retainedSourceManager;
     }
-    return static_cast<Module*>(parsedModule);
+
+    // The source manager of this version is made a child of the newest retained one, such that the
+    // locations in reused modules can be resolved, and new locations don't overlap with them.
+    //
+    // Source files found by unique identity (such as included files) are then also found in the
+    // retained source managers. Any of those that have changed are shadowed by a file with the
+    // current contents in this version.
+    List<SourceFile*> changedFiles;
+    List<ComPtr<ISlangBlob>> changedFileBlobs;
+    for (const auto& retainedLinkage : retainedLinkages)
+    {
+        for (SourceFile* sourceFile : retainedLinkage->getSourceManager()->getSourceFiles())
+        {
+            const String& uniqueIdentity = sourceFile->getPathInfo().uniqueIdentity;
+            if (uniqueIdentity.getLength() == 0 ||
+                parentSourceManager->findSourceFileRecursively(uniqueIdentity) != sourceFile ||
+                _isFileUnchanged(sourceFile, unchangedFiles))
+            {
+                continue;
+            }
+
+            ComPtr<ISlangBlob> blob;
+            if (SLANG_FAILED(workspace->loadFile(sourceFile->getPathInfo().foundPath.getBuffer(), blob.writeRef())))
+            {
+                // The file can't be shadowed if it can no longer be loaded, so nothing is reused.
+                retainedLinkages.clear();
+                return;
+            }
+            changedFiles.add(sourceFile);
+            changedFileBlobs.add(blob);
+        }
+    }
+
+    SourceManager* sourceManager = linkage->getSourceManager();
+    sourceManager->initialize(parentSourceManager, sourceManager->getFileSystemExt());
+    for (Index i = 0; i < changedFiles.getCount(); ++i)
+    {
+        const PathInfo& pathInfo = changedFiles[i]->getPathInfo();
+        SourceFile* sourceFile = sourceManager->createSourceFileWithBlob(pathInfo, changedFileBlobs[i]);
+        sourceManager->addSourceFile(pathInfo.uniqueIdentity, sourceFile);
+    }
+
+    for (const auto& pair : previousLinkage->mapNameToLoadedModules)
+    {
+        if (pair.Value && !linkage->mapNameToLoadedModules.ContainsKey(pair.Key) &&
+            reusableModules.Contains(pair.Value))
+        {
+            linkage->mapNameToLoadedModules.Add(pair.Key, pair.Value);
+        }
+    }
+    for (const auto& pair : previousLinkage->mapPathToLoadedModule)
+    {
+        if (pair.Value && !linkage->mapPathToLoadedModule.ContainsKey(pair.Key) &&
+            reusableModules.Contains(pair.Value))
+        {
+            linkage->mapPathToLoadedModule.Add(pair.Key, pair.Value);
+        }
+    }
+
+    // Diagnostics in the files of reused modules were reported when the modules were loaded, so
+    // carry them over.
+    for (Module* module : modulesToReuse)
+    {
+        linkage->loadedModulesList.add(module);
+
+        for (SourceFile* sourceFile : module->getFileDependencyList())
+        {
+            String canonicalPath;
+            if (SLANG_FAILED(Path::getCanonical(sourceFile->getPathInfo().foundPath, canonicalPath)) ||
+                diagnostics.ContainsKey(canonicalPath))
+            {
+                continue;
+            }
+            if (auto fileDiagnostics = previousVersion->diagnostics.TryGetValue(canonicalPath))
+            {
+                diagnostics.Add(canonicalPath, *fileDiagnostics);
+                reusedDiagnosticsFileCount++;
+            }
+        }
+    }
+
+    // The retained linkages only hold on to the modules that are reused. The others (such as the
+    // modules of open documents) can't be used from a later version, and are released.
+    for (const auto& retainedLinkage : retainedLinkages)
+    {
+        _releaseModules(retainedLinkage, reusableModules);
+    }
+
+    reusedModuleCount = modulesToReuse.getCount();
 }
 
 MacroDefinitionContentAssistInfo* WorkspaceVersion::tryGetMacroDefinition(UnownedStringSlice name)
@@ -105,7 +105,6 @@ namespace Slang
     struct DocumentDiagnostics
     {
         OrderedHashSet<LanguageServerProtocol::Diagnostic> messages;
-        String originalOutput;
     };
 
     class WorkspaceVersion : public RefObject
@@ -114,14 +113,42 @@ namespace Slang
         Dictionary<String, Module*> modules;
         Dictionary<ModuleDecl*, RefPtr<ASTMarkup>> markupASTs;
         Dictionary<Name*, MacroDefinitionContentAssistInfo*> macroDefinitions;
-        void parseDiagnostics(String compilerOutput);
+            /// Add diagnostics recorded by a DiagnosticSink to the diagnostics of each document
+        void addDiagnostics(const List<RecordedDiagnostic>& recordedDiagnostics);
+        bool _isFileUnchanged(SourceFile* sourceFile, Dictionary<String, bool>& ioUnchangedFiles);
     public:
         Workspace* workspace;
+
+            /// The linkages of earlier versions that loaded the reused modules, or the source files
+            /// they depend on, newest first. The nodes of a reused module are owned by the AST
+            /// builder of the linkage that checked it. The source manager of each retained linkage
+            /// is the parent of the one before it, and the first is the parent of the source
+            /// manager of this version.
+            ///
+            /// Earlier linkages are released once none of their modules are reused, so the number
+            /// retained is bounded by the number of reused modules, not by the number of versions.
+        List<RefPtr<Linkage>> retainedLinkages;
+
         RefPtr<Linkage> linkage;
         Dictionary<String, DocumentDiagnostics> diagnostics;
+
+            /// The search paths and macros the linkage was created with. Modules can only be
+            /// reused between versions with the same configuration.
+        String configKey;
+
+            /// The number of modules reused from the previous version
+        Index reusedModuleCount = 0;
+            /// The number of files whose diagnostics were carried over from the previous version
+        Index reusedDiagnosticsFileCount = 0;
+
         ASTMarkup* getOrCreateMarkupAST(ModuleDecl* module);
         Module* getOrLoadModule(String path);
         MacroDefinitionContentAssistInfo* tryGetMacroDefinition(UnownedStringSlice name);
+
+            /// Add the imported modules of `previousVersion` whose source files (including those
+            /// of their transitive imports) are unchanged to this version, such that they are not
+            /// parsed and checked again. Must be called before any module is loaded.
+        void reuseModules(WorkspaceVersion* previousVersion);
     };
 
     struct OwnedPreprocessorMacroDefinition
@@ -136,7 +163,9 @@ namespace Slang
     private:
         RefPtr<WorkspaceVersion> currentVersion;
         RefPtr<WorkspaceVersion> currentCompletionVersion;
-        RefPtr<WorkspaceVersion> createWorkspaceVersion();
+            /// The last invalidated version, whose modules can be reused by the next version
+        RefPtr<WorkspaceVersion> previousVersion;
+        RefPtr<WorkspaceVersion> createWorkspaceVersion(WorkspaceVersion* reuseFromVersion);
     public:
         List<String> rootDirectories;
         List<String> additionalSearchPaths;
@@ -160,6 +189,7 @@ namespace Slang
         void init(List<URI> rootDirURI, slang::IGlobalSession* globalSession);
         void invalidate();
         WorkspaceVersion* getCurrentVersion();
+        bool hasCurrentVersion() { return currentVersion.Ptr() != nullptr; }
         WorkspaceVersion* getCurrentCompletionVersion() { return currentCompletionVersion.Ptr(); }
         WorkspaceVersion* createVersionForCompletion();
     public:
@@ -17,6 +17,7 @@
 
 #include "slang-check.h"
 #include "slang-parameter-binding.h"
+#include "slang-ir-link.h"
 #include "slang-lower-to-ir.h"
 #include "slang-mangle.h"
 #include "slang-parser.h"
@@ -300,6 +301,8 @@ SlangResult Session::compileStdLib(slang::CompileStdLibFlags compileFlags)
     addBuiltinSource(hlslLanguageScope, "hlsl", StringBlob::moveCreate(getHLSLLibraryCode()));
     addBuiltinSource(autodiffLanguageScope, "diff", StringBlob::moveCreate(getAutodiffLibraryCode()));
 
+    _prepareStdLibForSharedUse();
+
     if (compileFlags & slang::CompileStdLibFlag::WriteDocumentation)
     {
         // Not 100% clear where best to get the ASTBuilder from, but from the linkage shouldn't
@@ -358,6 +361,8 @@ SlangResult Session::loadStdLib(const void* stdLib, size_t stdLibSizeInBytes)
     SLANG_RETURN_ON_FAIL(_readBuiltinModule(fileSystem, coreLanguageScope, "core"));
     SLANG_RETURN_ON_FAIL(_readBuiltinModule(fileSystem, hlslLanguageScope, "hlsl"));
     SLANG_RETURN_ON_FAIL(_readBuiltinModule(fileSystem, autodiffLanguageScope, "diff"));
+
+    _prepareStdLibForSharedUse();
     return SLANG_OK;
 }
 
@@ -452,6 +457,10 @@ SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* sco
     // Hmm - don't have a suitable sink yet, so attempt to just not have one
     options.sink = nullptr;
 
+    // Only the IR for the stdlib globals that are linked against is needed, so each global is
+    // read when the linker first uses it. Sessions only used for checking or reflection read none.
+    options.readIRLazily = true;
+
     SLANG_RETURN_ON_FAIL(SerialContainerUtil::read(&riffContainer, options, containerData));
 
     for (auto& srcModule : containerData.modules)
@@ -500,6 +509,84 @@ SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* sco
     return SLANG_OK;
 }
 
+// Compute the state of stdlib decls that is otherwise computed lazily on first use, such that
+// linkages on different threads only read it.
+static void _prepareDeclForSharedUse(Decl* decl)
+{
+    auto prepareType = [](TypeExp& typeExp)
+    {
+        if (typeExp.type)
+        {
+            typeExp.type->getCanonicalType();
+        }
+    };
+
+    if (auto varDecl = as<VarDeclBase>(decl))
+    {
+        prepareType(varDecl->type);
+    }
+    else if (auto typeDefDecl = as<TypeDefDecl>(decl))
+    {
+        prepareType(typeDefDecl->type);
+    }
+    else if (auto inheritanceDecl = as<InheritanceDecl>(decl))
+    {
+        prepareType(inheritanceDecl->base);
+    }
+    else if (auto constraintDecl = as<GenericTypeConstraintDecl>(decl))
+    {
+        prepareType(constraintDecl->sub);
+        prepareType(constraintDecl->sup);
+    }
+
+    if (auto callableDecl = as<CallableDecl>(decl))
+    {
+        prepareType(callableDecl->returnType);
+    }
+
+    if (auto containerDecl = as<ContainerDecl>(decl))
+    {
+        containerDecl->buildMemberDictionary();
+        for (auto member : containerDecl->members)
+        {
+            _prepareDeclForSharedUse(member);
+        }
+    }
+}
+
+void Session::_prepareStdLibForSharedUse()
+{
+    // Nodes can still be created on the builders holding the stdlib (and the session wide
+    // builders), so they need to be guarded.
+    m_sharedASTBuilder->enableSharedAccess();
+    m_builtinLinkage->getASTBuilder()->enableSharedAccess();
+    globalAstBuilder->enableSharedAccess();
+
+    // Subtype witnesses found while checking the stdlib can be used by every linkage, so they
+    // aren't found again. The cache is taken from the builtin linkage so it's no longer changed.
+    if (!m_stdlibTypeCheckingCache)
+    {
+        m_stdlibTypeCheckingCache = m_builtinLinkage->m_typeCheckingCache;
+        m_builtinLinkage->m_typeCheckingCache = nullptr;
+    }
+
+    for (Module* module : stdlibModules)
+    {
+        module->getASTBuilder()->enableSharedAccess();
+        if (auto moduleDecl = module->getModuleDecl())
+        {
+            _prepareDeclForSharedUse(moduleDecl);
+        }
+    }
+
+    // Line breaks of source files are found on first use, for example when reporting a
+    // diagnostic that refers to a stdlib declaration
+    for (SourceFile* sourceFile : builtinSourceManager.getSourceFiles())
+    {
+        sourceFile->getLineBreakOffsets();
+    }
+}
+
 ISlangUnknown* Session::getInterface(const Guid& guid)
 {
     if(guid == ISlangUnknown::getTypeGuid() || guid == IGlobalSession::getTypeGuid())
@@ -581,6 +668,11 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Session::createSession(
         linkage->m_useFalcorCustomSharedKeywordSemantics = true;
     }
 
+    if (desc.flags & slang::kSessionFlag_ReportPerformance)
+    {
+        linkage->setReportPerformance(true);
+    }
+
     linkage->setMatrixLayoutMode(desc.defaultMatrixLayoutMode);
 
     Int searchPathCount = desc.searchPathCount;
@@ -901,6 +993,9 @@ Linkage::Linkage(Session* session, ASTBuilder* astBuilder, Linkage* builtinLinka
 
     m_defaultSourceManager.initialize(session->getBuiltinSourceManager(), nullptr);
 
+    m_preprocessorTokenCache = new PreprocessorTokenCache(getNamePool());
+    m_downstreamCompileCache = new DownstreamCompileCache;
+
     setFileSystem(nullptr);
 
     // Copy of the built in linkages modules
@@ -1031,6 +1126,17 @@ SLANG_NO_THROW slang::IModule* SLANG_MCALL Linkage::loadModuleFromSource(
         sink.setFlags(DiagnosticSink::Flag::HumaneLoc | DiagnosticSink::Flag::LanguageServer);
     }
 
+    auto module = loadModuleFromSource(moduleName, path, source, &sink);
+    sink.getBlobIfNeeded(outDiagnostics);
+    return asExternal(module);
+}
+
+RefPtr<Module> Linkage::loadModuleFromSource(
+    const char*     moduleName,
+    const char*     path,
+    ISlangBlob*     source,
+    DiagnosticSink* sink)
+{
     try
     {
         auto name = getNamePool()->getName(moduleName);
@@ -1049,20 +1155,16 @@ SLANG_NO_THROW slang::IModule* SLANG_MCALL Linkage::loadModuleFromSource(
                 pathInfo = PathInfo::makeNormal(pathStr, cannonicalPath);
             }
         }
-        auto module = loadModule(
+        return loadModule(
             name,
             pathInfo,
             source,
             SourceLoc(),
-            &sink,
+            sink,
             nullptr);
-        sink.getBlobIfNeeded(outDiagnostics);
-        return asExternal(module);
-
     }
     catch (const AbortCompilationException&)
     {
-        sink.getBlobIfNeeded(outDiagnostics);
         return nullptr;
     }
 }
@@ -2595,6 +2697,8 @@ void EndToEndCompileRequest::init()
 
 SlangResult EndToEndCompileRequest::executeActionsInner()
 {
+    CompileProfiler::Scope profileScope(getLinkage()->getProfiler(), "executeActions");
+
     // If no code-generation target was specified, then try to infer one from the source language,
     // just to make sure we can do something reasonable when invoked from the command line.
     //
@@ -2714,11 +2818,56 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
     return SLANG_OK;
 }
 
+SlangResult EndToEndCompileRequest::_writePerformanceReports()
+{
+    auto profiler = getLinkage()->getProfiler();
+    if (!profiler)
+    {
+        return SLANG_OK;
+    }
+
+    if (m_reportPerformance)
+    {
+        StringBuilder buf;
+        profiler->appendTable(buf);
+
+        if (auto writer = getWriter(WriterChannel::StdOutput))
+        {
+            SLANG_RETURN_ON_FAIL(writer->write(buf.getBuffer(), buf.getLength()));
+        }
+    }
+
+    if (m_performanceReportOutputPath.getLength())
+    {
+        StringBuilder buf;
+        profiler->appendJSON(buf);
+
+        if (SLANG_FAILED(File::writeAllText(m_performanceReportOutputPath, buf)))
+        {
+            getSink()->diagnose(SourceLoc(), Diagnostics::cannotWriteOutputFile, m_performanceReportOutputPath);
+            return SLANG_FAIL;
+        }
+    }
+
+    return SLANG_OK;
+}
+
 // Act as expected of the API-based compiler
 SlangResult EndToEndCompileRequest::executeActions()
 {
     SlangResult res = executeActionsInner();
 
+    // Performance reports are written even if compilation failed, as they are still
+    // useful for seeing where the time went.
+    if (m_isCommandLineCompile)
+    {
+        const SlangResult reportRes = _writePerformanceReports();
+        if (SLANG_SUCCEEDED(res))
+        {
+            res = reportRes;
+        }
+    }
+
     m_diagnosticOutput = getSink()->outputBuffer.ProduceString();
     return res;
 }
@@ -2963,6 +3112,30 @@ RefPtr<Module> Linkage::loadModule(
     DiagnosticSink*     sink,
     const LoadedModuleDictionary* additionalLoadedModules)
 {
+    // If module caching is enabled, try loading the already checked module from the cache.
+    //
+    // The cache isn't used if there are additional loaded modules, because the cached module's
+    // imports are found by name on the linkage, which wouldn't find modules in that dictionary.
+    const bool useModuleCache = m_moduleCache &&
+        sourceBlob &&
+        !isInLanguageServer() &&
+        !(additionalLoadedModules && additionalLoadedModules->Count());
+
+    if (useModuleCache)
+    {
+        if (RefPtr<Module> cachedModule = m_moduleCache->tryLoadModule(this, name, filePathInfo, sourceBlob, srcLoc, sink))
+        {
+            mapPathToLoadedModule.Add(filePathInfo.getMostUniqueIdentity(), cachedModule);
+            mapNameToLoadedModules.Add(name, cachedModule);
+            loadedModulesList.add(cachedModule);
+            return cachedModule;
+        }
+    }
+
+    // Diagnostics aren't stored in the module cache, so a module is only cached if it produced none.
+    // Otherwise the diagnostics would be lost when the module is loaded from the cache.
+    const int diagnosticCountBefore = sink->getDiagnosticCount();
+
     RefPtr<FrontEndCompileRequest> frontEndReq = new FrontEndCompileRequest(this, nullptr, sink);
 
     frontEndReq->additionalLoadedModules = additionalLoadedModules;
@@ -3040,6 +3213,12 @@ RefPtr<Module> Linkage::loadModule(
         return nullptr;
     }
 
+    if (useModuleCache && sink->getDiagnosticCount() == diagnosticCountBefore)
+    {
+        // Failing to store the module isn't an error, it will just be compiled from source next time.
+        m_moduleCache->storeModule(this, name, filePathInfo, sourceBlob, module);
+    }
+
     return module;
 }
 
@@ -3240,6 +3419,15 @@ Module::Module(Linkage* linkage, ASTBuilder* astBuilder)
     addModuleDependency(this);
 }
 
+IRModule* Module::getIRModule()
+{
+    if (m_irModule)
+    {
+        m_irModule->readLazyGlobals();
+    }
+    return m_irModule;
+}
+
 ISlangUnknown* Module::getInterface(const Guid& guid)
 {
     if(guid == IModule::getTypeGuid())
@@ -3279,7 +3467,7 @@ RefPtr<EntryPoint> Module::findEntryPointByName(UnownedStringSlice const& name)
 
     for(auto entryPoint : m_entryPoints)
     {
-        if(entryPoint->getName()->text.getUnownedSlice() == name)
+        if(entryPoint->getName()->text == name)
             return entryPoint;
     }
 
@@ -3542,28 +3730,28 @@ RefPtr<ComponentType> ComponentType::specialize(
         sink);
 }
 
-SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::specialize(
+    /// Convert the specialization arguments passed to the API to the internal representation.
+    /// Fails if the number of arguments doesn't match the parameters of `componentType`.
+static SlangResult _expandSpecializationArgs(
+    ComponentType*                  componentType,
     slang::SpecializationArg const* specializationArgs,
     SlangInt                        specializationArgCount,
-    slang::IComponentType**         outSpecializedComponentType,
-    ISlangBlob**                    outDiagnostics)
+    DiagnosticSink*                 sink,
+    List<SpecializationArg>&        outExpandedArgs)
 {
-    DiagnosticSink sink(getLinkage()->getSourceManager(), Lexer::sourceLocationLexer);
-
     // First let's check if the number of arguments given matches
     // the number of parameters that are present on this component type.
     //
-    auto specializationParamCount = getSpecializationParamCount();
+    auto specializationParamCount = componentType->getSpecializationParamCount();
     if( specializationArgCount != specializationParamCount )
     {
-        sink.diagnose(SourceLoc(), Diagnostics::mismatchSpecializationArguments,
+        sink->diagnose(SourceLoc(), Diagnostics::mismatchSpecializationArguments,
             specializationParamCount,
             specializationArgCount);
-        sink.getBlobIfNeeded(outDiagnostics);
         return SLANG_FAIL;
     }
 
-    List<SpecializationArg> expandedArgs;
+    outExpandedArgs.clear();
     for( Int aa = 0; aa < specializationArgCount; ++aa )
     {
         auto apiArg = specializationArgs[aa];
@@ -3576,10 +3764,26 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::specialize(
             break;
 
         default:
-            sink.getBlobIfNeeded(outDiagnostics);
             return SLANG_FAIL;
         }
-        expandedArgs.add(expandedArg);
+        outExpandedArgs.add(expandedArg);
+    }
+    return SLANG_OK;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::specialize(
+    slang::SpecializationArg const* specializationArgs,
+    SlangInt                        specializationArgCount,
+    slang::IComponentType**         outSpecializedComponentType,
+    ISlangBlob**                    outDiagnostics)
+{
+    DiagnosticSink sink(getLinkage()->getSourceManager(), Lexer::sourceLocationLexer);
+
+    List<SpecializationArg> expandedArgs;
+    if (SLANG_FAILED(_expandSpecializationArgs(this, specializationArgs, specializationArgCount, &sink, expandedArgs)))
+    {
+        sink.getBlobIfNeeded(outDiagnostics);
+        return SLANG_FAIL;
     }
 
     auto specializedComponentType = specialize(
@@ -3603,9 +3807,115 @@ SLANG_NO_THROW SlangResult SLANG_MCALL
     return SLANG_OK;
 }
 
+SLANG_NO_THROW SlangResult SLANG_MCALL
+    ComponentType::getPerformanceReport(SlangPerformanceReportFormat format, ISlangBlob** outReport)
+{
+    auto profiler = getLinkage()->getProfiler();
+    if (!profiler)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    return profiler->writeReport(format, outReport);
+}
+
 RefPtr<ComponentType> fillRequirements(
     ComponentType* inComponentType);
 
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getSpecializedEntryPointCodes(
+    slang::SpecializationArg const* specializationArgs,
+    SlangInt                        specializationArgCount,
+    SlangInt                        specializationArgSetCount,
+    SlangInt                        entryPointIndex,
+    SlangInt                        targetIndex,
+    slang::IBlob**                  outCodes,
+    slang::IBlob**                  outDiagnostics)
+{
+    auto linkage = getLinkage();
+    if (targetIndex < 0 || targetIndex >= linkage->targets.getCount() ||
+        entryPointIndex < 0 || entryPointIndex >= getEntryPointCount() ||
+        specializationArgCount < 0 || specializationArgSetCount < 0)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+    auto target = linkage->targets[targetIndex];
+
+    for (Index i = 0; i < specializationArgSetCount; ++i)
+    {
+        outCodes[i] = nullptr;
+    }
+
+    DiagnosticSink sink(linkage->getSourceManager(), Lexer::sourceLocationLexer);
+
+    // Every specialization links the IR of the stdlib and of this component
+    // type, followed by the IR specific to the specialization. The symbols for
+    // the former are the same for every specialization, so are built once.
+    //
+    RefPtr<IRLinkSymbolTable> symbolTable = createLinkSymbolTable(this);
+
+    // Specializing and laying out the programs checks and creates AST nodes on
+    // the linkage, so is done serially. Linking, the IR passes, emit and the
+    // downstream compile for each specialization are then done concurrently as
+    // tasks of a `ParallelDownstreamCompile`, which fans out for source targets
+    // as well as binary ones.
+    //
+    List<RefPtr<ComponentType>> linkedPrograms;
+    List<TargetProgram*> targetPrograms;
+    ParallelDownstreamCompile parallelDownstreamCompile;
+
+    SlangResult result = SLANG_OK;
+    for (Index i = 0; i < specializationArgSetCount; ++i)
+    {
+        const Index errorCount = sink.getErrorCount();
+
+        List<SpecializationArg> expandedArgs;
+        if (SLANG_FAILED(_expandSpecializationArgs(this, specializationArgs + i * specializationArgCount, specializationArgCount, &sink, expandedArgs)))
+        {
+            sink.getBlobIfNeeded(outDiagnostics);
+            return SLANG_FAIL;
+        }
+
+        TargetProgram* targetProgram = nullptr;
+        auto specialized = specialize(expandedArgs.getBuffer(), expandedArgs.getCount(), &sink);
+        if (specialized && sink.getErrorCount() == errorCount)
+        {
+            if (auto linked = fillRequirements(specialized))
+            {
+                linkedPrograms.add(linked);
+
+                targetProgram = linked->getTargetProgram(target);
+                if (targetProgram->getOrCreateIRModuleForLayout(&sink))
+                {
+                    targetProgram->setLinkSymbolTable(symbolTable);
+                    parallelDownstreamCompile.addTask(targetProgram, entryPointIndex);
+                }
+                else
+                {
+                    targetProgram = nullptr;
+                }
+            }
+        }
+        if (!targetProgram)
+        {
+            result = SLANG_FAIL;
+        }
+        targetPrograms.add(targetProgram);
+    }
+
+    parallelDownstreamCompile.execute(0, nullptr, &sink);
+
+    for (Index i = 0; i < specializationArgSetCount; ++i)
+    {
+        IArtifact* artifact = targetPrograms[i] ? targetPrograms[i]->getExistingEntryPointResult(entryPointIndex) : nullptr;
+        if (!artifact || SLANG_FAILED(artifact->loadBlob(ArtifactKeep::Yes, &outCodes[i])))
+        {
+            result = SLANG_FAIL;
+        }
+    }
+
+    sink.getBlobIfNeeded(outDiagnostics);
+    return result;
+}
+
 SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::link(
     slang::IComponentType**         outLinkedComponentType,
     ISlangBlob**                    outDiagnostics)
@@ -4413,6 +4723,15 @@ TargetProgram::TargetProgram(
     m_entryPointResults.setCount(componentType->getEntryPointCount());
 }
 
+TargetProgram::~TargetProgram()
+{
+}
+
+void TargetProgram::setLinkSymbolTable(IRLinkSymbolTable* symbolTable)
+{
+    m_linkSymbolTable = symbolTable;
+}
+
 //
 
 
@@ -4470,6 +4789,36 @@ void Linkage::setFileSystem(ISlangFileSystem* inFileSystem)
     getSourceManager()->setFileSystemExt(m_fileSystemExt);
 }
 
+void Linkage::setReportPerformance(bool enable)
+{
+    if (enable)
+    {
+        if (!m_profiler)
+        {
+            m_profiler = new CompileProfiler;
+        }
+    }
+    else
+    {
+        m_profiler.setNull();
+    }
+}
+
+void Linkage::setModuleCachePath(const String& path)
+{
+    if (path.getLength())
+    {
+        if (!m_moduleCache || m_moduleCache->getDirectory() != path)
+        {
+            m_moduleCache = new ModuleCache(path);
+        }
+    }
+    else
+    {
+        m_moduleCache.setNull();
+    }
+}
+
 void Linkage::setRequireCacheFileSystem(bool requireCacheFileSystem)
 {
     if (requireCacheFileSystem == m_requireCacheFileSystem)
@@ -4563,6 +4912,8 @@ Session::~Session()
 {
     // destroy modules next
     stdlibModules = decltype(stdlibModules)();
+
+    delete m_stdlibTypeCheckingCache;
 }
 
 }
@@ -4752,6 +5103,26 @@ void EndToEndCompileRequest::setOptimizationLevel(SlangOptimizationLevel level)
     getLinkage()->optimizationLevel = OptimizationLevel(level);
 }
 
+void EndToEndCompileRequest::setReportPerformance(bool enable)
+{
+    getLinkage()->setReportPerformance(enable);
+}
+
+SlangResult EndToEndCompileRequest::getPerformanceReport(SlangPerformanceReportFormat format, ISlangBlob** outReport)
+{
+    auto profiler = getLinkage()->getProfiler();
+    if (!profiler)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    return profiler->writeReport(format, outReport);
+}
+
+void EndToEndCompileRequest::setDownstreamCompileThreadCount(int count)
+{
+    m_downstreamCompileThreadCount = count;
+}
+
 void EndToEndCompileRequest::setOutputContainerFormat(SlangContainerFormat format)
 {
     m_containerFormat = ContainerFormat(format);
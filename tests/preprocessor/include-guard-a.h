@@ -0,0 +1,10 @@
+// include-guard-a.h
+
+// Used by the `include-guard.slang` test
+
+#ifndef INCLUDE_GUARD_A_H
+#define INCLUDE_GUARD_A_H
+
+float guardedA(float x) { return x; }
+
+#endif
@@ -0,0 +1,14 @@
+// include-guard-b.h
+
+// Used by the `include-guard.slang` test
+
+#ifndef INCLUDE_GUARD_B_H
+#define INCLUDE_GUARD_B_H
+#endif
+
+#ifdef INCLUDE_GUARD_B_ONCE
+#define INCLUDE_GUARD_B_TWICE
+#endif
+#ifndef INCLUDE_GUARD_B_ONCE
+#define INCLUDE_GUARD_B_ONCE
+#endif
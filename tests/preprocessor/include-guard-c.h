@@ -0,0 +1,15 @@
+// include-guard-c.h
+
+// Used by the `include-guard.slang` test
+
+#ifndef INCLUDE_GUARD_C_H
+#define INCLUDE_GUARD_C_H
+
+#ifdef INCLUDE_GUARD_C_ONCE
+#define INCLUDE_GUARD_C_TWICE
+#endif
+#ifndef INCLUDE_GUARD_C_ONCE
+#define INCLUDE_GUARD_C_ONCE
+#endif
+
+#endif
@@ -0,0 +1,9 @@
+// include-guard-d.h
+
+// Used by the `include-guard.slang` test
+
+#ifndef INCLUDE_GUARD_D_H
+#define INCLUDE_GUARD_D_H
+#else
+#define INCLUDE_GUARD_D_TWICE
+#endif
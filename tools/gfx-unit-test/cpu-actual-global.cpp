@@ -0,0 +1,108 @@
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "slang-gfx.h"
+#include "gfx-test-util.h"
+#include "tools/gfx-util/shader-cursor.h"
+#include "source/core/slang-basic.h"
+
+using namespace gfx;
+
+namespace gfx_test
+{
+    void cpuActualGlobalTestImpl(IDevice* device, UnitTestContext* context)
+    {
+        Slang::ComPtr<ITransientResourceHeap> transientHeap;
+        ITransientResourceHeap::Desc transientHeapDesc = {};
+        transientHeapDesc.constantBufferSize = 4096;
+        GFX_CHECK_CALL_ABORT(
+            device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+        ComPtr<IShaderProgram> shaderProgram;
+        slang::ProgramLayout* slangReflection;
+        GFX_CHECK_CALL_ABORT(loadComputeProgram(device, shaderProgram, "cpu-actual-global", "computeMain", slangReflection));
+
+        ComputePipelineStateDesc pipelineDesc = {};
+        pipelineDesc.program = shaderProgram.get();
+        ComPtr<gfx::IPipelineState> pipelineState;
+        GFX_CHECK_CALL_ABORT(
+            device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+        // One value per group, written and read back by groups spread over the threads of the device
+        const int groupCount = 64;
+        const int numberCount = groupCount;
+
+        Slang::List<uint32_t> initialData;
+        initialData.setCount(numberCount);
+        ::memset(initialData.getBuffer(), 0, sizeof(uint32_t) * numberCount);
+
+        IBufferResource::Desc bufferDesc = {};
+        bufferDesc.sizeInBytes = numberCount * sizeof(uint32_t);
+        bufferDesc.format = gfx::Format::Unknown;
+        bufferDesc.elementSize = sizeof(uint32_t);
+        bufferDesc.allowedStates = ResourceStateSet(
+            ResourceState::ShaderResource,
+            ResourceState::UnorderedAccess,
+            ResourceState::CopyDestination,
+            ResourceState::CopySource);
+        bufferDesc.defaultState = ResourceState::UnorderedAccess;
+        bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+        ComPtr<IBufferResource> numbersBuffer;
+        GFX_CHECK_CALL_ABORT(device->createBufferResource(
+            bufferDesc,
+            (void*)initialData.getBuffer(),
+            numbersBuffer.writeRef()));
+
+        ComPtr<IResourceView> bufferView;
+        IResourceView::Desc viewDesc = {};
+        viewDesc.type = IResourceView::Type::UnorderedAccess;
+        viewDesc.format = Format::Unknown;
+        GFX_CHECK_CALL_ABORT(
+            device->createBufferView(numbersBuffer, nullptr, viewDesc, bufferView.writeRef()));
+
+        {
+            ICommandQueue::Desc queueDesc = { ICommandQueue::QueueType::Graphics };
+            auto queue = device->createCommandQueue(queueDesc);
+
+            // The first dispatch writes the `__global` from every group, the second reads it back
+            for (uint32_t mode = 0; mode < 2; ++mode)
+            {
+                auto commandBuffer = transientHeap->createCommandBuffer();
+                auto encoder = commandBuffer->encodeComputeCommands();
+
+                auto rootObject = encoder->bindPipeline(pipelineState);
+
+                ShaderCursor entryPointCursor(rootObject->getEntryPoint(0));
+                entryPointCursor.getPath("mode").setData(&mode, sizeof(mode));
+                entryPointCursor.getPath("buffer").setResource(bufferView);
+
+                encoder->dispatchCompute(groupCount, 1, 1);
+                encoder->endEncoding();
+                commandBuffer->close();
+                queue->executeCommandBuffer(commandBuffer);
+                queue->waitOnHost();
+            }
+        }
+
+        // Every value written by the first dispatch must be visible to the second
+        Slang::List<uint32_t> expectedData;
+        expectedData.setCount(numberCount);
+        for (int i = 0; i < numberCount; ++i)
+        {
+            expectedData[i] = uint32_t(i + 1);
+        }
+
+        compareComputeResult(
+            device,
+            numbersBuffer,
+            0,
+            expectedData.getBuffer(),
+            sizeof(uint32_t) * numberCount);
+    }
+
+    SLANG_UNIT_TEST(cpuActualGlobal)
+    {
+        runTestImpl(cpuActualGlobalTestImpl, unitTestContext, Slang::RenderApiFlag::CPU);
+    }
+
+}
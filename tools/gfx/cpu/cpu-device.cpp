@@ -21,6 +21,7 @@ namespace cpu
     {
         m_currentPipeline = nullptr;
         m_currentRootObject = nullptr;
+        m_threadPool = nullptr;
     }
 
     SLANG_NO_THROW Result SLANG_MCALL DeviceImpl::initialize(const Desc& desc)
@@ -33,6 +34,23 @@ namespace cpu
 
         SLANG_RETURN_ON_FAIL(RendererBase::initialize(desc));
 
+        // Find extended desc.
+        for (GfxIndex i = 0; i < desc.extendedDescCount; i++)
+        {
+            StructType stype;
+            memcpy(&stype, desc.extendedDescs[i], sizeof(stype));
+            switch (stype)
+            {
+            case StructType::CPUDeviceExtendedDesc:
+                memcpy(&m_extendedDesc, desc.extendedDescs[i], sizeof(m_extendedDesc));
+                break;
+            default:
+                break;
+            }
+        }
+
+        m_threadPool = new ThreadPool(Count(m_extendedDesc.workerThreadCount));
+
         // Initialize DeviceInfo
         {
             m_info.deviceType = DeviceType::CPU;
@@ -263,17 +281,51 @@ namespace cpu
 
         auto func = (slang_prelude::ComputeFunc)sharedLibrary->findSymbolAddressByName(entryPointName);
 
+        // The group range is split along its largest axis into chunks, which are run on the
+        // thread pool. Each chunk invokes the kernel on a disjoint range of groups.
+        DispatchContext context;
+        context.func = func;
+        context.entryPointParams = entryPointObject->getDataBuffer();
+        context.globalParams = m_currentRootObject->getDataBuffer();
+        context.groupCount[0] = uint32_t(x);
+        context.groupCount[1] = uint32_t(y);
+        context.groupCount[2] = uint32_t(z);
+
+        context.splitAxis = 0;
+        for (int i = 1; i < 3; ++i)
+        {
+            if (context.groupCount[i] > context.groupCount[context.splitAxis])
+            {
+                context.splitAxis = i;
+            }
+        }
+
+        const Index splitAxisCount = Index(context.groupCount[context.splitAxis]);
+        context.chunkCount = Math::Min(splitAxisCount, m_threadPool->getThreadCount() * kChunksPerThread);
+
+        m_threadPool->run(context.chunkCount, &_dispatchChunk, &context);
+    }
+
+    /* static */void DeviceImpl::_dispatchChunk(void* inContext, Index chunkIndex)
+    {
+        const DispatchContext& context = *(const DispatchContext*)inContext;
+
+        uint32_t start[3] = { 0, 0, 0 };
+        uint32_t end[3] = { context.groupCount[0], context.groupCount[1], context.groupCount[2] };
+
+        const uint64_t splitAxisCount = context.groupCount[context.splitAxis];
+        start[context.splitAxis] = uint32_t((splitAxisCount * chunkIndex) / context.chunkCount);
+        end[context.splitAxis] = uint32_t((splitAxisCount * (chunkIndex + 1)) / context.chunkCount);
+
         slang_prelude::ComputeVaryingInput varyingInput;
-        varyingInput.startGroupID.x = 0;
-        varyingInput.startGroupID.y = 0;
-        varyingInput.startGroupID.z = 0;
-        varyingInput.endGroupID.x = x;
-        varyingInput.endGroupID.y = y;
-        varyingInput.endGroupID.z = z;
-
-        auto globalParamsData = m_currentRootObject->getDataBuffer();
-        auto entryPointParamsData = entryPointObject->getDataBuffer();
-        func(&varyingInput, entryPointParamsData, globalParamsData);
+        varyingInput.startGroupID.x = start[0];
+        varyingInput.startGroupID.y = start[1];
+        varyingInput.startGroupID.z = start[2];
+        varyingInput.endGroupID.x = end[0];
+        varyingInput.endGroupID.y = end[1];
+        varyingInput.endGroupID.z = end[2];
+
+        context.func(&varyingInput, context.entryPointParams, context.globalParams);
     }
 
     void DeviceImpl::copyBuffer(
@@ -4,6 +4,7 @@
 
 #include "cpu-pipeline-state.h"
 #include "cpu-shader-object.h"
+#include "cpu-thread-pool.h"
 
 namespace gfx
 {
@@ -79,6 +80,9 @@ private:
     RefPtr<PipelineStateImpl> m_currentPipeline = nullptr;
     RefPtr<RootShaderObjectImpl> m_currentRootObject = nullptr;
     DeviceInfo m_info;
+    CPUDeviceExtendedDesc m_extendedDesc;
+        /// Runs the thread groups of a dispatch in parallel
+    RefPtr<ThreadPool> m_threadPool;
 
     virtual void setPipelineState(IPipelineState* state) override;
 
@@ -86,6 +90,23 @@ private:
 
     virtual void dispatchCompute(int x, int y, int z) override;
 
+        /// The number of chunks a dispatch is split into per thread, such that the work can be
+        /// balanced between threads if some thread groups take longer than others.
+    static const Index kChunksPerThread = 8;
+
+    struct DispatchContext
+    {
+        slang_prelude::ComputeFunc func = nullptr;
+        void* entryPointParams = nullptr;
+        void* globalParams = nullptr;
+        uint32_t groupCount[3] = { 0, 0, 0 };
+        int splitAxis = 0;                      ///< The axis the group range is split along
+        Index chunkCount = 0;
+    };
+
+        /// Run the chunk at `chunkIndex` of the dispatch described by `context` (a DispatchContext)
+    static void _dispatchChunk(void* context, Index chunkIndex);
+
     virtual void copyBuffer(
         IBufferResource* dst,
         size_t dstOffset,
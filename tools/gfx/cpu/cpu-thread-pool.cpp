@@ -0,0 +1,162 @@
+// cpu-thread-pool.cpp
+#include "cpu-thread-pool.h"
+
+namespace gfx
+{
+using namespace Slang;
+
+namespace cpu
+{
+
+ThreadPool::ThreadPool(Count threadCount)
+    : m_remainingTaskCount(0)
+{
+    if (threadCount <= 0)
+    {
+        // hardware_concurrency can return 0 if the value can't be determined
+        threadCount = Math::Max(Count(1), Count(std::thread::hardware_concurrency()));
+    }
+
+    m_taskRanges.reset(new TaskRange[threadCount]);
+
+    for (Index i = 1; i < threadCount; ++i)
+    {
+        m_workers.add(std::thread([this, i]() { _workerMain(i); }));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isDestroying = true;
+    }
+    m_jobStartCondition.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+bool ThreadPool::_takeTask(Index threadIndex, Index& outTaskIndex)
+{
+    TaskRange& ownRange = m_taskRanges[threadIndex];
+
+    // Take from the front of our own range
+    {
+        std::lock_guard<std::mutex> lock(ownRange.mutex);
+        if (ownRange.begin < ownRange.end)
+        {
+            outTaskIndex = ownRange.begin++;
+            return true;
+        }
+    }
+
+    // Steal the back half of the range of another thread
+    const Count threadCount = getThreadCount();
+    for (Index i = 1; i < threadCount; ++i)
+    {
+        TaskRange& victimRange = m_taskRanges[(threadIndex + i) % threadCount];
+
+        Index stolenBegin, stolenEnd;
+        {
+            std::lock_guard<std::mutex> lock(victimRange.mutex);
+            const Count remainingCount = victimRange.end - victimRange.begin;
+            if (remainingCount <= 0)
+            {
+                continue;
+            }
+            stolenEnd = victimRange.end;
+            stolenBegin = stolenEnd - (remainingCount + 1) / 2;
+            victimRange.end = stolenBegin;
+        }
+
+        // Run the first stolen task, and make the rest available through our own range
+        {
+            std::lock_guard<std::mutex> lock(ownRange.mutex);
+            ownRange.begin = stolenBegin + 1;
+            ownRange.end = stolenEnd;
+        }
+        outTaskIndex = stolenBegin;
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::_runTasks(Index threadIndex)
+{
+    Index taskIndex;
+    while (_takeTask(threadIndex, taskIndex))
+    {
+        m_func(m_context, taskIndex);
+
+        if (--m_remainingTaskCount == 0)
+        {
+            // Notify holding the lock, so the wake up can't be missed by `run`
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_jobDoneCondition.notify_all();
+        }
+    }
+}
+
+void ThreadPool::_workerMain(Index threadIndex)
+{
+    uint64_t jobGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobStartCondition.wait(lock, [&]() { return m_isDestroying || m_jobGeneration != jobGeneration; });
+            if (m_isDestroying)
+            {
+                return;
+            }
+            jobGeneration = m_jobGeneration;
+        }
+
+        _runTasks(threadIndex);
+    }
+}
+
+void ThreadPool::run(Index taskCount, TaskFunc func, void* context)
+{
+    const Count threadCount = getThreadCount();
+    if (threadCount <= 1 || taskCount <= 1)
+    {
+        for (Index i = 0; i < taskCount; ++i)
+        {
+            func(context, i);
+        }
+        return;
+    }
+
+    m_func = func;
+    m_context = context;
+    m_remainingTaskCount = taskCount;
+
+    // Split the tasks evenly between the threads. The ranges are only written holding their
+    // locks, so a thread that takes a task also sees the job's function and context.
+    for (Index i = 0; i < threadCount; ++i)
+    {
+        TaskRange& range = m_taskRanges[i];
+        std::lock_guard<std::mutex> lock(range.mutex);
+        range.begin = (taskCount * i) / threadCount;
+        range.end = (taskCount * (i + 1)) / threadCount;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobGeneration++;
+    }
+    m_jobStartCondition.notify_all();
+
+    _runTasks(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_jobDoneCondition.wait(lock, [this]() { return m_remainingTaskCount == 0; });
+}
+
+} // namespace cpu
+} // namespace gfx
@@ -0,0 +1,70 @@
+// cpu-thread-pool.h
+#pragma once
+#include "cpu-base.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace gfx
+{
+using namespace Slang;
+
+namespace cpu
+{
+
+/* A pool of threads that runs the tasks of a job in parallel.
+
+The tasks of a job are split evenly between the participating threads (the workers, and the thread
+that calls `run`) up front. A thread runs tasks from the front of its own range, and once that is
+empty, steals the back half of the remaining range of another thread. This balances the work when
+tasks take differing amounts of time, without all the threads contending on a single queue. */
+class ThreadPool : public RefObject
+{
+public:
+    typedef void (*TaskFunc)(void* context, Index taskIndex);
+
+        /// Run `func` for each task index in [0, taskCount), returning once all tasks have completed.
+        /// The calling thread runs tasks too. Must not be called concurrently, or from within a task.
+    void run(Index taskCount, TaskFunc func, void* context);
+
+        /// Get the total number of threads that run tasks, including the thread that calls `run`
+    Count getThreadCount() const { return m_workers.getCount() + 1; }
+
+        /// `threadCount` is the total number of threads to run tasks on, including the thread that
+        /// calls `run`. 0 uses a thread per hardware thread.
+    ThreadPool(Count threadCount);
+    ~ThreadPool();
+
+protected:
+        /// The tasks [begin, end) not yet taken by any thread
+    struct TaskRange
+    {
+        std::mutex mutex;
+        Index begin = 0;
+        Index end = 0;
+    };
+
+    bool _takeTask(Index threadIndex, Index& outTaskIndex);
+    void _runTasks(Index threadIndex);
+    void _workerMain(Index threadIndex);
+
+    List<std::thread> m_workers;
+        /// A range per thread. The calling thread uses index 0, worker i uses i + 1
+    std::unique_ptr<TaskRange[]> m_taskRanges;
+
+    TaskFunc m_func = nullptr;
+    void* m_context = nullptr;
+    std::atomic<Index> m_remainingTaskCount;
+
+    std::mutex m_mutex;
+    std::condition_variable m_jobStartCondition;        ///< Signalled when a job starts, or the pool is destroyed
+    std::condition_variable m_jobDoneCondition;         ///< Signalled when all the tasks of a job have completed
+    uint64_t m_jobGeneration = 0;
+    bool m_isDestroying = false;
+};
+
+} // namespace cpu
+} // namespace gfx
@@ -3,37 +3,1250 @@
 #include "../../source/core/slang-io.h"
 #include "../../source/core/slang-std-writers.h"
 
-#include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-process.h"
+#include "../../source/core/slang-rtti-info.h"
 
 #include "../../slang-com-helper.h"
 
 #include "../../source/core/slang-string-util.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-flat-dictionary.h"
+
+#include "../../source/compiler-core/slang-json-rpc.h"
+#include "../../source/compiler-core/slang-lexer.h"
+#include "../../source/compiler-core/slang-name.h"
+
+#include "../../source/slang/slang-workspace-version.h"
+
+#if SLANG_WINDOWS_FAMILY
+#   include <windows.h>
+#   include <psapi.h>
+#   pragma comment(lib, "psapi")
+#else
+#   include <sys/resource.h>
+#endif
 
 using namespace Slang;
 
-SlangResult innerMain(int argc, char** argv)
+// A benchmark harness for the compile throughput of Slang.
+//
+// Each scenario is run a number of times after some warm up runs, and the min/median/percentile
+// times are reported as JSON. The report can be saved and passed back in as a baseline, in which
+// case a scenario whose median time regressed by more than the threshold fails the run.
+//
+// Usage: slang-profile [options] [corpus files...]
+//
+//  -iterations <n>     Number of timed runs per scenario (default 10)
+//  -warmup <n>         Number of untimed runs per scenario (default 1)
+//  -scenario <name>    Only run the named scenario (can be repeated)
+//  -output <path>      Write the JSON report to path, instead of stdout
+//  -baseline <path>    Compare against a JSON report written previously
+//  -threshold <n>      Allowed regression of the median time in percent (default 10)
+//  -list               List the scenarios
+//
+// The corpus files are compiled by the compile scenarios, and need a `computeMain` compute entry
+// point. If none are specified a set of tests from tests/compute is used.
+//
+// The specialize scenarios compile many specializations of a generic entry point, either one at a
+// time with specialize/link/getEntryPointCode or with one call to getSpecializedEntryPointCodes.
+// The time per specialization is also output.
+//
+// The lex scenario measures the throughput of the lexer alone, on the corpus repeated to make up
+// a few MB of source. The throughput in MB/s is also output.
+//
+// The member-lookup scenario checks source that accesses members of stdlib types (swizzles of
+// vectors, methods of textures) many times. After it has run, the lookup cache counters of the
+// performance report are output.
+//
+// The overload-resolution scenario is similar, but calls stdlib intrinsics with large overload
+// groups (such as `lerp`, `dot` and `mul`) and vector initializers.
+//
+// The name-pool scenario interns the identifiers of the corpus (repeated, so most lookups find
+// an existing name) in a new name pool, as the lexer and parser do.
+//
+// The dictionary scenarios compare Dictionary with FlatDictionary, looking up identifier-like
+// strings by slice (half of which are present), and adding and removing integer keys.
+//
+// The ir-memory scenario compiles the corpus to HLSL. After it has run, the instruction count and
+// bytes per instruction of the linked IR (with the stdlib linked in) are output, along with the
+// bytes per instruction if every instruction held its operand count and structural hash.
+
+namespace { // anonymous
+
+struct ScenarioResult
 {
-    auto stdWriters = StdWriters::initDefaultSingleton();
+    String name;
+    int32_t sampleCount = 0;
+    double minMs = 0;
+    double medianMs = 0;
+    double meanMs = 0;
+    double p90Ms = 0;
+    double p99Ms = 0;
+    double maxMs = 0;
+        /// The peak memory usage of the process after the scenario was run. As the scenarios are
+        /// run in a single process, this is the high water mark of this and all earlier scenarios.
+    uint64_t peakMemoryBytes = 0;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+struct BenchmarkReport
+{
+    List<ScenarioResult> scenarios;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+static const StructRttiInfo _makeScenarioResultRtti()
+{
+    ScenarioResult obj;
+    StructRttiBuilder builder(&obj, "ScenarioResult", nullptr);
+    builder.addField("name", &obj.name);
+    builder.addField("sampleCount", &obj.sampleCount);
+    builder.addField("minMs", &obj.minMs);
+    builder.addField("medianMs", &obj.medianMs);
+    builder.addField("meanMs", &obj.meanMs);
+    builder.addField("p90Ms", &obj.p90Ms);
+    builder.addField("p99Ms", &obj.p99Ms);
+    builder.addField("maxMs", &obj.maxMs);
+    builder.addField("peakMemoryBytes", &obj.peakMemoryBytes);
+    return builder.make();
+}
+/* static */const StructRttiInfo ScenarioResult::g_rttiInfo = _makeScenarioResultRtti();
+
+static const StructRttiInfo _makeBenchmarkReportRtti()
+{
+    BenchmarkReport obj;
+    StructRttiBuilder builder(&obj, "BenchmarkReport", nullptr);
+    builder.addField("scenarios", &obj.scenarios);
+    return builder.make();
+}
+/* static */const StructRttiInfo BenchmarkReport::g_rttiInfo = _makeBenchmarkReportRtti();
+
+struct Options
+{
+    Index iterationCount = 10;
+    Index warmupCount = 1;
+    List<String> scenarioNames;
+    List<String> corpusPaths;
+    String outputPath;
+    String baselinePath;
+    double regressionThreshold = 10.0;
+    bool listScenarios = false;
+};
+
+struct CorpusFile
+{
+    String path;
+    String moduleName;
+    String contents;
+};
+
+struct BenchmarkContext
+{
+    Options options;
+    List<CorpusFile> corpus;
+
+        /// Shared by scenarios that aren't measuring global session creation
+    ComPtr<slang::IGlobalSession> globalSession;
+
+        /// The serialized stdlib used by the stdlib load scenario
+    ComPtr<ISlangBlob> stdLibBlob;
+
+        /// Compile requests kept alive for the reflection scenario
+    List<SlangCompileRequest*> reflectionRequests;
+
+        /// The workspace and documents for the language server scenario
+    RefPtr<Workspace> workspace;
+    List<DocumentVersion*> workspaceDocs;
+    Index editCount = 0;
+
+        /// The program and specialization arguments for the specialize scenarios
+    ComPtr<slang::ISession> specializeSession;
+    ComPtr<slang::IComponentType> specializeProgram;
+    List<slang::SpecializationArg> specializeArgs;
+
+        /// The source lexed by the lex scenario
+    SourceManager lexSourceManager;
+    SourceView* lexSourceView = nullptr;
+    RootNamePool lexRootNamePool;
+    NamePool lexNamePool;
+
+        /// The source checked by the member lookup scenario
+    String memberLookupSource;
+        /// The source checked by the overload resolution scenario
+    String overloadResolutionSource;
+
+        /// The identifiers interned by the name pool scenario
+    List<String> namePoolIdentifiers;
+
+        /// The keys and dictionaries for the dictionary scenarios
+    List<String> dictionaryKeys;
+    Dictionary<String, Index> stringDictionary;
+    FlatDictionary<String, Index> stringFlatDictionary;
+
+        /// Accumulates values read by scenarios, so the reads can't be optimized away
+    uint64_t checksum = 0;
+
+    ~BenchmarkContext()
+    {
+        for (auto request : reflectionRequests)
+        {
+            spDestroyCompileRequest(request);
+        }
+    }
+};
+
+typedef SlangResult (*ScenarioFunc)(BenchmarkContext* context);
+typedef Index (*ScenarioByteCountFunc)(BenchmarkContext* context);
+
+struct Scenario
+{
+    const char* name;
+        /// Run once before the scenario, isn't timed. Can be nullptr.
+    ScenarioFunc prepareFunc;
+        /// Run for each warm up and timed iteration
+    ScenarioFunc runFunc;
+        /// If set, the number of items (such as specializations) processed by each run,
+        /// which is used to output the time per item
+    Index itemCount;
+        /// If set, gets the number of bytes of input processed by each run, which is
+        /// used to output the throughput
+    ScenarioByteCountFunc byteCountFunc;
+        /// Run once after the scenario to output anything else it measures, isn't timed. Can be nullptr.
+    ScenarioFunc reportFunc;
+};
+
+} // anonymous
+
+static uint64_t _getPeakMemoryUsage()
+{
+#if SLANG_WINDOWS_FAMILY
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return uint64_t(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#   if SLANG_APPLE_FAMILY
+    // Reported in bytes
+    return uint64_t(usage.ru_maxrss);
+#   else
+    // Reported in kilobytes
+    return uint64_t(usage.ru_maxrss) * 1024;
+#   endif
+#endif
+}
+
+static void _writeDiagnostics(SlangCompileRequest* request)
+{
+    const char* diagnostics = spGetDiagnosticOutput(request);
+    if (diagnostics && diagnostics[0])
+    {
+        StdWriters::getError().print("%s", diagnostics);
+    }
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! Scenarios !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+static SlangResult _runGlobalSession(BenchmarkContext* context)
+{
+    SLANG_UNUSED(context);
+    ComPtr<slang::IGlobalSession> globalSession;
+    return slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef());
+}
+
+static SlangResult _prepareStdLibLoad(BenchmarkContext* context)
+{
+    // Use the embedded stdlib if there is one. Otherwise compile the stdlib and serialize it the
+    // same way it is when embedded.
+    if (ISlangBlob* embeddedStdLib = slang_getEmbeddedStdLib())
+    {
+        context->stdLibBlob = embeddedStdLib;
+        return SLANG_OK;
+    }
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_RETURN_ON_FAIL(slang_createGlobalSessionWithoutStdLib(SLANG_API_VERSION, globalSession.writeRef()));
+    SLANG_RETURN_ON_FAIL(globalSession->compileStdLib(0));
+    return globalSession->saveStdLib(SLANG_ARCHIVE_TYPE_RIFF_LZ4, context->stdLibBlob.writeRef());
+}
+
+static SlangResult _runStdLibLoad(BenchmarkContext* context)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_RETURN_ON_FAIL(slang_createGlobalSessionWithoutStdLib(SLANG_API_VERSION, globalSession.writeRef()));
+    return globalSession->loadStdLib(context->stdLibBlob->getBufferPointer(), context->stdLibBlob->getBufferSize());
+}
+
+static SlangResult _compileCorpusFile(
+    BenchmarkContext* context,
+    const CorpusFile& file,
+    SlangCompileTarget target,
+    const char* profileName,
+    SlangTargetFlags targetFlags,
+    SlangCompileRequest** outRequest = nullptr,
+    bool reportPerformance = false)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(context->globalSession);
+    spSetReportPerformance(request, reportPerformance);
+
+    if (target == SLANG_TARGET_NONE)
+    {
+        spSetCompileFlags(request, SLANG_COMPILE_FLAG_NO_CODEGEN);
+    }
+    else
+    {
+        const int targetIndex = spAddCodeGenTarget(request, target);
+        if (profileName)
+        {
+            spSetTargetProfile(request, targetIndex, spFindProfile(context->globalSession, profileName));
+        }
+        if (targetFlags)
+        {
+            spSetTargetFlags(request, targetIndex, targetFlags);
+        }
+    }
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, file.path.getBuffer(), file.contents.getBuffer());
+
+    if (target != SLANG_TARGET_NONE)
+    {
+        spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    }
+
+    const SlangResult res = spCompile(request);
+    if (SLANG_FAILED(res))
+    {
+        _writeDiagnostics(request);
+    }
+
+    if (outRequest && SLANG_SUCCEEDED(res))
+    {
+        *outRequest = request;
+    }
+    else
+    {
+        spDestroyCompileRequest(request);
+    }
+    return res;
+}
+
+static SlangResult _compileCorpus(BenchmarkContext* context, SlangCompileTarget target, const char* profileName, SlangTargetFlags targetFlags = 0)
+{
+    for (const auto& file : context->corpus)
+    {
+        SLANG_RETURN_ON_FAIL(_compileCorpusFile(context, file, target, profileName, targetFlags));
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _runFrontEnd(BenchmarkContext* context) { return _compileCorpus(context, SLANG_TARGET_NONE, nullptr); }
+static SlangResult _runCompileHLSL(BenchmarkContext* context) { return _compileCorpus(context, SLANG_HLSL, "sm_5_0"); }
+static SlangResult _runCompileGLSL(BenchmarkContext* context) { return _compileCorpus(context, SLANG_GLSL, "glsl_450"); }
+static SlangResult _runCompileSPIRV(BenchmarkContext* context) { return _compileCorpus(context, SLANG_SPIRV, "glsl_450", SLANG_TARGET_FLAG_GENERATE_SPIRV_DIRECTLY); }
+static SlangResult _runCompileCPP(BenchmarkContext* context) { return _compileCorpus(context, SLANG_CPP_SOURCE, nullptr); }
+static SlangResult _runCompileCUDA(BenchmarkContext* context) { return _compileCorpus(context, SLANG_CUDA_SOURCE, nullptr); }
+
+static SlangResult _runModuleImport(BenchmarkContext* context)
+{
+    // A new session each time, so the modules are loaded again
+    List<String> searchPaths;
+    List<const char*> searchPathPtrs;
+    for (const auto& file : context->corpus)
+    {
+        String directory = Path::getParentDirectory(file.path);
+        if (directory.getLength() == 0)
+        {
+            directory = ".";
+        }
+        if (searchPaths.indexOf(directory) < 0)
+        {
+            searchPaths.add(directory);
+        }
+    }
+    for (const auto& searchPath : searchPaths)
+    {
+        searchPathPtrs.add(searchPath.getBuffer());
+    }
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.searchPaths = searchPathPtrs.getBuffer();
+    sessionDesc.searchPathCount = searchPathPtrs.getCount();
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(context->globalSession->createSession(sessionDesc, session.writeRef()));
+
+    for (const auto& file : context->corpus)
+    {
+        ComPtr<slang::IBlob> diagnostics;
+        if (!session->loadModule(file.moduleName.getBuffer(), diagnostics.writeRef()))
+        {
+            if (diagnostics)
+            {
+                StdWriters::getError().print("%s", (const char*)diagnostics->getBufferPointer());
+            }
+            return SLANG_FAIL;
+        }
+    }
+    return SLANG_OK;
+}
 
-    // Time the creation of the session
+static void _visitTypeLayout(BenchmarkContext* context, slang::TypeLayoutReflection* typeLayout, Index depth)
+{
+    // Limit the depth, in case of recursive types
+    if (!typeLayout || depth > 16)
     {
-        const auto startTick = ProcessUtil::getClockTick();
+        return;
+    }
+
+    context->checksum += uint64_t(typeLayout->getKind());
+    context->checksum += typeLayout->getSize();
+    context->checksum += typeLayout->getCategoryCount();
+
+    const unsigned fieldCount = typeLayout->getFieldCount();
+    for (unsigned i = 0; i < fieldCount; ++i)
+    {
+        slang::VariableLayoutReflection* field = typeLayout->getFieldByIndex(i);
+        const char* name = field->getName();
+        context->checksum += name ? ::strlen(name) : 0;
+        context->checksum += field->getOffset();
+        _visitTypeLayout(context, field->getTypeLayout(), depth + 1);
+    }
+
+    switch (typeLayout->getKind())
+    {
+        case slang::TypeReflection::Kind::Array:
+        case slang::TypeReflection::Kind::ConstantBuffer:
+        case slang::TypeReflection::Kind::ParameterBlock:
+        case slang::TypeReflection::Kind::ShaderStorageBuffer:
+        case slang::TypeReflection::Kind::TextureBuffer:
+        {
+            _visitTypeLayout(context, typeLayout->getElementTypeLayout(), depth + 1);
+            break;
+        }
+        default: break;
+    }
+}
+
+static SlangResult _prepareReflection(BenchmarkContext* context)
+{
+    for (const auto& file : context->corpus)
+    {
+        SlangCompileRequest* request = nullptr;
+        SLANG_RETURN_ON_FAIL(_compileCorpusFile(context, file, SLANG_HLSL, "sm_5_0", 0, &request));
+        context->reflectionRequests.add(request);
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _runReflection(BenchmarkContext* context)
+{
+    for (auto request : context->reflectionRequests)
+    {
+        slang::ShaderReflection* reflection = slang::ShaderReflection::get(request);
+        if (!reflection)
+        {
+            return SLANG_FAIL;
+        }
+
+        const unsigned parameterCount = reflection->getParameterCount();
+        for (unsigned i = 0; i < parameterCount; ++i)
+        {
+            slang::VariableLayoutReflection* parameter = reflection->getParameterByIndex(i);
+            context->checksum += parameter->getBindingIndex();
+            _visitTypeLayout(context, parameter->getTypeLayout(), 0);
+        }
+
+        const SlangUInt entryPointCount = reflection->getEntryPointCount();
+        for (SlangUInt i = 0; i < entryPointCount; ++i)
+        {
+            slang::EntryPointReflection* entryPoint = reflection->getEntryPointByIndex(i);
+            context->checksum += uint64_t(entryPoint->getStage());
+
+            SlangUInt threadGroupSize[3];
+            entryPoint->getComputeThreadGroupSize(3, threadGroupSize);
+            context->checksum += threadGroupSize[0] + threadGroupSize[1] + threadGroupSize[2];
+
+            const unsigned entryPointParameterCount = entryPoint->getParameterCount();
+            for (unsigned j = 0; j < entryPointParameterCount; ++j)
+            {
+                _visitTypeLayout(context, entryPoint->getParameterByIndex(j)->getTypeLayout(), 0);
+            }
+        }
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _prepareLanguageServer(BenchmarkContext* context)
+{
+    context->workspace = new Workspace();
+
+    List<URI> rootUris;
+    List<String> canonicalPaths;
+    for (const auto& file : context->corpus)
+    {
+        String canonicalPath;
+        SLANG_RETURN_ON_FAIL(Path::getCanonical(file.path, canonicalPath));
+        canonicalPaths.add(canonicalPath);
+
+        URI rootUri = URI::fromLocalFilePath(Path::getParentDirectory(canonicalPath).getUnownedSlice());
+        if (rootUris.findFirstIndex([&](const URI& uri) { return uri.uri == rootUri.uri; }) < 0)
+        {
+            rootUris.add(rootUri);
+        }
+    }
+    context->workspace->init(rootUris, context->globalSession);
+
+    for (Index i = 0; i < context->corpus.getCount(); ++i)
+    {
+        context->workspaceDocs.add(context->workspace->openDoc(canonicalPaths[i], context->corpus[i].contents));
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _runLanguageServer(BenchmarkContext* context)
+{
+    // Simulates what the language server does for each edit of a document: the workspace is
+    // updated with the new text, and the module of the document is checked again (which reuses
+    // the unchanged modules of the previous version).
+    for (Index i = 0; i < context->workspaceDocs.getCount(); ++i)
+    {
+        DocumentVersion* doc = context->workspaceDocs[i];
+
+        StringBuilder newText;
+        newText << context->corpus[i].contents;
+        newText << "\n// edit " << context->editCount++ << "\n";
+        context->workspace->changeDoc(doc, newText);
 
-        for (Int i = 0; i < 32; ++i)
+        WorkspaceVersion* version = context->workspace->getCurrentVersion();
+        if (!version->getOrLoadModule(doc->getPath()))
         {
-            ComPtr<slang::IGlobalSession> slangSession;
-            slangSession.attach(spCreateSession(nullptr));
+            return SLANG_FAIL;
         }
+    }
+    return SLANG_OK;
+}
 
-        const auto endTick = ProcessUtil::getClockTick();
+// The number of specializations compiled by each run of the specialize scenarios
+static const Index kSpecializationCount = 32;
 
-        printf("Ticks %f\n", double(endTick - startTick) / ProcessUtil::getClockFrequency());
+static SlangResult _prepareSpecialize(BenchmarkContext* context)
+{
+    // Shared by the specialize scenarios
+    if (context->specializeProgram)
+    {
         return SLANG_OK;
     }
 
+    StringBuilder source;
+    source << "interface IMaterial { float4 shade(float2 uv); }\n";
+    for (Index i = 0; i < kSpecializationCount; ++i)
+    {
+        source << "struct Material" << i << " : IMaterial { float4 shade(float2 uv) { return float4(uv * " << i << ".0, sin(uv.x), cos(uv.y)); } }\n";
+    }
+    source << R"(
+        [shader("compute")]
+        [numthreads(8,1,1)]
+        void computeMain<M : IMaterial>(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float4> buffer)
+        {
+            M material;
+            buffer[tid.x] = material.shade(float2(tid.xy));
+        })";
+
+    slang::TargetDesc targetDesc;
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = context->globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+    SLANG_RETURN_ON_FAIL(context->globalSession->createSession(sessionDesc, context->specializeSession.writeRef()));
+
+    ComPtr<slang::IBlob> diagnostics;
+    ComPtr<ISlangBlob> sourceBlob = StringBlob::create(source.ProduceString());
+    slang::IModule* module = context->specializeSession->loadModuleFromSource("materials", "materials.slang", sourceBlob, diagnostics.writeRef());
+    if (!module)
+    {
+        return SLANG_FAIL;
+    }
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+    slang::IComponentType* components[] = { module, entryPoint };
+    SLANG_RETURN_ON_FAIL(context->specializeSession->createCompositeComponentType(components, 2, context->specializeProgram.writeRef()));
+
+    for (Index i = 0; i < kSpecializationCount; ++i)
+    {
+        StringBuilder typeName;
+        typeName << "Material" << i;
+        slang::TypeReflection* type = module->getLayout()->findTypeByName(typeName.getBuffer());
+        if (!type)
+        {
+            return SLANG_FAIL;
+        }
+        context->specializeArgs.add(slang::SpecializationArg::fromType(type));
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _runSpecializeLoop(BenchmarkContext* context)
+{
+    for (const auto& arg : context->specializeArgs)
+    {
+        ComPtr<slang::IComponentType> specialized;
+        SLANG_RETURN_ON_FAIL(context->specializeProgram->specialize(&arg, 1, specialized.writeRef()));
+        ComPtr<slang::IComponentType> linked;
+        SLANG_RETURN_ON_FAIL(specialized->link(linked.writeRef()));
+        ComPtr<slang::IBlob> code;
+        SLANG_RETURN_ON_FAIL(linked->getEntryPointCode(0, 0, code.writeRef()));
+        context->checksum += code->getBufferSize();
+    }
     return SLANG_OK;
 }
 
+static SlangResult _runSpecializeBatch(BenchmarkContext* context)
+{
+    List<slang::IBlob*> codes;
+    codes.setCount(context->specializeArgs.getCount());
+    const SlangResult res = context->specializeProgram->getSpecializedEntryPointCodes(
+        context->specializeArgs.getBuffer(), 1, context->specializeArgs.getCount(), 0, 0, codes.getBuffer());
+    for (auto code : codes)
+    {
+        if (code)
+        {
+            context->checksum += code->getBufferSize();
+            code->release();
+        }
+    }
+    return res;
+}
+
+static SlangResult _prepareLex(BenchmarkContext* context)
+{
+    // Repeat the corpus so there is enough source for a stable measurement
+    const Index minSize = 4 * 1024 * 1024;
+
+    StringBuilder source;
+    while (source.getLength() < minSize)
+    {
+        for (const auto& file : context->corpus)
+        {
+            source << file.contents << "\n";
+        }
+    }
+
+    SourceManager* sourceManager = &context->lexSourceManager;
+    sourceManager->initialize(nullptr, nullptr);
+    context->lexNamePool.setRootNamePool(&context->lexRootNamePool);
+
+    SourceFile* sourceFile = sourceManager->createSourceFileWithString(PathInfo::makeUnknown(), source.ProduceString());
+    context->lexSourceView = sourceManager->createSourceView(sourceFile, nullptr, SourceLoc());
+    return SLANG_OK;
+}
+
+static SlangResult _runLex(BenchmarkContext* context)
+{
+    Lexer lexer;
+    lexer.initialize(context->lexSourceView, nullptr, &context->lexNamePool, context->lexSourceManager.getMemoryArena());
+    lexer.m_lexerFlags |= kLexerFlag_SuppressDiagnostics;
+
+    for (;;)
+    {
+        const Token token = lexer.lexToken();
+        context->checksum += uint64_t(token.type) + token.charsCount;
+        if (token.type == TokenType::EndOfFile)
+        {
+            break;
+        }
+    }
+    return SLANG_OK;
+}
+
+static Index _getLexByteCount(BenchmarkContext* context)
+{
+    return Index(context->lexSourceView->getContentSize());
+}
+
+static SlangResult _checkSource(BenchmarkContext* context, const String& source, bool reportCounters)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(context->globalSession);
+    spSetCompileFlags(request, SLANG_COMPILE_FLAG_NO_CODEGEN);
+    spSetReportPerformance(request, reportCounters);
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "generated.slang", source.getBuffer());
+
+    SlangResult res = spCompile(request);
+    if (SLANG_FAILED(res))
+    {
+        _writeDiagnostics(request);
+    }
+    else if (reportCounters)
+    {
+        // Output just the counters, which follow the per-phase timings
+        ComPtr<ISlangBlob> report;
+        res = spGetPerformanceReport(request, SLANG_PERFORMANCE_REPORT_FORMAT_TEXT, report.writeRef());
+        if (SLANG_SUCCEEDED(res))
+        {
+            const UnownedStringSlice text = StringUtil::getSlice(report);
+            const Index countersIndex = text.indexOf(toSlice("\nCounter"));
+            if (countersIndex >= 0)
+            {
+                const UnownedStringSlice counters = text.tail(countersIndex + 1);
+                StdWriters::getError().write(counters.begin(), counters.getLength());
+            }
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+    /// Add the value of the counter `name` in the text performance `report` to `ioValue`
+static void _addCounter(const UnownedStringSlice& report, const UnownedStringSlice& name, Count& ioValue)
+{
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(report, lines);
+    for (const auto& line : lines)
+    {
+        // The name is followed by the value, right aligned
+        const UnownedStringSlice trimmed = line.trim();
+        const Index valueIndex = trimmed.lastIndexOf(' ');
+        Int value;
+        if (valueIndex > 0 &&
+            trimmed.head(valueIndex).trim() == name &&
+            SLANG_SUCCEEDED(StringUtil::parseInt(trimmed.tail(valueIndex + 1), value)))
+        {
+            ioValue += Count(value);
+            return;
+        }
+    }
+}
+
+static SlangResult _reportIRMemory(BenchmarkContext* context)
+{
+    Count instCount = 0;
+    Count instBytes = 0;
+    Count inlineCountAndHashBytes = 0;
+    for (const auto& file : context->corpus)
+    {
+        SlangCompileRequest* request = nullptr;
+        SLANG_RETURN_ON_FAIL(_compileCorpusFile(context, file, SLANG_HLSL, "sm_5_0", 0, &request, true));
+
+        ComPtr<ISlangBlob> report;
+        const SlangResult res = spGetPerformanceReport(request, SLANG_PERFORMANCE_REPORT_FORMAT_TEXT, report.writeRef());
+        spDestroyCompileRequest(request);
+        SLANG_RETURN_ON_FAIL(res);
+
+        const UnownedStringSlice text = StringUtil::getSlice(report);
+        _addCounter(text, toSlice("IR insts"), instCount);
+        _addCounter(text, toSlice("IR inst bytes"), instBytes);
+        _addCounter(text, toSlice("IR inst bytes (count and hash inline)"), inlineCountAndHashBytes);
+    }
+
+    if (instCount == 0)
+    {
+        return SLANG_FAIL;
+    }
+
+    auto writer = StdWriters::getError();
+    writer.print("  linked IR insts: %lld\n", (long long)instCount);
+    writer.print("  bytes per inst: %.1f\n", double(instBytes) / double(instCount));
+    writer.print("  bytes per inst (count and hash inline): %.1f\n", double(inlineCountAndHashBytes) / double(instCount));
+    return SLANG_OK;
+}
+
+// The number of functions in the source checked by the member lookup scenario
+static const Index kMemberLookupFunctionCount = 200;
+
+static SlangResult _prepareMemberLookup(BenchmarkContext* context)
+{
+    StringBuilder source;
+    for (Index i = 0; i < kMemberLookupFunctionCount; ++i)
+    {
+        source << "float4 shade" << i << "(float4 v, Texture2D<float4> t, SamplerState s, float2 uv)\n";
+        source << "{\n";
+        source << "    float4 c = t.Sample(s, uv) + t.SampleLevel(s, uv.yx, 0.0);\n";
+        source << "    uint w, h;\n";
+        source << "    t.GetDimensions(w, h);\n";
+        source << "    return float4(v.xyz * c.w, v.x + c.y + float(w)) + c.zyxw * v.wwww;\n";
+        source << "}\n";
+    }
+    context->memberLookupSource = source.ProduceString();
+    return SLANG_OK;
+}
+
+static SlangResult _runMemberLookup(BenchmarkContext* context) { return _checkSource(context, context->memberLookupSource, false); }
+static SlangResult _reportMemberLookup(BenchmarkContext* context) { return _checkSource(context, context->memberLookupSource, true); }
+
+// The number of functions in the source checked by the overload resolution scenario
+static const Index kOverloadResolutionFunctionCount = 200;
+
+static SlangResult _prepareOverloadResolution(BenchmarkContext* context)
+{
+    StringBuilder source;
+    for (Index i = 0; i < kOverloadResolutionFunctionCount; ++i)
+    {
+        source << "float3 blend" << i << "(float3 a, float3 b, float t, float3x3 m)\n";
+        source << "{\n";
+        source << "    float3 c = lerp(a, b, saturate(t)) + float3(t, t, 1.0);\n";
+        source << "    float d = dot(a, c) + dot(b, c);\n";
+        source << "    return mul(m, c) * d + max(a, b) + abs(c - a);\n";
+        source << "}\n";
+    }
+    context->overloadResolutionSource = source.ProduceString();
+    return SLANG_OK;
+}
+
+static SlangResult _runOverloadResolution(BenchmarkContext* context) { return _checkSource(context, context->overloadResolutionSource, false); }
+static SlangResult _reportOverloadResolution(BenchmarkContext* context) { return _checkSource(context, context->overloadResolutionSource, true); }
+
+// The number of times the name pool scenario interns the identifiers of the corpus
+static const Index kNamePoolRoundCount = 20;
+
+static SlangResult _prepareNamePool(BenchmarkContext* context)
+{
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    RootNamePool rootNamePool;
+    NamePool namePool;
+    namePool.setRootNamePool(&rootNamePool);
+
+    for (const auto& file : context->corpus)
+    {
+        SourceFile* sourceFile = sourceManager.createSourceFileWithString(PathInfo::makeUnknown(), file.contents);
+        SourceView* sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+
+        Lexer lexer;
+        lexer.initialize(sourceView, nullptr, &namePool, sourceManager.getMemoryArena());
+        lexer.m_lexerFlags |= kLexerFlag_SuppressDiagnostics;
+
+        for (;;)
+        {
+            const Token token = lexer.lexToken();
+            if (token.type == TokenType::EndOfFile)
+            {
+                break;
+            }
+            if (token.type == TokenType::Identifier)
+            {
+                context->namePoolIdentifiers.add(token.getContent());
+            }
+        }
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _runNamePool(BenchmarkContext* context)
+{
+    RootNamePool rootNamePool;
+    NamePool namePool;
+    namePool.setRootNamePool(&rootNamePool);
+
+    for (Index round = 0; round < kNamePoolRoundCount; ++round)
+    {
+        for (const auto& identifier : context->namePoolIdentifiers)
+        {
+            Name* name = namePool.getName(identifier.getUnownedSlice());
+            context->checksum += uint64_t(name->text.getLength());
+        }
+    }
+    return SLANG_OK;
+}
+
+// The number of keys used by the dictionary scenarios, and the number of times each run goes
+// through all of them
+static const Index kDictionaryKeyCount = 10000;
+static const Index kDictionaryRoundCount = 20;
+
+static SlangResult _prepareDictionary(BenchmarkContext* context)
+{
+    // Shared by the dictionary scenarios
+    if (context->dictionaryKeys.getCount())
+    {
+        return SLANG_OK;
+    }
+
+    for (Index i = 0; i < kDictionaryKeyCount; ++i)
+    {
+        StringBuilder buf;
+        buf << "identifier_" << i;
+        context->dictionaryKeys.add(buf.ProduceString());
+    }
+    for (Index i = 0; i < kDictionaryKeyCount; i += 2)
+    {
+        context->stringDictionary.Add(context->dictionaryKeys[i], i);
+        context->stringFlatDictionary.Add(context->dictionaryKeys[i], i);
+    }
+    return SLANG_OK;
+}
+
+template<typename TDictionary>
+static SlangResult _lookupDictionary(BenchmarkContext* context, TDictionary& dict)
+{
+    for (Index round = 0; round < kDictionaryRoundCount; ++round)
+    {
+        for (const auto& key : context->dictionaryKeys)
+        {
+            // Lookup with a slice, as is common when looking up names
+            context->checksum += dict.ContainsKey(key.getUnownedSlice()) ? 1 : 0;
+        }
+    }
+    return SLANG_OK;
+}
+
+template<typename TDictionary>
+static SlangResult _insertRemoveDictionary(BenchmarkContext* context)
+{
+    for (Index round = 0; round < kDictionaryRoundCount; ++round)
+    {
+        TDictionary dict;
+        for (Index i = 0; i < kDictionaryKeyCount; ++i)
+        {
+            dict.Add(i * 7919, i);
+        }
+        for (Index i = 0; i < kDictionaryKeyCount; i += 2)
+        {
+            dict.Remove(i * 7919);
+        }
+        context->checksum += dict.Count();
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _runDictionaryLookup(BenchmarkContext* context) { return _lookupDictionary(context, context->stringDictionary); }
+static SlangResult _runFlatDictionaryLookup(BenchmarkContext* context) { return _lookupDictionary(context, context->stringFlatDictionary); }
+static SlangResult _runDictionaryInsertRemove(BenchmarkContext* context) { return _insertRemoveDictionary<Dictionary<Index, Index>>(context); }
+static SlangResult _runFlatDictionaryInsertRemove(BenchmarkContext* context) { return _insertRemoveDictionary<FlatDictionary<Index, Index>>(context); }
+
+static const Scenario kScenarios[] =
+{
+    { "global-session",     nullptr,                    _runGlobalSession },
+    { "stdlib-load",        _prepareStdLibLoad,         _runStdLibLoad },
+    { "front-end",          nullptr,                    _runFrontEnd },
+    { "compile-hlsl",       nullptr,                    _runCompileHLSL },
+    { "compile-glsl",       nullptr,                    _runCompileGLSL },
+    { "compile-spirv",      nullptr,                    _runCompileSPIRV },
+    { "compile-cpp",        nullptr,                    _runCompileCPP },
+    { "compile-cuda",       nullptr,                    _runCompileCUDA },
+    { "module-import",      nullptr,                    _runModuleImport },
+    { "reflection",         _prepareReflection,         _runReflection },
+    { "language-server",    _prepareLanguageServer,     _runLanguageServer },
+    { "specialize-loop",    _prepareSpecialize,         _runSpecializeLoop,     kSpecializationCount },
+    { "specialize-batch",   _prepareSpecialize,         _runSpecializeBatch,    kSpecializationCount },
+    { "lex",                _prepareLex,                _runLex,                0,  _getLexByteCount },
+    { "member-lookup",      _prepareMemberLookup,       _runMemberLookup,       0,  nullptr,    _reportMemberLookup },
+    { "overload-resolution", _prepareOverloadResolution, _runOverloadResolution, 0, nullptr,   _reportOverloadResolution },
+    { "name-pool",          _prepareNamePool,           _runNamePool },
+    { "dict-lookup",        _prepareDictionary,         _runDictionaryLookup },
+    { "flat-dict-lookup",   _prepareDictionary,         _runFlatDictionaryLookup },
+    { "dict-add-remove",    nullptr,                    _runDictionaryInsertRemove },
+    { "flat-dict-add-remove", nullptr,                  _runFlatDictionaryInsertRemove },
+    { "ir-memory",          nullptr,                    _runCompileHLSL,        0,  nullptr,    _reportIRMemory },
+};
+
+// Used if no corpus is specified on the command line
+static const char* const kDefaultCorpus[] =
+{
+    "tests/compute/simple.slang",
+    "tests/compute/assoctype-simple.slang",
+    "tests/compute/generics-simple.slang",
+    "tests/compute/interface-static-method.slang",
+    "tests/compute/struct-default-init.slang",
+    "tests/compute/func-param-legalize.slang",
+};
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! Harness !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+static double _getPercentile(const List<double>& sortedSamples, double percentile)
+{
+    // Nearest rank
+    const Index count = sortedSamples.getCount();
+    Index index = Index(percentile / 100.0 * count + 0.5) - 1;
+    index = Math::Clamp(index, Index(0), count - 1);
+    return sortedSamples[index];
+}
+
+static SlangResult _runScenario(BenchmarkContext* context, const Scenario& scenario, ScenarioResult& outResult)
+{
+    if (scenario.prepareFunc)
+    {
+        SLANG_RETURN_ON_FAIL(scenario.prepareFunc(context));
+    }
+
+    for (Index i = 0; i < context->options.warmupCount; ++i)
+    {
+        SLANG_RETURN_ON_FAIL(scenario.runFunc(context));
+    }
+
+    const double tickToMs = 1000.0 / double(Process::getClockFrequency());
+
+    List<double> samples;
+    for (Index i = 0; i < context->options.iterationCount; ++i)
+    {
+        const auto startTick = Process::getClockTick();
+        SLANG_RETURN_ON_FAIL(scenario.runFunc(context));
+        const auto endTick = Process::getClockTick();
+
+        samples.add(double(endTick - startTick) * tickToMs);
+    }
+    samples.sort();
+
+    double total = 0;
+    for (auto sample : samples)
+    {
+        total += sample;
+    }
+
+    outResult.name = scenario.name;
+    outResult.sampleCount = int32_t(samples.getCount());
+    outResult.minMs = samples[0];
+    outResult.medianMs = _getPercentile(samples, 50);
+    outResult.meanMs = total / samples.getCount();
+    outResult.p90Ms = _getPercentile(samples, 90);
+    outResult.p99Ms = _getPercentile(samples, 99);
+    outResult.maxMs = samples.getLast();
+    outResult.peakMemoryBytes = _getPeakMemoryUsage();
+    return SLANG_OK;
+}
+
+static SlangResult _parseOptions(int argc, char** argv, Options& outOptions)
+{
+    auto errorWriter = StdWriters::getError();
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const UnownedStringSlice arg(argv[i]);
+
+        if (arg == "-list")
+        {
+            outOptions.listScenarios = true;
+            continue;
+        }
+        if (!arg.startsWith("-"))
+        {
+            outOptions.corpusPaths.add(arg);
+            continue;
+        }
+
+        if (i + 1 >= argc)
+        {
+            errorWriter.print("error: expected a value after '%s'\n", argv[i]);
+            return SLANG_FAIL;
+        }
+        const UnownedStringSlice value(argv[++i]);
+
+        if (arg == "-iterations" || arg == "-warmup")
+        {
+            Int count;
+            if (SLANG_FAILED(StringUtil::parseInt(value, count)) || count < 0 || (count == 0 && arg == "-iterations"))
+            {
+                errorWriter.print("error: invalid count '%s' for '%s'\n", argv[i], argv[i - 1]);
+                return SLANG_FAIL;
+            }
+            (arg == "-iterations" ? outOptions.iterationCount : outOptions.warmupCount) = Index(count);
+        }
+        else if (arg == "-threshold")
+        {
+            if (SLANG_FAILED(StringUtil::parseDouble(value, outOptions.regressionThreshold)))
+            {
+                errorWriter.print("error: invalid threshold '%s'\n", argv[i]);
+                return SLANG_FAIL;
+            }
+        }
+        else if (arg == "-scenario")
+        {
+            outOptions.scenarioNames.add(value);
+        }
+        else if (arg == "-output")
+        {
+            outOptions.outputPath = value;
+        }
+        else if (arg == "-baseline")
+        {
+            outOptions.baselinePath = value;
+        }
+        else
+        {
+            errorWriter.print("error: unknown option '%s'\n", argv[i - 1]);
+            return SLANG_FAIL;
+        }
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _readBaseline(const String& path, BenchmarkReport& outReport)
+{
+    String contents;
+    SLANG_RETURN_ON_FAIL(File::readAllText(path, contents));
+
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink(&sourceManager, nullptr);
+
+    JSONContainer container(&sourceManager);
+    JSONValue root;
+    SLANG_RETURN_ON_FAIL(JSONRPCUtil::parseJSON(contents.getUnownedSlice(), &container, &sink, root));
+    return JSONRPCUtil::convertToNative(&container, root, &sink, GetRttiInfo<BenchmarkReport>::get(), &outReport);
+}
+
+static SlangResult _compareWithBaseline(const BenchmarkReport& report, const BenchmarkReport& baseline, double threshold)
+{
+    auto outWriter = StdWriters::getOut();
+
+    SlangResult res = SLANG_OK;
+    for (const auto& result : report.scenarios)
+    {
+        const Index baselineIndex = baseline.scenarios.findFirstIndex(
+            [&](const ScenarioResult& baselineResult) { return baselineResult.name == result.name; });
+        if (baselineIndex < 0)
+        {
+            outWriter.print("%-18s no baseline\n", result.name.getBuffer());
+            continue;
+        }
+
+        const auto& baselineResult = baseline.scenarios[baselineIndex];
+        const double change = baselineResult.medianMs > 0 ? (result.medianMs / baselineResult.medianMs - 1.0) * 100.0 : 0.0;
+        const bool isRegression = change > threshold;
+
+        outWriter.print("%-18s median %10.3fms baseline %10.3fms (%+.1f%%)%s\n",
+            result.name.getBuffer(), result.medianMs, baselineResult.medianMs, change, isRegression ? " REGRESSION" : "");
+
+        if (isRegression)
+        {
+            res = SLANG_FAIL;
+        }
+    }
+    return res;
+}
+
+SlangResult innerMain(int argc, char** argv)
+{
+    auto stdWriters = StdWriters::initDefaultSingleton();
+    auto outWriter = StdWriters::getOut();
+    auto errorWriter = StdWriters::getError();
+
+    BenchmarkContext context;
+    SLANG_RETURN_ON_FAIL(_parseOptions(argc, argv, context.options));
+    const Options& options = context.options;
+
+    if (options.listScenarios)
+    {
+        for (const auto& scenario : kScenarios)
+        {
+            outWriter.print("%s\n", scenario.name);
+        }
+        return SLANG_OK;
+    }
+
+    // Load the corpus
+    if (options.corpusPaths.getCount() == 0)
+    {
+        for (auto path : kDefaultCorpus)
+        {
+            context.options.corpusPaths.add(path);
+        }
+    }
+    for (const auto& path : options.corpusPaths)
+    {
+        CorpusFile file;
+        file.path = path;
+        file.moduleName = Path::getFileNameWithoutExt(path);
+        if (SLANG_FAILED(File::readAllText(path, file.contents)))
+        {
+            errorWriter.print("error: unable to read corpus file '%s'\n", path.getBuffer());
+            return SLANG_FAIL;
+        }
+        context.corpus.add(file);
+    }
+
+    SLANG_RETURN_ON_FAIL(slang_createGlobalSession(SLANG_API_VERSION, context.globalSession.writeRef()));
+
+    BenchmarkReport report;
+    SlangResult res = SLANG_OK;
+
+    for (const auto& scenario : kScenarios)
+    {
+        if (options.scenarioNames.getCount() && options.scenarioNames.indexOf(String(scenario.name)) < 0)
+        {
+            continue;
+        }
+
+        ScenarioResult result;
+        if (SLANG_FAILED(_runScenario(&context, scenario, result)))
+        {
+            errorWriter.print("error: scenario '%s' failed\n", scenario.name);
+            res = SLANG_FAIL;
+            continue;
+        }
+
+        errorWriter.print("%-18s min %10.3fms median %10.3fms p90 %10.3fms peak memory %6.1fMB",
+            result.name.getBuffer(), result.minMs, result.medianMs, result.p90Ms, result.peakMemoryBytes / (1024.0 * 1024.0));
+        if (scenario.itemCount > 1)
+        {
+            errorWriter.print(" median per item %8.3fms", result.medianMs / scenario.itemCount);
+        }
+        if (scenario.byteCountFunc && result.medianMs > 0)
+        {
+            const double megaBytes = scenario.byteCountFunc(&context) / (1024.0 * 1024.0);
+            errorWriter.print(" median throughput %8.1fMB/s", megaBytes / (result.medianMs / 1000.0));
+        }
+        errorWriter.print("\n");
+        report.scenarios.add(result);
+
+        if (scenario.reportFunc && SLANG_FAILED(scenario.reportFunc(&context)))
+        {
+            errorWriter.print("error: report of scenario '%s' failed\n", scenario.name);
+            res = SLANG_FAIL;
+        }
+    }
+
+    // Write the report as JSON
+    {
+        SourceManager sourceManager;
+        sourceManager.initialize(nullptr, nullptr);
+        DiagnosticSink sink(&sourceManager, nullptr);
+
+        StringBuilder json;
+        SLANG_RETURN_ON_FAIL(JSONRPCUtil::convertToJSON(GetRttiInfo<BenchmarkReport>::get(), &report, &sink, json));
+        json << "\n";
+
+        if (options.outputPath.getLength())
+        {
+            SLANG_RETURN_ON_FAIL(File::writeAllText(options.outputPath, json));
+        }
+        else
+        {
+            outWriter.write(json.getBuffer(), json.getLength());
+        }
+    }
+
+    if (options.baselinePath.getLength())
+    {
+        BenchmarkReport baseline;
+        if (SLANG_FAILED(_readBaseline(options.baselinePath, baseline)))
+        {
+            errorWriter.print("error: unable to read baseline '%s'\n", options.baselinePath.getBuffer());
+            return SLANG_FAIL;
+        }
+        if (SLANG_FAILED(_compareWithBaseline(report, baseline, options.regressionThreshold)))
+        {
+            res = SLANG_FAIL;
+        }
+    }
+
+    return res;
+}
+
 int main(int argc, char** argv)
 {
     const SlangResult res = innerMain(argc, argv);
@@ -1533,6 +1533,7 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
     Path::getCanonical(input.filePath, fullPath);
     wsFolder.uri = URI::fromLocalFilePath(Path::getParentDirectory(fullPath).getUnownedSlice()).uri;
     initParams.workspaceFolders.add(wsFolder);
+    initParams.trace = "verbose";
     if (SLANG_FAILED(connection->sendCall(
             LanguageServerProtocol::InitializeParams::methodName, &initParams, JSONValue::makeInt(0))))
     {
@@ -1567,6 +1568,7 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
         JSONValue::makeInt(1));
     List<LanguageServerProtocol::PublishDiagnosticsParams> diagnostics;
     bool diagnosticsReceived = false;
+    List<String> logMessages;
     auto waitForNonDiagnosticResponse = [&]() -> SlangResult
     {
         repeat:
@@ -1585,6 +1587,14 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
                 diagnostics.add(arg);
                 goto repeat;
             }
+            else if (call.method == LanguageServerProtocol::LogMessageParams::methodName)
+            {
+                LanguageServerProtocol::LogMessageParams arg;
+                if (SLANG_FAILED(connection->getMessage(&arg)))
+                    return SLANG_FAIL;
+                logMessages.add(arg.message);
+                goto repeat;
+            }
         }
         return SLANG_OK;
     };
@@ -1601,9 +1611,38 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
         return startPos;
     };
     int callId = 2;
+    int docVersion = 0;
     for (auto line : lines)
     {
-        if (line.startsWith("//COMPLETE:"))
+        if (line.startsWith("//CHANGE:"))
+        {
+            // Insert the text after the location into the document
+            auto arg = line.tail(UnownedStringSlice("//CHANGE:").getLength());
+            Int linePos, colPos;
+            Index textPos = parseLocation(arg, 0, linePos, colPos);
+
+            LanguageServerProtocol::DidChangeTextDocumentParams params;
+            params.textDocument.uri = openDocParams.textDocument.uri;
+            params.textDocument.version = ++docVersion;
+            LanguageServerProtocol::TextDocumentContentChangeEvent change;
+            change.range.start.line = change.range.end.line = int(linePos - 1);
+            change.range.start.character = change.range.end.character = int(colPos - 1);
+            change.text = arg.trimStart().tail(textPos + 1);
+            params.contentChanges.add(change);
+            connection->sendCall(
+                LanguageServerProtocol::DidChangeTextDocumentParams::methodName,
+                &params,
+                JSONValue::makeInt(callId++));
+        }
+        else if (line.startsWith("//LOG"))
+        {
+            actualOutputSB << "--------\n";
+            for (auto& message : logMessages)
+            {
+                actualOutputSB << message << "\n";
+            }
+        }
+        else if (line.startsWith("//COMPLETE:"))
         {
             auto arg = line.tail(UnownedStringSlice("//COMPLETE:").getLength());
             Int linePos, colPos;
@@ -0,0 +1,155 @@
+// unit-test-downstream-compile-cache.cpp
+
+#include "../../slang.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-string-util.h"
+#include "../../source/compiler-core/slang-artifact-associated-impl.h"
+#include "../../source/compiler-core/slang-artifact-desc-util.h"
+#include "../../source/compiler-core/slang-artifact-util.h"
+#include "../../source/compiler-core/slang-downstream-compile-cache.h"
+
+using namespace Slang;
+
+static const char kSource[] = R"(
+[shader("compute")]
+[numthreads(8,1,1)]
+void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> buffer)
+{
+    buffer[tid.x] = buffer[tid.x] * 2.0f;
+}
+)";
+
+    /// Get the value of the counter `name` from a text performance report, or -1 if not found
+static Index _getCounterValue(const UnownedStringSlice& report, const UnownedStringSlice& name)
+{
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(report, lines);
+    for (const auto& line : lines)
+    {
+        if (line.startsWith(name))
+        {
+            const UnownedStringSlice valueText = UnownedStringSlice(line.begin() + name.getLength(), line.end()).trim();
+            Int value = 0;
+            return SLANG_SUCCEEDED(StringUtil::parseInt(valueText, value)) ? Index(value) : -1;
+        }
+    }
+    return -1;
+}
+
+// Test that compiling the same entry point twice only invokes the downstream compiler once,
+// and that the cached output is the same.
+SLANG_UNIT_TEST(downstreamCompileCache)
+{
+    slang::IGlobalSession* globalSession = unitTestContext->slangGlobalSession;
+
+    if (SLANG_FAILED(globalSession->checkPassThroughSupport(SLANG_PASS_THROUGH_GLSLANG)))
+    {
+        SLANG_IGNORE_TEST
+    }
+
+    slang::TargetDesc targetDesc;
+    targetDesc.format = SLANG_SPIRV;
+    targetDesc.profile = globalSession->findProfile("glsl_450");
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+    sessionDesc.flags = slang::kSessionFlag_ReportPerformance;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnostics;
+    slang::IModule* module = session->loadModuleFromSource("downstreamCacheTest", "downstream-cache-test.slang", StringBlob::create(UnownedStringSlice(kSource)), diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+    // Each program generates code separately, but the emitted GLSL is the same, so the second
+    // compile with glslang should be found in the cache.
+    ComPtr<slang::IBlob> codes[2];
+    ComPtr<slang::IComponentType> program;
+    for (auto& code : codes)
+    {
+        slang::IComponentType* components[] = { module, entryPoint };
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->createCompositeComponentType(components, 2, program.writeRef())));
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program->getEntryPointCode(0, 0, code.writeRef())));
+    }
+
+    SLANG_CHECK(codes[0]->getBufferSize() > 0);
+    SLANG_CHECK(codes[0]->getBufferSize() == codes[1]->getBufferSize() &&
+        ::memcmp(codes[0]->getBufferPointer(), codes[1]->getBufferPointer(), codes[0]->getBufferSize()) == 0);
+
+    ComPtr<ISlangBlob> report;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program->getPerformanceReport(SLANG_PERFORMANCE_REPORT_FORMAT_TEXT, report.writeRef())));
+    const Index hitCount = _getCounterValue(StringUtil::getSlice(report), UnownedStringSlice::fromLiteral("downstream compiles read from cache"));
+    SLANG_CHECK(hitCount == 1);
+}
+
+    /// Create an artifact as produced by a successful compile, holding `text`
+static ComPtr<IArtifact> _createCompiledArtifact(const char* text)
+{
+    auto artifact = ArtifactUtil::createArtifact(ArtifactDescUtil::makeDescForCompileTarget(SLANG_SPIRV));
+    artifact->addRepresentationUnknown(StringBlob::create(UnownedStringSlice(text)));
+
+    auto diagnostics = ArtifactDiagnostics::create();
+    diagnostics->setResult(SLANG_OK);
+    artifact->addAssociated(diagnostics);
+    return artifact;
+}
+
+// Test that the in memory tier of the cache evicts the least recently used entries once full,
+// and can be disabled.
+SLANG_UNIT_TEST(downstreamCompileCacheEviction)
+{
+    const char* const texts[] = { "a", "b", "c", "d", "e" };
+    const Index textCount = SLANG_COUNT_OF(texts);
+
+    DownstreamCompileCache::Key keys[textCount];
+    for (Index i = 0; i < textCount; ++i)
+    {
+        keys[i] = SHA1::compute(texts[i], 1);
+    }
+
+    RefPtr<DownstreamCompileCache> cache = new DownstreamCompileCache;
+    cache->setMaxMemoryEntryCount(4);
+
+    for (Index i = 0; i < 4; ++i)
+    {
+        SLANG_CHECK(SLANG_SUCCEEDED(cache->storeArtifact(keys[i], _createCompiledArtifact(texts[i]))));
+    }
+
+    // Use the first entry, such that the second is the least recently used
+    {
+        ComPtr<IArtifact> artifact;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(cache->findArtifact(keys[0], artifact.writeRef())));
+        ComPtr<ISlangBlob> blob;
+        SLANG_CHECK(SLANG_SUCCEEDED(artifact->loadBlob(ArtifactKeep::No, blob.writeRef())));
+        SLANG_CHECK(StringUtil::getSlice(blob) == UnownedStringSlice("a"));
+    }
+
+    // Going over the maximum evicts a batch of the least recently used entries
+    SLANG_CHECK(SLANG_SUCCEEDED(cache->storeArtifact(keys[4], _createCompiledArtifact(texts[4]))));
+    SLANG_CHECK(cache->getStats().evictCount == 2);
+
+    const bool expectedFound[textCount] = { true, false, false, true, true };
+    for (Index i = 0; i < textCount; ++i)
+    {
+        ComPtr<IArtifact> artifact;
+        SLANG_CHECK(SLANG_SUCCEEDED(cache->findArtifact(keys[i], artifact.writeRef())) == expectedFound[i]);
+    }
+
+    // Disabling the in memory tier removes everything, and nothing is added after
+    cache->setMaxMemoryEntryCount(0);
+    SLANG_CHECK(SLANG_SUCCEEDED(cache->storeArtifact(keys[1], _createCompiledArtifact(texts[1]))));
+    for (Index i = 0; i < textCount; ++i)
+    {
+        ComPtr<IArtifact> artifact;
+        SLANG_CHECK(cache->findArtifact(keys[i], artifact.writeRef()) == SLANG_E_NOT_FOUND);
+    }
+}
@@ -0,0 +1,244 @@
+// unit-test-flat-dictionary.cpp
+
+#include "../../source/core/slang-flat-dictionary.h"
+#include "../../source/core/slang-random-generator.h"
+#include "../../source/core/slang-string.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+// A key with a poor hash, such that many keys share the same hash code
+struct CollidingKey
+{
+    int value;
+
+    HashCode getHashCode() const { return HashCode(value & 3); }
+    bool operator==(const CollidingKey& rhs) const { return value == rhs.value; }
+};
+
+} // anonymous
+
+template<typename TKey, typename TValue>
+static bool _isEqual(FlatDictionary<TKey, TValue>& flat, Dictionary<TKey, TValue>& dict)
+{
+    if (flat.Count() != Index(dict.Count()))
+    {
+        return false;
+    }
+    for (const auto& pair : dict)
+    {
+        TValue* value = flat.TryGetValue(pair.Key);
+        if (!value || !(*value == pair.Value))
+        {
+            return false;
+        }
+    }
+    // Every entry is visited exactly once by iteration
+    Index count = 0;
+    for (const auto& pair : flat)
+    {
+        TValue* value = dict.TryGetValue(pair.Key);
+        if (!value || !(*value == pair.Value))
+        {
+            return false;
+        }
+        count++;
+    }
+    return count == flat.Count();
+}
+
+static void _randomizedTest(RandomGenerator* rand, Int keyRange, Int opCount)
+{
+    FlatDictionary<Int, Int> flat;
+    Dictionary<Int, Int> dict;
+
+    for (Int i = 0; i < opCount; ++i)
+    {
+        const Int key = rand->nextInt32InRange(0, int32_t(keyRange));
+        const Int value = rand->nextInt32();
+        switch (rand->nextInt32UpTo(6))
+        {
+            case 0:
+            case 1:
+            {
+                flat[key] = value;
+                dict[key] = value;
+                break;
+            }
+            case 2:
+            {
+                SLANG_CHECK(flat.AddIfNotExists(key, value) == dict.AddIfNotExists(key, value));
+                break;
+            }
+            case 3:
+            {
+                flat.Remove(key);
+                dict.Remove(key);
+                break;
+            }
+            case 4:
+            {
+                Int* flatValue = flat.TryGetValueOrAdd(key, value);
+                Int* dictValue = dict.TryGetValueOrAdd(key, value);
+                SLANG_CHECK((flatValue == nullptr) == (dictValue == nullptr));
+                SLANG_CHECK(!flatValue || *flatValue == *dictValue);
+                break;
+            }
+            default:
+            {
+                SLANG_CHECK(flat.ContainsKey(key) == dict.ContainsKey(key));
+                break;
+            }
+        }
+        SLANG_CHECK(flat.Count() == Index(dict.Count()));
+    }
+
+    SLANG_CHECK(_isEqual(flat, dict));
+
+    // Copies are independent of the original
+    FlatDictionary<Int, Int> copy(flat);
+    SLANG_CHECK(_isEqual(copy, dict));
+    copy.Clear();
+    SLANG_CHECK(copy.Count() == 0);
+    SLANG_CHECK(_isEqual(flat, dict));
+
+    FlatDictionary<Int, Int> moved(_Move(flat));
+    SLANG_CHECK(flat.Count() == 0);
+    SLANG_CHECK(_isEqual(moved, dict));
+}
+
+SLANG_UNIT_TEST(flatDictionary)
+{
+    // Basic operations
+    {
+        FlatDictionary<String, Int> dict;
+        SLANG_CHECK(dict.Count() == 0);
+        SLANG_CHECK(!dict.ContainsKey(String("a")));
+        SLANG_CHECK(dict.begin() == dict.end());
+
+        dict.Add("a", 1);
+        dict["b"] = 2;
+        dict.Set("c", 3);
+        SLANG_CHECK(dict.Count() == 3);
+        SLANG_CHECK(dict["a"].GetValue() == 1);
+        SLANG_CHECK(dict.GetOrAddValue("b", 10) == 2);
+        SLANG_CHECK(dict.GetOrAddValue("d", 4) == 4);
+        SLANG_CHECK(!dict.AddIfNotExists("d", 5));
+        SLANG_CHECK(dict.Count() == 4);
+
+        dict.Set("c", 30);
+        Int value = 0;
+        SLANG_CHECK(dict.TryGetValue(String("c"), value) && value == 30);
+
+        // Lookup with a different key type
+        SLANG_CHECK(dict.ContainsKey(UnownedStringSlice("a")));
+        SLANG_CHECK(dict.TryGetValue(UnownedStringSlice("d")) && *dict.TryGetValue(UnownedStringSlice("d")) == 4);
+        SLANG_CHECK(!dict.ContainsKey(UnownedStringSlice("e")));
+        dict.Remove(UnownedStringSlice("a"));
+        SLANG_CHECK(!dict.ContainsKey(String("a")));
+        SLANG_CHECK(dict.Count() == 3);
+
+        FlatDictionary<String, Int> init(KeyValuePair<String, Int>("x", 1), KeyValuePair<String, Int>("y", 2));
+        SLANG_CHECK(init.Count() == 2 && init.ContainsKey(String("y")));
+    }
+
+    // Keys that all hash to a few values, filling whole groups such that removed slots become
+    // tombstones, and removing/adding repeatedly such that tombstones are reclaimed
+    {
+        FlatDictionary<CollidingKey, int> dict;
+        for (int i = 0; i < 200; ++i)
+        {
+            dict.Add(CollidingKey{i}, i);
+        }
+        for (int round = 0; round < 10; ++round)
+        {
+            for (int i = 0; i < 200; i += 2)
+            {
+                dict.Remove(CollidingKey{i});
+            }
+            SLANG_CHECK(dict.Count() == 100);
+            for (int i = 1; i < 200; i += 2)
+            {
+                SLANG_CHECK(dict.ContainsKey(CollidingKey{i}));
+            }
+            for (int i = 0; i < 200; i += 2)
+            {
+                SLANG_CHECK(!dict.ContainsKey(CollidingKey{i}));
+                dict.Add(CollidingKey{i}, i);
+            }
+            SLANG_CHECK(dict.Count() == 200);
+        }
+        for (const auto& pair : dict)
+        {
+            SLANG_CHECK(pair.Key.value == pair.Value);
+        }
+    }
+
+    // Probe statistics. With a few distinct hashes the colliding keys spill over into later groups,
+    // whereas well distributed keys are nearly all found in the first group probed.
+    {
+        FlatDictionary<CollidingKey, int> colliding;
+        FlatDictionary<Int, Int> spread;
+        for (int i = 0; i < 200; ++i)
+        {
+            colliding.Add(CollidingKey{i}, i);
+            spread.Add(i, i);
+        }
+
+        const auto collidingStats = colliding.calcProbeStats();
+        SLANG_CHECK(collidingStats.count == 200 && collidingStats.capacity >= 200);
+        SLANG_CHECK(collidingStats.maxProbeLength > 1);
+        SLANG_CHECK(collidingStats.totalProbeLength > collidingStats.count);
+
+        const auto spreadStats = spread.calcProbeStats();
+        SLANG_CHECK(spreadStats.count == 200);
+        SLANG_CHECK(spreadStats.totalProbeLength >= spreadStats.count);
+        SLANG_CHECK(spreadStats.totalProbeLength < collidingStats.totalProbeLength);
+
+        const FlatDictionary<Int, Int> empty;
+        SLANG_CHECK(empty.calcProbeStats().totalProbeLength == 0);
+    }
+
+    // Table sizes stay bounded when the same keys are repeatedly added and removed
+    {
+        FlatDictionary<Int, Int> dict;
+        dict.reserve(100);
+        for (Int i = 0; i < 100000; ++i)
+        {
+            dict.Add(i, i);
+            if (i >= 50)
+            {
+                dict.Remove(i - 50);
+            }
+        }
+        SLANG_CHECK(dict.Count() == 50);
+        for (Int i = 100000 - 50; i < 100000; ++i)
+        {
+            SLANG_CHECK(dict.ContainsKey(i));
+        }
+    }
+
+    // Randomized comparison with Dictionary, with dense and sparse keys
+    {
+        RefPtr<RandomGenerator> rand = RandomGenerator::create(0x1234);
+        _randomizedTest(rand, 64, 10000);
+        _randomizedTest(rand, 4096, 50000);
+        _randomizedTest(rand, 0x7fffffff, 20000);
+    }
+
+    // Sets
+    {
+        FlatHashSet<String> set;
+        SLANG_CHECK(set.Add("a"));
+        SLANG_CHECK(!set.Add("a"));
+        SLANG_CHECK(set.Add("b"));
+        SLANG_CHECK(set.Count() == 2);
+        SLANG_CHECK(set.Contains("b"));
+        set.Remove("a");
+        SLANG_CHECK(!set.Contains("a"));
+        SLANG_CHECK(set.Count() == 1);
+    }
+}
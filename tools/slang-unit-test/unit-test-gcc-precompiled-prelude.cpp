@@ -0,0 +1,86 @@
+// unit-test-gcc-precompiled-prelude.cpp
+
+#include "../../slang.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/compiler-core/slang-artifact-associated.h"
+#include "../../source/compiler-core/slang-artifact-desc-util.h"
+#include "../../source/compiler-core/slang-artifact-util.h"
+#include "../../source/compiler-core/slang-gcc-compiler-util.h"
+#include "../../source/compiler-core/slang-slice-allocator.h"
+
+using namespace Slang;
+
+// Three lines long, so the source that follows it starts on line 4
+static const char kPrelude[] =
+    "// prelude\n"
+    "#include <stdint.h>\n"
+    "static inline int32_t preludeValue() { return 1; }\n";
+
+    /// Compile C++ `source`, which starts with kPrelude
+static SlangResult _compile(IDownstreamCompiler* compiler, const String& source, ComPtr<IArtifactDiagnostics>& outDiagnostics)
+{
+    const String prelude(kPrelude);
+
+    auto sourceArtifact = ArtifactUtil::createArtifact(ArtifactDescUtil::makeDescForSourceLanguage(SLANG_SOURCE_LANGUAGE_CPP));
+    sourceArtifact->addRepresentationUnknown(StringBlob::create(source));
+    IArtifact* sourceArtifacts[] = { sourceArtifact.get() };
+
+    DownstreamCompileOptions options;
+    options.sourceLanguage = SLANG_SOURCE_LANGUAGE_CPP;
+    options.targetType = SLANG_OBJECT_CODE;
+    options.sourceArtifacts = makeSlice(sourceArtifacts, 1);
+    options.sourcePrelude = SliceUtil::asTerminatedCharSlice(prelude);
+
+    ComPtr<IArtifact> artifact;
+    SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
+
+    outDiagnostics = findAssociated<IArtifactDiagnostics>(artifact);
+    return outDiagnostics ? outDiagnostics->getResult() : SLANG_FAIL;
+}
+
+// Test that the prelude of C++ sources is precompiled once and used by later compiles, and that
+// diagnostics in the rest of the source still report the lines of the original source.
+SLANG_UNIT_TEST(gccPrecompiledPrelude)
+{
+    ComPtr<IDownstreamCompiler> compiler;
+    if (SLANG_FAILED(GCCDownstreamCompilerUtil::createCompiler(ExecutableLocation("g++"), compiler)) &&
+        SLANG_FAILED(GCCDownstreamCompilerUtil::createCompiler(ExecutableLocation("clang"), compiler)))
+    {
+        SLANG_IGNORE_TEST
+    }
+    auto gccCompiler = static_cast<GCCDownstreamCompiler*>(compiler.get());
+
+    const String prelude(kPrelude);
+    for (Index i = 0; i < 2; ++i)
+    {
+        ComPtr<IArtifactDiagnostics> diagnostics;
+        SLANG_CHECK(SLANG_SUCCEEDED(_compile(compiler, prelude + "int32_t getValue() { return preludeValue(); }\n", diagnostics)));
+
+        // The second compile uses the prelude precompiled by the first
+        SLANG_CHECK(gccCompiler->getPrecompiledPreludeCount() == 1);
+    }
+
+    // The error is on line 5 of the source
+    {
+        ComPtr<IArtifactDiagnostics> diagnostics;
+        SLANG_CHECK(SLANG_FAILED(_compile(compiler, prelude + "\nint32_t getError() { return undeclaredValue; }\n", diagnostics)));
+        SLANG_CHECK_ABORT(diagnostics);
+
+        bool foundError = false;
+        for (Index i = 0; i < diagnostics->getCount(); ++i)
+        {
+            const auto diagnostic = diagnostics->getAt(i);
+            if (diagnostic->severity == ArtifactDiagnostic::Severity::Error)
+            {
+                SLANG_CHECK(diagnostic->location.line == 5);
+                foundError = true;
+            }
+        }
+        SLANG_CHECK(foundError);
+        SLANG_CHECK(gccCompiler->getPrecompiledPreludeCount() == 1);
+    }
+}
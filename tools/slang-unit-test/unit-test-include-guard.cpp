@@ -0,0 +1,95 @@
+// unit-test-include-guard.cpp
+
+#include "../../slang.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-memory-file-system.h"
+#include "../../source/core/slang-string-util.h"
+
+using namespace Slang;
+
+static const char kGuardedHeader[] = R"(
+#ifndef GUARDED_H
+#define GUARDED_H
+float guarded(float x) { return x; }
+#endif
+)";
+
+// Has a directive after the `#endif`, so isn't an include guard
+static const char kUnguardedHeader[] = R"(
+#ifndef UNGUARDED_H
+#define UNGUARDED_H
+float unguarded(float x) { return x; }
+#endif
+#undef UNGUARDED_H
+#define UNGUARDED_H
+)";
+
+static const char kSource[] = R"(
+#include "guarded.h"
+#include "guarded.h"
+#include "guarded.h"
+#include "unguarded.h"
+#include "unguarded.h"
+
+[shader("compute")]
+[numthreads(8,1,1)]
+void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> buffer)
+{
+    buffer[tid.x] = guarded(unguarded(float(tid.x)));
+}
+)";
+
+    /// Get the value of the counter `name` from a text performance report, or -1 if not found
+static Index _getCounterValue(const UnownedStringSlice& report, const UnownedStringSlice& name)
+{
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(report, lines);
+    for (const auto& line : lines)
+    {
+        if (line.startsWith(name))
+        {
+            const UnownedStringSlice valueText = UnownedStringSlice(line.begin() + name.getLength(), line.end()).trim();
+            Int value = 0;
+            return SLANG_SUCCEEDED(StringUtil::parseInt(valueText, value)) ? Index(value) : -1;
+        }
+    }
+    return -1;
+}
+
+// Test that includes of a file wrapped in an include guard are skipped, and includes of a file
+// that only looks like it is are not.
+SLANG_UNIT_TEST(includeGuard)
+{
+    slang::IGlobalSession* globalSession = unitTestContext->slangGlobalSession;
+
+    ComPtr<ISlangMutableFileSystem> fileSystem(new MemoryFileSystem);
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(fileSystem->saveFile("guarded.h", kGuardedHeader, SLANG_COUNT_OF(kGuardedHeader) - 1)));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(fileSystem->saveFile("unguarded.h", kUnguardedHeader, SLANG_COUNT_OF(kUnguardedHeader) - 1)));
+
+    slang::TargetDesc targetDesc;
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+    sessionDesc.fileSystem = fileSystem;
+    sessionDesc.flags = slang::kSessionFlag_ReportPerformance;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnostics;
+    slang::IModule* module = session->loadModuleFromSource("module", "module.slang", StringBlob::create(String(kSource)), diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module);
+
+    // The second and third includes of `guarded.h` are skipped
+    ComPtr<ISlangBlob> report;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(module->getPerformanceReport(SLANG_PERFORMANCE_REPORT_FORMAT_TEXT, report.writeRef())));
+    const Index skipCount = _getCounterValue(StringUtil::getSlice(report), UnownedStringSlice::fromLiteral("includes skipped by include guard"));
+    SLANG_CHECK(skipCount == 2);
+}
@@ -0,0 +1,169 @@
+// unit-test-ir-pass-manager.cpp
+
+#include "../../slang.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-string-util.h"
+
+using namespace Slang;
+
+// Has nothing to specialize, and no functions with array parameters. For GLSL the simplifyIR after
+// specializeArrayParameters has no new work, so is skipped.
+static const char kSource[] = R"(
+[shader("compute")]
+[numthreads(8,1,1)]
+void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> buffer)
+{
+    buffer[tid.x] = float(tid.x) * 2.0;
+}
+)";
+
+// `apply` is specialized for `Doubler`, after which the generic is dead code. Removing it changes
+// the IR, so specializeModule is run again on the next iteration of the specialization loop.
+static const char kGenericSource[] = R"(
+interface IScale { float scale(float x); }
+
+struct Doubler : IScale { float scale(float x) { return x * 2.0; } }
+
+float apply<T : IScale>(T s, float x) { return s.scale(x); }
+
+[shader("compute")]
+[numthreads(8,1,1)]
+void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> buffer)
+{
+    Doubler d;
+    buffer[tid.x] = apply(d, float(tid.x));
+}
+)";
+
+namespace { // anonymous
+
+struct PassCounts
+{
+    Index runCount = -1;            ///< Times the pass was run
+    Index changeCount = -1;         ///< Times a run of the pass changed IR
+    Index skipCount = -1;           ///< Times the pass was skipped
+};
+
+} // anonymous
+
+    /// Find the counts of the pass `name` in a text performance report. Returns false if not found.
+static bool _findPassCounts(const UnownedStringSlice& report, const UnownedStringSlice& name, PassCounts& outCounts)
+{
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(report, lines);
+    for (const auto& line : lines)
+    {
+        // Columns are the (indented) name, calls, total ms, self ms, changed and skipped
+        List<UnownedStringSlice> columns;
+        StringUtil::split(line.trim(), ' ', columns);
+
+        List<UnownedStringSlice> values;
+        for (const auto& column : columns)
+        {
+            if (column.getLength())
+            {
+                values.add(column);
+            }
+        }
+
+        if (values.getCount() < 6 || values[0] != name)
+        {
+            continue;
+        }
+
+        Int runCount, changeCount, skipCount;
+        if (SLANG_FAILED(StringUtil::parseInt(values[1], runCount)) ||
+            SLANG_FAILED(StringUtil::parseInt(values[4], changeCount)) ||
+            SLANG_FAILED(StringUtil::parseInt(values[5], skipCount)))
+        {
+            return false;
+        }
+
+        outCounts.runCount = Index(runCount);
+        outCounts.changeCount = Index(changeCount);
+        outCounts.skipCount = Index(skipCount);
+        return true;
+    }
+    return false;
+}
+
+    /// Generate GLSL for `computeMain` in `source`, and get the text performance report.
+static SlangResult _compileAndGetReport(UnitTestContext* unitTestContext, const char* source, String& outReport)
+{
+    slang::IGlobalSession* globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc;
+    targetDesc.format = SLANG_GLSL;
+    targetDesc.profile = globalSession->findProfile("glsl_450");
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+    sessionDesc.flags = slang::kSessionFlag_ReportPerformance;
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+    ComPtr<slang::IBlob> diagnostics;
+    slang::IModule* module = session->loadModuleFromSource("module", "module.slang", StringBlob::create(String(source)), diagnostics.writeRef());
+    if (!module)
+    {
+        return SLANG_FAIL;
+    }
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+    slang::IComponentType* components[] = { module, entryPoint };
+    ComPtr<slang::IComponentType> program;
+    SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(components, 2, program.writeRef()));
+
+    ComPtr<slang::IComponentType> linked;
+    SLANG_RETURN_ON_FAIL(program->link(linked.writeRef()));
+
+    ComPtr<slang::IBlob> code;
+    SLANG_RETURN_ON_FAIL(linked->getEntryPointCode(0, 0, code.writeRef()));
+
+    ComPtr<ISlangBlob> report;
+    SLANG_RETURN_ON_FAIL(module->getPerformanceReport(SLANG_PERFORMANCE_REPORT_FORMAT_TEXT, report.writeRef()));
+    outReport = StringUtil::getString(report);
+    return SLANG_OK;
+}
+
+// Test that a pass is skipped when the IR hasn't changed since it last ran, and is run again
+// when it has.
+SLANG_UNIT_TEST(irPassManager)
+{
+    // No IR is changed between the last two simplifyIR passes, so the second is skipped
+    {
+        String report;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileAndGetReport(unitTestContext, kSource, report)));
+
+        PassCounts simplify;
+        SLANG_CHECK_ABORT(_findPassCounts(report.getUnownedSlice(), UnownedStringSlice::fromLiteral("simplifyIR"), simplify));
+        SLANG_CHECK(simplify.runCount >= 1);
+        SLANG_CHECK(simplify.skipCount >= 1);
+        SLANG_CHECK(simplify.changeCount <= simplify.runCount);
+    }
+
+    // specializeModule runs until it has nothing left to do, so it is only run again because
+    // the IR was changed after its first run.
+    {
+        String report;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileAndGetReport(unitTestContext, kGenericSource, report)));
+
+        PassCounts specialize;
+        SLANG_CHECK_ABORT(_findPassCounts(report.getUnownedSlice(), UnownedStringSlice::fromLiteral("specializeModule"), specialize));
+        SLANG_CHECK(specialize.changeCount >= 1);
+        SLANG_CHECK(specialize.runCount >= 2);
+
+        // The dead code removed after specialization is why it was run again
+        PassCounts deadCode;
+        SLANG_CHECK_ABORT(_findPassCounts(report.getUnownedSlice(), UnownedStringSlice::fromLiteral("eliminateDeadCode"), deadCode));
+        SLANG_CHECK(deadCode.changeCount >= 1);
+    }
+}
@@ -0,0 +1,280 @@
+// unit-test-member-lookup-cache.cpp
+
+#include "../../slang.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-string-util.h"
+
+using namespace Slang;
+
+// The members of `Scaler` are looked up many times. `scale` is only found through the extension.
+static const char kSource[] = R"(
+interface IScale { float scale(float x); }
+
+struct Scaler { float factor; float bias; }
+
+extension Scaler : IScale
+{
+    float scale(float x) { return x * factor + bias; }
+}
+
+float apply(Scaler s, float x) { return s.scale(x) + s.factor + s.bias; }
+
+[shader("compute")]
+[numthreads(8,1,1)]
+void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> buffer)
+{
+    Scaler s;
+    s.factor = 2.0;
+    s.bias = s.factor;
+    buffer[tid.x] = apply(s, float(tid.x)) + s.scale(s.bias);
+}
+)";
+
+// `Value` is checked against `IValue` for each call. `Offset` only conforms through the extension.
+static const char kGenericSource[] = R"(
+interface IValue { float get(); }
+
+struct Value : IValue { float v; float get() { return v; } }
+
+struct Offset { float v; }
+
+extension Offset : IValue { float get() { return v + 1.0; } }
+
+float twice<T : IValue>(T t) { return t.get() * 2.0; }
+float sum<T : IValue, U : IValue>(T a, U b) { return a.get() + b.get(); }
+
+[shader("compute")]
+[numthreads(8,1,1)]
+void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> buffer)
+{
+    Value value;
+    value.v = float(tid.x);
+    Offset offset;
+    offset.v = value.v;
+    buffer[tid.x] = twice(value) + twice(offset) + sum(value, offset) + sum(offset, value) + twice(value);
+}
+)";
+
+// `blend` and `dot` are called several times with the same argument types, and the `float3` initializers are
+// an overload group where most of the candidates take a different number of arguments.
+static const char kCallSource[] = R"(
+float3 blend(float3 a, float3 b, float t) { return lerp(a, b, t); }
+
+[shader("compute")]
+[numthreads(8,1,1)]
+void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> buffer)
+{
+    float t = float(tid.x);
+    float3 a = float3(t, t, t);
+    float3 b = float3(1.0, 2.0, t);
+    float3 c = blend(a, b, t) + blend(b, a, t) + blend(a, a, t);
+    buffer[tid.x] = dot(a, b) + dot(b, c) + dot(c, a);
+}
+)";
+
+// The cases below check the callee that is chosen, when calls with the same argument types are
+// resolved from the call overload cache. Each overload returns a distinct value, which is found in the
+// generated code if the overload was called.
+
+// The mutating `f` is the better match, but can't be called on an r-value, for which `f(float)` is
+// called instead.
+static const char kMutatingCallSource[] = R"(
+struct Counter
+{
+    int v;
+    [mutating] int f(int x) { v += x; return 1111; }
+    int f(float x) { return 2222; }
+}
+
+Counter makeCounter(int v) { Counter c; c.v = v; return c; }
+
+[shader("compute")]
+[numthreads(8,1,1)]
+void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<int> buffer)
+{
+    Counter c = makeCounter(buffer[0]);
+    int x = int(tid.x);
+    buffer[tid.x] = c.f(x) + c.f(x + 1) + makeCounter(x).f(x) + makeCounter(x + 1).f(x);
+}
+)";
+
+// `MyInt` is the same type as `int`, so calls with either use `g(int)`. `MyFloat` uses `g(float)`.
+static const char kTypedefCallSource[] = R"(
+typedef int MyInt;
+typedef float MyFloat;
+
+int g(int x) { return 3333; }
+int g(float x) { return 4444; }
+
+[shader("compute")]
+[numthreads(8,1,1)]
+void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<int> buffer)
+{
+    int a = int(tid.x);
+    MyInt b = a + 1;
+    MyFloat c = float(a);
+    buffer[tid.x] = g(a) + g(b) + g(b) + g(c) + g(c);
+}
+)";
+
+// `Point` only conforms to `IGet` through an extension that comes after the calls in the module, so
+// the generic `h` is called for it. `int` doesn't conform, so `h(float)` is called.
+static const char kExtensionCallSource[] = R"(
+interface IGet { int get(); }
+
+struct Point { int x; }
+
+int h<T : IGet>(T t) { return t.get() + 5555; }
+int h(float x) { return 6666; }
+
+[shader("compute")]
+[numthreads(8,1,1)]
+void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<int> buffer)
+{
+    Point p;
+    p.x = int(tid.x);
+    buffer[tid.x] = h(p) + h(p) + h(int(tid.x)) + h(int(tid.x));
+}
+
+extension Point : IGet { int get() { return x; } }
+)";
+
+    /// Get the value of the counter `name` from a text performance report, or -1 if not found
+static Index _getCounterValue(const UnownedStringSlice& report, const UnownedStringSlice& name)
+{
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(report, lines);
+    for (const auto& line : lines)
+    {
+        if (line.startsWith(name))
+        {
+            const UnownedStringSlice valueText = UnownedStringSlice(line.begin() + name.getLength(), line.end()).trim();
+            Int value = 0;
+            return SLANG_SUCCEEDED(StringUtil::parseInt(valueText, value)) ? Index(value) : -1;
+        }
+    }
+    return -1;
+}
+
+    /// Compile `source` and return the text performance report, or an empty string on failure.
+    /// If `outCode` is set, it is set to the generated code.
+static String _compileAndGetReport(slang::IGlobalSession* globalSession, const char* source, String* outCode = nullptr)
+{
+    slang::TargetDesc targetDesc;
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+    sessionDesc.flags = slang::kSessionFlag_ReportPerformance;
+
+    ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(globalSession->createSession(sessionDesc, session.writeRef())))
+        return String();
+
+    ComPtr<slang::IBlob> diagnostics;
+    slang::IModule* module = session->loadModuleFromSource("lookupCache", "lookupCache.slang", StringBlob::create(UnownedStringSlice(source)), diagnostics.writeRef());
+    if (!module)
+        return String();
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    if (SLANG_FAILED(module->findEntryPointByName("computeMain", entryPoint.writeRef())))
+        return String();
+
+    slang::IComponentType* components[] = { module, entryPoint };
+    ComPtr<slang::IComponentType> program;
+    if (SLANG_FAILED(session->createCompositeComponentType(components, 2, program.writeRef())))
+        return String();
+
+    ComPtr<slang::IBlob> code;
+    if (SLANG_FAILED(program->getEntryPointCode(0, 0, code.writeRef())) || !code || code->getBufferSize() == 0)
+        return String();
+    if (outCode)
+        *outCode = StringUtil::getString(code);
+
+    ComPtr<ISlangBlob> report;
+    if (SLANG_FAILED(program->getPerformanceReport(SLANG_PERFORMANCE_REPORT_FORMAT_TEXT, report.writeRef())))
+        return String();
+    return StringUtil::getString(report);
+}
+
+// Test that repeated member lookups during checking are read from the member lookup cache,
+// and that members found through extensions are still found.
+SLANG_UNIT_TEST(memberLookupCache)
+{
+    const String report = _compileAndGetReport(unitTestContext->slangGlobalSession, kSource);
+    SLANG_CHECK_ABORT(report.getLength() > 0);
+
+    const Index hitCount = _getCounterValue(report.getUnownedSlice(), UnownedStringSlice::fromLiteral("member lookup cache hits"));
+    const Index missCount = _getCounterValue(report.getUnownedSlice(), UnownedStringSlice::fromLiteral("member lookup cache misses"));
+    SLANG_CHECK(hitCount > 0);
+    SLANG_CHECK(missCount > 0);
+}
+
+// Test that repeated subtype checks for generic calls are read from the subtype witness cache,
+// and that conformances declared by extensions are still found.
+SLANG_UNIT_TEST(subtypeWitnessCache)
+{
+    const String report = _compileAndGetReport(unitTestContext->slangGlobalSession, kGenericSource);
+    SLANG_CHECK_ABORT(report.getLength() > 0);
+
+    const Index hitCount = _getCounterValue(report.getUnownedSlice(), UnownedStringSlice::fromLiteral("subtype witness cache hits"));
+    const Index missCount = _getCounterValue(report.getUnownedSlice(), UnownedStringSlice::fromLiteral("subtype witness cache misses"));
+    SLANG_CHECK(hitCount > 0);
+    SLANG_CHECK(missCount > 0);
+}
+
+// Test that repeated calls with the same argument types are resolved from the call overload cache,
+// and that candidates taking a different number of arguments are skipped.
+SLANG_UNIT_TEST(callOverloadCache)
+{
+    const String report = _compileAndGetReport(unitTestContext->slangGlobalSession, kCallSource);
+    SLANG_CHECK_ABORT(report.getLength() > 0);
+
+    const Index hitCount = _getCounterValue(report.getUnownedSlice(), UnownedStringSlice::fromLiteral("call overload cache hits"));
+    const Index missCount = _getCounterValue(report.getUnownedSlice(), UnownedStringSlice::fromLiteral("call overload cache misses"));
+    const Index skipCount = _getCounterValue(report.getUnownedSlice(), UnownedStringSlice::fromLiteral("overload candidates skipped"));
+    SLANG_CHECK(hitCount > 0);
+    SLANG_CHECK(missCount > 0);
+    SLANG_CHECK(skipCount > 0);
+}
+
+// Test that calls resolved from the call overload cache choose the same callee as if they weren't cached
+SLANG_UNIT_TEST(callOverloadCacheCallee)
+{
+    slang::IGlobalSession* globalSession = unitTestContext->slangGlobalSession;
+
+    // l-value and r-value bases
+    {
+        String code;
+        const String report = _compileAndGetReport(globalSession, kMutatingCallSource, &code);
+        SLANG_CHECK_ABORT(report.getLength() > 0);
+        SLANG_CHECK(code.indexOf("1111") >= 0);
+        SLANG_CHECK(code.indexOf("2222") >= 0);
+        SLANG_CHECK(_getCounterValue(report.getUnownedSlice(), UnownedStringSlice::fromLiteral("call overload cache hits")) > 0);
+    }
+
+    // Argument types that only differ by typedef
+    {
+        String code;
+        const String report = _compileAndGetReport(globalSession, kTypedefCallSource, &code);
+        SLANG_CHECK_ABORT(report.getLength() > 0);
+        SLANG_CHECK(code.indexOf("3333") >= 0);
+        SLANG_CHECK(code.indexOf("4444") >= 0);
+        SLANG_CHECK(_getCounterValue(report.getUnownedSlice(), UnownedStringSlice::fromLiteral("call overload cache hits")) > 0);
+    }
+
+    // A generic callee whose constraint is satisfied by an extension later in the module
+    {
+        String code;
+        const String report = _compileAndGetReport(globalSession, kExtensionCallSource, &code);
+        SLANG_CHECK_ABORT(report.getLength() > 0);
+        SLANG_CHECK(code.indexOf("5555") >= 0);
+        SLANG_CHECK(code.indexOf("6666") >= 0);
+    }
+}
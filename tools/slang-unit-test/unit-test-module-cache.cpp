@@ -0,0 +1,186 @@
+// unit-test-module-cache.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-file-system.h"
+#include "../../source/core/slang-string-util.h"
+
+using namespace Slang;
+
+static void _removeDirectory(const String& cacheDirectory)
+{
+    auto osFileSystem = OSFileSystem::getMutableSingleton();
+
+    osFileSystem->enumeratePathContents(
+        cacheDirectory.getBuffer(),
+        [](SlangPathType pathType, const char* fileName, void* userData)
+        {
+            SLANG_UNUSED(pathType);
+            const String& directory = *static_cast<const String*>(userData);
+            String path = directory + "/" + fileName;
+            OSFileSystem::getMutableSingleton()->remove(path.getBuffer());
+        },
+        const_cast<String*>(&cacheDirectory));
+
+    osFileSystem->remove(cacheDirectory.getBuffer());
+}
+
+    /// Get the value of the counter `name` from a text performance report, or 0 if not found
+static Index _getCounterValue(const UnownedStringSlice& report, const UnownedStringSlice& name)
+{
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(report, lines);
+    for (const auto& line : lines)
+    {
+        if (line.startsWith(name))
+        {
+            Int value = 0;
+            const UnownedStringSlice valueText = UnownedStringSlice(line.begin() + name.getLength(), line.end()).trim();
+            return SLANG_SUCCEEDED(StringUtil::parseInt(valueText, value)) ? Index(value) : 0;
+        }
+    }
+    return 0;
+}
+
+struct ModuleCacheCompileResult
+{
+    ComPtr<ISlangBlob> code;
+    Index hitCount = 0;
+    Index missCount = 0;
+    SlangInt entryPointCount = -1;          ///< Entry points defined by module C
+    bool foundEntryPoint = false;           ///< True if module C's entry point was found by name
+    String diagnostics;
+};
+
+static ModuleCacheCompileResult _compileWithModuleCache(const String& searchDirectory, const String& cacheDirectory)
+{
+    // Imports module B, which in turn imports module A, and module C which defines an entry point
+    const char* userSource = R"(
+        import module_cache_test_b;
+        import module_cache_test_c;
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeMain(
+            uint3 sv_dispatchThreadID : SV_DispatchThreadID,
+            uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[sv_dispatchThreadID.x] = g();
+        })";
+
+    auto session = spCreateSession();
+    auto request = spCreateCompileRequest(session);
+
+    const char* args[] = { "-module-cache-path", cacheDirectory.getBuffer(), "-I", searchDirectory.getBuffer() };
+    SLANG_CHECK(SLANG_SUCCEEDED(spProcessCommandLineArguments(request, args, int(SLANG_COUNT_OF(args)))));
+
+    spSetReportPerformance(request, true);
+
+    // Source locations of cached modules are remapped, so don't include them in the output
+    int targetIndex = spAddCodeGenTarget(request, SLANG_HLSL);
+    spSetTargetLineDirectiveMode(request, targetIndex, SLANG_LINE_DIRECTIVE_MODE_NONE);
+
+    int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "userUnit");
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "userFile", userSource);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    ModuleCacheCompileResult result;
+    const SlangResult compileResult = spCompile(request);
+    result.diagnostics = spGetDiagnosticOutput(request);
+    if (SLANG_SUCCEEDED(compileResult))
+    {
+        spGetEntryPointCodeBlob(request, 0, 0, result.code.writeRef());
+
+        ComPtr<ISlangBlob> report;
+        if (SLANG_SUCCEEDED(spGetPerformanceReport(request, SLANG_PERFORMANCE_REPORT_FORMAT_TEXT, report.writeRef())))
+        {
+            const String reportText = StringUtil::getString(report);
+            result.hitCount = _getCounterValue(reportText.getUnownedSlice(), toSlice("module cache hits"));
+            result.missCount = _getCounterValue(reportText.getUnownedSlice(), toSlice("module cache misses"));
+        }
+
+        // Module C has already been loaded, so this finds it whether it came from source or the cache
+        ComPtr<slang::ISession> linkage;
+        if (SLANG_SUCCEEDED(spCompileRequest_getSession(request, linkage.writeRef())))
+        {
+            if (slang::IModule* moduleC = linkage->loadModule("module_cache_test_c"))
+            {
+                result.entryPointCount = moduleC->getDefinedEntryPointCount();
+
+                ComPtr<slang::IEntryPoint> entryPoint;
+                result.foundEntryPoint = SLANG_SUCCEEDED(moduleC->findEntryPointByName("otherMain", entryPoint.writeRef()));
+            }
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+
+    return result;
+}
+
+static bool _isBlobEqual(ISlangBlob* a, ISlangBlob* b)
+{
+    return a->getBufferSize() == b->getBufferSize() &&
+        ::memcmp(a->getBufferPointer(), b->getBufferPointer(), a->getBufferSize()) == 0;
+}
+
+// Test that modules loaded from the module cache produce the same result as compiling from source,
+// and that a change to a module in the import chain invalidates the cached modules that depend on it.
+SLANG_UNIT_TEST(moduleCache)
+{
+    // The modules and the cache are written to a new temporary directory
+    String directory;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::generateTemporary(toSlice("slang-module-cache-test"), directory)));
+    File::remove(directory);
+    SLANG_CHECK_ABORT(Path::createDirectory(directory));
+
+    const String cacheDirectory = Path::combine(directory, "cache");
+    const String pathA = Path::combine(directory, "module-cache-test-a.slang");
+    const String pathB = Path::combine(directory, "module-cache-test-b.slang");
+    const String pathC = Path::combine(directory, "module-cache-test-c.slang");
+
+    File::writeAllText(pathA, "int f() { return 5; }");
+    File::writeAllText(pathB, "import module_cache_test_a;\nint g() { return f() + 1; }");
+    File::writeAllText(pathC, "[shader(\"compute\")]\n[numthreads(1,1,1)]\nvoid otherMain(uniform RWStructuredBuffer<int> buffer) { buffer[0] = 1; }");
+
+    // Compiles from source, and populates the cache
+    auto sourceResult = _compileWithModuleCache(directory, cacheDirectory);
+    SLANG_CHECK(sourceResult.code && sourceResult.code->getBufferSize() != 0);
+    SLANG_CHECK(File::exists(cacheDirectory + "/index"));
+    SLANG_CHECK(sourceResult.hitCount == 0 && sourceResult.missCount > 0);
+    SLANG_CHECK(sourceResult.entryPointCount == 1 && sourceResult.foundEntryPoint);
+
+    // Loads all the modules from the cache. The entry point of module C is found as it was from source.
+    auto cachedResult = _compileWithModuleCache(directory, cacheDirectory);
+    SLANG_CHECK(cachedResult.code && sourceResult.code && _isBlobEqual(sourceResult.code, cachedResult.code));
+    SLANG_CHECK(cachedResult.hitCount == 3 && cachedResult.missCount == 0);
+    SLANG_CHECK(cachedResult.entryPointCount == sourceResult.entryPointCount && cachedResult.foundEntryPoint);
+
+    // Changing module A must invalidate the entry for A and B (whose key doesn't change,
+    // but which depends on A). Module C doesn't depend on A, so is still loaded from the cache.
+    File::writeAllText(pathA, "int f() { return 7; }");
+
+    auto changedResult = _compileWithModuleCache(directory, cacheDirectory);
+    SLANG_CHECK(changedResult.code && sourceResult.code && !_isBlobEqual(sourceResult.code, changedResult.code));
+    SLANG_CHECK(changedResult.hitCount == 1 && changedResult.missCount > 0);
+
+    // A module that produces a warning isn't cached, so the warning is output every time it's compiled
+    File::writeAllText(pathA, "int f() { return 7; }\n#warning module a warning");
+
+    auto warningResult = _compileWithModuleCache(directory, cacheDirectory);
+    SLANG_CHECK(warningResult.code && warningResult.hitCount == 1);
+    SLANG_CHECK(warningResult.diagnostics.indexOf(toSlice("module a warning")) >= 0);
+
+    auto warningAgainResult = _compileWithModuleCache(directory, cacheDirectory);
+    SLANG_CHECK(warningAgainResult.code && warningAgainResult.hitCount == 1 && warningAgainResult.missCount > 0);
+    SLANG_CHECK(warningAgainResult.diagnostics.indexOf(toSlice("module a warning")) >= 0);
+
+    _removeDirectory(cacheDirectory);
+    _removeDirectory(directory);
+}
@@ -0,0 +1,67 @@
+// unit-test-name-pool.cpp
+
+#include "../../source/compiler-core/slang-name.h"
+#include "../../source/core/slang-string.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+SLANG_UNIT_TEST(namePool)
+{
+    RootNamePool rootNamePool;
+    NamePool namePool;
+    namePool.setRootNamePool(&rootNamePool);
+
+    // Basic operations
+    {
+        SLANG_CHECK(namePool.tryGetName(UnownedStringSlice("a")) == nullptr);
+
+        Name* a = namePool.getName("a");
+        SLANG_CHECK(a && a->text == "a");
+
+        // Names are unique, however the text is passed
+        SLANG_CHECK(namePool.getName(String("a")) == a);
+        SLANG_CHECK(namePool.getName(UnownedStringSlice("a")) == a);
+        SLANG_CHECK(namePool.tryGetName(String("a")) == a);
+
+        // The text is held by the pool, and is zero terminated
+        const char buffer[] = "abc";
+        Name* ab = namePool.getName(UnownedStringSlice(buffer, 2));
+        SLANG_CHECK(ab != a && ab->text.begin() != buffer);
+        SLANG_CHECK(::strcmp(getCstr(ab), "ab") == 0);
+        SLANG_CHECK(getText(ab) == "ab");
+
+        // The empty name
+        Name* empty = namePool.getName(UnownedStringSlice());
+        SLANG_CHECK(empty && empty->text.getLength() == 0 && empty != a);
+        SLANG_CHECK(namePool.getName("") == empty);
+
+        SLANG_CHECK(getText(nullptr).getLength() == 0);
+        SLANG_CHECK(getCstr(nullptr) == nullptr);
+    }
+
+    // Growing the table keeps the names
+    {
+        const Index count = 10000;
+        List<Name*> names;
+        for (Index i = 0; i < count; ++i)
+        {
+            names.add(namePool.getName(String("name") + String(i)));
+        }
+        for (Index i = 0; i < count; ++i)
+        {
+            const String text = String("name") + String(i);
+            SLANG_CHECK(namePool.tryGetName(text) == names[i]);
+            SLANG_CHECK(names[i]->text == text.getUnownedSlice());
+        }
+        SLANG_CHECK(namePool.getName("a")->text == "a");
+    }
+
+    // Names are shared through the root pool
+    {
+        NamePool otherNamePool;
+        otherNamePool.setRootNamePool(&rootNamePool);
+        SLANG_CHECK(otherNamePool.getName("a") == namePool.getName("a"));
+    }
+}
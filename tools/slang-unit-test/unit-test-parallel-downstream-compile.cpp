@@ -0,0 +1,169 @@
+// unit-test-parallel-downstream-compile.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+
+using namespace Slang;
+
+struct ParallelDownstreamCompileResult
+{
+    List<ComPtr<ISlangBlob>> codes;
+    String diagnostics;
+};
+
+struct ParallelDownstreamCompileTarget
+{
+    SlangCompileTarget format;
+    const char* profile;                    ///< The profile, or nullptr for the default
+};
+
+static void _compile(int threadCount, const List<ParallelDownstreamCompileTarget>& targets, ParallelDownstreamCompileResult& outResult)
+{
+    const char* userSource = R"(
+        int f(int x) { return x * 3; }
+
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeA(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[tid.x] = f(tid.x);
+        }
+
+        [shader("compute")]
+        [numthreads(8,1,1)]
+        void computeB(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[tid.x] = f(tid.x) + 1;
+        }
+
+        [shader("compute")]
+        [numthreads(16,1,1)]
+        void computeC(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> buffer)
+        {
+            buffer[tid.x] = float(f(tid.x)) * 0.5;
+        })";
+
+    const char* entryPointNames[] = { "computeA", "computeB", "computeC" };
+
+    auto session = spCreateSession();
+    auto request = spCreateCompileRequest(session);
+
+    spSetDownstreamCompileThreadCount(request, threadCount);
+
+    for (const auto& target : targets)
+    {
+        const int targetIndex = spAddCodeGenTarget(request, target.format);
+        if (target.profile)
+        {
+            spSetTargetProfile(request, targetIndex, spFindProfile(session, target.profile));
+        }
+    }
+
+    int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "userUnit");
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "userFile", userSource);
+    for (auto entryPointName : entryPointNames)
+    {
+        spAddEntryPoint(request, translationUnitIndex, entryPointName, SLANG_STAGE_COMPUTE);
+    }
+
+    if (SLANG_SUCCEEDED(spCompile(request)))
+    {
+        for (Index targetIndex = 0; targetIndex < targets.getCount(); ++targetIndex)
+        {
+            for (Index entryPointIndex = 0; entryPointIndex < Index(SLANG_COUNT_OF(entryPointNames)); ++entryPointIndex)
+            {
+                ComPtr<ISlangBlob> code;
+                spGetEntryPointCodeBlob(request, int(entryPointIndex), int(targetIndex), code.writeRef());
+                outResult.codes.add(code);
+            }
+        }
+    }
+    outResult.diagnostics = spGetDiagnosticOutput(request);
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+}
+
+static bool _isBlobEqual(ISlangBlob* a, ISlangBlob* b)
+{
+    return a && b && a->getBufferSize() == b->getBufferSize() &&
+        ::memcmp(a->getBufferPointer(), b->getBufferPointer(), a->getBufferSize()) == 0;
+}
+
+static void _checkSameAsSerial(const List<ParallelDownstreamCompileTarget>& targets)
+{
+    ParallelDownstreamCompileResult serialResult;
+    _compile(1, targets, serialResult);
+
+    SLANG_CHECK(serialResult.codes.getCount() == targets.getCount() * 3);
+
+    for (int threadCount : { 0, 2, 4 })
+    {
+        ParallelDownstreamCompileResult parallelResult;
+        _compile(threadCount, targets, parallelResult);
+
+        SLANG_CHECK(parallelResult.diagnostics == serialResult.diagnostics);
+        SLANG_CHECK(parallelResult.codes.getCount() == serialResult.codes.getCount());
+
+        if (parallelResult.codes.getCount() == serialResult.codes.getCount())
+        {
+            for (Index i = 0; i < serialResult.codes.getCount(); ++i)
+            {
+                SLANG_CHECK(_isBlobEqual(serialResult.codes[i], parallelResult.codes[i]));
+            }
+        }
+    }
+}
+
+// Test that generating code for entry points and targets on several threads produces the same code and
+// diagnostics as generating serially, for targets that are only emitted as source.
+SLANG_UNIT_TEST(parallelDownstreamCompile)
+{
+    List<ParallelDownstreamCompileTarget> targets;
+    targets.add(ParallelDownstreamCompileTarget{ SLANG_HLSL, nullptr });
+    targets.add(ParallelDownstreamCompileTarget{ SLANG_GLSL, nullptr });
+    _checkSameAsSerial(targets);
+}
+
+// As above, but with targets that need a downstream compiler, where the downstream compiles of different
+// tasks run concurrently. Uses whichever of the downstream compilers are available.
+SLANG_UNIT_TEST(parallelDownstreamCompileBinaryTargets)
+{
+    slang::IGlobalSession* globalSession = unitTestContext->slangGlobalSession;
+
+    struct Candidate
+    {
+        SlangPassThrough passThrough;
+        ParallelDownstreamCompileTarget target;
+    };
+    const Candidate candidates[] =
+    {
+        { SLANG_PASS_THROUGH_GLSLANG, { SLANG_SPIRV, "glsl_450" } },
+        { SLANG_PASS_THROUGH_DXC, { SLANG_DXIL, "sm_6_0" } },
+        { SLANG_PASS_THROUGH_FXC, { SLANG_DXBC, "sm_5_0" } },
+    };
+
+    // Mixed with a source target, so tasks for different kinds of target run together
+    List<ParallelDownstreamCompileTarget> targets;
+    targets.add(ParallelDownstreamCompileTarget{ SLANG_HLSL, nullptr });
+    for (const auto& candidate : candidates)
+    {
+        if (SLANG_SUCCEEDED(globalSession->checkPassThroughSupport(candidate.passThrough)))
+        {
+            targets.add(candidate.target);
+        }
+    }
+
+    if (targets.getCount() < 2)
+    {
+        SLANG_IGNORE_TEST
+    }
+
+    _checkSameAsSerial(targets);
+}
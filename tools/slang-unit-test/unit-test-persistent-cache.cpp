@@ -13,6 +13,11 @@
 #include <condition_variable>
 #include <functional>
 
+#if !SLANG_WINDOWS_FAMILY
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 using namespace Slang;
 
 static DefaultRandomGenerator rng(0xdeadbeef);
@@ -83,7 +88,7 @@ struct PersistentCacheTest
     String cacheDirectory;
     RefPtr<PersistentCache> cache;
 
-    PersistentCacheTest(Count maxEntryCount = 0)
+    PersistentCacheTest(Count maxEntryCount = 0, Count evictionBatchCount = 0)
     {
         osFileSystem = OSFileSystem::getMutableSingleton();
         cacheDirectory = Path::simplify(Path::getParentDirectory(Path::getExecutablePath()) + "/persistent-cache-test");
@@ -93,6 +98,7 @@ struct PersistentCacheTest
         PersistentCache::Desc desc;
         desc.directory = cacheDirectory.getBuffer();
         desc.maxEntryCount = maxEntryCount;
+        desc.evictionBatchCount = evictionBatchCount;
         cache = new PersistentCache(desc);
     }
 
@@ -310,21 +316,21 @@ struct CorruptionTest : public PersistentCacheTest
 {
     List<Entry> entries;
 
+    // Reads don't use the index, so the entries stay readable when the index is corrupt. The next
+    // write rebuilds the index from the entry files.
     template<typename Func>
-    void testIndexCorruption(Func func, SlangResult expectedReadResult)
+    void testIndexCorruption(Func func)
     {
         writeEntry(entries[0]);
+        writeEntry(entries[1]);
         SLANG_CHECK(readEntry(entries[0]) == true);
         func();
-        // We expect a SLANG_E_NOT_FOUND because the cache has an empty index now.
-        ComPtr<ISlangBlob> data;
-        SLANG_CHECK(cache->readEntry(entries[0].key, data.writeRef()) == expectedReadResult);
-
-        writeEntry(entries[0]);
         SLANG_CHECK(readEntry(entries[0]) == true);
-        func();
-        writeEntry(entries[0]);
+
+        writeEntry(entries[1]);
+        SLANG_CHECK(cache->getStats().entryCount == 2);
         SLANG_CHECK(readEntry(entries[0]) == true);
+        SLANG_CHECK(readEntry(entries[1]) == true);
     }
 
     void run()
@@ -342,11 +348,20 @@ struct CorruptionTest : public PersistentCacheTest
         SLANG_CHECK(readEntry(entries[0]) == true);
         osFileSystem->remove(getEntryFileName(entries[0]).getBuffer());
         ComPtr<ISlangBlob> data;
-        // First time we read the entry, we expect a SLANG_E_CANNOT_OPEN because the file is gone.
-        SLANG_CHECK(cache->readEntry(entries[0].key, data.writeRef()) == SLANG_E_CANNOT_OPEN);
-        // The next time we read the entry, we expect a SLANG_E_NOT_FOUND because the entry has
-        // been removed from the cache index.
+        // The entry is still in the index, but as its file is gone it isn't found.
+        SLANG_CHECK(cache->readEntry(entries[0].key, data.writeRef()) == SLANG_E_NOT_FOUND);
+        SLANG_CHECK(data == nullptr);
         SLANG_CHECK(cache->readEntry(entries[0].key, data.writeRef()) == SLANG_E_NOT_FOUND);
+        // The stale entry was dropped from the index, which is recorded with the next write.
+        writeEntry(entries[1]);
+        SLANG_CHECK(cache->getStats().entryCount == 1);
+        SLANG_CHECK(readEntry(entries[1]) == true);
+        {
+            PersistentCache::Desc desc;
+            desc.directory = cacheDirectory.getBuffer();
+            RefPtr<PersistentCache> otherCache = new PersistentCache(desc);
+            SLANG_CHECK(otherCache->getStats().entryCount == 1);
+        }
 
         // Test behavior when a cached entry file is removed externally before writing.
         writeEntry(entries[0]);
@@ -359,8 +374,8 @@ struct CorruptionTest : public PersistentCacheTest
         writeEntry(entries[0]);
         SLANG_CHECK(readEntry(entries[0]) == true);
         osFileSystem->remove(getIndexFilename().getBuffer());
-        // We expect a SLANG_E_NOT_FOUND because the cache has an empty index now.
-        SLANG_CHECK(cache->readEntry(entries[0].key, data.writeRef()) == SLANG_E_NOT_FOUND);
+        // The entry file still exists, so the entry is found.
+        SLANG_CHECK(readEntry(entries[0]) == true);
 
         // Test behavior when the index file is removed before writing.
         writeEntry(entries[0]);
@@ -374,18 +389,18 @@ struct CorruptionTest : public PersistentCacheTest
             [this]()
             {
                 osFileSystem->remove(getIndexFilename().getBuffer());
-            },
-            SLANG_E_NOT_FOUND);
+            });
 
+        // Invalid magic.
         testIndexCorruption(
             [this]()
             {
                 FileStream fs;
                 fs.init(getIndexFilename(), FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite);
                 fs.write("x", 1);
-            },
-            SLANG_E_INTERNAL_FAIL);
+            });
 
+        // Invalid version.
         testIndexCorruption(
             [this]()
             {
@@ -394,31 +409,31 @@ struct CorruptionTest : public PersistentCacheTest
                 fs.seek(SeekOrigin::Start, 4);
                 uint32_t version = 0xffffffff;
                 fs.write(&version, sizeof(version));
-            },
-            SLANG_E_INTERNAL_FAIL);
+            });
 
+        // A different generation, as if another process rewrote the index.
         testIndexCorruption(
             [this]()
             {
                 FileStream fs;
                 fs.init(getIndexFilename(), FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite);
                 fs.seek(SeekOrigin::Start, 8);
-                uint32_t count = 0x7fffffff;
-                fs.write(&count, sizeof(count));
-            },
-            SLANG_E_INTERNAL_FAIL);
+                uint32_t generation = 0x7fffffff;
+                fs.write(&generation, sizeof(generation));
+            });
 
+        // Invalid record type in the last record.
         testIndexCorruption(
             [this]()
             {
                 FileStream fs;
                 fs.init(getIndexFilename(), FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite);
-                fs.seek(SeekOrigin::Start, 8);
-                uint32_t count = 0;
-                fs.write(&count, sizeof(count));
-            },
-            SLANG_E_INTERNAL_FAIL);
+                fs.seek(SeekOrigin::End, -4);
+                uint32_t type = 0xffffffff;
+                fs.write(&type, sizeof(type));
+            });
 
+        // A partially written record, as if the application was terminated while appending.
         testIndexCorruption(
             [this]()
             {
@@ -426,8 +441,7 @@ struct CorruptionTest : public PersistentCacheTest
                 fs.init(getIndexFilename(), FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite);
                 fs.seek(SeekOrigin::End, 0);
                 fs.write("x", 1);
-            },
-            SLANG_E_INTERNAL_FAIL);
+            });
     }
 };
 
@@ -585,6 +599,136 @@ struct StressTest : public PersistentCacheTest
     }
 };
 
+// Multi-process stress testing.
+// Runs a number of workers, each with its own cache object (as separate processes would have) on
+// the same cache directory. On Windows the workers run on threads, elsewhere they are forked
+// processes. Each worker writes and reads random entries, and checks that every entry read has the
+// expected data. Afterwards, the cache must be within its size limit and all remaining entries must
+// be readable.
+struct MultiProcessStressTest : public PersistentCacheTest
+{
+    // Number of distinct entries used by the workers.
+    static const uint32_t kEntryCount = 200;
+    // Maximum number of entries stored in the cache.
+    static const uint32_t kMaxEntryCount = 100;
+    // Number of entries evicted at once.
+    static const uint32_t kEvictionBatchCount = 16;
+    // Number of workers.
+    static const uint32_t kWorkerCount = 4;
+    // Number of operations per worker.
+    static const uint32_t kOperationCount = 500;
+
+    List<Entry> entries;
+
+    MultiProcessStressTest() : PersistentCacheTest(kMaxEntryCount, kEvictionBatchCount) {}
+
+    RefPtr<PersistentCache> createCache()
+    {
+        PersistentCache::Desc desc;
+        desc.directory = cacheDirectory.getBuffer();
+        desc.maxEntryCount = kMaxEntryCount;
+        desc.evictionBatchCount = kEvictionBatchCount;
+        return new PersistentCache(desc);
+    }
+
+    // Runs the operations of a worker, returns the number of entries read with unexpected data.
+    uint32_t runWorker(uint32_t workerIndex)
+    {
+        RefPtr<PersistentCache> workerCache = createCache();
+        DefaultRandomGenerator workerRng(0x1234 + workerIndex);
+        uint32_t errorCount = 0;
+
+        for (uint32_t i = 0; i < kOperationCount; ++i)
+        {
+            const Entry& entry = entries[workerRng.nextInt32InRange(0, kEntryCount)];
+            ComPtr<ISlangBlob> data;
+            SlangResult result = workerCache->readEntry(entry.key, data.writeRef());
+            if (SLANG_SUCCEEDED(result))
+            {
+                errorCount += isBlobEqual(data, entry.data) ? 0 : 1;
+            }
+            else if (SLANG_FAILED(workerCache->writeEntry(entry.key, entry.data)))
+            {
+                errorCount++;
+            }
+        }
+        return errorCount;
+    }
+
+    void run()
+    {
+        // Setup a list of entries to store in the cache.
+        for (size_t i = 0; i < kEntryCount; ++i)
+        {
+            size_t size = rng.nextInt32InRange(256, 16 * 1024);
+            auto data = createRandomBlob(size);
+            auto key = SHA1::compute(data->getBufferPointer(), data->getBufferSize());
+            entries.add(Entry{ key, data });
+        }
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+#if SLANG_WINDOWS_FAMILY
+        std::atomic<uint32_t> errorCount{0};
+        List<std::thread> workers;
+        for (uint32_t workerIndex = 0; workerIndex < kWorkerCount; ++workerIndex)
+        {
+            workers.add(std::thread(
+                [this, workerIndex, &errorCount]()
+                {
+                    errorCount.fetch_add(runWorker(workerIndex));
+                }));
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        SLANG_CHECK(errorCount == 0);
+#else
+        List<pid_t> workers;
+        for (uint32_t workerIndex = 0; workerIndex < kWorkerCount; ++workerIndex)
+        {
+            pid_t pid = fork();
+            if (pid == 0)
+            {
+                // Exit without running any destructors or handlers of the parent process.
+                _exit(runWorker(workerIndex) == 0 ? 0 : 1);
+            }
+            SLANG_CHECK(pid > 0);
+            if (pid > 0)
+            {
+                workers.add(pid);
+            }
+        }
+        for (auto pid : workers)
+        {
+            int status = 0;
+            SLANG_CHECK(waitpid(pid, &status, 0) == pid);
+            SLANG_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+        }
+#endif
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        auto duration = endTime - startTime;
+        auto seconds = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() / 1000.0;
+
+        LOG("Total time: %.3fs\n", seconds);
+        LOG("Operations per second: %.1f\n", (kWorkerCount * kOperationCount) / seconds);
+
+        // Check the state of the cache as seen by a new cache object.
+        cache = createCache();
+        SLANG_CHECK(cache->getStats().entryCount > 0);
+        SLANG_CHECK(cache->getStats().entryCount <= kMaxEntryCount);
+
+        Count foundCount = 0;
+        for (const auto& entry : entries)
+        {
+            foundCount += readEntry(entry) ? 1 : 0;
+        }
+        SLANG_CHECK(foundCount == cache->getStats().entryCount);
+    }
+};
+
 SLANG_UNIT_TEST(persistentCacheBasic)
 {
     BasicTest test;
@@ -613,3 +757,13 @@ SLANG_UNIT_TEST(persistentCacheStress)
     StressTest test;
     test.run();
 }
+
+SLANG_UNIT_TEST(persistentCacheMultiProcessStress)
+{
+    // See persistentCacheStress.
+#if SLANG_PROCESSOR_ARM_64
+    SLANG_IGNORE_TEST
+#endif
+    MultiProcessStressTest test;
+    test.run();
+}
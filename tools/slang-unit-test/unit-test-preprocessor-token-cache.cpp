@@ -0,0 +1,130 @@
+// unit-test-preprocessor-token-cache.cpp
+
+#include "../../slang.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-memory-file-system.h"
+#include "../../source/core/slang-string-util.h"
+
+using namespace Slang;
+
+static const char kCommonHeader[] = R"(
+#pragma once
+#include "inner.h"
+
+// A line continuation, such that the token has to be scrubbed \
+   of the escaped newline
+float scale(float x) { return x * SCA\
+LE; }
+)";
+
+static const char kInnerHeader[] = R"(
+#define SCALE 2.0
+float offset(float x) { return x + __LINE__; }
+)";
+
+    /// Get the value of the counter `name` from a text performance report, or -1 if not found
+static Index _getCounterValue(const UnownedStringSlice& report, const UnownedStringSlice& name)
+{
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(report, lines);
+    for (const auto& line : lines)
+    {
+        if (line.startsWith(name))
+        {
+            const UnownedStringSlice valueText = UnownedStringSlice(line.begin() + name.getLength(), line.end()).trim();
+            Int value = 0;
+            return SLANG_SUCCEEDED(StringUtil::parseInt(valueText, value)) ? Index(value) : -1;
+        }
+    }
+    return -1;
+}
+
+    /// Remove `#line` directives, as they name the module being compiled
+static String _removeLineDirectives(const UnownedStringSlice& code)
+{
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(code, lines);
+
+    StringBuilder buf;
+    for (const auto& line : lines)
+    {
+        if (!line.trim().startsWith("#line"))
+        {
+            buf << line << "\n";
+        }
+    }
+    return buf.ProduceString();
+}
+
+// Test that files that are included by many modules are read from the preprocessor token cache,
+// producing the same code as if they had been lexed.
+SLANG_UNIT_TEST(preprocessorTokenCache)
+{
+    slang::IGlobalSession* globalSession = unitTestContext->slangGlobalSession;
+
+    ComPtr<ISlangMutableFileSystem> fileSystem(new MemoryFileSystem);
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(fileSystem->saveFile("common.h", kCommonHeader, SLANG_COUNT_OF(kCommonHeader) - 1)));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(fileSystem->saveFile("inner.h", kInnerHeader, SLANG_COUNT_OF(kInnerHeader) - 1)));
+
+    slang::TargetDesc targetDesc;
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+    sessionDesc.fileSystem = fileSystem;
+    sessionDesc.flags = slang::kSessionFlag_ReportPerformance;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    const Index moduleCount = 3;
+    List<String> codes;
+    ComPtr<slang::IComponentType> lastProgram;
+    for (Index i = 0; i < moduleCount; ++i)
+    {
+        StringBuilder moduleName;
+        moduleName << "module" << i;
+
+        StringBuilder source;
+        source << "#include \"common.h\"\n";
+        source << "[shader(\"compute\")]\n[numthreads(8,1,1)]\n";
+        source << "void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> buffer)\n";
+        source << "{ buffer[tid.x] = offset(scale(float(tid.x))); }\n";
+
+        ComPtr<slang::IBlob> diagnostics;
+        slang::IModule* module = session->loadModuleFromSource(moduleName.getBuffer(), (moduleName + ".slang").getBuffer(), StringBlob::create(source.ProduceString()), diagnostics.writeRef());
+        SLANG_CHECK_ABORT(module);
+
+        ComPtr<slang::IEntryPoint> entryPoint;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+        slang::IComponentType* components[] = { module, entryPoint };
+        ComPtr<slang::IComponentType> program;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->createCompositeComponentType(components, 2, program.writeRef())));
+
+        ComPtr<slang::IBlob> code;
+        SLANG_CHECK(SLANG_SUCCEEDED(program->getEntryPointCode(0, 0, code.writeRef())));
+        codes.add(code ? _removeLineDirectives(StringUtil::getSlice(code)) : String());
+
+        lastProgram = program;
+    }
+
+    // The headers are the same for every module, so the code should be too. The first module has
+    // its headers lexed, the others are replayed from the cache.
+    SLANG_CHECK(codes[0].getLength() > 0);
+    for (Index i = 1; i < moduleCount; ++i)
+    {
+        SLANG_CHECK(codes[i] == codes[0]);
+    }
+
+    ComPtr<ISlangBlob> report;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(lastProgram->getPerformanceReport(SLANG_PERFORMANCE_REPORT_FORMAT_TEXT, report.writeRef())));
+    const Index hitCount = _getCounterValue(StringUtil::getSlice(report), UnownedStringSlice::fromLiteral("includes read from token cache"));
+    SLANG_CHECK(hitCount == (moduleCount - 1) * 2);
+}
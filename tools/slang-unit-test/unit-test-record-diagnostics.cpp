@@ -0,0 +1,67 @@
+// unit-test-record-diagnostics.cpp
+
+#include "../../source/compiler-core/slang-diagnostic-sink.h"
+#include "../../source/core/slang-char-util.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static const DiagnosticInfo kUndefinedIdentifier = { 30015, Severity::Error, "undefinedIdentifier", "undefined identifier '$0'." };
+static const DiagnosticInfo kUnusedVariable = { 30016, Severity::Warning, "unusedVariable", "unused variable '$0'." };
+
+static UnownedStringSlice _lexIdentifier(const UnownedStringSlice& text)
+{
+    const char* end = text.begin();
+    while (end < text.end() && (CharUtil::isAlphaOrDigit(*end) || *end == '_'))
+    {
+        end++;
+    }
+    return UnownedStringSlice(text.begin(), end);
+}
+
+SLANG_UNIT_TEST(recordDiagnostics)
+{
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+
+    const String contents("int a = someName;\nint unused;\n");
+    SourceFile* sourceFile = sourceManager.createSourceFileWithString(PathInfo::makePath("test.slang"), contents);
+    SourceView* sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+
+    const SourceLoc nameLoc = sourceView->getRange().begin + contents.indexOf("someName");
+    const SourceLoc unusedLoc = sourceView->getRange().begin + contents.indexOf("unused");
+
+    DiagnosticSink sink(&sourceManager, _lexIdentifier);
+    sink.setFlag(DiagnosticSink::Flag::RecordDiagnostics);
+
+    sink.diagnose(nameLoc, kUndefinedIdentifier, "someName");
+    sink.diagnose(unusedLoc, kUnusedVariable, "unused");
+
+    // Recorded diagnostics aren't formatted into the output, but are still counted
+    SLANG_CHECK(sink.outputBuffer.getLength() == 0);
+    SLANG_CHECK(sink.getErrorCount() == 1);
+
+    const auto& recorded = sink.getRecordedDiagnostics();
+    SLANG_CHECK(recorded.getCount() == 2);
+    if (recorded.getCount() == 2)
+    {
+        SLANG_CHECK(recorded[0].severity == Severity::Error);
+        SLANG_CHECK(recorded[0].code == 30015);
+        SLANG_CHECK(recorded[0].message == "undefined identifier 'someName'.");
+        // The range covers the token at the location
+        SLANG_CHECK(recorded[0].range.begin == nameLoc);
+        SLANG_CHECK(recorded[0].range.getSize() == UInt(strlen("someName")));
+
+        SLANG_CHECK(recorded[1].severity == Severity::Warning);
+        SLANG_CHECK(recorded[1].code == 30016);
+        SLANG_CHECK(recorded[1].range.begin == unusedLoc);
+        SLANG_CHECK(recorded[1].range.getSize() == UInt(strlen("unused")));
+
+        HumaneSourceLoc humaneLoc = sourceManager.getHumaneLoc(recorded[1].range.begin);
+        SLANG_CHECK(humaneLoc.line == 2 && humaneLoc.column == 5);
+    }
+
+    sink.reset();
+    SLANG_CHECK(sink.getRecordedDiagnostics().getCount() == 0);
+}
@@ -0,0 +1,157 @@
+// unit-test-shared-global-session.cpp
+
+#include "../../slang.h"
+
+#include <atomic>
+#include <thread>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-string-util.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct SharedSessionCompileResult
+{
+    String code;
+    String diagnostics;
+
+    bool operator==(const SharedSessionCompileResult& rhs) const { return code == rhs.code && diagnostics == rhs.diagnostics; }
+};
+
+} // anonymous
+
+static const char* const kSources[] =
+{
+    // Uses generics, interfaces and builtin types and functions from the stdlib
+    R"(
+        interface IShape { float area(); }
+        struct Circle : IShape { float r; float area() { return 3.14159 * r * r; } }
+        struct Square : IShape { float s; float area() { return s * s; } }
+
+        float totalArea<T : IShape>(T a, T b) { return a.area() + b.area(); }
+
+        [shader("compute")]
+        [numthreads(8,1,1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float4> buffer)
+        {
+            Circle c = { float(tid.x) };
+            Square s = { 2.0 };
+            float3 v = normalize(float3(tid) + 1.0);
+            buffer[tid.x] = float4(v * totalArea(c, c), max(s.area(), 1.0));
+        })",
+    // Fails to compile, with a diagnostic that refers to stdlib declarations
+    R"(
+        [shader("compute")]
+        [numthreads(8,1,1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> buffer)
+        {
+            buffer[tid.x] = max(float(tid.x));
+        })",
+};
+
+static SharedSessionCompileResult _compile(slang::IGlobalSession* globalSession, const char* source)
+{
+    SharedSessionCompileResult result;
+
+    slang::TargetDesc targetDesc;
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+
+    ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(globalSession->createSession(sessionDesc, session.writeRef())))
+    {
+        return result;
+    }
+
+    ComPtr<slang::IBlob> diagnostics;
+    // The module is owned by the session
+    slang::IModule* module = session->loadModuleFromSource("shared", "shared.slang", StringBlob::create(source), diagnostics.writeRef());
+    if (diagnostics)
+    {
+        result.diagnostics = StringUtil::getString(diagnostics);
+    }
+    if (!module)
+    {
+        return result;
+    }
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    if (SLANG_FAILED(module->findEntryPointByName("computeMain", entryPoint.writeRef())))
+    {
+        return result;
+    }
+
+    slang::IComponentType* components[] = { module, entryPoint };
+    ComPtr<slang::IComponentType> program;
+    if (SLANG_FAILED(session->createCompositeComponentType(components, 2, program.writeRef())))
+    {
+        return result;
+    }
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    if (SLANG_FAILED(program->link(linkedProgram.writeRef())))
+    {
+        return result;
+    }
+
+    ComPtr<slang::IBlob> code;
+    if (SLANG_SUCCEEDED(linkedProgram->getEntryPointCode(0, 0, code.writeRef())))
+    {
+        result.code = StringUtil::getString(code);
+    }
+    return result;
+}
+
+// Test that sessions created from one global session can compile on multiple threads at the same
+// time, with the same results as compiling on a single thread.
+SLANG_UNIT_TEST(sharedGlobalSession)
+{
+    slang::IGlobalSession* globalSession = unitTestContext->slangGlobalSession;
+
+    const Index sourceCount = SLANG_COUNT_OF(kSources);
+
+    List<SharedSessionCompileResult> expectedResults;
+    for (Index i = 0; i < sourceCount; ++i)
+    {
+        expectedResults.add(_compile(globalSession, kSources[i]));
+    }
+    SLANG_CHECK(expectedResults[0].code.getLength() > 0);
+    SLANG_CHECK(expectedResults[1].code.getLength() == 0 && expectedResults[1].diagnostics.getLength() > 0);
+
+    const Index threadCount = 8;
+    const Index iterationCount = 4;
+
+    std::atomic<Index> mismatchCount(0);
+    List<std::thread> threads;
+    for (Index threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+    {
+        threads.add(std::thread(
+            [&, threadIndex]()
+            {
+                for (Index iteration = 0; iteration < iterationCount; ++iteration)
+                {
+                    // Interleave the sources between threads
+                    const Index sourceIndex = (threadIndex + iteration) % sourceCount;
+                    if (!(_compile(globalSession, kSources[sourceIndex]) == expectedResults[sourceIndex]))
+                    {
+                        mismatchCount++;
+                    }
+                }
+            }));
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    SLANG_CHECK(mismatchCount == 0);
+}
@@ -0,0 +1,143 @@
+// unit-test-specialized-entry-point-codes.cpp
+
+#include "../../slang.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-string-util.h"
+
+using namespace Slang;
+
+static const Index kMaterialCount = 16;
+
+static String _getSource()
+{
+    StringBuilder buf;
+    buf << "interface IMaterial { float4 shade(float2 uv); }\n";
+    for (Index i = 0; i < kMaterialCount; ++i)
+    {
+        buf << "struct Material" << i << " : IMaterial { float4 shade(float2 uv) { return float4(uv * " << i << ".0, sin(uv.x), " << i << ".0); } }\n";
+    }
+    buf << R"(
+        [shader("compute")]
+        [numthreads(8,1,1)]
+        void computeMain<M : IMaterial>(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float4> buffer)
+        {
+            M material;
+            buffer[tid.x] = material.shade(float2(tid.xy));
+        })";
+    return buf.ProduceString();
+}
+
+    /// Get the codes for a batch. The code is empty for a set of arguments that failed.
+static SlangResult _getSpecializedEntryPointCodes(
+    slang::IComponentType* program,
+    const slang::SpecializationArg* args,
+    Index argCount,
+    Index argSetCount,
+    List<String>& outCodes,
+    slang::IBlob** outDiagnostics = nullptr)
+{
+    List<slang::IBlob*> blobs;
+    blobs.setCount(argSetCount);
+    const SlangResult res = program->getSpecializedEntryPointCodes(args, argCount, argSetCount, 0, 0, blobs.getBuffer(), outDiagnostics);
+
+    outCodes.clear();
+    for (auto blob : blobs)
+    {
+        // Take ownership of the blob
+        ComPtr<slang::IBlob> code;
+        code.attach(blob);
+        outCodes.add(code ? StringUtil::getString(code) : String());
+    }
+    return res;
+}
+
+SLANG_UNIT_TEST(specializedEntryPointCodes)
+{
+    slang::IGlobalSession* globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc;
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnostics;
+    slang::IModule* module = session->loadModuleFromSource("materials", "materials.slang", StringBlob::create(_getSource()), diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+    slang::IComponentType* components[] = { module, entryPoint };
+    ComPtr<slang::IComponentType> program;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->createCompositeComponentType(components, 2, program.writeRef())));
+    SLANG_CHECK_ABORT(program->getSpecializationParamCount() == 1);
+
+    List<slang::SpecializationArg> args;
+    for (Index i = 0; i < kMaterialCount; ++i)
+    {
+        StringBuilder typeName;
+        typeName << "Material" << i;
+        slang::TypeReflection* type = module->getLayout()->findTypeByName(typeName.getBuffer());
+        SLANG_CHECK_ABORT(type);
+        args.add(slang::SpecializationArg::fromType(type));
+    }
+
+    // Compile each specialization in turn
+    List<String> expectedCodes;
+    for (const auto& arg : args)
+    {
+        ComPtr<slang::IComponentType> specialized;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program->specialize(&arg, 1, specialized.writeRef())));
+        ComPtr<slang::IComponentType> linked;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(specialized->link(linked.writeRef())));
+        ComPtr<slang::IBlob> code;
+        SLANG_CHECK(SLANG_SUCCEEDED(linked->getEntryPointCode(0, 0, code.writeRef())));
+        expectedCodes.add(code ? StringUtil::getString(code) : String());
+    }
+
+    // Compile all of them in a batch, which should produce the same code
+    {
+        List<String> codes;
+        SLANG_CHECK(SLANG_SUCCEEDED(_getSpecializedEntryPointCodes(program, args.getBuffer(), 1, kMaterialCount, codes)));
+
+        SLANG_CHECK_ABORT(codes.getCount() == kMaterialCount);
+        for (Index i = 0; i < kMaterialCount; ++i)
+        {
+            SLANG_CHECK(expectedCodes[i].getLength() > 0);
+            SLANG_CHECK(codes[i] == expectedCodes[i]);
+        }
+    }
+
+    // A set of arguments that fails to specialize only fails that set
+    {
+        slang::TypeReflection* floatType = module->getLayout()->findTypeByName("float");
+        SLANG_CHECK_ABORT(floatType);
+        const slang::SpecializationArg badArgs[] = { args[0], slang::SpecializationArg::fromType(floatType), args[1] };
+
+        List<String> codes;
+        ComPtr<slang::IBlob> batchDiagnostics;
+        SLANG_CHECK(SLANG_FAILED(_getSpecializedEntryPointCodes(program, badArgs, 1, 3, codes, batchDiagnostics.writeRef())));
+        SLANG_CHECK_ABORT(codes.getCount() == 3);
+        SLANG_CHECK(codes[0] == expectedCodes[0]);
+        SLANG_CHECK(codes[1].getLength() == 0);
+        SLANG_CHECK(codes[2] == expectedCodes[1]);
+        SLANG_CHECK(batchDiagnostics != nullptr);
+    }
+
+    // The number of arguments in each set must match the specialization parameters
+    {
+        List<String> codes;
+        SLANG_CHECK(SLANG_FAILED(_getSpecializedEntryPointCodes(program, args.getBuffer(), 2, 1, codes)));
+        SLANG_CHECK(codes.getCount() == 1 && codes[0].getLength() == 0);
+    }
+}